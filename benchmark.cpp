@@ -0,0 +1,536 @@
+/**
+ * @file benchmark.cpp
+ * @brief Headless simulation benchmark with reproducible scenarios
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ *
+ * Runs GravitySimulation without a window or GL context over canned
+ * scenarios and reports throughput, force cost, grid update time and energy
+ * drift, as a table or CSV for nightly regression tracking. --check-resume
+ * also verifies that a checkpointed run resumes bit for bit.
+ */
+
+#include "include/GravitySimulation.h"
+#include "include/DirectForceSolver.h"
+#include "include/BarnesHutSolver.h"
+#include "include/BodyGenerators.h"
+#include "include/Checkpoint.h"
+#include "include/Integrators.h"
+#include "include/Profiler.h"
+#include "include/TrajectoryRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Benchmark options parsed from the command line
+ */
+struct BenchmarkOptions {
+    std::string scenario = "all";      ///< Scenario name or "all" (--scenario=NAME)
+    int steps = 0;                     ///< Timed steps, 0 = the scenario's default (--steps=N)
+    int warmupSteps = 2;               ///< Untimed steps before measuring (--warmup=N)
+    float timeStep = 0.016f;           ///< Simulated seconds per step (--dt=S)
+    std::string solver = "direct";     ///< Force solver (--solver=direct|barnes-hut)
+    float theta = 0.5f;                ///< Barnes-Hut opening angle (--theta=T)
+    std::string integrator = "leapfrog"; ///< Time integrator (--integrator=NAME)
+    PositionPrecision positionPrecision = PositionPrecision::Single; ///< Position accumulation (--precision=single|compensated|double)
+    bool particleMeshField = false;    ///< Grid field via FFTs (--field=pm)
+    CollisionResolver::Mode collisions = CollisionResolver::Mode::None; ///< Touching bodies (--collisions=none|merge|inelastic)
+    std::string collisionName = "none"; ///< Name of collisions for the report
+    ForceLaw forceLaw;                 ///< Body-body law (--softening=clamped|plummer, --softening-length=L, --force-clamp=on|off)
+    size_t threads = 0;                ///< Worker threads, 0 = hardware concurrency (--threads=N)
+    std::string recordPath;            ///< Record trajectories while timing, to measure the cost (--record=FILE)
+    std::string resumeCheckPath;       ///< Scratch checkpoint for the resume check, empty = no check (--check-resume=FILE)
+    bool csv = false;                  ///< Machine-readable output (--format=csv)
+
+    /**
+     * @brief Parses command line arguments
+     * @param argc Argument count
+     * @param argv Argument values
+     * @param options Parsed options
+     * @return false if an argument is not understood
+     */
+    static bool parse(int argc, char** argv, BenchmarkOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--scenario=", 0) == 0) {
+                options.scenario = arg.substr(11);
+            } else if (arg.rfind("--steps=", 0) == 0) {
+                options.steps = std::atoi(arg.c_str() + 8);
+            } else if (arg.rfind("--warmup=", 0) == 0) {
+                options.warmupSteps = std::atoi(arg.c_str() + 9);
+            } else if (arg.rfind("--dt=", 0) == 0) {
+                options.timeStep = std::strtof(arg.c_str() + 5, nullptr);
+            } else if (arg.rfind("--solver=", 0) == 0) {
+                options.solver = arg.substr(9);
+            } else if (arg.rfind("--theta=", 0) == 0) {
+                options.theta = std::strtof(arg.c_str() + 8, nullptr);
+            } else if (arg.rfind("--integrator=", 0) == 0) {
+                options.integrator = arg.substr(13);
+            } else if (arg.rfind("--precision=", 0) == 0) {
+                if (!parsePositionPrecision(arg.substr(12), options.positionPrecision)) {
+                    std::cerr << "Unknown precision: " << arg.substr(12) << "\n";
+                    return false;
+                }
+            } else if (arg == "--field=pm") {
+                options.particleMeshField = true;
+            } else if (arg == "--field=direct") {
+                options.particleMeshField = false;
+            } else if (arg == "--collisions=none") {
+                options.collisions = CollisionResolver::Mode::None;
+                options.collisionName = "none";
+            } else if (arg == "--collisions=merge") {
+                options.collisions = CollisionResolver::Mode::Merge;
+                options.collisionName = "merge";
+            } else if (arg == "--collisions=inelastic") {
+                options.collisions = CollisionResolver::Mode::Inelastic;
+                options.collisionName = "inelastic";
+            } else if (arg == "--softening=clamped") {
+                options.forceLaw.softening = Softening::Clamped;
+            } else if (arg == "--softening=plummer") {
+                options.forceLaw.softening = Softening::Plummer;
+            } else if (arg.rfind("--softening-length=", 0) == 0) {
+                options.forceLaw.softeningLength = std::strtof(arg.c_str() + 19, nullptr);
+            } else if (arg == "--force-clamp=on") {
+                options.forceLaw.clampForce = true;
+            } else if (arg == "--force-clamp=off") {
+                options.forceLaw.clampForce = false;
+            } else if (arg.rfind("--record=", 0) == 0) {
+                options.recordPath = arg.substr(9);
+            } else if (arg.rfind("--check-resume=", 0) == 0) {
+                options.resumeCheckPath = arg.substr(15);
+            } else if (arg.rfind("--threads=", 0) == 0) {
+                options.threads = static_cast<size_t>(std::atoi(arg.c_str() + 10));
+            } else if (arg == "--format=csv") {
+                options.csv = true;
+            } else if (arg == "--format=text") {
+                options.csv = false;
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @class CountingForceSolver
+ * @brief Forwards to another solver and counts the work requested from it
+ *
+ * Interactions are counted as direct-sum pairs (targets x sources), so the
+ * cost per interaction of approximate solvers is comparable with the direct one.
+ */
+class CountingForceSolver : public IForceSolver {
+public:
+    explicit CountingForceSolver(std::unique_ptr<IForceSolver> solver) : solver(std::move(solver)) {}
+
+    void computeForces(const BodyStore& bodies, float gravitationalConstant,
+                       std::vector<Vec2>& forces, ThreadPool* threadPool) override {
+        interactions += static_cast<double>(bodies.size()) * (bodies.size() - 1);
+        solver->computeForces(bodies, gravitationalConstant, forces, threadPool);
+    }
+
+    void computeForcesOn(const BodyStore& bodies, float gravitationalConstant,
+                         const std::vector<size_t>& targets, std::vector<Vec2>& forces,
+                         ThreadPool* threadPool) override {
+        interactions += static_cast<double>(targets.size()) * (bodies.size() - 1);
+        solver->computeForcesOn(bodies, gravitationalConstant, targets, forces, threadPool);
+    }
+
+    void setForceLaw(const ForceLaw& law) override { solver->setForceLaw(law); }
+    const ForceLaw& getForceLaw() const override { return solver->getForceLaw(); }
+    void setFrameArena(FrameArena* arena) override { solver->setFrameArena(arena); }
+
+    const char* getName() const override { return solver->getName(); }
+
+    double interactions = 0.0;   ///< Pairs requested since the last reset
+
+private:
+    std::unique_ptr<IForceSolver> solver;
+};
+
+/**
+ * @class ScenarioRandom
+ * @brief Platform-independent random numbers for scenario setup
+ *
+ * std::uniform_real_distribution differs between standard libraries, so
+ * the raw mt19937 output is converted by hand to keep scenarios identical
+ * on every compiler.
+ */
+class ScenarioRandom {
+public:
+    explicit ScenarioRandom(uint32_t seed) : engine(seed) {}
+
+    /** Uniform in [0, 1) */
+    double uniform() {
+        return (engine() >> 8) * (1.0 / 16777216.0);
+    }
+
+private:
+    std::mt19937 engine;
+};
+
+/**
+ * @struct Scenario
+ * @brief A reproducible initial state
+ */
+struct Scenario {
+    const char* name;            ///< Name for --scenario
+    float worldWidth;            ///< World size (large enough that bodies rarely bounce)
+    float worldHeight;
+    int gridResolution;          ///< Grid points per 100 units; keeps every grid near the window's 200 x 150
+    int defaultSteps;            ///< Timed steps unless --steps is given
+    size_t bodyCount;            ///< Bodies created (used by the generated scenes)
+    void (*populate)(GravitySimulation& simulation, const Scenario& scenario);
+};
+
+/**
+ * @brief Adds a uniform disc of bodies on circular orbits around an optional central mass
+ * @param simulation Simulation to add to
+ * @param random Random source
+ * @param centerX Disc center
+ * @param centerY Disc center
+ * @param radius Disc radius
+ * @param count Number of disc bodies
+ * @param discMass Total mass of the disc bodies
+ * @param centralMass Mass of a body at the center (0 for none)
+ * @param driftX Velocity added to every body
+ * @param driftY Velocity added to every body
+ */
+void addDisc(GravitySimulation& simulation, ScenarioRandom& random, float centerX, float centerY,
+             float radius, size_t count, float discMass, float centralMass, float driftX, float driftY) {
+    const float g = simulation.getGravitationalConstant();
+    std::vector<BodyDescriptor> disc;
+    disc.reserve(count + 1);
+    if (centralMass > 0.0f) {
+        disc.push_back({Vec2(centerX, centerY), Vec2(driftX, driftY), centralMass, 15.0f});
+    }
+
+    const float bodyMass = discMass / count;
+    for (size_t i = 0; i < count; ++i) {
+        // sqrt keeps the surface density uniform
+        double r = radius * std::sqrt(random.uniform());
+        double angle = 2.0 * M_PI * random.uniform();
+        double enclosed = centralMass + discMass * (r * r) / (radius * radius);
+        double speed = std::sqrt(g * enclosed / std::max(r, static_cast<double>(GravityBody::PAIR_MIN_DISTANCE)));
+
+        disc.push_back({Vec2(static_cast<float>(centerX + r * std::cos(angle)), static_cast<float>(centerY + r * std::sin(angle))),
+                        Vec2(static_cast<float>(-speed * std::sin(angle)) + driftX,
+                             static_cast<float>(speed * std::cos(angle)) + driftY),
+                        bodyMass, 1.0f});
+    }
+    simulation.addBodies(disc.data(), disc.size());
+}
+
+/**
+ * @brief Replaces the bodies with a built-in generated scene
+ * @param simulation Simulation to fill
+ * @param scenario Scenario giving the body count and world size
+ * @param scene Name accepted by createSceneGenerator()
+ */
+void addGeneratedScene(GravitySimulation& simulation, const Scenario& scenario, const char* scene) {
+    simulation.clearBodies();
+    auto generator = createSceneGenerator(scene, scenario.bodyCount, scenario.worldWidth, scenario.worldHeight);
+    simulation.addBodies(*generator);
+}
+
+void populateSolarSystem(GravitySimulation& simulation, const Scenario&) {
+    simulation.initialize();
+}
+
+void populateDisc(GravitySimulation& simulation, const Scenario& scenario) {
+    ScenarioRandom random(static_cast<uint32_t>(scenario.bodyCount));
+    simulation.clearBodies();
+    addDisc(simulation, random, scenario.worldWidth * 0.5f, scenario.worldHeight * 0.5f,
+            scenario.worldWidth * 0.3f, scenario.bodyCount - 1, 5000.0f, 5000.0f, 0.0f, 0.0f);
+}
+
+void populateCollision(GravitySimulation& simulation, const Scenario& scenario) {
+    ScenarioRandom random(2026);
+    simulation.clearBodies();
+    const size_t perCluster = scenario.bodyCount / 2;
+    const float x = scenario.worldWidth * 0.5f;
+    const float y = scenario.worldHeight * 0.5f;
+    const float offset = scenario.worldWidth * 0.2f;
+    addDisc(simulation, random, x - offset, y - offset * 0.25f, offset * 0.5f, perCluster - 1,
+            2000.0f, 2000.0f, 15.0f, 0.0f);
+    addDisc(simulation, random, x + offset, y + offset * 0.25f, offset * 0.5f, perCluster - 1,
+            2000.0f, 2000.0f, -15.0f, 0.0f);
+}
+
+void populatePlummer(GravitySimulation& simulation, const Scenario& scenario) {
+    addGeneratedScene(simulation, scenario, "plummer");
+}
+
+void populateGalaxies(GravitySimulation& simulation, const Scenario& scenario) {
+    addGeneratedScene(simulation, scenario, "galaxies");
+}
+
+const Scenario SCENARIOS[] = {
+    {"solar", 800.0f, 600.0f, 25, 2000, 7, populateSolarSystem},
+    {"disc-1k", 4000.0f, 4000.0f, 5, 200, 1000, populateDisc},
+    {"disc-10k", 8000.0f, 8000.0f, 2, 20, 10000, populateDisc},
+    {"disc-100k", 16000.0f, 16000.0f, 1, 3, 100000, populateDisc},
+    {"collision", 4000.0f, 4000.0f, 5, 200, 2000, populateCollision},
+    {"plummer-10k", 4000.0f, 4000.0f, 5, 20, 10000, populatePlummer},
+    {"galaxies-10k", 8000.0f, 8000.0f, 2, 20, 10000, populateGalaxies},
+};
+
+/** Above this body count the O(N^2) energy check is skipped */
+constexpr size_t ENERGY_BODY_LIMIT = 20000;
+
+/**
+ * @struct BenchmarkResult
+ * @brief Measurements of one scenario run
+ */
+struct BenchmarkResult {
+    size_t bodies = 0;
+    size_t threads = 0;
+    int steps = 0;
+    double stepsPerSecond = 0.0;
+    double nsPerInteraction = 0.0;
+    double bodyMsPerStep = 0.0;
+    double gridMsPerStep = 0.0;
+    double energyDrift = NAN;       ///< |E_end - E_start| / |E_start|, NaN when skipped
+};
+
+/**
+ * @brief Creates the force solver selected by --solver and --theta
+ */
+std::unique_ptr<IForceSolver> createSolver(const BenchmarkOptions& options) {
+    if (options.solver == "barnes-hut") {
+        return std::make_unique<BarnesHutSolver>(options.theta);
+    }
+    return std::make_unique<DirectForceSolver>();
+}
+
+/**
+ * @brief Builds a scenario's simulation with the selected options
+ * @param scenario Scenario to populate
+ * @param options Benchmark options
+ * @param solver Force solver to inject
+ * @return Simulation holding the scenario's initial bodies
+ */
+std::unique_ptr<GravitySimulation> createSimulation(const Scenario& scenario, const BenchmarkOptions& options,
+                                                    std::unique_ptr<IForceSolver> solver) {
+    auto simulation = std::make_unique<GravitySimulation>(scenario.worldWidth, scenario.worldHeight,
+                                                          scenario.gridResolution, std::move(solver),
+                                                          options.threads);
+    if (options.particleMeshField) {
+        simulation->getGravityGrid()->setFieldMethod(GravityGrid::FieldMethod::ParticleMesh);
+    }
+    simulation->setPositionPrecision(options.positionPrecision);
+    simulation->setIntegrator(createIntegrator(options.integrator));
+    simulation->setCollisionMode(options.collisions);
+    simulation->setForceLaw(options.forceLaw);
+    scenario.populate(*simulation, scenario);
+    return simulation;
+}
+
+/**
+ * @brief Checks that a run resumed from a checkpoint continues bit for bit
+ * @param scenario Scenario to run
+ * @param options Benchmark options; resumeCheckPath is overwritten and removed
+ * @param steps Steps before the checkpoint and again after it
+ * @return true if the resumed bodies match the uninterrupted run exactly
+ *
+ * One simulation runs steps, is checkpointed and runs steps more; a second
+ * one loads the checkpoint and runs the same steps. Every body array must
+ * be identical, which fails if a checkpoint drops integrator state such as
+ * cached forces or the extra position precision.
+ */
+bool checkResume(const Scenario& scenario, const BenchmarkOptions& options, int steps) {
+    auto original = createSimulation(scenario, options, createSolver(options));
+    for (int i = 0; i < steps; ++i) {
+        original->update(options.timeStep);
+    }
+    if (!Checkpoint::save(*original, options.resumeCheckPath)) return false;
+    for (int i = 0; i < steps; ++i) {
+        original->update(options.timeStep);
+    }
+
+    auto resumed = createSimulation(scenario, options, createSolver(options));
+    bool loaded = Checkpoint::load(*resumed, options.resumeCheckPath);
+    std::remove(options.resumeCheckPath.c_str());
+    if (!loaded) return false;
+    for (int i = 0; i < steps; ++i) {
+        resumed->update(options.timeStep);
+    }
+
+    const BodyStore& expected = *original->getBodyStore();
+    const BodyStore& actual = *resumed->getBodyStore();
+    if (expected.size() != actual.size()) {
+        std::cerr << scenario.name << ": resumed run has " << actual.size() << " bodies, expected "
+                  << expected.size() << "\n";
+        return false;
+    }
+    const std::vector<float> BodyStore::*arrays[] = {&BodyStore::x, &BodyStore::y, &BodyStore::vx, &BodyStore::vy,
+                                                     &BodyStore::mass, &BodyStore::radius};
+    for (auto array : arrays) {
+        const std::vector<float>& a = expected.*array;
+        const std::vector<float>& b = actual.*array;
+        if (!a.empty() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) != 0) {
+            size_t body = std::mismatch(a.begin(), a.end(), b.begin()).first - a.begin();
+            std::cerr << scenario.name << ": resumed run differs from the uninterrupted one at body " << body
+                      << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Builds, warms up and times one scenario
+ */
+BenchmarkResult runScenario(const Scenario& scenario, const BenchmarkOptions& options) {
+    auto counting = std::make_unique<CountingForceSolver>(createSolver(options));
+    CountingForceSolver* counter = counting.get();
+    std::unique_ptr<GravitySimulation> owned = createSimulation(scenario, options, std::move(counting));
+    GravitySimulation& simulation = *owned;
+
+    // The profiler's CPU scopes split each step into body and grid time
+    Profiler profiler;
+    profiler.setEnabled(true);
+    simulation.setProfiler(&profiler);
+
+    // Recording happens inside the body step, so its cost shows up in the body time
+    TrajectoryRecorder recorder;
+    if (!options.recordPath.empty()) {
+        auto world = simulation.getGravityGrid()->getWorldDimensions();
+        if (recorder.start(options.recordPath, TrajectoryRecorder::Settings(),
+                           simulation.getGravitationalConstant(), world.first, world.second)) {
+            simulation.setRecorder(&recorder);
+        }
+    }
+
+    for (int i = 0; i < options.warmupSteps; ++i) {
+        simulation.update(options.timeStep);
+    }
+
+    BenchmarkResult result;
+    result.bodies = simulation.getBodyStore()->size();
+    result.threads = simulation.getThreadCount();
+    result.steps = options.steps > 0 ? options.steps : scenario.defaultSteps;
+    bool checkEnergy = result.bodies <= ENERGY_BODY_LIMIT;
+    double startEnergy = checkEnergy ? simulation.computeTotalEnergy() : 0.0;
+
+    counter->interactions = 0.0;
+    double bodyMs = 0.0, gridMs = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < result.steps; ++i) {
+        profiler.beginFrame();
+        simulation.update(options.timeStep);
+        profiler.endFrame();
+        const Profiler::FrameStats& stats = profiler.getFrame(0);
+        bodyMs += stats.cpuMs[static_cast<size_t>(Profiler::Phase::Bodies)];
+        gridMs += stats.cpuMs[static_cast<size_t>(Profiler::Phase::Grid)];
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.stepsPerSecond = result.steps / seconds;
+    result.bodyMsPerStep = bodyMs / result.steps;
+    result.gridMsPerStep = gridMs / result.steps;
+    if (counter->interactions > 0.0) {
+        result.nsPerInteraction = bodyMs * 1e6 / counter->interactions;
+    }
+    if (checkEnergy && startEnergy != 0.0) {
+        result.energyDrift = std::fabs(simulation.computeTotalEnergy() - startEnergy) / std::fabs(startEnergy);
+    }
+    simulation.setRecorder(nullptr);
+    recorder.stop();
+    if (recorder.getDroppedFrameCount() > 0) {
+        std::cerr << scenario.name << ": recorder dropped " << recorder.getDroppedFrameCount() << " of "
+                  << recorder.getRecordedFrameCount() + recorder.getDroppedFrameCount() << " frames\n";
+    }
+    return result;
+}
+
+void printUsage() {
+    std::cerr << "Usage: benchmark [--scenario=NAME|all] [--steps=N] [--warmup=N] [--dt=S]\n"
+                 "                 [--solver=direct|barnes-hut] [--theta=T] [--integrator=NAME]\n"
+                 "                 [--precision=single|compensated|double]\n"
+                 "                 [--field=direct|pm] [--collisions=none|merge|inelastic]\n"
+                 "                 [--softening=clamped|plummer] [--softening-length=L] [--force-clamp=on|off]\n"
+                 "                 [--threads=N] [--record=FILE] [--check-resume=FILE] [--format=text|csv]\n"
+                 "Scenarios:";
+    for (const Scenario& scenario : SCENARIOS) std::cerr << " " << scenario.name;
+    std::cerr << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!BenchmarkOptions::parse(argc, argv, options) || !createIntegrator(options.integrator) ||
+        (options.solver != "direct" && options.solver != "barnes-hut") ||
+        !(options.forceLaw.softeningLength > 0.0f)) {
+        printUsage();
+        return 2;
+    }
+
+    // Scenario setup talks on std::cout; results go there too, so keep them apart
+    std::vector<const Scenario*> selected;
+    for (const Scenario& scenario : SCENARIOS) {
+        if (options.scenario == "all" || options.scenario == scenario.name) selected.push_back(&scenario);
+    }
+    if (selected.empty()) {
+        std::cerr << "Unknown scenario: " << options.scenario << "\n";
+        printUsage();
+        return 2;
+    }
+    std::cout.setstate(std::ios::failbit);
+
+    std::string field = options.particleMeshField ? "pm" : "direct";
+    if (options.csv) {
+        std::printf("scenario,bodies,steps,solver,integrator,field,collisions,threads,steps_per_sec,ns_per_interaction,"
+                    "body_ms_per_step,grid_ms_per_step,energy_drift\n");
+    } else {
+        std::printf("solver=%s integrator=%s precision=%s field=%s collisions=%s softening=%s:%g clamp=%s dt=%g\n",
+                    options.solver.c_str(), options.integrator.c_str(),
+                    getPositionPrecisionName(options.positionPrecision), field.c_str(), options.collisionName.c_str(),
+                    ForceLaw::getSofteningName(options.forceLaw.softening), options.forceLaw.softeningLength,
+                    options.forceLaw.clampForce ? "on" : "off", options.timeStep);
+        std::printf("%-12s %7s %7s %6s %11s %9s %12s %12s %12s\n", "scenario", "bodies", "threads", "steps", "steps/s",
+                    "ns/inter", "body ms/step", "grid ms/step", "energy drift");
+    }
+
+    bool resumesExactly = true;
+    for (const Scenario* scenario : selected) {
+        BenchmarkResult result = runScenario(*scenario, options);
+        if (options.csv) {
+            std::printf("%s,%zu,%d,%s,%s,%s,%s,%zu,%.3f,%.4f,%.4f,%.4f,%.6e\n", scenario->name, result.bodies,
+                        result.steps, options.solver.c_str(), options.integrator.c_str(), field.c_str(),
+                        options.collisionName.c_str(),
+                        result.threads, result.stepsPerSecond, result.nsPerInteraction, result.bodyMsPerStep,
+                        result.gridMsPerStep, result.energyDrift);
+        } else {
+            char drift[32] = "skipped";
+            if (!std::isnan(result.energyDrift)) std::snprintf(drift, sizeof(drift), "%.3e", result.energyDrift);
+            std::printf("%-12s %7zu %7zu %6d %11.2f %9.3f %12.3f %12.3f %12s\n", scenario->name, result.bodies,
+                        result.threads, result.steps, result.stepsPerSecond, result.nsPerInteraction, result.bodyMsPerStep,
+                        result.gridMsPerStep, drift);
+        }
+        std::fflush(stdout);
+
+        if (!options.resumeCheckPath.empty()) {
+            int steps = std::max(1, std::min(result.steps, 20));
+            bool exact = checkResume(*scenario, options, steps);
+            std::fprintf(stderr, "%s: resume after %d steps %s\n", scenario->name, steps,
+                         exact ? "bit-identical" : "FAILED");
+            resumesExactly = resumesExactly && exact;
+        }
+    }
+    return resumesExactly ? 0 : 1;
+}
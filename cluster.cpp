@@ -0,0 +1,217 @@
+/**
+ * @file cluster.cpp
+ * @brief Headless domain-decomposed run over MPI ranks
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ *
+ * Every rank steps the bodies of its own domain with DistributedSimulation;
+ * rank 0 reports the slowest rank's timings and can write a decimated
+ * trajectory that the viewer plays back with --play. Built without
+ * BLACKHOLE_WITH_MPI it runs as a single rank.
+ */
+
+#include "include/DistributedSimulation.h"
+#include "include/Communicators.h"
+#include "include/BodyGenerators.h"
+#include "include/Integrators.h"
+#include "include/TrajectoryRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Cluster run options parsed from the command line
+ */
+struct ClusterOptions {
+    std::string scene = "plummer";     ///< Generated scene (--scene=plummer|disc|galaxies)
+    size_t sceneBodies = 100000;       ///< Approximate body count (--scene-bodies=N)
+    float worldWidth = 16000.0f;       ///< World size (--world=W)
+    int steps = 20;                    ///< Timed steps (--steps=N)
+    float timeStep = 0.016f;           ///< Simulated seconds per step (--dt=S)
+    float theta = 0.5f;                ///< Barnes-Hut opening angle (--theta=T)
+    std::string integrator = "leapfrog"; ///< Time integrator (--integrator=NAME, not block)
+    PositionPrecision positionPrecision = PositionPrecision::Single; ///< Position accumulation (--precision=single|compensated|double)
+    int rebalanceEvery = 10;           ///< Steps between domain rebalances, 0 = never (--rebalance-every=N)
+    size_t threads = 0;                ///< Worker threads per rank, 0 = hardware concurrency (--threads=N)
+    std::string snapshotPath;          ///< Decimated trajectory written by rank 0 (--snapshot=FILE)
+    int snapshotEvery = 1;             ///< Steps between snapshots (--snapshot-every=N)
+    size_t snapshotDecimation = 16;    ///< Every n-th body by id goes into a snapshot (--snapshot-decimate=N)
+
+    /**
+     * @brief Parses command line arguments
+     * @param argc Argument count
+     * @param argv Argument values
+     * @param options Parsed options
+     * @return false if an argument is not understood
+     */
+    static bool parse(int argc, char** argv, ClusterOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--scene=", 0) == 0) {
+                options.scene = arg.substr(8);
+            } else if (arg.rfind("--scene-bodies=", 0) == 0) {
+                options.sceneBodies = static_cast<size_t>(std::strtoull(arg.c_str() + 15, nullptr, 10));
+            } else if (arg.rfind("--world=", 0) == 0) {
+                options.worldWidth = std::strtof(arg.c_str() + 8, nullptr);
+            } else if (arg.rfind("--steps=", 0) == 0) {
+                options.steps = std::atoi(arg.c_str() + 8);
+            } else if (arg.rfind("--dt=", 0) == 0) {
+                options.timeStep = std::strtof(arg.c_str() + 5, nullptr);
+            } else if (arg.rfind("--theta=", 0) == 0) {
+                options.theta = std::strtof(arg.c_str() + 8, nullptr);
+            } else if (arg.rfind("--integrator=", 0) == 0) {
+                options.integrator = arg.substr(13);
+            } else if (arg.rfind("--precision=", 0) == 0) {
+                if (!parsePositionPrecision(arg.substr(12), options.positionPrecision)) {
+                    std::cerr << "Unknown precision: " << arg.substr(12) << "\n";
+                    return false;
+                }
+            } else if (arg.rfind("--rebalance-every=", 0) == 0) {
+                options.rebalanceEvery = std::atoi(arg.c_str() + 18);
+            } else if (arg.rfind("--threads=", 0) == 0) {
+                options.threads = static_cast<size_t>(std::atoi(arg.c_str() + 10));
+            } else if (arg.rfind("--snapshot=", 0) == 0) {
+                options.snapshotPath = arg.substr(11);
+            } else if (arg.rfind("--snapshot-every=", 0) == 0) {
+                options.snapshotEvery = std::max(1, std::atoi(arg.c_str() + 17));
+            } else if (arg.rfind("--snapshot-decimate=", 0) == 0) {
+                options.snapshotDecimation = std::max<size_t>(1, std::strtoull(arg.c_str() + 20, nullptr, 10));
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @struct Conserved
+ * @brief Totals over all ranks that the exchange must not change
+ */
+struct Conserved {
+    double bodies = 0.0;
+    double mass = 0.0;
+    double momentumX = 0.0;
+    double momentumY = 0.0;
+};
+
+/**
+ * @brief Sums body count, mass and momentum over all ranks (collective)
+ */
+Conserved sumConserved(const BodyStore& bodies, ICommunicator& communicator) {
+    double totals[4] = {static_cast<double>(bodies.size()), 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        totals[1] += bodies.mass[i];
+        totals[2] += static_cast<double>(bodies.mass[i]) * bodies.vx[i];
+        totals[3] += static_cast<double>(bodies.mass[i]) * bodies.vy[i];
+    }
+    communicator.allReduceSum(totals, 4);
+    return {totals[0], totals[1], totals[2], totals[3]};
+}
+
+void printUsage() {
+    std::cerr << "Usage: cluster [--scene=plummer|disc|galaxies] [--scene-bodies=N] [--world=W]\n"
+                 "               [--steps=N] [--dt=S] [--theta=T] [--integrator=euler|leapfrog|verlet|yoshida4]\n"
+                 "               [--precision=single|compensated|double] [--rebalance-every=N] [--threads=N]\n"
+                 "               [--snapshot=FILE] [--snapshot-every=N] [--snapshot-decimate=N]\n"
+                 "Run under mpirun with a build that defines BLACKHOLE_WITH_MPI.\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::unique_ptr<ICommunicator> communicator = createCommunicator(&argc, &argv);
+    const int rank = communicator->getRank();
+    const bool root = rank == 0;
+
+    ClusterOptions options;
+    bool valid = ClusterOptions::parse(argc, argv, options) && options.steps >= 0 &&
+                 options.worldWidth > 0.0f && options.theta >= 0.0f;
+    auto generator = createSceneGenerator(options.scene, options.sceneBodies, options.worldWidth,
+                                          options.worldWidth);
+    DistributedSimulation simulation(*communicator, options.worldWidth, options.worldWidth, options.theta,
+                                     options.threads);
+    valid = valid && generator && simulation.setIntegrator(createIntegrator(options.integrator));
+    if (!valid) {
+        if (root) printUsage();
+        return 2;
+    }
+    simulation.setPositionPrecision(options.positionPrecision);
+    simulation.setRebalanceInterval(options.rebalanceEvery);
+
+    // Scene setup talks on std::cout; results go there too, so keep them apart
+    std::cout.setstate(std::ios::failbit);
+    size_t total = simulation.populate(*generator);
+    Conserved before = sumConserved(simulation.getLocalBodies(), *communicator);
+
+    TrajectoryRecorder recorder;
+    bool snapshots = !options.snapshotPath.empty();
+    if (snapshots && root) {
+        const GravitySimulation& local = simulation.getSimulation();
+        if (!recorder.start(options.snapshotPath, TrajectoryRecorder::Settings(),
+                            local.getGravitationalConstant(), options.worldWidth, options.worldWidth)) {
+            std::cerr << "Could not create " << options.snapshotPath << "\n";
+        }
+    }
+    BodyStore snapshot;
+    auto writeSnapshot = [&](uint64_t step) {
+        simulation.gatherSnapshot(options.snapshotDecimation, snapshot);
+        if (root && recorder.isRecording()) {
+            recorder.record(snapshot, simulation.getSimulation().getSimulationTime(), step);
+        }
+    };
+    if (snapshots) writeSnapshot(0);
+
+    simulation.resetStatistics();
+    for (int i = 0; i < options.steps; ++i) {
+        simulation.step(options.timeStep);
+        if (snapshots && (i + 1) % options.snapshotEvery == 0) writeSnapshot(static_cast<uint64_t>(i + 1));
+    }
+
+    // Slowest rank sets the pace; the sum shows the total exchange volume
+    const DistributedSimulation::Statistics& stats = simulation.getStatistics();
+    const DistributedForceSolver::Statistics& forces = simulation.getForceSolver().getStatistics();
+    double slowest[5] = {stats.stepSeconds, forces.forceSeconds, forces.exchangeSeconds, stats.migrationSeconds,
+                         static_cast<double>(simulation.getLocalBodies().size())};
+    communicator->allReduceMax(slowest, 5);
+    double sums[4] = {static_cast<double>(forces.exportedMasses), static_cast<double>(forces.importedMasses),
+                      static_cast<double>(stats.migratedBodies), static_cast<double>(stats.stateResets)};
+    communicator->allReduceSum(sums, 4);
+    Conserved after = sumConserved(simulation.getLocalBodies(), *communicator);
+
+    if (snapshots && root) recorder.stop();
+    if (!root) return 0;
+
+    const int ranks = communicator->getSize();
+    const double steps = std::max(1, options.steps);
+    const double evaluations = std::max<double>(1.0, static_cast<double>(forces.evaluations));
+    std::printf("communicator=%s ranks=%d scene=%s bodies=%zu integrator=%s precision=%s theta=%g dt=%g "
+                "threads/rank=%zu\n",
+                communicator->getName(), ranks, options.scene.c_str(), total, options.integrator.c_str(),
+                getPositionPrecisionName(options.positionPrecision), options.theta, options.timeStep, simulation.getSimulation().getThreadCount());
+    std::printf("%-22s %12.3f\n", "step ms (max rank)", slowest[0] * 1e3 / steps);
+    std::printf("%-22s %12.3f\n", "force ms (max rank)", slowest[1] * 1e3 / steps);
+    std::printf("%-22s %12.3f\n", "exchange ms (max rank)", slowest[2] * 1e3 / steps);
+    std::printf("%-22s %12.3f\n", "migrate ms (max rank)", slowest[3] * 1e3 / steps);
+    std::printf("%-22s %12.3f\n", "body imbalance", slowest[4] * ranks / std::max(1.0, after.bodies));
+    std::printf("%-22s %12.1f\n", "LET masses/rank/eval", sums[1] / ranks / evaluations);
+    std::printf("%-22s %12.1f\n", "migrated/step", sums[2] / steps);
+    std::printf("%-22s %12.0f\n", "state resets", sums[3] / ranks);
+
+    // Migration must neither lose nor duplicate bodies; the tree approximation only bends momentum slightly
+    double mass = std::fabs(after.mass - before.mass) / std::max(1e-30, std::fabs(before.mass));
+    double momentum = std::hypot(after.momentumX - before.momentumX, after.momentumY - before.momentumY) /
+                      std::max(1e-30, before.mass);
+    std::printf("%-22s %12.0f (start %.0f)\n", "bodies", after.bodies, before.bodies);
+    std::printf("%-22s %12.3e\n", "mass change", mass);
+    std::printf("%-22s %12.3e\n", "momentum change / M", momentum);
+    std::fflush(stdout);
+    return after.bodies == before.bodies ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file BarnesHutSolver.h
+ * @brief Barnes-Hut quadtree force solver
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IForceSolver.h"
+#include "FrameArena.h"
+#include <vector>
+
+/**
+ * @class BarnesHutSolver
+ * @brief Approximate O(N log N) force solver using a quadtree
+ * 
+ * The quadtree is rebuilt every step from the current body positions. Each
+ * node stores the total mass and center of mass of the bodies below it. When
+ * a node is far enough away (node size / distance < theta) its bodies are
+ * treated as a single mass; otherwise the node is opened. theta = 0 gives
+ * the same result as DirectForceSolver, larger values trade accuracy for
+ * speed (0.5 is the usual choice).
+ * 
+ * Nodes and the body ordering are carved from the frame arena (or a private
+ * one when none is set), sized from the previous tree, and discarded at the
+ * end of every computeForces() call.
+ * 
+ * summarize() exports the same tree for bodies held elsewhere (a locally
+ * essential tree): the nodes another process would accept for every point
+ * of a region, plus the bodies of the leaves it would open.
+ */
+class BarnesHutSolver : public IForceSolver {
+public:
+    /**
+     * @struct Region
+     * @brief Axis-aligned rectangle holding the bodies that need forces
+     */
+    struct Region {
+        float minX, minY, maxX, maxY;
+    };
+
+    /**
+     * @struct PointMass
+     * @brief A body or a whole tree node acting as a single mass
+     */
+    struct PointMass {
+        float x, y, mass;
+    };
+
+    /**
+     * @brief Constructs a Barnes-Hut solver
+     * @param theta Opening angle (node size / distance threshold)
+     * @param leafCapacity Maximum number of bodies stored in a leaf node
+     */
+    explicit BarnesHutSolver(float theta = 0.5f, int leafCapacity = 1);
+
+    void computeForces(const BodyStore& bodies,
+                       float gravitationalConstant,
+                       std::vector<Vec2>& forces,
+                       ThreadPool* threadPool) override;
+
+    void computeForcesOn(const BodyStore& bodies,
+                         float gravitationalConstant,
+                         const std::vector<size_t>& targets,
+                         std::vector<Vec2>& forces,
+                         ThreadPool* threadPool) override;
+
+    void setForceLaw(const ForceLaw& law) override { forceLaw = law; }
+    const ForceLaw& getForceLaw() const override { return forceLaw; }
+
+    void setFrameArena(FrameArena* arena) override { frameArena = arena; }
+
+    const char* getName() const override { return "barnes-hut"; }
+
+    /**
+     * @brief Summarizes the bodies as point masses for several remote regions
+     * @param bodies Source bodies
+     * @param regions Rectangles containing the bodies that will feel the sources
+     * @param regionCount Number of regions
+     * @param summaries One list per region, overwritten
+     * @param threadPool Pool to spread the regions over (null runs on the calling thread)
+     * 
+     * A node is exported whole when it does not overlap the region and
+     * passes the opening test at the region's point closest to the node's
+     * center of mass, i.e. when it would pass for every body inside. Forces
+     * computed from a region's summary therefore match a tree walk over the
+     * source bodies to within the usual Barnes-Hut error.
+     */
+    void summarize(const BodyStore& bodies, const Region* regions, size_t regionCount,
+                   std::vector<PointMass>* summaries, ThreadPool* threadPool);
+
+    /**
+     * @brief Sets the opening angle
+     * @param newTheta Node size / distance threshold (>= 0)
+     */
+    void setTheta(float newTheta) { theta = newTheta; }
+
+    /**
+     * @brief Gets the opening angle
+     * @return Current theta value
+     */
+    float getTheta() const { return theta; }
+
+    /**
+     * @brief Gets the number of nodes in the most recently built tree
+     * @return Node count
+     */
+    size_t getNodeCount() const { return lastNodeCount; }
+
+private:
+    /**
+     * @struct Node
+     * @brief Quadtree node covering a square region of the world
+     */
+    struct Node {
+        float centerX, centerY;    ///< Center of the node's square
+        float halfSize;            ///< Half of the square's side length
+        float mass;                ///< Total mass of contained bodies
+        float comX, comY;          ///< Center of mass of contained bodies
+        int firstChild;            ///< Index of the first of 4 children, -1 for leaves
+        int firstBody;             ///< First entry in bodyOrder (leaves only)
+        int bodyCount;             ///< Number of contained bodies
+    };
+
+    float theta;                   ///< Opening angle
+    ForceLaw forceLaw;             ///< Softening and clamp for every interaction
+    int leafCapacity;              ///< Maximum bodies per leaf
+    FrameArena* frameArena = nullptr; ///< Scratch provided by the simulation
+    FrameArena ownArena;           ///< Scratch when no frame arena is set
+    ArenaArray<Node> nodes;        ///< Flat node storage, root at index 0 (valid during a call)
+    ArenaArray<int> bodyOrder;     ///< Body indices grouped by leaf (valid during a call)
+    size_t lastNodeCount = 0;      ///< Size of the most recent tree
+    const BodyStore* store = nullptr; ///< Bodies of the step in progress
+
+    /** Maximum tree depth; coincident bodies end up sharing a leaf */
+    static constexpr int MAX_DEPTH = 32;
+
+    /** Bodies per parallel task; small because walk costs vary a lot between bodies */
+    static constexpr size_t BODIES_PER_TASK = 32;
+
+    /** Traversal stack entries; a walk holds at most 3 pending siblings per level plus 4 children */
+    static constexpr size_t STACK_CAPACITY = 4 * MAX_DEPTH;
+
+    /**
+     * @brief Rebuilds the quadtree from the current store positions and masses
+     * @param arena Arena the tree is allocated from
+     */
+    void buildTree(FrameArena& arena);
+
+    /**
+     * @brief Drops the tree; its memory goes back with the next arena reset
+     */
+    void releaseTree();
+
+    /**
+     * @brief Recursively subdivides a node over a range of bodyOrder
+     * @param nodeIndex Node to subdivide
+     * @param depth Depth of the node in the tree
+     */
+    void subdivide(int nodeIndex, int depth);
+
+    /**
+     * @brief Computes the force on a single body by walking the tree
+     * @tparam Law ForceLawPolicy matching forceLaw
+     * @param bodyIndex Index of the body receiving the force
+     * @param gravitationalConstant G constant for force calculation
+     * @param traversalStack Scratch stack of STACK_CAPACITY entries owned by the calling thread
+     * @return Net force on the body
+     */
+    template <class Law>
+    Vec2 computeForceOn(int bodyIndex, float gravitationalConstant, int* traversalStack) const;
+
+    /**
+     * @brief Collects the point masses a region needs from the current tree
+     * @param region Rectangle containing the remote bodies
+     * @param summary Receives the point masses
+     * @param traversalStack Scratch stack of STACK_CAPACITY entries owned by the calling thread
+     */
+    void summarizeFor(const Region& region, std::vector<PointMass>& summary, int* traversalStack) const;
+};
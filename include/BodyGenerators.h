@@ -0,0 +1,141 @@
+/**
+ * @file BodyGenerators.h
+ * @brief Procedural initial conditions: Plummer spheres, Keplerian discs and galaxy pairs
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IBodyGenerator.h"
+#include "Vec2.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @class PlummerSphereGenerator
+ * @brief Star cluster sampled from the Plummer model and projected onto the plane
+ *
+ * Positions and velocities are drawn in 3D from the Plummer distribution
+ * function (Aarseth, Henon & Wielen 1974) and the z components dropped, so
+ * the cluster is pressure supported with no net rotation. Since the bodies
+ * then lie in one plane the projected cluster is somewhat more bound than
+ * the 3D model and contracts a little before settling.
+ */
+class PlummerSphereGenerator : public IBodyGenerator {
+public:
+    /**
+     * @brief Cluster parameters
+     */
+    struct Settings {
+        Vec2 center;                   ///< Cluster center
+        Vec2 velocity;                 ///< Bulk velocity added to every body
+        size_t count = 1000;           ///< Number of bodies
+        float scaleRadius = 50.0f;     ///< Plummer radius a (half the mass lies within 1.3 a)
+        float maxRadius = 250.0f;      ///< Bodies are only placed within this 3D radius
+        float totalMass = 5000.0f;     ///< Mass shared equally by all bodies
+        float bodyRadius = 1.0f;       ///< Visual radius of every body
+        uint32_t seed = 1;             ///< Random seed
+    };
+
+    explicit PlummerSphereGenerator(const Settings& settings) : settings(settings) {}
+
+    size_t getBodyCount() const override { return settings.count; }
+    void generate(BodyStore& bodies, size_t first, float gravitationalConstant,
+                  ThreadPool* threadPool) const override;
+    const char* getName() const override { return "plummer"; }
+
+private:
+    Settings settings;
+};
+
+/**
+ * @class KeplerianDiscGenerator
+ * @brief Thin disc of bodies on circular orbits around an optional central mass
+ *
+ * Bodies are spread with uniform surface density between the inner and
+ * outer radius. Each orbits at the circular speed of the central mass plus
+ * the disc mass inside its radius, the same enclosed-mass estimate the
+ * benchmark discs use. The central body, if any, takes the first slot.
+ */
+class KeplerianDiscGenerator : public IBodyGenerator {
+public:
+    /**
+     * @brief Disc parameters
+     */
+    struct Settings {
+        Vec2 center;                   ///< Disc center
+        Vec2 velocity;                 ///< Bulk velocity added to every body
+        size_t count = 1000;           ///< Number of disc bodies (excluding the central body)
+        float innerRadius = 20.0f;     ///< Inner edge of the disc
+        float outerRadius = 250.0f;    ///< Outer edge of the disc
+        float discMass = 1000.0f;      ///< Mass shared equally by the disc bodies
+        float centralMass = 5000.0f;   ///< Mass of the central body (0 for none)
+        float bodyRadius = 1.0f;       ///< Visual radius of the disc bodies
+        float centralRadius = 15.0f;   ///< Visual radius of the central body
+        bool clockwise = false;        ///< Orbit direction
+        uint32_t seed = 1;             ///< Random seed
+    };
+
+    explicit KeplerianDiscGenerator(const Settings& settings) : settings(settings) {}
+
+    size_t getBodyCount() const override { return settings.count + (settings.centralMass > 0.0f ? 1 : 0); }
+    void generate(BodyStore& bodies, size_t first, float gravitationalConstant,
+                  ThreadPool* threadPool) const override;
+    const char* getName() const override { return "disc"; }
+
+    /**
+     * @brief Gets the mass of the central body and the disc together
+     * @return Total mass
+     */
+    float getTotalMass() const { return settings.centralMass + settings.discMass; }
+
+private:
+    Settings settings;
+};
+
+/**
+ * @class GalaxyPairGenerator
+ * @brief Two disc galaxies on a bound or parabolic encounter
+ *
+ * The galaxies start the given separation apart along x, offset in y by the
+ * impact parameter, and approach each other along x with the given fraction
+ * of the parabolic (escape) speed for point masses. Positions and
+ * velocities are chosen so the pair's centre of mass rests at the center.
+ * Each galaxy's own center and velocity settings are ignored.
+ */
+class GalaxyPairGenerator : public IBodyGenerator {
+public:
+    /**
+     * @brief Encounter parameters
+     */
+    struct Settings {
+        Vec2 center;                             ///< Center of mass of the pair
+        float separation = 600.0f;               ///< Initial distance along x
+        float impactParameter = 150.0f;          ///< Initial offset along y
+        float approachSpeed = 1.0f;              ///< Relative speed as a fraction of the parabolic speed
+        KeplerianDiscGenerator::Settings primary;    ///< Galaxy starting at lower x
+        KeplerianDiscGenerator::Settings secondary;  ///< Galaxy starting at higher x
+    };
+
+    explicit GalaxyPairGenerator(const Settings& settings) : settings(settings) {}
+
+    size_t getBodyCount() const override;
+    void generate(BodyStore& bodies, size_t first, float gravitationalConstant,
+                  ThreadPool* threadPool) const override;
+    const char* getName() const override { return "galaxies"; }
+
+private:
+    Settings settings;
+};
+
+/**
+ * @brief Creates a generator for a named scene scaled to a world
+ * @param name "plummer", "disc" or "galaxies"
+ * @param bodyCount Approximate number of bodies
+ * @param worldWidth World width; the scene is centered and fits inside
+ * @param worldHeight World height
+ * @return Generator, or nullptr when the name is unknown
+ */
+std::unique_ptr<IBodyGenerator> createSceneGenerator(const std::string& name, size_t bodyCount,
+                                                     float worldWidth, float worldHeight);
@@ -0,0 +1,270 @@
+/**
+ * @file BodyMesh.h
+ * @brief Instanced sphere rendering of gravity bodies with distance-based LOD
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "CameraUniformBuffer.h"
+#include "Mat4.h"
+#include "ShaderProgram.h"
+#include "StreamingBuffer.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BodyMesh
+ * @brief Draws all bodies with a handful of instanced draw calls
+ *
+ * Unit spheres are tessellated once at LOD_LEVEL_COUNT detail levels and
+ * kept on the GPU. Every frame each body is assigned a level from its
+ * projected radius in pixels and one instance record (center, radius,
+ * color) is streamed, grouped by level. Each level is then one instanced
+ * draw for the spheres and one for the glows; bodies smaller than
+ * SPRITE_PIXEL_RADIUS on screen become round point sprites (body and glow
+ * in one point). Frame cost is independent of how the bodies are
+ * distributed: at most 2 * LOD_LEVEL_COUNT + 1 draw calls. Bodies whose
+ * glow lies outside the view frustum get no instance at all.
+ *
+ * Placement, size and color follow GravityRenderer's original body
+ * rendering. Works in 2.1 contexts with ARB_draw_instanced and
+ * ARB_instanced_arrays, and in 3.3 core contexts.
+ *
+ * With OpenGL 4.3 in a core context the bodies can also come straight from
+ * GpuNBodySimulation's body buffer (updateFromBuffer): a compute shader
+ * does the level assignment, appends each instance to its group with an
+ * atomic counter and fills indirect draw commands, so no body data is
+ * read back and the frame is three multi-draw calls.
+ */
+class BodyMesh {
+public:
+    /**
+     * @struct Instance
+     * @brief Per-body render data, streamed every frame as vertex attributes
+     */
+    struct Instance {
+        float x, y, z, radius;      ///< Render-space center and radius
+        float r, g, b, a;           ///< Body color
+    };
+
+    /**
+     * @struct LodLevel
+     * @brief Sphere tessellation used above a projected size
+     */
+    struct LodLevel {
+        int bodySegments;           ///< Segments of the body sphere
+        int glowSegments;           ///< Segments of the glow sphere
+        float minPixelRadius;       ///< Smallest on-screen body radius using this level
+    };
+
+    BodyMesh() = default;
+
+    /**
+     * @brief Releases GPU resources
+     */
+    ~BodyMesh();
+
+    BodyMesh(const BodyMesh&) = delete;
+    BodyMesh& operator=(const BodyMesh&) = delete;
+
+    /**
+     * @brief Checks whether the current context supports instanced drawing
+     * @param profile GLSL dialect the mesh would use
+     * @return true if initialize() can succeed
+     */
+    static bool isSupported(ShaderProgram::Profile profile);
+
+    /**
+     * @brief Compiles the shaders and uploads the sphere meshes
+     * @param profile Legacy (fixed-function matrices) or Core (CameraUniformBuffer)
+     * @return true if the mesh can be used
+     */
+    bool initialize(ShaderProgram::Profile profile);
+
+    /**
+     * @brief Assigns detail levels and streams this frame's instance data
+     * @param bodies Bodies to draw
+     * @param view World-to-eye transform of the camera
+     * @param projection Eye-to-clip transform of the camera, used for culling
+     * @param pixelScale Viewport pixels per world unit at unit depth (see pixelScaleFor)
+     *
+     * Keeps the previous frame's instances when the bodies' version, the
+     * matrices and the pixel scale are all unchanged.
+     */
+    void update(const BodyStore& bodies, const Mat4& view, const Mat4& projection, float pixelScale);
+
+    /**
+     * @brief Assigns detail levels on the GPU from a GpuNBodySimulation body buffer
+     * @param bodyBuffer Buffer of GpuNBodySimulation::Body records
+     * @param bodyCount Number of records
+     * @param view World-to-eye transform of the camera
+     * @param pixelScale Viewport pixels per world unit at unit depth (see pixelScaleFor)
+     *
+     * Only valid when canDrawBodyBuffers() is true.
+     */
+    void updateFromBuffer(GLuint bodyBuffer, GLsizei bodyCount, const Mat4& view, float pixelScale);
+
+    /**
+     * @brief Checks whether updateFromBuffer() can be used
+     * @return true if the binning compute shader was built (core profile, OpenGL 4.3)
+     */
+    bool canDrawBodyBuffers() const {
+        return binningProgram.isValid();
+    }
+
+    /**
+     * @brief Draws all bodies, then their glows, then the point sprites
+     */
+    void draw();
+
+    /**
+     * @brief Deletes all GPU resources (safe to call more than once)
+     */
+    void release();
+
+    /**
+     * @brief Gets the draw calls issued by the last draw()
+     * @return Number of glDraw* calls
+     */
+    int getLastDrawCallCount() const {
+        return lastDrawCalls;
+    }
+
+    /**
+     * @brief Builds the render data of one body
+     * @param bodies Body store
+     * @param index Body index
+     * @return Render-space placement, radius and color
+     */
+    static Instance instanceFor(const BodyStore& bodies, size_t index);
+
+    /**
+     * @brief Computes the pixel scale of a symmetric perspective projection
+     * @param fovyDegrees Vertical field of view
+     * @param viewportHeight Viewport height in pixels
+     * @return Pixels per world unit at unit depth
+     */
+    static float pixelScaleFor(float fovyDegrees, float viewportHeight);
+
+    /**
+     * @brief Picks the detail level for a body
+     * @param instance Body render data
+     * @param view World-to-eye transform
+     * @param pixelScale Pixels per world unit at unit depth
+     * @return Index into LOD_LEVELS, or LOD_LEVEL_COUNT for a point sprite
+     */
+    static int levelFor(const Instance& instance, const Mat4& view, float pixelScale);
+
+    /** Number of sphere detail levels */
+    static constexpr int LOD_LEVEL_COUNT = 3;
+
+    /** On-screen body radius in pixels below which the body is drawn as a point sprite */
+    static constexpr float SPRITE_PIXEL_RADIUS = 4.0f;
+
+    /** Sphere detail levels, finest first; the middle level matches the original spheres */
+    static constexpr LodLevel LOD_LEVELS[LOD_LEVEL_COUNT] = {
+        {24, 16, 48.0f},
+        {12, 8, 12.0f},
+        {6, 6, SPRITE_PIXEL_RADIUS},
+    };
+
+    /** Glow radius relative to the body */
+    static constexpr float GLOW_SCALE = 1.5f;
+
+    /** Height of body centers above the undisplaced grid */
+    static constexpr float BODY_ELEVATION = 50.0f;
+
+private:
+    /**
+     * @struct SphereRange
+     * @brief Location of one sphere mesh inside the shared index buffer
+     */
+    struct SphereRange {
+        GLsizei indexCount = 0;     ///< Triangle indices
+        size_t indexOffset = 0;     ///< Byte offset into indexBuffer
+    };
+
+    /** Instance groups: one per LOD level plus the point sprites */
+    static constexpr int GROUP_COUNT = LOD_LEVEL_COUNT + 1;
+
+    ShaderProgram::Profile profile = ShaderProgram::Profile::Legacy; ///< GLSL dialect in use
+    ShaderProgram sphereProgram;           ///< Instanced sphere shader
+    ShaderProgram spriteProgram;           ///< Point sprite shader
+    StreamingBuffer instanceBuffer;        ///< Per-frame Instance records, grouped by level
+    std::vector<Instance> bodyInstances;   ///< Render data in body order
+    std::vector<Instance> instances;       ///< Render data grouped by level, staged for instanceBuffer
+    std::vector<uint8_t> levels;           ///< Group of each body this frame
+    GLuint vertexArray = 0;                ///< Vertex array object (core profile only)
+    GLuint vertexBuffer = 0;               ///< Unit sphere positions for all meshes
+    GLuint indexBuffer = 0;                ///< Triangle indices for all meshes
+    SphereRange bodySpheres[LOD_LEVEL_COUNT];  ///< Body mesh per level
+    SphereRange glowSpheres[LOD_LEVEL_COUNT];  ///< Glow mesh per level
+    GLintptr instanceOffset = 0;           ///< Offset of this frame's instances
+    size_t groupStart[GROUP_COUNT] = {};   ///< First instance of each group
+    GLsizei groupCount[GROUP_COUNT] = {};  ///< Instances in each group
+    float currentPixelScale = 1.0f;        ///< pixelScale of the last update
+    uint64_t instancedVersion = 0;         ///< BodyStore::version the CPU instances were built from (0 = none)
+    Mat4 instancedView;                    ///< View the CPU instances were binned with
+    Mat4 instancedProjection;              ///< Projection the CPU instances were culled with
+    ShaderProgram binningProgram;          ///< GPU level assignment (OpenGL 4.3 core only)
+    GLuint binnedBuffer = 0;               ///< GROUP_COUNT regions of binnedCapacity instances
+    GLuint commandBuffer = 0;              ///< Indirect commands: bodies, glows, then sprites
+    GLsizei binnedCapacity = 0;            ///< Instances per region of binnedBuffer
+    GLsizei binnedBodyCount = 0;           ///< Bodies binned on the GPU this frame (0 = CPU instances)
+    int lastDrawCalls = 0;                 ///< Draw calls issued by the last draw()
+
+    // Uniform locations
+    GLint sphereRadiusScaleLocation = -1;
+    GLint sphereGlowColorLocation = -1;
+    GLint sphereGlowWeightLocation = -1;
+    GLint spritePixelScaleLocation = -1;
+    GLint spriteRadiusScaleLocation = -1;
+    GLint spriteGlowColorLocation = -1;
+    GLint binningBodyCountLocation = -1;
+    GLint binningCapacityLocation = -1;
+    GLint binningViewLocation = -1;
+    GLint binningPixelScaleLocation = -1;
+
+    /** Attribute locations bound before linking */
+    static constexpr GLuint POSITION_ATTRIBUTE = 0;
+    static constexpr GLuint CENTER_RADIUS_ATTRIBUTE = 1;
+    static constexpr GLuint COLOR_ATTRIBUTE = 2;
+
+    /** Words of a DrawElementsIndirectCommand and of a DrawArraysIndirectCommand */
+    static constexpr int ELEMENTS_COMMAND_WORDS = 5;
+    static constexpr int ARRAYS_COMMAND_WORDS = 4;
+
+    /** Word offset of the sprite command, after the body and glow commands of every level */
+    static constexpr int SPRITE_COMMAND_WORD = 2 * LOD_LEVEL_COUNT * ELEMENTS_COMMAND_WORDS;
+
+    /**
+     * @brief Uploads every LOD level's body and glow sphere into shared buffers
+     */
+    void buildSpheres();
+
+    /**
+     * @brief Builds the level assignment compute shader and its buffers
+     */
+    void buildBinning();
+
+    /**
+     * @brief Points the instance attributes at one group of this frame's data
+     * @param group Group index
+     * @param divisor 1 to advance per instance (spheres), 0 per vertex (sprites)
+     */
+    void bindInstances(int group, GLuint divisor);
+
+    /**
+     * @brief Draws the sphere pass (bodies or glows) for every LOD level
+     * @param glow true for the glow spheres
+     */
+    void drawSpheres(bool glow);
+
+    /**
+     * @brief Draws the point sprite group
+     */
+    void drawSprites();
+};
@@ -0,0 +1,193 @@
+/**
+ * @file BodyStore.h
+ * @brief Structure-of-arrays storage for gravitational bodies
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "Vec2.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @struct BodyDescriptor
+ * @brief Initial state of one body, for adding many at once
+ */
+struct BodyDescriptor {
+    Vec2 position;       ///< Initial position
+    Vec2 velocity;       ///< Initial velocity
+    float mass;          ///< Mass of the body
+    float radius;        ///< Visual radius of the body
+};
+
+/**
+ * @struct BodyStore
+ * @brief Contiguous structure-of-arrays body state shared by physics and rendering
+ * 
+ * Every per-body property lives in its own tightly packed array, so hot loops
+ * (force solvers, grid updates, rendering) stream only the fields they need
+ * instead of chasing pointers into separate heap blocks. Index i refers to the
+ * same body in every array. GravityBody objects act as handles into this store.
+ * 
+ * The version stamp lets readers that hold the store by pointer (renderers,
+ * snapshot publishing) tell whether anything changed since they last looked
+ * without comparing the arrays.
+ */
+struct BodyStore {
+    std::vector<float> x, y;      ///< Positions
+    std::vector<float> vx, vy;    ///< Velocities
+    std::vector<float> mass;      ///< Masses
+    std::vector<float> radius;    ///< Visual radii
+    uint64_t version = 0;         ///< Stamp of the current contents (0 = never stamped), see touch()
+
+    /**
+     * @brief Gets the number of bodies in the store
+     * @return Body count
+     */
+    size_t size() const { return mass.size(); }
+
+    /**
+     * @brief Checks whether the store holds no bodies
+     * @return true if empty
+     */
+    bool empty() const { return mass.empty(); }
+
+    /**
+     * @brief Marks the contents as changed
+     * 
+     * Stamps come from one process-wide counter, so two stores (say, a store
+     * and its copy in a snapshot) carry the same version only if they hold
+     * the same state. The resizing members call it; code that writes the
+     * arrays directly (integrators, set()) must call it once it is done.
+     */
+    void touch() { version = nextVersion(); }
+
+    /**
+     * @brief Draws a fresh version stamp
+     * @return Value never returned before in this process (never 0)
+     */
+    static uint64_t nextVersion() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    /**
+     * @brief Reserves capacity in every array
+     * @param count Number of bodies to reserve space for
+     */
+    void reserve(size_t count) {
+        x.reserve(count); y.reserve(count);
+        vx.reserve(count); vy.reserve(count);
+        mass.reserve(count); radius.reserve(count);
+    }
+
+    /**
+     * @brief Appends a body to the store
+     * @param position Initial position
+     * @param velocity Initial velocity
+     * @param bodyMass Mass of the body
+     * @param bodyRadius Visual radius of the body
+     * @return Index of the new body
+     */
+    size_t add(const Vec2& position, const Vec2& velocity, float bodyMass, float bodyRadius) {
+        x.push_back(position.x); y.push_back(position.y);
+        vx.push_back(velocity.x); vy.push_back(velocity.y);
+        mass.push_back(bodyMass); radius.push_back(bodyRadius);
+        touch();
+        return mass.size() - 1;
+    }
+
+    /**
+     * @brief Appends many bodies with one growth per array
+     * @param bodies First descriptor
+     * @param count Number of descriptors
+     */
+    void append(const BodyDescriptor* bodies, size_t count) {
+        size_t first = size();
+        resize(first + count);
+        for (size_t i = 0; i < count; ++i) {
+            set(first + i, bodies[i]);
+        }
+        touch();
+    }
+
+    /**
+     * @brief Changes the body count; new bodies are zeroed
+     * @param count New body count
+     * 
+     * Lets generators fill a range of slots in parallel with set().
+     */
+    void resize(size_t count) {
+        x.resize(count); y.resize(count);
+        vx.resize(count); vy.resize(count);
+        mass.resize(count); radius.resize(count);
+        touch();
+    }
+
+    /**
+     * @brief Overwrites the state of one body
+     * @param index Body index
+     * @param body New state
+     * 
+     * Does not touch() the store, so parallel writers can share it.
+     */
+    void set(size_t index, const BodyDescriptor& body) {
+        x[index] = body.position.x; y[index] = body.position.y;
+        vx[index] = body.velocity.x; vy[index] = body.velocity.y;
+        mass[index] = body.mass; radius[index] = body.radius;
+    }
+
+    /**
+     * @brief Removes a set of bodies, keeping the others in order
+     * @param indices Indices to remove, ascending and unique
+     * 
+     * Bodies after a removed one move down, so indices held elsewhere must
+     * be remapped the same way.
+     */
+    void erase(const std::vector<size_t>& indices) {
+        if (indices.empty()) return;
+        size_t write = indices.front();
+        size_t next = 0;
+        for (size_t read = indices.front(); read < size(); ++read) {
+            if (next < indices.size() && indices[next] == read) {
+                ++next;
+                continue;
+            }
+            x[write] = x[read]; y[write] = y[read];
+            vx[write] = vx[read]; vy[write] = vy[read];
+            mass[write] = mass[read]; radius[write] = radius[read];
+            ++write;
+        }
+        x.resize(write); y.resize(write);
+        vx.resize(write); vy.resize(write);
+        mass.resize(write); radius.resize(write);
+        touch();
+    }
+
+    /**
+     * @brief Removes all bodies
+     */
+    void clear() {
+        x.clear(); y.clear();
+        vx.clear(); vy.clear();
+        mass.clear(); radius.clear();
+        touch();
+    }
+
+    /**
+     * @brief Gets the position of a body as a vector
+     * @param index Body index
+     * @return Position vector
+     */
+    Vec2 getPosition(size_t index) const { return Vec2(x[index], y[index]); }
+
+    /**
+     * @brief Gets the velocity of a body as a vector
+     * @param index Body index
+     * @return Velocity vector
+     */
+    Vec2 getVelocity(size_t index) const { return Vec2(vx[index], vy[index]); }
+};
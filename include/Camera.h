@@ -6,6 +6,7 @@
  */
 
 #pragma once
+#include "Mat4.h"
 #include <memory>
 
 /**
@@ -24,6 +25,12 @@ public:
      */
     virtual void applyTransform() const = 0;
     
+    /**
+     * @brief Gets the view matrix that applyTransform() multiplies onto the modelview stack
+     * @return World-to-eye transform for shader-based renderers
+     */
+    virtual Mat4 getViewMatrix() const = 0;
+    
     /**
      * @brief Updates camera based on mouse input
      * @param deltaX Mouse movement in X direction
@@ -65,6 +72,7 @@ public:
     FreeFlightCamera(float speed = 10.0f, float sensitivity = 0.5f);
     
     void applyTransform() const override;
+    Mat4 getViewMatrix() const override;
     void updateFromMouse(float deltaX, float deltaY, bool isMousePressed) override;
     void updateFromKeyboard(float forward, float right, float up) override;
     std::shared_ptr<ICamera> clone() const override;
@@ -105,6 +113,7 @@ public:
     GameStyleCamera(float speed = 10.0f, float sensitivity = 0.5f);
     
     void applyTransform() const override;
+    Mat4 getViewMatrix() const override;
     void updateFromMouse(float deltaX, float deltaY, bool isMousePressed) override;
     void updateFromKeyboard(float forward, float right, float up) override;
     std::shared_ptr<ICamera> clone() const override;
@@ -152,6 +161,12 @@ public:
      */
     void applyTransform() const;
     
+    /**
+     * @brief Gets the current camera's view matrix
+     * @return World-to-eye transform
+     */
+    Mat4 getViewMatrix() const;
+    
     /**
      * @brief Updates current camera from mouse input
      */
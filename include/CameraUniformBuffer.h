@@ -0,0 +1,84 @@
+/**
+ * @file CameraUniformBuffer.h
+ * @brief Uniform buffer holding the camera matrices for core-profile shaders
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "Mat4.h"
+#include "ShaderProgram.h"
+#include <GL/glew.h>
+
+/**
+ * @class CameraUniformBuffer
+ * @brief Uploads projection and view matrices once per frame for all programs
+ *
+ * Core-profile shaders have no gl_ModelViewProjectionMatrix. Instead they
+ * declare the CameraMatrices block (GLSL_BLOCK) and bind it to
+ * BINDING_POINT; one glBufferSubData per frame then updates every program
+ * that uses the camera. glslDeclaration() gives shaders the same names
+ * (projection, view, viewProjection) in legacy contexts, where they map to
+ * the fixed-function matrices.
+ */
+class CameraUniformBuffer {
+public:
+    CameraUniformBuffer() = default;
+
+    /**
+     * @brief Releases the GL buffer
+     */
+    ~CameraUniformBuffer();
+
+    CameraUniformBuffer(const CameraUniformBuffer&) = delete;
+    CameraUniformBuffer& operator=(const CameraUniformBuffer&) = delete;
+
+    /**
+     * @brief Creates the buffer and binds it to BINDING_POINT
+     */
+    void initialize();
+
+    /**
+     * @brief Uploads the matrices for this frame
+     * @param projection Eye-to-clip transform
+     * @param view World-to-eye transform
+     */
+    void update(const Mat4& projection, const Mat4& view);
+
+    /**
+     * @brief Deletes the GL buffer (safe to call more than once)
+     */
+    void release();
+
+    /** Uniform buffer binding point shared by all programs using the camera */
+    static constexpr GLuint BINDING_POINT = 0;
+
+    /** Name of the uniform block, for ShaderProgram::bindUniformBlock */
+    static constexpr const char* BLOCK_NAME = "CameraMatrices";
+
+    /** GLSL declaration of the block (std140: three column-major mat4) */
+    static constexpr const char* GLSL_BLOCK =
+        "layout(std140) uniform CameraMatrices {\n"
+        "    mat4 projection;\n"
+        "    mat4 view;\n"
+        "    mat4 viewProjection;\n"
+        "};\n";
+
+    /** Legacy equivalent of GLSL_BLOCK: the same names bound to the fixed-function matrices */
+    static constexpr const char* LEGACY_GLSL_DEFINES =
+        "#define projection gl_ProjectionMatrix\n"
+        "#define view gl_ModelViewMatrix\n"
+        "#define viewProjection gl_ModelViewProjectionMatrix\n";
+
+    /**
+     * @brief Gets the camera matrix declarations for a shader profile
+     * @param profile GLSL dialect
+     * @return GLSL_BLOCK for core shaders, LEGACY_GLSL_DEFINES otherwise
+     */
+    static const char* glslDeclaration(ShaderProgram::Profile profile) {
+        return profile == ShaderProgram::Profile::Core ? GLSL_BLOCK : LEGACY_GLSL_DEFINES;
+    }
+
+private:
+    GLuint buffer = 0;    ///< GL uniform buffer object
+};
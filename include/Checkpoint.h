@@ -0,0 +1,177 @@
+/**
+ * @file Checkpoint.h
+ * @brief Versioned binary simulation checkpoints that load straight from a memory mapping
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "IIntegrator.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+
+class GravitySimulation;
+
+/**
+ * @struct CheckpointHeader
+ * @brief Fixed-size header at the start of every checkpoint file
+ *
+ * The file is a header, a table of sectionCount CheckpointSection entries
+ * and then the section data. Every section is one contiguous array of 4-byte
+ * elements (8-byte for Float64) starting at a multiple of SECTION_ALIGNMENT,
+ * so a mapped file can be used in place: body arrays are copied into a
+ * BodyStore with a single memcpy each and integrator arrays are read where
+ * they lie.
+ *
+ * Values are stored in the writer's native byte order; byteOrder lets a
+ * reader recognise (and reject) files from a machine of the other order.
+ */
+struct CheckpointHeader {
+    char magic[8];                  ///< "BHSCKPT" and a terminating zero
+    uint32_t version;               ///< Format version, CURRENT_VERSION when written
+    uint32_t headerSize;            ///< sizeof(CheckpointHeader)
+    uint32_t byteOrder;             ///< BYTE_ORDER_MARK in the writer's byte order
+    uint32_t sectionCount;          ///< Entries in the section table
+    uint64_t bodyCount;             ///< Bodies in the body sections
+    uint64_t stepCount;             ///< Body steps taken when saved
+    uint64_t fileSize;              ///< Total file size, to detect truncation
+    double simulationTime;          ///< Simulated seconds when saved
+    float gravitationalConstant;    ///< G of the simulation
+    float worldWidth, worldHeight;  ///< World dimensions of the simulation
+    uint32_t reserved0;             ///< Zero
+    char integrator[32];            ///< IIntegrator::getName() of the saved integrator
+    uint8_t reserved[24];           ///< Zero; pads the header to 128 bytes
+
+    static constexpr uint32_t CURRENT_VERSION = 1;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+};
+
+/**
+ * @struct CheckpointSection
+ * @brief Entry of the section table describing one array
+ *
+ * Body arrays are named "body.x", "body.y", "body.vx", "body.vy", "body.mass"
+ * and "body.radius"; integrator state arrays are "integrator." followed by
+ * the IntegratorState array name.
+ */
+struct CheckpointSection {
+    char name[32];                  ///< Zero-terminated section name
+    uint32_t type;                  ///< IntegratorState::ElementType of the elements
+    uint32_t reserved;              ///< Zero
+    uint64_t offset;                ///< Byte offset of the data from the start of the file
+    uint64_t count;                 ///< Number of elements (4 bytes, 8 for Float64)
+};
+
+static_assert(sizeof(CheckpointHeader) == 128, "checkpoint header layout changed");
+static_assert(sizeof(CheckpointSection) == 56, "checkpoint section layout changed");
+
+/**
+ * @class CheckpointFile
+ * @brief A validated, memory-mapped checkpoint
+ *
+ * open() maps the file and checks the header and section table (magic,
+ * version, byte order, bounds and alignment of every section) without
+ * touching the array contents, so opening is O(sections) regardless of the
+ * body count. Pointers returned stay valid while the object is alive.
+ */
+class CheckpointFile {
+public:
+    /**
+     * @brief Maps and validates a checkpoint
+     * @param path Checkpoint file
+     * @return true if the file is a readable checkpoint; errors go to std::cerr
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Gets the header of the open file
+     * @return Header inside the mapping
+     */
+    const CheckpointHeader& getHeader() const { return *header; }
+
+    /**
+     * @brief Finds a section by name and shape
+     * @param name Section name
+     * @param type Required element type
+     * @param count Required element count
+     * @return First element inside the mapping, or null if missing or mismatched
+     */
+    const void* findSection(const char* name, IntegratorState::ElementType type, uint64_t count) const;
+
+    /**
+     * @brief Finds one of the body arrays
+     * @param name Section name such as "body.x"
+     * @return bodyCount floats, or null if missing
+     */
+    const float* getBodyArray(const char* name) const;
+
+    /**
+     * @brief Collects the integrator sections, referencing the mapping
+     * @return State for IIntegrator::restoreState()
+     */
+    IntegratorState getIntegratorState() const;
+
+private:
+    MappedFile file;                            ///< The mapped checkpoint
+    const CheckpointHeader* header = nullptr;   ///< Header inside the mapping
+    const CheckpointSection* sections = nullptr; ///< Section table inside the mapping
+};
+
+/**
+ * @class Checkpoint
+ * @brief Saves and restores complete simulation state
+ *
+ * A checkpoint holds the bodies, G, world size, simulation clock and the
+ * integrator's name and cached state, so a resumed run continues exactly
+ * like the original one would have. Files are written to a temporary name
+ * and renamed over the target, so a crash while saving leaves the previous
+ * checkpoint intact.
+ */
+class Checkpoint {
+public:
+    /**
+     * @brief Simulation settings stored next to the body arrays
+     */
+    struct Info {
+        float gravitationalConstant = 0.0f;  ///< G
+        float worldWidth = 0.0f;             ///< World width
+        float worldHeight = 0.0f;            ///< World height
+        double simulationTime = 0.0;         ///< Simulated seconds
+        uint64_t stepCount = 0;              ///< Body steps taken
+        std::string integrator;              ///< Integrator name
+    };
+
+    /**
+     * @brief Writes a checkpoint from raw state
+     * @param path Destination file
+     * @param bodies Body state
+     * @param info Settings and clock
+     * @param integratorState Integrator arrays to include (may be empty)
+     * @return true on success; errors go to std::cerr
+     */
+    static bool write(const std::string& path, const BodyStore& bodies, const Info& info,
+                      const IntegratorState& integratorState);
+
+    /**
+     * @brief Writes a checkpoint of a simulation
+     * @param simulation Simulation to save
+     * @param path Destination file
+     * @return true on success
+     */
+    static bool save(const GravitySimulation& simulation, const std::string& path);
+
+    /**
+     * @brief Restores a simulation from a checkpoint
+     * @param simulation Simulation to overwrite; its world size must match the file's
+     * @param path Checkpoint file
+     * @return true on success; on failure the simulation is unchanged
+     *
+     * The saved integrator is selected if it differs from the current one.
+     */
+    static bool load(GravitySimulation& simulation, const std::string& path);
+
+    /** Alignment of every section's data, a cache line so arrays can be streamed with SIMD loads */
+    static constexpr uint64_t SECTION_ALIGNMENT = 64;
+};
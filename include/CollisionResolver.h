@@ -0,0 +1,130 @@
+/**
+ * @file CollisionResolver.h
+ * @brief Merges or bounces bodies that touch, using the spatial hash broad phase
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "SpatialHash.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class CollisionResolver
+ * @brief Finds touching bodies each step and applies a collision response
+ *
+ * Two bodies touch when their centers are closer than the sum of their
+ * radii. The broad phase rebuilds a SpatialHash with cells as wide as the
+ * largest body, so the search is linear in the body count instead of all
+ * pairs. Pairs are resolved in ascending index order and re-tested against
+ * the current state first, since an earlier response in the same step may
+ * already have moved or absorbed one of the bodies.
+ *
+ * - Merge: the lighter body is absorbed into the heavier one (the lower
+ *   index on ties). Mass and momentum are conserved, the survivor moves to
+ *   the common center of mass and its radius grows to keep the combined
+ *   area (r = sqrt(r1^2 + r2^2)).
+ * - Inelastic: approaching bodies exchange an impulse along the line of
+ *   centers with the configured restitution and are pushed apart until they
+ *   just touch, split by inverse mass.
+ */
+class CollisionResolver {
+public:
+    /**
+     * @brief Collision response
+     */
+    enum class Mode {
+        None,       ///< Bodies pass through each other (softened gravity only)
+        Merge,      ///< Touching bodies combine into one
+        Inelastic   ///< Touching bodies bounce with energy loss
+    };
+
+    /**
+     * @brief Creates a resolver for a world
+     * @param worldWidth World width in simulation units
+     * @param worldHeight World height in simulation units
+     */
+    CollisionResolver(float worldWidth, float worldHeight);
+
+    /**
+     * @brief Resolves every touching pair once
+     * @param bodies Body state to update
+     * @param removed Output: ascending indices of absorbed bodies, which the
+     *                caller must erase from the store (Merge mode only)
+     * @return Number of collisions handled
+     */
+    size_t resolve(BodyStore& bodies, std::vector<size_t>& removed);
+
+    /**
+     * @brief Sets the collision response
+     * @param newMode Response applied by resolve()
+     */
+    void setMode(Mode newMode) { mode = newMode; }
+
+    /**
+     * @brief Gets the collision response
+     * @return Current mode
+     */
+    Mode getMode() const { return mode; }
+
+    /**
+     * @brief Sets the fraction of approach speed kept after an inelastic bounce
+     * @param value Coefficient of restitution, clamped to [0, 1]
+     */
+    void setRestitution(float value);
+
+    /**
+     * @brief Gets the coefficient of restitution
+     * @return Value in [0, 1]
+     */
+    float getRestitution() const { return restitution; }
+
+    /**
+     * @brief Gets the number of collisions handled by the last resolve()
+     * @return Collision count
+     */
+    size_t getLastCollisionCount() const { return lastCollisionCount; }
+
+    /**
+     * @brief Gets the broad phase as built by the last resolve()
+     * @return Spatial hash over the bodies before the responses were applied
+     */
+    const SpatialHash& getBroadPhase() const { return broadPhase; }
+
+private:
+    Mode mode = Mode::None;                    ///< Collision response
+    float restitution = 0.5f;                  ///< Coefficient of restitution for Inelastic
+    SpatialHash broadPhase;                    ///< Uniform grid over the world
+    std::vector<SpatialHash::BodyPair> pairs;  ///< Touching pairs found this step
+    std::vector<uint8_t> absorbed;             ///< Per body: merged into another this step
+    size_t lastCollisionCount = 0;             ///< Collisions handled by the last resolve()
+
+    /**
+     * @brief Combines one body into another
+     * @param bodies Body state
+     * @param into Surviving body
+     * @param from Absorbed body (left in place for the caller to erase)
+     */
+    static void merge(BodyStore& bodies, size_t into, size_t from);
+
+    /**
+     * @brief Applies the restitution impulse and separation to a touching pair
+     * @param bodies Body state
+     * @param first Lower body index
+     * @param second Higher body index
+     * @return true if the bodies were approaching and got an impulse
+     */
+    bool bounce(BodyStore& bodies, size_t first, size_t second) const;
+
+    /**
+     * @brief Checks whether two bodies currently overlap
+     * @param bodies Body state
+     * @param first First body index
+     * @param second Second body index
+     * @return true if the centers are closer than the sum of the radii
+     */
+    static bool touching(const BodyStore& bodies, size_t first, size_t second);
+};
@@ -0,0 +1,91 @@
+/**
+ * @file Communicators.h
+ * @brief Single-process and MPI implementations of ICommunicator
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "ICommunicator.h"
+#include <memory>
+
+/**
+ * @class SerialCommunicator
+ * @brief The only rank of a one-process run; every collective is a copy
+ */
+class SerialCommunicator : public ICommunicator {
+public:
+    int getRank() const override { return 0; }
+    int getSize() const override { return 1; }
+    void allToAll(const std::vector<unsigned char>& send, const std::vector<size_t>& sendBytes,
+                  std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) override;
+    void allGather(const void* send, size_t bytes,
+                   std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) override;
+    void gather(const void* send, size_t bytes, std::vector<unsigned char>& receive,
+                std::vector<size_t>& receiveBytes, int root) override;
+    void allReduceSum(double* values, size_t count) override { (void)values; (void)count; }
+    void allReduceMax(double* values, size_t count) override { (void)values; (void)count; }
+    const char* getName() const override { return "serial"; }
+};
+
+#ifdef BLACKHOLE_WITH_MPI
+/**
+ * @class MpiCommunicator
+ * @brief Ranks of MPI_COMM_WORLD
+ *
+ * Initializes MPI (requesting MPI_THREAD_FUNNELED, since only the thread
+ * that created the communicator calls MPI while ThreadPool workers compute)
+ * unless the program already did, and finalizes it on destruction if it
+ * initialized it. Only compiled when BLACKHOLE_WITH_MPI is defined (build
+ * with mpicxx -DBLACKHOLE_WITH_MPI).
+ *
+ * MPI counts are int, so a single block of an exchange is limited to 2 GiB;
+ * larger exchanges are reported on std::cerr and abort the run.
+ */
+class MpiCommunicator : public ICommunicator {
+public:
+    /**
+     * @brief Joins the MPI job
+     * @param argc Program argument count, passed on to MPI_Init_thread
+     * @param argv Program arguments, passed on to MPI_Init_thread
+     */
+    MpiCommunicator(int* argc, char*** argv);
+
+    /**
+     * @brief Finalizes MPI if this communicator initialized it
+     */
+    ~MpiCommunicator() override;
+
+    MpiCommunicator(const MpiCommunicator&) = delete;
+    MpiCommunicator& operator=(const MpiCommunicator&) = delete;
+
+    int getRank() const override { return rank; }
+    int getSize() const override { return size; }
+    void allToAll(const std::vector<unsigned char>& send, const std::vector<size_t>& sendBytes,
+                  std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) override;
+    void allGather(const void* send, size_t bytes,
+                   std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) override;
+    void gather(const void* send, size_t bytes, std::vector<unsigned char>& receive,
+                std::vector<size_t>& receiveBytes, int root) override;
+    void allReduceSum(double* values, size_t count) override;
+    void allReduceMax(double* values, size_t count) override;
+    const char* getName() const override { return "mpi"; }
+
+private:
+    int rank = 0;                  ///< This process in MPI_COMM_WORLD
+    int size = 1;                  ///< Processes in MPI_COMM_WORLD
+    bool ownsMpi = false;          ///< MPI_Init_thread was called here
+    std::vector<int> counts;       ///< Scratch per-rank counts
+    std::vector<int> offsets;      ///< Scratch per-rank displacements
+    std::vector<int> peerCounts;   ///< Scratch per-rank counts of the other direction
+    std::vector<int> peerOffsets;  ///< Scratch per-rank displacements of the other direction
+};
+#endif
+
+/**
+ * @brief Creates the communicator for this build
+ * @param argc Program argument count (MPI may consume its own arguments)
+ * @param argv Program arguments
+ * @return MpiCommunicator when built with BLACKHOLE_WITH_MPI, otherwise SerialCommunicator
+ */
+std::unique_ptr<ICommunicator> createCommunicator(int* argc, char*** argv);
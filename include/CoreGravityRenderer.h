@@ -0,0 +1,136 @@
+/**
+ * @file CoreGravityRenderer.h
+ * @brief Gravity visualization for OpenGL 3.3+ core-profile contexts
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IGravityRenderer.h"
+#include "BodyMesh.h"
+#include "CameraUniformBuffer.h"
+#include "Mat4.h"
+#include "Profiler.h"
+#include "SceneSource.h"
+#include "SpacetimeGridMesh.h"
+#include <GL/glew.h>
+#include <memory>
+
+/**
+ * @class CoreGravityRenderer
+ * @brief Shader-only renderer producing the same image as GravityRenderer
+ *
+ * Everything is drawn from GPU buffers: the spacetime grid through
+ * SpacetimeGridMesh and the bodies through instanced BodyMesh draws. With a
+ * GpuNBodySimulation attached, both read the simulation's buffers directly
+ * and the CPU-side grid and body store are not touched. The
+ * camera's projection and view matrices are uploaded once per frame to a
+ * uniform buffer shared by all programs instead of the fixed-function
+ * matrix stack, which core profiles do not have.
+ *
+ * A core context is what unlocks persistent mapping, compute shaders and
+ * timer queries on every driver (macOS only exposes them in core), so this
+ * is the backend new GPU features build on. GravityRenderer remains the
+ * fallback for machines without OpenGL 3.3.
+ */
+class CoreGravityRenderer : public IGravityRenderer {
+public:
+    /**
+     * @brief Constructs a core-profile renderer with specified viewport
+     * @param viewportWidth Width of the rendering viewport
+     * @param viewportHeight Height of the rendering viewport
+     */
+    CoreGravityRenderer(float viewportWidth, float viewportHeight);
+
+    /**
+     * @brief Checks whether the current context can run this renderer
+     * @return true if OpenGL 3.3 is available (call after GLEW is initialized)
+     */
+    static bool isSupported();
+
+    /**
+     * @brief Builds shaders, meshes and the camera uniform buffer
+     */
+    void initialize() override;
+
+    /**
+     * @brief Renders the gravity grid and bodies from the camera's view
+     * @param cameraController Camera system providing the view matrix
+     * @param uiRenderer Ignored; the overlay is drawn by the caller between beginUIMode() and endUIMode()
+     */
+    void render(const CameraController& cameraController, UIRenderer* uiRenderer = nullptr) override;
+
+    /**
+     * @brief Renders with the legacy default camera (800 units back)
+     */
+    void render() override;
+
+    /**
+     * @brief Releases all GPU resources
+     */
+    void cleanup() override;
+
+    void setGravityGrid(std::shared_ptr<GravityGrid> grid) override {
+        sceneSource.setGravityGrid(grid);
+    }
+
+    void setBodyStore(std::shared_ptr<const BodyStore> store) override {
+        sceneSource.setBodyStore(store);
+    }
+
+    void setSnapshotSource(TripleBuffer<SimulationSnapshot>* source) override {
+        sceneSource.setSnapshotSource(source);
+    }
+
+    /**
+     * @brief Draws from a GPU simulation's buffers instead of the grid and store
+     * @param simulation Simulation to draw, or null to go back to the scene source
+     * @return false if the context lacks OpenGL 4.3 (call after initialize())
+     */
+    bool setGpuSimulation(std::shared_ptr<const GpuNBodySimulation> simulation) override;
+
+    void setProfiler(Profiler* profiler) override {
+        this->profiler = profiler;
+    }
+
+    void setMaxForceForVisualization(float maxForce) override {
+        maxForceVisualization = maxForce;
+    }
+
+    void setViewportSize(float width, float height) override;
+
+    /** Vertical field of view in degrees, as in GravityRenderer::setup3DProjection */
+    static constexpr float FIELD_OF_VIEW = 60.0f;
+
+    /** Near clipping distance */
+    static constexpr float Z_NEAR = 1.0f;
+
+    /** Far clipping distance */
+    static constexpr float Z_FAR = 2000.0f;
+
+    /** Camera distance used by the camera-less render() */
+    static constexpr float DEFAULT_CAMERA_DISTANCE = 800.0f;
+
+private:
+    float viewportWidth, viewportHeight;                ///< Viewport dimensions
+    SceneSource sceneSource;                            ///< Grid and bodies to visualize
+    float maxForceVisualization;                        ///< Max force for color scaling
+    bool isInitialized;                                 ///< Initialization state
+    CameraUniformBuffer cameraUniforms;                 ///< Projection/view matrices for all programs
+    std::unique_ptr<SpacetimeGridMesh> gridMesh;        ///< Spacetime grid surface and lines
+    std::unique_ptr<BodyMesh> bodyMesh;                 ///< Instanced body spheres
+    std::shared_ptr<const GpuNBodySimulation> gpuSimulation; ///< Drawn instead of sceneSource when set
+    Profiler* profiler = nullptr;                       ///< Optional phase timing (not owned)
+
+    /**
+     * @brief Clears the frame and draws the scene with a view matrix
+     * @param view World-to-eye transform
+     */
+    void renderFrame(const Mat4& view);
+
+    /**
+     * @brief Gets the perspective projection for the current viewport
+     * @return Projection matrix
+     */
+    Mat4 projectionMatrix() const;
+};
@@ -0,0 +1,42 @@
+/**
+ * @file DirectForceSolver.h
+ * @brief Exact O(N^2) pairwise force solver
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IForceSolver.h"
+
+/**
+ * @class DirectForceSolver
+ * @brief Sums the force from every other body on each body
+ * 
+ * Exact reference solver. Cost grows as O(N^2), which is fine for small
+ * scenes such as the default solar system. The pair loop runs through the
+ * SIMD ForceKernels.
+ */
+class DirectForceSolver : public IForceSolver {
+public:
+    void computeForces(const BodyStore& bodies,
+                       float gravitationalConstant,
+                       std::vector<Vec2>& forces,
+                       ThreadPool* threadPool) override;
+
+    void computeForcesOn(const BodyStore& bodies,
+                         float gravitationalConstant,
+                         const std::vector<size_t>& targets,
+                         std::vector<Vec2>& forces,
+                         ThreadPool* threadPool) override;
+
+    void setForceLaw(const ForceLaw& law) override { forceLaw = law; }
+    const ForceLaw& getForceLaw() const override { return forceLaw; }
+
+    const char* getName() const override { return "direct"; }
+
+private:
+    ForceLaw forceLaw;             ///< Softening and clamp passed to the kernels
+
+    /** Targets per parallel task; a multiple of the widest SIMD width */
+    static constexpr size_t TARGETS_PER_TASK = 64;
+};
@@ -0,0 +1,107 @@
+/**
+ * @file DistributedForceSolver.h
+ * @brief Barnes-Hut forces over bodies spread across ranks
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IForceSolver.h"
+#include "BarnesHutSolver.h"
+#include "ICommunicator.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class DistributedForceSolver
+ * @brief Computes forces on this rank's bodies from the bodies of every rank
+ *
+ * Each evaluation the ranks share the bounding rectangles of their bodies.
+ * Every rank then summarizes its own bodies for each other rank's rectangle
+ * (BarnesHutSolver::summarize, the locally essential tree) and the
+ * summaries are exchanged in one all-to-all. Distant ranks contribute a
+ * handful of point masses, neighbours the bodies near the shared border.
+ * The local bodies and the imported point masses are then walked with an
+ * ordinary Barnes-Hut tree, with only the local bodies as targets.
+ *
+ * Every call is collective: all ranks must evaluate forces the same number
+ * of times per step, which holds for the fixed-sequence integrators but not
+ * for BlockTimestepIntegrator. With a single rank it is exactly
+ * BarnesHutSolver.
+ */
+class DistributedForceSolver : public IForceSolver {
+public:
+    /**
+     * @struct Statistics
+     * @brief Work and traffic since the last resetStatistics()
+     */
+    struct Statistics {
+        size_t evaluations = 0;        ///< Force evaluations
+        size_t exportedMasses = 0;     ///< Point masses sent to other ranks
+        size_t importedMasses = 0;     ///< Point masses received from other ranks
+        double forceSeconds = 0.0;     ///< Wall time in computeForces(), exchange included
+        double exchangeSeconds = 0.0;  ///< Wall time summarizing and exchanging
+    };
+
+    /**
+     * @brief Constructs a distributed solver
+     * @param communicator Ranks sharing the bodies; must outlive the solver
+     * @param theta Opening angle for both the exported summaries and the local walk
+     */
+    explicit DistributedForceSolver(ICommunicator& communicator, float theta = 0.5f);
+
+    void computeForces(const BodyStore& bodies,
+                       float gravitationalConstant,
+                       std::vector<Vec2>& forces,
+                       ThreadPool* threadPool) override;
+
+    void computeForcesOn(const BodyStore& bodies,
+                         float gravitationalConstant,
+                         const std::vector<size_t>& targets,
+                         std::vector<Vec2>& forces,
+                         ThreadPool* threadPool) override;
+
+    void setForceLaw(const ForceLaw& law) override { localSolver.setForceLaw(law); }
+    const ForceLaw& getForceLaw() const override { return localSolver.getForceLaw(); }
+
+    void setFrameArena(FrameArena* arena) override { localSolver.setFrameArena(arena); }
+
+    const char* getName() const override { return "distributed-barnes-hut"; }
+
+    /**
+     * @brief Gets the opening angle
+     * @return Current theta value
+     */
+    float getTheta() const { return localSolver.getTheta(); }
+
+    /**
+     * @brief Gets the counters of this rank
+     * @return Statistics since the last reset
+     */
+    const Statistics& getStatistics() const { return statistics; }
+
+    /**
+     * @brief Zeroes the counters
+     */
+    void resetStatistics() { statistics = Statistics(); }
+
+private:
+    ICommunicator& communicator;                               ///< Ranks sharing the bodies
+    BarnesHutSolver localSolver;                               ///< Summaries and the final walk
+    Statistics statistics;                                     ///< Counters since the last reset
+    BodyStore sources;                                         ///< Local bodies followed by imported point masses
+    std::vector<Vec2> sourceForces;                            ///< Forces indexed like sources
+    std::vector<size_t> localTargets;                          ///< Source indices that need forces
+    std::vector<BarnesHutSolver::Region> regions;              ///< Bounding rectangles of the ranks exported to
+    std::vector<int> exportRanks;                              ///< Rank of each entry of regions
+    std::vector<std::vector<BarnesHutSolver::PointMass>> summaries; ///< Export per entry of regions
+    std::vector<unsigned char> sendBuffer, receiveBuffer;      ///< Exchange scratch
+    std::vector<size_t> sendBytes, receiveBytes;               ///< Exchange block sizes
+
+    /**
+     * @brief Exchanges summaries and fills sources (collective)
+     * @param bodies This rank's bodies
+     * @param threadPool Pool for the summaries
+     */
+    void gatherSources(const BodyStore& bodies, ThreadPool* threadPool);
+};
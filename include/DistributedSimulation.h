@@ -0,0 +1,213 @@
+/**
+ * @file DistributedSimulation.h
+ * @brief One rank of a simulation whose bodies are split across processes
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "GravitySimulation.h"
+#include "DistributedForceSolver.h"
+#include "DomainDecomposition.h"
+#include "ICommunicator.h"
+#include "IBodyGenerator.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class DistributedSimulation
+ * @brief Runs a GravitySimulation over the bodies inside this rank's domain
+ *
+ * The world is split by DomainDecomposition and every rank steps only the
+ * bodies of its own rectangle; forces from everyone else's bodies arrive
+ * through DistributedForceSolver. After each step bodies that left the
+ * domain move to their new owner together with their share of the
+ * integrator's cached state (e.g. leapfrog forces), so the integrator keeps
+ * evaluating forces the same number of times on every rank. Every
+ * rebalanceInterval steps the domains are recomputed from the measured force
+ * time, so ranks with expensive (dense) regions shrink.
+ *
+ * Every body keeps the index it had in the generated scene as a global id,
+ * which orders gathered snapshots independently of the decomposition.
+ *
+ * Restrictions: collisions are off (merging needs bodies on both sides of a
+ * border), the grid field is not maintained, and BlockTimestepIntegrator is
+ * rejected because its evaluation count differs between ranks. Every method
+ * marked collective must be called by all ranks in the same order.
+ */
+class DistributedSimulation {
+public:
+    /**
+     * @struct Statistics
+     * @brief Work of this rank since the last resetStatistics()
+     */
+    struct Statistics {
+        size_t steps = 0;               ///< Steps taken
+        size_t migratedBodies = 0;      ///< Bodies sent to other ranks
+        size_t rebalances = 0;          ///< Domain recomputations
+        size_t stateResets = 0;         ///< Migrations whose integrator state could not be carried over
+        double stepSeconds = 0.0;       ///< Wall time in step(), migration included
+        double migrationSeconds = 0.0;  ///< Wall time rebalancing and migrating
+    };
+
+    /**
+     * @brief Constructs this rank's part of the simulation
+     * @param communicator Ranks sharing the simulation; must outlive it
+     * @param worldWidth Width of the world
+     * @param worldHeight Height of the world
+     * @param theta Barnes-Hut opening angle
+     * @param threadCount Threads per rank (0 = hardware concurrency)
+     */
+    DistributedSimulation(ICommunicator& communicator, float worldWidth, float worldHeight,
+                          float theta = 0.5f, size_t threadCount = 0);
+
+    /**
+     * @brief Selects the time integrator
+     * @param integrator New integrator; null or block timestep is rejected
+     * @return false (and the integrator is unchanged) if it cannot run distributed
+     */
+    bool setIntegrator(std::unique_ptr<IIntegrator> integrator);
+
+    /**
+     * @brief Selects the softening and clamp used for body-body forces
+     * @param law Force law
+     * @return false if the law is invalid
+     */
+    bool setForceLaw(const ForceLaw& law) {
+        return simulation.setForceLaw(law);
+    }
+
+    /**
+     * @brief Selects the precision positions are accumulated in
+     * @param precision Position precision; the accumulated bits migrate with their bodies
+     * @return false if the integrator only supports single precision
+     */
+    bool setPositionPrecision(PositionPrecision precision) {
+        return simulation.setPositionPrecision(precision);
+    }
+
+    /**
+     * @brief Sets how often the domains are recomputed
+     * @param steps Steps between rebalances (0 keeps the initial domains)
+     */
+    void setRebalanceInterval(int steps) {
+        rebalanceInterval = steps;
+    }
+
+    /**
+     * @brief Replaces the bodies with a generated scene (collective)
+     * @param generator Scene; every rank must pass an identical one
+     * @return Number of bodies over all ranks
+     *
+     * Every rank generates the whole scene and keeps the bodies of its domain,
+     * so setup needs memory for the full scene once per rank.
+     */
+    size_t populate(const IBodyGenerator& generator);
+
+    /**
+     * @brief Advances all bodies by one time step (collective)
+     * @param deltaTime Time step
+     */
+    void step(float deltaTime);
+
+    /**
+     * @brief Recomputes the domains from the force time since the last rebalance (collective)
+     */
+    void rebalance();
+
+    /**
+     * @brief Sends every body outside this rank's domain to its owner (collective)
+     */
+    void migrate();
+
+    /**
+     * @brief Collects every decimation-th body (by global id) on one rank (collective)
+     * @param decimation Keep bodies whose id is a multiple of this (1 = all)
+     * @param snapshot Receives the bodies ordered by id on the root; untouched elsewhere
+     * @param root Rank that receives the snapshot
+     */
+    void gatherSnapshot(size_t decimation, BodyStore& snapshot, int root = 0);
+
+    /**
+     * @brief Gets this rank's bodies
+     * @return Body store of the local simulation
+     */
+    const BodyStore& getLocalBodies() const {
+        return *simulation.getBodyStore();
+    }
+
+    /**
+     * @brief Gets the global ids of the local bodies
+     * @return One id per local body, indexed like getLocalBodies()
+     */
+    const std::vector<uint64_t>& getGlobalIds() const {
+        return ids;
+    }
+
+    /**
+     * @brief Gets the local simulation
+     * @return Simulation stepping this rank's bodies
+     */
+    const GravitySimulation& getSimulation() const {
+        return simulation;
+    }
+
+    /**
+     * @brief Gets the force solver of this rank
+     * @return Solver with exchange statistics
+     */
+    DistributedForceSolver& getForceSolver() {
+        return *forceSolver;
+    }
+
+    /**
+     * @brief Gets the current domains
+     * @return Decomposition shared by all ranks
+     */
+    const DomainDecomposition& getDecomposition() const {
+        return decomposition;
+    }
+
+    /**
+     * @brief Gets the counters of this rank
+     * @return Statistics since the last reset
+     */
+    const Statistics& getStatistics() const {
+        return statistics;
+    }
+
+    /**
+     * @brief Zeroes the counters of the simulation and its force solver
+     */
+    void resetStatistics();
+
+private:
+    /**
+     * @struct BodyRecord
+     * @brief A body as exchanged between ranks
+     */
+    struct BodyRecord {
+        float x, y, vx, vy, mass, radius;
+        uint64_t id;
+    };
+
+    ICommunicator& communicator;           ///< Ranks sharing the simulation
+    DistributedForceSolver* forceSolver;   ///< Owned by simulation
+    GravitySimulation simulation;          ///< Steps the local bodies
+    DomainDecomposition decomposition;     ///< Domain of every rank
+    std::vector<uint64_t> ids;             ///< Global id of every local body
+    int rebalanceInterval = 10;            ///< Steps between rebalances (0 = never)
+    double costAtRebalance = 0.0;          ///< Local tree walk seconds at the last rebalance
+    Statistics statistics;                 ///< Counters since the last reset
+    std::vector<unsigned char> sendBuffer, receiveBuffer; ///< Exchange scratch
+    std::vector<size_t> sendBytes, receiveBytes;          ///< Exchange block sizes
+
+    /**
+     * @brief Builds a body store from records
+     * @param records First record
+     * @param count Number of records
+     * @param store Receives the bodies, appended
+     */
+    static void appendRecords(const BodyRecord* records, size_t count, BodyStore& store);
+};
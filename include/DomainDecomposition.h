@@ -0,0 +1,144 @@
+/**
+ * @file DomainDecomposition.h
+ * @brief Orthogonal recursive bisection of the world between ranks
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "ICommunicator.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct DomainBox
+ * @brief Axis-aligned rectangle of the world owned by one rank
+ */
+struct DomainBox {
+    float minX, minY, maxX, maxY;   ///< Bounds; the upper edges belong to the neighbour
+};
+
+/**
+ * @class DomainDecomposition
+ * @brief Splits the world into one rectangle per rank with equal estimated work
+ *
+ * The world is cut in two across its longer side, the ranks are split in
+ * proportion, and each half is cut again until every rank has a rectangle
+ * (orthogonal recursive bisection, so any rank count works). Each cut is
+ * placed at the weighted quantile of a sample of body positions; weights
+ * come from each rank's measured cost, so ranks that were slow last time
+ * receive smaller domains. Every rank evaluates the same cuts from the same
+ * gathered samples, so all ranks agree on the domains without a root.
+ */
+class DomainDecomposition {
+public:
+    /**
+     * @brief Creates a decomposition into equal slices of the world
+     * @param worldWidth Width of the world
+     * @param worldHeight Height of the world
+     * @param rankCount Number of domains
+     */
+    DomainDecomposition(float worldWidth, float worldHeight, int rankCount);
+
+    /**
+     * @brief Recomputes the domains from the bodies every rank holds (collective)
+     * @param bodies This rank's bodies
+     * @param cost This rank's work since the last rebalance (e.g. force seconds; <= 0 counts bodies)
+     * @param communicator Ranks to balance over
+     */
+    void rebalance(const BodyStore& bodies, double cost, ICommunicator& communicator);
+
+    /**
+     * @brief Recomputes the domains from a range of a store that every rank holds in full (collective)
+     * @param bodies Complete body set, identical on every rank
+     * @param first First body this rank samples
+     * @param count Bodies this rank samples
+     * @param communicator Ranks to balance over
+     *
+     * Used for the initial decomposition, before bodies are distributed.
+     */
+    void rebalance(const BodyStore& bodies, size_t first, size_t count, ICommunicator& communicator);
+
+    /**
+     * @brief Finds the rank whose domain contains a point
+     * @param x Position; points outside the world go to the nearest domain
+     * @param y Position
+     * @return Owning rank
+     */
+    int ownerOf(float x, float y) const;
+
+    /**
+     * @brief Gets the rectangle of a rank
+     * @param rank Rank
+     * @return Domain bounds
+     */
+    const DomainBox& getDomain(int rank) const {
+        return domains[rank];
+    }
+
+    /**
+     * @brief Gets the number of domains
+     * @return Rank count
+     */
+    int getRankCount() const {
+        return static_cast<int>(domains.size());
+    }
+
+    /** Positions each rank contributes to placing the cuts */
+    static constexpr size_t SAMPLES_PER_RANK = 2048;
+
+private:
+    /**
+     * @struct Sample
+     * @brief Position standing in for weight bodies' worth of work
+     */
+    struct Sample {
+        float x, y, weight;
+    };
+
+    /**
+     * @struct Cut
+     * @brief Inner node of the bisection tree
+     */
+    struct Cut {
+        int axis;               ///< 0 = x, 1 = y; -1 for a leaf
+        float position;         ///< Points below go to the low side
+        int low, high;          ///< Child cuts
+        int rank;               ///< Owner (leaves only)
+    };
+
+    float worldWidth, worldHeight;     ///< World bounds
+    std::vector<DomainBox> domains;    ///< Rectangle per rank
+    std::vector<Cut> cuts;             ///< Bisection tree, root at 0
+    std::vector<Sample> samples;       ///< Gathered samples (scratch)
+
+    /**
+     * @brief Gathers samples from every rank and rebuilds the cuts
+     * @param local This rank's samples
+     * @param communicator Ranks to gather from
+     */
+    void build(const std::vector<Sample>& local, ICommunicator& communicator);
+
+    /**
+     * @brief Recursively cuts a box between a range of ranks
+     * @param box Region to cut
+     * @param firstRank First rank of the range
+     * @param rankCount Ranks in the range
+     * @param begin First sample inside the box
+     * @param end One past the last sample inside the box
+     * @return Index of the created cut
+     */
+    int split(const DomainBox& box, int firstRank, int rankCount, size_t begin, size_t end);
+
+    /**
+     * @brief Picks evenly spaced bodies of a range with weights summing to a cost
+     * @param bodies Bodies to sample
+     * @param first First body
+     * @param count Bodies in the range
+     * @param cost Total weight to spread over the samples
+     * @param out Receives the samples
+     */
+    static void sampleRange(const BodyStore& bodies, size_t first, size_t count, double cost,
+                            std::vector<Sample>& out);
+};
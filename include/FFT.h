@@ -0,0 +1,56 @@
+/**
+ * @file FFT.h
+ * @brief Radix-2 complex fast Fourier transform
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class FFT
+ * @brief In-place iterative Cooley-Tukey FFT for a fixed power-of-two size
+ *
+ * The bit-reversal permutation and twiddle factors are computed once per
+ * size, so repeated transforms (one per frame for the particle-mesh field)
+ * only do the butterflies. Transforms are unnormalised: a forward transform
+ * followed by an inverse one scales the data by the size.
+ */
+class FFT {
+public:
+    using Complex = std::complex<float>;
+
+    /**
+     * @brief Prepares transforms of a given length
+     * @param size Transform length; must be a power of two
+     */
+    explicit FFT(size_t size);
+
+    /**
+     * @brief Transforms size contiguous values in place
+     * @param data Values to transform
+     * @param inverse true for the inverse transform (positive exponent)
+     */
+    void transform(Complex* data, bool inverse) const;
+
+    /**
+     * @brief Gets the transform length
+     * @return Number of values per transform
+     */
+    size_t getSize() const { return size; }
+
+    /**
+     * @brief Rounds up to the next power of two
+     * @param value Minimum size
+     * @return Smallest power of two >= value (1 for 0)
+     */
+    static size_t nextPowerOfTwo(size_t value);
+
+private:
+    size_t size;                         ///< Transform length
+    std::vector<size_t> bitReversed;     ///< Bit-reversed index of every position
+    std::vector<Complex> twiddles;       ///< exp(-2*pi*i*k/size) for k < size/2
+};
@@ -0,0 +1,114 @@
+/**
+ * @file ForceKernels.h
+ * @brief Vectorized gravity kernels with runtime instruction set dispatch
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "ForceLaw.h"
+#include "Vec2.h"
+#include <cstddef>
+
+/**
+ * @class ForceKernels
+ * @brief SIMD implementations of the body-body and field force sums
+ * 
+ * Each kernel evaluates 8 (AVX2) or 4 (SSE/NEON) targets at once against a
+ * broadcast source body, using a reciprocal square root refined by one Newton
+ * step instead of sqrt + divide. Kernels are instantiated for every
+ * ForceLawPolicy and for unit-mass versus massive targets; the law passed to
+ * a call picks one instantiation up front, so softening and clamping are
+ * masked selects with no branches in the inner loop, and results match
+ * ForceLawPolicy::force to within float rounding.
+ * 
+ * The best instruction set supported by the running CPU is chosen the first
+ * time a kernel is called, so one binary runs on every machine.
+ */
+class ForceKernels {
+public:
+    /**
+     * @enum InstructionSet
+     * @brief Kernel implementations that can be dispatched to
+     */
+    enum class InstructionSet {
+        Scalar,  ///< Portable C++ fallback
+        SSE,     ///< 4-wide x86 SSE
+        AVX2,    ///< 8-wide x86 AVX2 + FMA
+        NEON     ///< 4-wide ARM NEON
+    };
+
+    /**
+     * @brief Computes body-body forces on a contiguous range of bodies
+     * @param bodies Body store providing targets and sources
+     * @param begin First target index
+     * @param end One past the last target index
+     * @param gravitationalConstant G constant for force calculations
+     * @param forces Output array indexed by body index; forces[begin..end) are overwritten
+     * @param law Softening and clamp to apply
+     * 
+     * Every body in the store acts as a source. Self-interaction contributes
+     * nothing because a zero separation has no direction.
+     */
+    static void computePairForces(const BodyStore& bodies, size_t begin, size_t end,
+                                  float gravitationalConstant, Vec2* forces,
+                                  const ForceLaw& law = ForceLaw::pair());
+
+    /**
+     * @brief Computes body-body forces on an arbitrary set of bodies
+     * @param bodies Body store providing targets and sources
+     * @param targets Indices of the target bodies
+     * @param targetCount Number of entries in targets
+     * @param gravitationalConstant G constant for force calculations
+     * @param forces Output array indexed by body index; only forces[targets[k]] are overwritten
+     * @param law Softening and clamp to apply
+     * 
+     * Targets are gathered into contiguous scratch arrays so the SIMD kernels
+     * still process them several at a time.
+     */
+    static void computePairForcesOn(const BodyStore& bodies, const size_t* targets, size_t targetCount,
+                                    float gravitationalConstant, Vec2* forces,
+                                  const ForceLaw& law = ForceLaw::pair());
+
+    /**
+     * @brief Computes the field force on unit masses at a set of points
+     * @param pointX X coordinates of the evaluation points
+     * @param pointY Y coordinates of the evaluation points
+     * @param pointCount Number of evaluation points
+     * @param bodies Body store providing the attracting masses
+     * @param gravitationalConstant G constant for force calculations
+     * @param forces Output array of pointCount force vectors (overwritten)
+     * @param law Softening and clamp to apply
+     */
+    static void computeFieldForces(const float* pointX, const float* pointY, size_t pointCount,
+                                   const BodyStore& bodies, float gravitationalConstant,
+                                   Vec2* forces, const ForceLaw& law = ForceLaw::field());
+
+    /**
+     * @brief Gets the instruction set kernels are currently dispatched to
+     * @return Active instruction set
+     */
+    static InstructionSet getInstructionSet();
+
+    /**
+     * @brief Forces a specific instruction set (e.g. for benchmarking)
+     * @param instructionSet Requested instruction set
+     * @return true if the CPU supports it and it is now active
+     */
+    static bool setInstructionSet(InstructionSet instructionSet);
+
+    /**
+     * @brief Checks whether the running CPU supports an instruction set
+     * @param instructionSet Instruction set to query
+     * @return true if kernels for it can run here
+     */
+    static bool isSupported(InstructionSet instructionSet);
+
+    /**
+     * @brief Gets a printable name for an instruction set
+     * @param instructionSet Instruction set to name
+     * @return Name such as "avx2"
+     */
+    static const char* getInstructionSetName(InstructionSet instructionSet);
+};
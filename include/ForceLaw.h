@@ -0,0 +1,143 @@
+/**
+ * @file ForceLaw.h
+ * @brief Softening and clamp policies for the gravity force law
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "GravityBody.h"
+#include "Vec2.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @enum Softening
+ * @brief How the force law avoids the singularity at zero separation
+ */
+enum class Softening {
+    Clamped,  ///< r^2 is raised to at least epsilon^2: F = G m1 m2 / max(r^2, epsilon^2)
+    Plummer   ///< r^2 is replaced by r^2 + epsilon^2: F = G m1 m2 r / (r^2 + epsilon^2)^(3/2)
+};
+
+/**
+ * @struct ForceLaw
+ * @brief Runtime description of the force law, chosen once at setup
+ *
+ * Kernels never branch on these fields per interaction: the softening and
+ * clamp switches select a ForceLawPolicy specialization (see
+ * visitForceLaw()) and only the two numbers reach the inner loop.
+ */
+struct ForceLaw {
+    Softening softening = Softening::Clamped;                  ///< Singularity treatment
+    float softeningLength = GravityBody::PAIR_MIN_DISTANCE;    ///< Epsilon, in world units (> 0)
+    bool clampForce = true;                                    ///< Limit the force magnitude
+    float maxForce = GravityBody::PAIR_MAX_FORCE;              ///< Force magnitude limit
+
+    /**
+     * @brief Gets the default body-body law
+     * @return Clamped softening at PAIR_MIN_DISTANCE, clamped at PAIR_MAX_FORCE
+     */
+    static ForceLaw pair() { return ForceLaw(); }
+
+    /**
+     * @brief Gets the default law for unit masses in the field grid
+     * @return Clamped softening at FIELD_MIN_DISTANCE, clamped at FIELD_MAX_FORCE
+     */
+    static ForceLaw field() {
+        ForceLaw law;
+        law.softeningLength = GravityBody::FIELD_MIN_DISTANCE;
+        law.maxForce = GravityBody::FIELD_MAX_FORCE;
+        return law;
+    }
+
+    /**
+     * @brief Gets a printable name for a softening type
+     * @param softening Softening to name
+     * @return "clamped" or "plummer"
+     */
+    static const char* getSofteningName(Softening softening) {
+        return softening == Softening::Plummer ? "plummer" : "clamped";
+    }
+};
+
+/**
+ * @struct ForceLawPolicy
+ * @brief Compile-time force law for one softening / clamp combination
+ * @tparam S Softening type
+ * @tparam ClampForce Whether the force magnitude is limited
+ *
+ * Scalar code (the Barnes-Hut walk, kernel tails) calls force() directly;
+ * the SIMD kernels mirror it with `if constexpr` on SOFTENING and CLAMP so
+ * every combination compiles to its own branch-free loop.
+ */
+template <Softening S, bool ClampForce>
+struct ForceLawPolicy {
+    static constexpr Softening SOFTENING = S;
+    static constexpr bool CLAMP = ClampForce;
+
+    /**
+     * @brief Computes the force a source exerts on a target
+     * @param direction Source position minus target position
+     * @param gmm G times both masses
+     * @param softeningSquared Epsilon squared
+     * @param maxForce Force magnitude limit (ignored unless CLAMP)
+     * @return Force on the target; zero for zero separation
+     */
+    static Vec2 force(const Vec2& direction, float gmm, float softeningSquared, float maxForce) {
+        float distanceSquared = direction.magnitudeSquared();
+        if constexpr (S == Softening::Clamped) {
+            float forceMagnitude = gmm / std::max(distanceSquared, softeningSquared);
+            if constexpr (ClampForce) {
+                forceMagnitude = std::min(forceMagnitude, maxForce);
+            }
+            return direction.normalized() * forceMagnitude;
+        } else {
+            // The Plummer term is finite at r = 0, where direction is zero anyway
+            float softened = distanceSquared + softeningSquared;
+            float scale = gmm / (softened * std::sqrt(softened));
+            if constexpr (ClampForce) {
+                scale = std::min(scale, maxForce / std::sqrt(distanceSquared));  // +inf at r = 0
+            }
+            return direction * scale;
+        }
+    }
+
+    /**
+     * @brief Computes the pair potential matching force()
+     * @param distance Separation
+     * @param gmm G times both masses
+     * @param softening Epsilon
+     * @return Potential energy (negative); the force clamp is not modelled
+     */
+    static double potential(double distance, double gmm, double softening) {
+        if constexpr (S == Softening::Clamped) {
+            // Inside epsilon the force magnitude is constant, so the potential is linear there
+            return distance >= softening ? -gmm / distance : -gmm * (2.0 - distance / softening) / softening;
+        } else {
+            return -gmm / std::sqrt(distance * distance + softening * softening);
+        }
+    }
+};
+
+/** The law every solver uses unless configured otherwise */
+using DefaultForceLaw = ForceLawPolicy<Softening::Clamped, true>;
+
+/**
+ * @brief Calls a visitor with the ForceLawPolicy matching a runtime law
+ * @param law Runtime description
+ * @param visitor Callable taking a ForceLawPolicy instance by value
+ * @return Whatever the visitor returns
+ *
+ * The only place the runtime switches are examined; call it once per force
+ * evaluation and run the whole loop inside the visitor.
+ */
+template <typename Visitor>
+decltype(auto) visitForceLaw(const ForceLaw& law, Visitor&& visitor) {
+    if (law.softening == Softening::Plummer) {
+        if (law.clampForce) return visitor(ForceLawPolicy<Softening::Plummer, true>());
+        return visitor(ForceLawPolicy<Softening::Plummer, false>());
+    }
+    if (law.clampForce) return visitor(ForceLawPolicy<Softening::Clamped, true>());
+    return visitor(ForceLawPolicy<Softening::Clamped, false>());
+}
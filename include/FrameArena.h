@@ -0,0 +1,224 @@
+/**
+ * @file FrameArena.h
+ * @brief Per-thread bump allocator for scratch memory that lives for one step
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class FrameArena
+ * @brief Hands out scratch memory that is released all at once by reset()
+ *
+ * Each ThreadPool thread allocates from its own lane (chosen with
+ * ThreadPool::getCurrentThreadIndex()), so parallel tasks never share a
+ * lock or a cache line. Allocation bumps an offset into the lane's block;
+ * reset() sets every offset back to zero. A lane that ran out of its block
+ * during a step falls back to extra heap blocks, and the next reset()
+ * replaces them with one block big enough for the whole step. After the
+ * first few steps the working set therefore fits and stepping performs no
+ * heap allocations at all.
+ *
+ * Memory is uninitialized and no destructors run, so only trivially
+ * destructible types may be allocated. Nothing handed out may be used
+ * after reset().
+ */
+class FrameArena {
+    struct Lane;
+
+public:
+    /**
+     * @brief Creates an arena
+     * @param laneCount Threads that may allocate concurrently (see reserveLanes())
+     * @param initialLaneBytes Size of each lane's first block
+     */
+    explicit FrameArena(size_t laneCount = 1, size_t initialLaneBytes = DEFAULT_LANE_BYTES);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Makes sure every thread of a pool has a lane
+     * @param laneCount Thread count of the pool that will allocate, including the caller
+     *
+     * Must not run while other threads are allocating.
+     */
+    void reserveLanes(size_t laneCount);
+
+    /**
+     * @brief Allocates raw memory from the calling thread's lane
+     * @param bytes Size in bytes
+     * @param alignment Power of two alignment
+     * @return Memory valid until reset()
+     */
+    void* allocateBytes(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Allocates an uninitialized array from the calling thread's lane
+     * @tparam T Trivially destructible element type
+     * @param count Number of elements
+     * @return Array valid until reset()
+     */
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @class Scope
+     * @brief Gives back the calling thread's allocations made during its lifetime
+     * 
+     * For scratch that is only needed within one task, so the lane is reused
+     * by the thread's next task instead of growing with every chunk. Scopes
+     * nest; memory from a lane that overflowed inside the scope is kept
+     * until reset().
+     */
+    class Scope {
+    public:
+        explicit Scope(FrameArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Lane* lane;            ///< Lane of the thread that opened the scope
+        size_t blockCount;     ///< Overflow blocks when opened
+        size_t used;           ///< Bytes used in the current block when opened
+    };
+
+    /**
+     * @brief Releases everything allocated since the last reset
+     *
+     * Constant time per lane once the lanes are large enough; lanes that
+     * overflowed are regrown to the step's peak usage first.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the bytes handed out since the last reset, over all lanes
+     * @return Bytes, including alignment padding
+     */
+    size_t getUsedBytes() const;
+
+    /**
+     * @brief Gets the bytes reserved by all lanes
+     * @return Bytes
+     */
+    size_t getCapacityBytes() const;
+
+    /**
+     * @brief Gets the number of heap blocks allocated since construction
+     * @return Block count; stops growing once the working set fits
+     *
+     * Like getUsedBytes() and getCapacityBytes(), call it while no other
+     * thread is allocating.
+     */
+    size_t getHeapAllocationCount() const;
+
+    /** First block size of each lane */
+    static constexpr size_t DEFAULT_LANE_BYTES = 64 * 1024;
+
+private:
+    /**
+     * @struct Lane
+     * @brief One thread's blocks; aligned so neighbouring lanes never share a cache line
+     */
+    struct alignas(64) Lane {
+        std::unique_ptr<unsigned char[]> block;                    ///< Primary block
+        size_t capacity = 0;                                       ///< Size of block
+        size_t used = 0;                                           ///< Bytes used in the current block
+        std::vector<std::unique_ptr<unsigned char[]>> overflow;    ///< Extra blocks this step, newest (current) last
+        size_t overflowCapacity = 0;                               ///< Size of the newest overflow block
+        size_t filled = 0;                                         ///< Bytes used in the blocks before the current one
+        size_t allocations = 0;                                    ///< Heap blocks allocated by this lane
+    };
+
+    std::vector<std::unique_ptr<Lane>> lanes;   ///< Indexed by ThreadPool::getCurrentThreadIndex()
+    size_t initialLaneBytes;                    ///< First block size of new lanes
+
+    /**
+     * @brief Gets the lane of the calling thread
+     * @return Lane
+     */
+    Lane& currentLane();
+};
+
+/**
+ * @class ArenaArray
+ * @brief Growable array of trivially copyable values stored in a FrameArena
+ * @tparam T Element type
+ *
+ * Growing copies the elements into a larger arena allocation and abandons
+ * the old one until the arena resets, so reserve() a good estimate (such as
+ * the previous step's size) to keep copies rare. All memory is the calling
+ * thread's; use one array per thread.
+ */
+template <typename T>
+class ArenaArray {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "ArenaArray moves elements with memcpy");
+
+    /**
+     * @brief Creates an empty array
+     * @param arena Arena to allocate from (must outlive the array's use)
+     */
+    explicit ArenaArray(FrameArena& arena) : arena(&arena) {}
+
+    /**
+     * @brief Ensures room for a number of elements without further allocation
+     * @param count Minimum capacity
+     */
+    void reserve(size_t count) {
+        if (count <= capacity) return;
+        T* grown = arena->allocate<T>(count);
+        if (length > 0) std::memcpy(grown, elements, length * sizeof(T));
+        elements = grown;
+        capacity = count;
+    }
+
+    /**
+     * @brief Sets the number of elements, leaving new ones uninitialized
+     * @param count New size
+     */
+    void resize(size_t count) {
+        reserve(count);
+        length = count;
+    }
+
+    /**
+     * @brief Appends an element
+     * @param value Element to copy in
+     */
+    void push_back(const T& value) {
+        if (length == capacity) reserve(capacity < 8 ? 16 : capacity * 2);
+        elements[length++] = value;
+    }
+
+    /**
+     * @brief Removes all elements, keeping the capacity
+     */
+    void clear() { length = 0; }
+
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    T* data() { return elements; }
+    const T* data() const { return elements; }
+    T* begin() { return elements; }
+    T* end() { return elements + length; }
+    T& operator[](size_t index) { return elements[index]; }
+    const T& operator[](size_t index) const { return elements[index]; }
+
+private:
+    FrameArena* arena;             ///< Source of the storage
+    T* elements = nullptr;         ///< Current storage
+    size_t length = 0;             ///< Elements in use
+    size_t capacity = 0;           ///< Elements that fit in storage
+};
@@ -0,0 +1,154 @@
+/**
+ * @file FrameCapture.h
+ * @brief Offscreen rendering to image sequences or an encoder pipe with asynchronous readback
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <GL/glew.h>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class FrameCapture
+ * @brief Renders frames into a framebuffer object and streams them to disk
+ *
+ * Between beginFrame() and endFrame() all drawing goes to an offscreen
+ * framebuffer of any size, independent of the (possibly hidden) window.
+ * endFrame() starts a glReadPixels into the next of a ring of pixel buffer
+ * objects, which returns immediately, and collects the frame read
+ * PBO_COUNT - 1 frames earlier, whose transfer has long finished (a fence
+ * confirms it where GL 3.2 / ARB_sync is available). Collecting is one
+ * memcpy out of the mapped buffer; flipping, conversion and encoding happen
+ * on a writer thread. The GPU therefore never waits for the CPU, and the
+ * CPU only waits when the writer falls more than QUEUE_FRAMES behind.
+ *
+ * Output is either a numbered PNG sequence (the path contains exactly one
+ * printf %d conversion such as "frames/frame_%05d.png", with %% for a
+ * literal percent sign) or, for a path starting with '|', the rest of the
+ * path run as a command that receives raw top-down
+ * RGB24 frames on stdin, e.g. "|ffmpeg -f rawvideo -pix_fmt rgb24 -s
+ * 1920x1080 -r 60 -i - out.mp4". PNGs are written with stored (unpacked)
+ * deflate blocks so no compression library is needed.
+ *
+ * Needs a current GL context with framebuffer objects (GL 3.0 or
+ * ARB_framebuffer_object); call every method on the context's thread.
+ */
+class FrameCapture {
+public:
+    FrameCapture() = default;
+
+    /**
+     * @brief Finishes any capture in progress
+     */
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /**
+     * @brief Creates the framebuffer and pixel buffers and opens the output
+     * @param width Frame width in pixels
+     * @param height Frame height in pixels
+     * @param output PNG path pattern, or '|' followed by an encoder command
+     * @return true on success; errors go to std::cerr
+     */
+    bool initialize(int width, int height, const std::string& output);
+
+    /**
+     * @brief Directs rendering to the offscreen framebuffer
+     */
+    void beginFrame();
+
+    /**
+     * @brief Queues the frame's readback and hands finished frames to the writer
+     *
+     * Rebinds the default framebuffer.
+     */
+    void endFrame();
+
+    /**
+     * @brief Collects all pending frames, waits for the writer and closes the output
+     */
+    void finish();
+
+    /**
+     * @brief Checks whether frames are being captured
+     * @return true between a successful initialize() and finish()
+     */
+    bool isActive() const { return active; }
+
+    /**
+     * @brief Gets the number of frames rendered for capture
+     * @return endFrame() calls so far
+     */
+    uint64_t getCapturedFrameCount() const { return capturedFrames; }
+
+    /**
+     * @brief Gets the number of frames the writer failed to write
+     * @return Failed frames so far
+     */
+    uint64_t getFailedFrameCount() const;
+
+    /** Pixel buffers in the readback ring; frames reach the CPU this many frames minus one late */
+    static constexpr int PBO_COUNT = 3;
+
+    /** Frames buffered between readback and the writer thread */
+    static constexpr size_t QUEUE_FRAMES = 4;
+
+private:
+    int width = 0, height = 0;                  ///< Frame size
+    bool active = false;                        ///< Capturing
+    GLuint framebuffer = 0;                     ///< Offscreen target
+    GLuint colorBuffer = 0, depthBuffer = 0;    ///< Attachments of framebuffer
+    GLuint pixelBuffers[PBO_COUNT] = {};        ///< Readback ring
+    GLsync fences[PBO_COUNT] = {};              ///< Readback completion, when sync objects exist
+    uint64_t capturedFrames = 0;                ///< Frames read back so far
+    uint64_t collectedFrames = 0;               ///< Frames handed to the writer so far
+
+    // Output, used only by the writer thread after initialize()
+    std::string pattern;                        ///< PNG path pattern (empty when piping)
+    FILE* pipe = nullptr;                       ///< Encoder stdin when piping
+    std::vector<uint8_t> rgb;                   ///< Converted top-down RGB24 frame
+    std::vector<uint8_t> encoded;               ///< PNG file contents
+
+    // Writer hand-off
+    std::vector<std::vector<uint8_t>> images;   ///< QUEUE_FRAMES bottom-up RGBA frames
+    std::deque<size_t> ready;                   ///< Images to write, oldest first
+    std::vector<size_t> freeImages;             ///< Images available for readback
+    mutable std::mutex mutex;                   ///< Guards ready, freeImages, stopping and failedFrames
+    std::condition_variable changed;            ///< Signals queue changes
+    bool stopping = false;                      ///< Writer should exit once ready is empty
+    uint64_t failedFrames = 0;                  ///< Frames the writer could not write
+    std::thread writer;                         ///< Background writer
+
+    /**
+     * @brief Copies the oldest pending readback out of its pixel buffer and queues it
+     */
+    void collectOldestFrame();
+
+    /**
+     * @brief Body of the writer thread
+     */
+    void runWriter();
+
+    /**
+     * @brief Converts and writes one frame
+     * @param pixels Bottom-up RGBA frame
+     * @param number Frame number for the file name
+     * @return false on an I/O error
+     */
+    bool writeImage(const std::vector<uint8_t>& pixels, uint64_t number);
+
+    /**
+     * @brief Deletes the GL objects
+     */
+    void releaseGL();
+};
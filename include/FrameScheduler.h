@@ -0,0 +1,117 @@
+/**
+ * @file FrameScheduler.h
+ * @brief Frame pacing and fixed-timestep simulation scheduling
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <chrono>
+
+/**
+ * @class FrameScheduler
+ * @brief Measures real frame time, feeds a fixed-timestep accumulator and paces frames
+ *
+ * Every frame starts with beginFrame(), which measures the wall time since the
+ * previous frame and adds it to an accumulator. takeSimulationStep() then
+ * hands out whole fixed steps until the accumulator is drained, so simulated
+ * time tracks wall time exactly no matter how long frames take. After a stall
+ * at most MAX_STEPS_PER_FRAME steps are run and the rest of the backlog is
+ * dropped, to avoid a spiral of death.
+ *
+ * Pacing depends on the mode: VSync leaves it to the swap interval, Capped
+ * sleeps until the frame's deadline in endFrame() and Uncapped runs as fast
+ * as possible (for benchmarking). Offline ignores the wall clock: every frame
+ * counts as exactly one target frame interval, so captured video plays at
+ * the right speed however long each frame took to render.
+ */
+class FrameScheduler {
+public:
+    /**
+     * @brief How frames are paced
+     */
+    enum class Mode {
+        VSync,      ///< Swap interval 1; the driver blocks in swapBuffers
+        Capped,     ///< Swap interval 0; sleep to a target frame rate
+        Uncapped,   ///< Swap interval 0; no waiting at all
+        Offline     ///< Swap interval 0; frames last 1 / targetFrameRate of simulated time
+    };
+
+    /**
+     * @brief Creates a scheduler
+     * @param mode Pacing mode
+     * @param targetFrameRate Frames per second in Capped and Offline mode
+     * @param simulationRate Fixed simulation steps per second of wall time
+     */
+    FrameScheduler(Mode mode = Mode::VSync, float targetFrameRate = 60.0f, float simulationRate = 60.0f);
+
+    /**
+     * @brief Starts a frame and accumulates the wall time since the previous one
+     * @return Seconds since the previous beginFrame() (0 for the first frame), or the fixed frame interval in Offline mode
+     */
+    float beginFrame();
+
+    /**
+     * @brief Takes one fixed step off the accumulator if a whole step is due
+     * @return true if the caller should advance the simulation by getFixedTimeStep()
+     */
+    bool takeSimulationStep();
+
+    /**
+     * @brief Waits until the frame's deadline in Capped mode
+     *
+     * Call after swapping buffers. Does nothing in the other modes.
+     */
+    void endFrame();
+
+    /**
+     * @brief Gets the swap interval matching the mode
+     * @return 1 for VSync, 0 otherwise
+     */
+    int getSwapInterval() const { return mode == Mode::VSync ? 1 : 0; }
+
+    /**
+     * @brief Gets the wall time covered by one simulation step
+     * @return Step length in seconds
+     */
+    float getFixedTimeStep() const { return fixedTimeStep; }
+
+    /**
+     * @brief Gets the wall time of the last frame
+     * @return Seconds between the last two beginFrame() calls
+     */
+    float getFrameTime() const { return frameTime; }
+
+    /**
+     * @brief Gets the number of steps dropped after stalls so far
+     * @return Dropped step count
+     */
+    unsigned long long getDroppedStepCount() const { return droppedSteps; }
+
+    /**
+     * @brief Gets the pacing mode
+     * @return Mode given at construction
+     */
+    Mode getMode() const { return mode; }
+
+    /** Steps run per frame at most before the backlog is dropped */
+    static constexpr int MAX_STEPS_PER_FRAME = 8;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Mode mode;                          ///< Pacing mode
+    float fixedTimeStep;                ///< Seconds per simulation step
+    Clock::duration frameInterval;      ///< Target frame duration in Capped mode
+    float offlineFrameTime;             ///< Frame duration in Offline mode, a whole multiple of fixedTimeStep when the rates divide
+    Clock::time_point lastFrameStart;   ///< Start of the previous frame
+    Clock::time_point nextDeadline;     ///< When the next Capped frame may start
+    bool started = false;               ///< beginFrame() has run before
+    double accumulator = 0.0;           ///< Wall time not yet simulated
+    float frameTime = 0.0f;             ///< Duration of the last frame
+    int stepsThisFrame = 0;             ///< Steps taken since beginFrame()
+    unsigned long long droppedSteps = 0; ///< Steps skipped to recover from stalls
+
+    /** The last stretch before a Capped deadline is spun instead of slept, as sleeps overshoot */
+    static constexpr std::chrono::microseconds SPIN_WINDOW{1500};
+};
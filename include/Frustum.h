@@ -0,0 +1,89 @@
+/**
+ * @file Frustum.h
+ * @brief View frustum planes for culling bounding volumes
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "Mat4.h"
+#include <cmath>
+
+/**
+ * @struct Frustum
+ * @brief The six clip planes of a view-projection matrix in world space
+ *
+ * Planes are extracted from the matrix rows (Gribb & Hartmann), so a point
+ * is inside when it is on the positive side of all six. The tests are
+ * conservative: a volume is only rejected when it lies entirely outside one
+ * plane, so a few volumes just outside a corner of the frustum still pass.
+ */
+struct Frustum {
+    float planes[6][4];   ///< a, b, c, d of a x + b y + c z + d >= 0, normalized
+
+    /**
+     * @brief Extracts the planes of a combined projection * view matrix
+     * @param viewProjection World-to-clip transform
+     * @return Frustum in world space
+     */
+    static Frustum fromMatrix(const Mat4& viewProjection) {
+        const float* m = viewProjection.data();
+        // Row r of a column-major matrix is m[r], m[4 + r], m[8 + r], m[12 + r]
+        auto row = [m](int r, int component) { return m[component * 4 + r]; };
+        Frustum frustum;
+        for (int plane = 0; plane < 6; ++plane) {
+            int axis = plane / 2;
+            float sign = (plane % 2 == 0) ? 1.0f : -1.0f;   // left/bottom/near, then right/top/far
+            float length = 0.0f;
+            for (int component = 0; component < 4; ++component) {
+                frustum.planes[plane][component] = row(3, component) + sign * row(axis, component);
+            }
+            for (int component = 0; component < 3; ++component) {
+                length += frustum.planes[plane][component] * frustum.planes[plane][component];
+            }
+            length = std::sqrt(length);
+            if (length > 0.0f) {
+                for (int component = 0; component < 4; ++component) {
+                    frustum.planes[plane][component] /= length;
+                }
+            }
+        }
+        return frustum;
+    }
+
+    /**
+     * @brief Tests a sphere against the frustum
+     * @param x Center
+     * @param y Center
+     * @param z Center
+     * @param radius Radius
+     * @return false only if the sphere is certainly outside
+     */
+    bool intersectsSphere(float x, float y, float z, float radius) const {
+        for (const auto& plane : planes) {
+            if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < -radius) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Tests an axis-aligned box against the frustum
+     * @param minX Lower corner
+     * @param minY Lower corner
+     * @param minZ Lower corner
+     * @param maxX Upper corner
+     * @param maxY Upper corner
+     * @param maxZ Upper corner
+     * @return false only if the box is certainly outside
+     */
+    bool intersectsBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) const {
+        for (const auto& plane : planes) {
+            // The corner furthest along the plane normal decides
+            float x = plane[0] >= 0.0f ? maxX : minX;
+            float y = plane[1] >= 0.0f ? maxY : minY;
+            float z = plane[2] >= 0.0f ? maxZ : minZ;
+            if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) return false;
+        }
+        return true;
+    }
+};
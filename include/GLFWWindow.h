@@ -68,6 +68,12 @@ public:
      */
     void swapBuffers() override;
     
+    /**
+     * @brief Sets the swap interval of the window's context
+     * @param interval Vertical blanks per swap (0 = no vsync)
+     */
+    void setSwapInterval(int interval) override;
+    
     /**
      * @brief Processes all pending GLFW events
      * 
@@ -115,6 +121,8 @@ private:
     /**
      * @brief Initializes the GLFW library and sets OpenGL hints
      * @return true if GLFW initialization was successful
+     * 
+     * The context version and profile come from WindowProperties.
      */
     bool initializeGLFW();
     
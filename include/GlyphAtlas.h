@@ -0,0 +1,108 @@
+/**
+ * @file GlyphAtlas.h
+ * @brief Texture atlas of the UI's stroke font
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <GL/glew.h>
+
+/**
+ * @class GlyphAtlas
+ * @brief Rasterizes the UI font once into a texture so text draws as textured quads
+ *
+ * The glyphs are the line-segment shapes UIRenderer used to draw with one
+ * glBegin(GL_LINES) per character. Here they are rendered once, anti-aliased
+ * and OVERSAMPLE times larger than their on-screen size, into one cell per
+ * printable ASCII character, with CPU-built mipmaps for small text scales.
+ * One extra cell is opaque white so untextured UI quads can come from the
+ * same texture and share a draw call with the text.
+ *
+ * The texture is RGBA (white, coverage in alpha), so it works unchanged in
+ * legacy and core-profile contexts.
+ */
+class GlyphAtlas {
+public:
+    /**
+     * @struct Glyph
+     * @brief Texture rectangle of one atlas cell
+     */
+    struct Glyph {
+        float u0, v0;       ///< Top-left texture coordinate
+        float u1, v1;       ///< Bottom-right texture coordinate
+    };
+
+    GlyphAtlas() = default;
+
+    /**
+     * @brief Deletes the texture
+     */
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /**
+     * @brief Rasterizes the font and uploads the atlas texture
+     * @return true if the texture was created
+     */
+    bool initialize();
+
+    /**
+     * @brief Deletes the texture (safe to call more than once)
+     */
+    void release();
+
+    /**
+     * @brief Gets the cell of a character
+     * @param c Character; letters are case-insensitive, unknown characters get a box
+     * @return Texture rectangle covering CELL_WIDTH x CELL_HEIGHT glyph units
+     */
+    const Glyph& getGlyph(char c) const;
+
+    /**
+     * @brief Gets a rectangle of opaque white texels for untextured quads
+     * @return Texture rectangle (inset so filtering never reaches another cell)
+     */
+    const Glyph& getSolidGlyph() const {
+        return glyphs[SOLID_CELL];
+    }
+
+    /**
+     * @brief Gets the atlas texture
+     * @return Texture name (0 before initialize())
+     */
+    GLuint getTexture() const {
+        return texture;
+    }
+
+    /** Glyph cell size in glyph units (pixels at text scale 1) */
+    static constexpr int CELL_WIDTH = 8;
+    static constexpr int CELL_HEIGHT = 12;
+
+    /** Texels per glyph unit in the finest mip level */
+    static constexpr int OVERSAMPLE = 4;
+
+    /** Half the stroke width in glyph units (one pixel wide lines at scale 1) */
+    static constexpr float STROKE_HALF_WIDTH = 0.5f;
+
+private:
+    /** First character with a cell, and the number of printable ASCII characters */
+    static constexpr int FIRST_CHARACTER = 32;
+    static constexpr int PRINTABLE_COUNT = 95;
+
+    /** Extra cells after the printable characters */
+    static constexpr int UNKNOWN_CELL = PRINTABLE_COUNT;
+    static constexpr int SOLID_CELL = PRINTABLE_COUNT + 1;
+    static constexpr int CELL_COUNT = PRINTABLE_COUNT + 2;
+
+    /** Cells per atlas row */
+    static constexpr int COLUMNS = 16;
+
+    /** Mip levels below the finest one; the last matches text scale 1 */
+    static constexpr int MIP_LEVELS = 2;
+
+    GLuint texture = 0;             ///< RGBA atlas texture
+    Glyph glyphs[CELL_COUNT] = {};  ///< Texture rectangle of every cell
+};
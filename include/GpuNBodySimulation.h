@@ -0,0 +1,205 @@
+/**
+ * @file GpuNBodySimulation.h
+ * @brief Compute-shader N-body integration and grid field evaluation
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "ShaderProgram.h"
+#include <GL/glew.h>
+#include <utility>
+
+/**
+ * @class GpuNBodySimulation
+ * @brief Runs the body-body forces, time stepping and grid field on the GPU
+ *
+ * Body state lives in a shader storage buffer (one Body record per body)
+ * that is uploaded once and then only touched by compute shaders:
+ *
+ * - the force kernel is the tiled shared-memory N-body sum: each work group
+ *   stages WORKGROUP_SIZE source bodies in shared memory, every invocation
+ *   accumulates the whole tile for its target, and the group moves on to
+ *   the next tile, so each body is read from memory once per work group
+ *   instead of once per pair;
+ * - the integrate kernel applies the kick-drift-kick leapfrog of
+ *   LeapfrogIntegrator and the world bounds of GravitySimulation;
+ * - the field kernel evaluates GravityGrid's field at every grid point with
+ *   the same tiling and writes one force magnitude per point.
+ *
+ * Softening distances and force clamps are those of GravityBody, so the
+ * result matches the CPU direct solver to within float rounding (the sum
+ * order differs). BodyMesh and SpacetimeGridMesh draw straight from the
+ * body and magnitude buffers, so nothing crosses the bus per frame;
+ * download() copies the state back for code that needs it on the CPU.
+ *
+ * Needs OpenGL 4.3 and must be used from the thread owning the context.
+ */
+class GpuNBodySimulation {
+public:
+    /**
+     * @struct Body
+     * @brief std430 layout of one body in the body buffer
+     */
+    struct Body {
+        float x, y;          ///< Position in world units
+        float vx, vy;        ///< Velocity
+        float mass;          ///< Mass
+        float radius;        ///< Radius
+        float ax, ay;        ///< Acceleration at the current position
+    };
+
+    /**
+     * @brief Creates an empty simulation for a world size
+     * @param worldWidth Width of the world (bodies bounce off its edges)
+     * @param worldHeight Height of the world
+     */
+    GpuNBodySimulation(float worldWidth, float worldHeight);
+
+    /**
+     * @brief Releases GPU resources
+     */
+    ~GpuNBodySimulation();
+
+    GpuNBodySimulation(const GpuNBodySimulation&) = delete;
+    GpuNBodySimulation& operator=(const GpuNBodySimulation&) = delete;
+
+    /**
+     * @brief Checks whether the current context has compute shaders
+     * @return true if OpenGL 4.3 is available (call after GLEW is initialized)
+     */
+    static bool isSupported();
+
+    /**
+     * @brief Compiles the compute kernels
+     * @return true if the simulation can be used
+     */
+    bool initialize();
+
+    /**
+     * @brief Replaces the GPU body state with the contents of a body store
+     * @param bodies Bodies to simulate
+     */
+    void upload(const BodyStore& bodies);
+
+    /**
+     * @brief Sets the grid the field kernel evaluates
+     * @param width Grid points along x
+     * @param height Grid points along y
+     *
+     * Points are spread over the world exactly like GravityGrid::gridToWorld.
+     */
+    void setGridDimensions(int width, int height);
+
+    /**
+     * @brief Advances the bodies by one leapfrog step
+     * @param deltaTime Time step
+     * @param gravitationalConstant G constant for force calculations
+     */
+    void step(float deltaTime, float gravitationalConstant);
+
+    /**
+     * @brief Recomputes the force magnitude at every grid point
+     * @param gravitationalConstant G constant for force calculations
+     */
+    void updateField(float gravitationalConstant);
+
+    /**
+     * @brief Copies the GPU body state back into a body store (stalls until the GPU is done)
+     * @param bodies Store to overwrite; resized to getBodyCount()
+     */
+    void download(BodyStore& bodies) const;
+
+    /**
+     * @brief Gets the body buffer, for drawing (Body records, bound as a storage or vertex buffer)
+     * @return Buffer name
+     */
+    GLuint getBodyBuffer() const {
+        return bodyBuffer;
+    }
+
+    /**
+     * @brief Gets the number of simulated bodies
+     * @return Body count
+     */
+    GLsizei getBodyCount() const {
+        return bodyCount;
+    }
+
+    /**
+     * @brief Gets the grid field buffer (row-major float magnitudes, as GravityGrid::getForceMagnitudeData)
+     * @return Buffer name
+     */
+    GLuint getFieldMagnitudeBuffer() const {
+        return fieldBuffer;
+    }
+
+    /**
+     * @brief Gets the grid dimensions
+     * @return Grid points along x and y
+     */
+    std::pair<int, int> getGridDimensions() const {
+        return {gridWidth, gridHeight};
+    }
+
+    /**
+     * @brief Deletes all GPU resources (safe to call more than once)
+     */
+    void release();
+
+    /** Invocations per work group, and bodies per shared-memory tile */
+    static constexpr GLuint WORKGROUP_SIZE = 256;
+
+    /** Storage buffer binding of the body buffer in every kernel */
+    static constexpr GLuint BODY_BINDING = 0;
+
+    /** GLSL declaration of Body matching the C++ struct */
+    static const char* GLSL_BODY_STRUCT;
+
+private:
+    float worldWidth, worldHeight;       ///< World bounds
+    ShaderProgram forceProgram;          ///< Tiled body-body accelerations
+    ShaderProgram integrateProgram;      ///< Leapfrog kick/drift and world bounds
+    ShaderProgram fieldProgram;          ///< Tiled grid field magnitudes
+    GLuint bodyBuffer = 0;               ///< Body records
+    GLuint fieldBuffer = 0;              ///< Grid force magnitudes
+    GLsizei bodyCount = 0;               ///< Bodies in bodyBuffer
+    int gridWidth = 0, gridHeight = 0;   ///< Grid size of fieldBuffer
+    bool hasAccelerations = false;       ///< Accelerations match the current positions
+    float accelerationG = 0.0f;          ///< G the accelerations were computed with
+
+    // Uniform locations
+    GLint forceBodyCountLocation = -1;
+    GLint forceGLocation = -1;
+    GLint integrateBodyCountLocation = -1;
+    GLint integrateDriftLocation = -1;
+    GLint integrateDeltaTimeLocation = -1;
+    GLint integrateWorldSizeLocation = -1;
+    GLint fieldBodyCountLocation = -1;
+    GLint fieldGLocation = -1;
+    GLint fieldGridSizeLocation = -1;
+    GLint fieldWorldSizeLocation = -1;
+
+    /**
+     * @brief Runs the force kernel, leaving accelerations for the current positions
+     * @param gravitationalConstant G constant for force calculations
+     */
+    void computeAccelerations(float gravitationalConstant);
+
+    /**
+     * @brief Runs one half of the integrate kernel
+     * @param drift true for half kick + drift, false for half kick + world bounds
+     * @param deltaTime Full time step
+     */
+    void integrate(bool drift, float deltaTime);
+
+    /**
+     * @brief Gets the number of work groups covering a count
+     * @param count Invocations needed
+     * @return Work groups of WORKGROUP_SIZE
+     */
+    static GLuint groupsFor(size_t count) {
+        return static_cast<GLuint>((count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE);
+    }
+};
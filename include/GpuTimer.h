@@ -0,0 +1,37 @@
+/**
+ * @file GpuTimer.h
+ * @brief OpenGL timestamp queries for the profiler
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IGpuTimer.h"
+#include <GL/glew.h>
+#include <vector>
+
+/**
+ * @class GpuTimer
+ * @brief IGpuTimer on GL_TIMESTAMP queries (OpenGL 3.3 or ARB_timer_query)
+ */
+class GpuTimer : public IGpuTimer {
+public:
+    GpuTimer() = default;
+
+    /**
+     * @brief Deletes the queries (needs the context they were created in)
+     */
+    ~GpuTimer() override;
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    bool initialize(size_t queryCount) override;
+    void writeTimestamp(size_t query) override;
+    bool isAvailable(size_t query) const override;
+    uint64_t getTimestamp(size_t query) const override;
+    uint64_t getCurrentTime() const override;
+
+private:
+    std::vector<GLuint> queries;   ///< Query objects by index
+};
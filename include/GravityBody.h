@@ -7,6 +7,8 @@
 
 #pragma once
 #include "Vec2.h"
+#include "BodyStore.h"
+#include <memory>
 
 /**
  * @class GravityBody
@@ -15,9 +17,18 @@
  * This class encapsulates the properties of a gravitational body that can
  * influence the gravity grid. Follows the Single Responsibility Principle
  * by handling only the physics properties of a gravitational object.
+ * 
+ * A freshly constructed body owns its own state. Once added to a simulation
+ * it is bound to the simulation's BodyStore and becomes a lightweight handle:
+ * all accessors read and write the store's arrays at the body's index.
  */
 class GravityBody {
 public:
+    static constexpr float PAIR_MIN_DISTANCE = 10.0f;   ///< Softening distance for body-body forces
+    static constexpr float PAIR_MAX_FORCE = 5000.0f;    ///< Clamp for body-body force magnitude
+    static constexpr float FIELD_MIN_DISTANCE = 1.0f;   ///< Softening distance for field evaluation
+    static constexpr float FIELD_MAX_FORCE = 1000.0f;   ///< Clamp for field force magnitude
+
     /**
      * @brief Constructs a gravity body with specified properties
      * @param position Initial position of the body
@@ -30,37 +41,67 @@ public:
      * @brief Gets the current position of the body
      * @return Position vector
      */
-    const Vec2& getPosition() const { return position; }
+    Vec2 getPosition() const { 
+        return store ? store->getPosition(storeIndex) : position; 
+    }
 
     /**
      * @brief Gets the mass of the body
      * @return Mass value
      */
-    float getMass() const { return mass; }
+    float getMass() const { return store ? store->mass[storeIndex] : mass; }
 
     /**
      * @brief Gets the visual radius of the body
      * @return Radius value
      */
-    float getRadius() const { return radius; }
+    float getRadius() const { return store ? store->radius[storeIndex] : radius; }
 
     /**
      * @brief Sets a new position for the body
      * @param newPosition New position vector
      */
-    void setPosition(const Vec2& newPosition) { position = newPosition; }
+    void setPosition(const Vec2& newPosition);
 
     /**
      * @brief Gets the current velocity of the body
      * @return Velocity vector
      */
-    const Vec2& getVelocity() const { return velocity; }
+    Vec2 getVelocity() const { 
+        return store ? store->getVelocity(storeIndex) : velocity; 
+    }
 
     /**
      * @brief Sets the velocity of the body
      * @param newVelocity New velocity vector
      */
-    void setVelocity(const Vec2& newVelocity) { velocity = newVelocity; }
+    void setVelocity(const Vec2& newVelocity);
+
+    /**
+     * @brief Binds this body to a slot in a body store
+     * @param bodyStore Store that now owns the body's state
+     * @param index Index of the body within the store
+     * 
+     * The store must already contain the body's state at the given index.
+     */
+    void bindToStore(std::shared_ptr<BodyStore> bodyStore, size_t index);
+
+    /**
+     * @brief Detaches the body from its store, copying the current state back
+     */
+    void unbindFromStore();
+
+    /**
+     * @brief Checks whether the body is a handle into a body store
+     * @return true if bound to a store
+     */
+    bool isBound() const { return store != nullptr; }
+
+    /**
+     * @brief Gets the index of the body within its store
+     * @return Store index (only meaningful while bound)
+     */
+    size_t getStoreIndex() const { return storeIndex; }
 
     /**
      * @brief Applies a force to the body for one timestep
@@ -91,9 +132,39 @@ public:
      */
     Vec2 calculateForceFrom(const GravityBody& other, float gravitationalConstant = 100.0f) const;
 
+    /**
+     * @brief Calculates the body-body force exerted by a source mass on a target mass
+     * @param targetPosition Position of the body receiving the force
+     * @param targetMass Mass of the body receiving the force
+     * @param sourcePosition Position of the attracting mass
+     * @param sourceMass Attracting mass (a single body or an aggregated tree node)
+     * @param gravitationalConstant G constant for force calculation
+     * @return Force vector that should be applied to the target
+     *
+     * Evaluates DefaultForceLaw (see ForceLaw.h) with the PAIR_ constants;
+     * solvers configured with another ForceLaw call its policy directly.
+     */
+    static Vec2 calculatePairForce(const Vec2& targetPosition, float targetMass,
+                                   const Vec2& sourcePosition, float sourceMass,
+                                   float gravitationalConstant = 100.0f);
+
+    /**
+     * @brief Calculates the field force a source mass exerts on a unit mass at a point
+     * @param point Position to calculate force at
+     * @param sourcePosition Position of the attracting mass
+     * @param sourceMass Attracting mass
+     * @param gravitationalConstant G constant for force calculation
+     * @return Force vector pointing toward the source
+     */
+    static Vec2 calculateFieldForce(const Vec2& point, const Vec2& sourcePosition, float sourceMass,
+                                    float gravitationalConstant = 100.0f);
+
 private:
-    Vec2 position;   ///< Current position of the body
-    Vec2 velocity;   ///< Current velocity of the body
-    float mass;      ///< Mass of the body
-    float radius;    ///< Visual radius for rendering
+    Vec2 position;   ///< Current position of the body (while unbound)
+    Vec2 velocity;   ///< Current velocity of the body (while unbound)
+    float mass;      ///< Mass of the body (while unbound)
+    float radius;    ///< Visual radius for rendering (while unbound)
+
+    std::shared_ptr<BodyStore> store;  ///< Store holding the body's state, null if unbound
+    size_t storeIndex;                 ///< Index of the body within the store
 };
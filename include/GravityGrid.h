@@ -7,9 +7,15 @@
 
 #pragma once
 #include "Vec2.h"
-#include "GravityBody.h"
-#include <vector>
+#include "BodyStore.h"
+#include "ThreadPool.h"
+#include "FrameArena.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
+#include <utility>
+
+class ParticleMeshField;
 
 /**
  * @class GravityGrid
@@ -21,6 +27,15 @@
  */
 class GravityGrid {
 public:
+    /**
+     * @enum FieldMethod
+     * @brief Algorithms for evaluating the field at the grid points
+     */
+    enum class FieldMethod {
+        Direct,        ///< Exact sum over bodies per point, O(points x bodies), incremental
+        ParticleMesh   ///< CIC deposit + FFT convolution, O(points log points) for any body count
+    };
+
     /**
      * @brief Constructs a gravity grid with specified dimensions
      * @param width Width of the simulation area
@@ -31,11 +46,76 @@ public:
 
     /**
      * @brief Updates the gravity grid based on current bodies
-     * @param bodies Vector of gravitational bodies to consider
+     * @param bodies Body store holding the bodies to consider
      * @param gravitationalConstant G constant for force calculations
+     * @param threadPool Pool to spread grid rows over (null runs on the calling thread)
+     * @return true if any grid force changed
+     * 
+     * The grid remembers the position and mass each body had when its field
+     * was last added. Only bodies that have since moved further than the
+     * move threshold (or changed mass) are updated, by subtracting their old
+     * field and adding the new one (particle-mesh mode always re-solves the
+     * whole field). If nothing moved the call returns immediately. The whole grid is recomputed when the body count or G
+     * changed, after invalidate(), when most bodies moved, and periodically
+     * to flush accumulated rounding error.
+     */
+    bool updateGrid(const BodyStore& bodies, float gravitationalConstant = 100.0f,
+                    ThreadPool* threadPool = nullptr);
+
+    /**
+     * @brief Provides scratch memory for updates
+     * @param arena Arena its owner resets after every updateGrid() (null uses a private one)
+     */
+    void setFrameArena(FrameArena* arena) { frameArena = arena; }
+
+    /**
+     * @brief Selects how the field is evaluated
+     * @param method Direct summation or particle-mesh
+     * 
+     * Particle-mesh is approximate within about a grid spacing of a body but
+     * its cost does not grow with the number of bodies, so it is the better
+     * choice for large scenes.
+     */
+    void setFieldMethod(FieldMethod method);
+
+    /**
+     * @brief Gets the field evaluation method
+     * @return Current method
+     */
+    FieldMethod getFieldMethod() const { 
+        return fieldMethod; 
+    }
+
+    /**
+     * @brief Forces the next updateGrid() call to recompute every grid point
+     */
+    void invalidate() { 
+        contributionsValid = false; 
+    }
+
+    /**
+     * @brief Sets how far a body must move before its field is updated
+     * @param threshold Distance in world units (0 updates every moving body)
+     */
+    void setMoveThreshold(float threshold) { 
+        moveThreshold = threshold; 
+    }
+
+    /**
+     * @brief Gets the distance a body must move before its field is updated
+     * @return Threshold in world units
+     */
+    float getMoveThreshold() const { 
+        return moveThreshold; 
+    }
+
+    /**
+     * @brief Gets the number of bodies whose field was updated by the last updateGrid()
+     * @return Body count (all bodies for a full recompute, 0 if nothing moved)
      */
-    void updateGrid(const std::vector<std::shared_ptr<GravityBody>>& bodies, 
-                    float gravitationalConstant = 100.0f);
+    size_t getLastUpdatedBodyCount() const { 
+        return lastUpdatedBodyCount; 
+    }
 
     /**
      * @brief Gets the grid dimensions
@@ -53,6 +133,44 @@ public:
         return {worldWidth, worldHeight}; 
     }
 
+    /**
+     * @brief Gets the forces at all grid points
+     * @return Row-major array of width * height forces (index y * width + x)
+     * 
+     * Valid until the next updateGrid() call; lets renderers and exporters
+     * stream the whole field without per-point calls.
+     */
+    const Vec2* getForceData() const { 
+        return forces.data(); 
+    }
+
+    /**
+     * @brief Gets the force magnitudes at all grid points
+     * @return Row-major array of width * height magnitudes, kept in sync with getForceData()
+     */
+    const float* getForceMagnitudeData() const { 
+        return magnitudes.data(); 
+    }
+
+    /**
+     * @brief Gets a stamp that changes whenever the field changes
+     * @return Version, unique across all grids in the process (0 = never computed)
+     * 
+     * Copies keep the version, so renderers can skip re-uploading a field
+     * they already have, whichever grid object it arrives in.
+     */
+    uint64_t getVersion() const { 
+        return version; 
+    }
+
+    /**
+     * @brief Gets the number of grid points
+     * @return width * height
+     */
+    size_t getPointCount() const { 
+        return forces.size(); 
+    }
+
     /**
      * @brief Gets the gravitational force at a specific grid point
      * @param gridX Grid X coordinate
@@ -88,7 +206,62 @@ private:
     float worldWidth, worldHeight;           ///< Dimensions in world units
     int gridWidth, gridHeight;               ///< Dimensions in grid points
     float gridSpacing;                       ///< Distance between grid points
-    std::vector<std::vector<Vec2>> forces;   ///< 2D array of force vectors
+    std::vector<Vec2> forces;                ///< Row-major force at every grid point
+    std::vector<float> magnitudes;           ///< Row-major |force| at every grid point
+    std::vector<float> pointX, pointY;       ///< Row-major world positions of every grid point
+    uint64_t version = 0;                    ///< Stamp of the current field (see getVersion())
+    FieldMethod fieldMethod = FieldMethod::Direct; ///< Field evaluation algorithm
+    std::shared_ptr<ParticleMeshField> particleMesh; ///< FFT workspace, created on first use; copies
+                                                     ///< (render snapshots) share it but never update
+    FrameArena* frameArena = nullptr;        ///< Scratch provided by the owner
+    std::shared_ptr<FrameArena> ownArena;    ///< Scratch when no frame arena is set, created on first use
+    
+    // Dirty tracking for incremental updates
+    std::vector<float> contributedX, contributedY, contributedMass; ///< Position and mass each body's current field was computed from
+    BodyStore movedBefore, movedAfter;       ///< Old and new state of the bodies being updated
+    float contributedG = 0.0f;               ///< G the grid forces were computed with
+    bool contributionsValid = false;         ///< contributed* match the grid forces
+    float moveThreshold;                     ///< Movement that triggers an update
+    int incrementalUpdates = 0;              ///< Delta updates since the last full recompute
+    size_t lastUpdatedBodyCount = 0;         ///< Bodies updated by the last call
+
+    /** Delta updates between full recomputes that flush rounding error */
+    static constexpr int FULL_UPDATE_INTERVAL = 256;
+
+    /** Default move threshold as a fraction of the grid spacing */
+    static constexpr float DEFAULT_MOVE_THRESHOLD = 0.05f;
+
+    /**
+     * @brief Recomputes every grid point from scratch
+     * @param bodies Body store holding the bodies to consider
+     * @param gravitationalConstant G constant for force calculations
+     * @param threadPool Pool to spread grid rows over
+     * @param arena Scratch memory
+     */
+    void computeFullGrid(const BodyStore& bodies, float gravitationalConstant, ThreadPool* threadPool,
+                         FrameArena& arena);
+
+    /**
+     * @brief Recomputes the cached force magnitudes of a range of rows
+     * @param firstRow First row to refresh
+     * @param lastRow One past the last row
+     */
+    void updateMagnitudes(size_t firstRow, size_t lastRow);
+
+    /**
+     * @brief Replaces the field of movedBefore with that of movedAfter at every grid point
+     * @param gravitationalConstant G constant for force calculations
+     * @param threadPool Pool to spread grid rows over
+     * @param arena Scratch memory for the per-row fields
+     */
+    void applyMovedBodies(float gravitationalConstant, ThreadPool* threadPool, FrameArena& arena);
+
+    /**
+     * @brief Gets the arena for an update, with a lane for every pool thread
+     * @param threadPool Pool the update runs on
+     * @return The frame arena, or the private one (reset first)
+     */
+    FrameArena& scratchArena(ThreadPool* threadPool);
 
     /**
      * @brief Calculates the index for the forces array
@@ -6,11 +6,16 @@
  */
 
 #pragma once
-#include "IRenderer.h"
+#include "IGravityRenderer.h"
 #include "GravityGrid.h"
-#include "GravityBody.h"
+#include "BodyStore.h"
 #include "Camera.h"
 #include "UIRenderer.h"
+#include "SceneSource.h"
+#include "SpacetimeGridMesh.h"
+#include "BodyMesh.h"
+#include "Mat4.h"
+#include "Profiler.h"
 #include <GL/glew.h>
 #include <vector>
 #include <memory>
@@ -23,8 +28,11 @@
  * Camera management is delegated to CameraController.
  * UI rendering is delegated to UIRenderer.
  * This follows the Single Responsibility Principle and Open/Closed Principle.
+ * 
+ * Uses the fixed-function pipeline and needs a 2.1 / compatibility context;
+ * CoreGravityRenderer is the core-profile alternative.
  */
-class GravityRenderer : public IRenderer {
+class GravityRenderer : public IGravityRenderer {
 public:
     /**
      * @brief Constructs a gravity renderer with specified viewport
@@ -43,7 +51,7 @@ public:
      * @param cameraController Camera system for view transformation
      * @param uiRenderer UI system for overlays (optional)
      */
-    void render(const CameraController& cameraController, UIRenderer* uiRenderer = nullptr);
+    void render(const CameraController& cameraController, UIRenderer* uiRenderer = nullptr) override;
 
     /**
      * @brief Legacy render method for IRenderer interface compatibility
@@ -59,23 +67,54 @@ public:
      * @brief Sets the gravity grid to render
      * @param grid Shared pointer to the gravity grid
      */
-    void setGravityGrid(std::shared_ptr<GravityGrid> grid) { 
-        gravityGrid = grid; 
+    void setGravityGrid(std::shared_ptr<GravityGrid> grid) override { 
+        sceneSource.setGravityGrid(grid); 
+    }
+
+    /**
+     * @brief Sets the body store to render bodies from
+     * @param store Shared, read-only body store owned by the simulation
+     * 
+     * The store is shared rather than copied, so bodies added to the
+     * simulation later are rendered as well.
+     */
+    void setBodyStore(std::shared_ptr<const BodyStore> store) override { 
+        sceneSource.setBodyStore(store); 
+    }
+
+    /**
+     * @brief Renders from snapshots published by a simulation thread
+     * @param source Snapshot buffer to consume, or null to render the shared grid and store directly
+     * 
+     * When set, every frame uses the newest published snapshot and interpolates
+     * body positions between its previous and current state.
+     */
+    void setSnapshotSource(TripleBuffer<SimulationSnapshot>* source) override { 
+        sceneSource.setSnapshotSource(source); 
+    }
+
+    /**
+     * @brief GPU simulations need compute shaders, which the fixed-function renderer does not use
+     * @param simulation Simulation to draw
+     * @return true only for null
+     */
+    bool setGpuSimulation(std::shared_ptr<const GpuNBodySimulation> simulation) override { 
+        return !simulation; 
     }
 
     /**
-     * @brief Sets the gravitational bodies to render
-     * @param bodies Vector of gravitational bodies
+     * @brief Reports grid and body drawing times to a profiler
+     * @param profiler Profiler to report to, or null
      */
-    void setGravityBodies(const std::vector<std::shared_ptr<GravityBody>>& bodies) { 
-        gravityBodies = bodies; 
+    void setProfiler(Profiler* profiler) override { 
+        this->profiler = profiler; 
     }
 
     /**
      * @brief Sets the maximum force value for color scaling
      * @param maxForce Maximum force magnitude for visualization
      */
-    void setMaxForceForVisualization(float maxForce) { 
+    void setMaxForceForVisualization(float maxForce) override { 
         maxForceVisualization = maxForce; 
     }
 
@@ -84,14 +123,21 @@ public:
      * @param width New viewport width
      * @param height New viewport height
      */
-    void setViewportSize(float width, float height);
+    void setViewportSize(float width, float height) override;
 
 private:
     float viewportWidth, viewportHeight;                         ///< Viewport dimensions
-    std::shared_ptr<GravityGrid> gravityGrid;                   ///< Grid to visualize
-    std::vector<std::shared_ptr<GravityBody>> gravityBodies;    ///< Bodies to render
+    SceneSource sceneSource;                                    ///< Grid and bodies to visualize
     float maxForceVisualization;                                ///< Max force for color scaling
     bool isInitialized;                                         ///< Initialization state
+    std::unique_ptr<SpacetimeGridMesh> gridMesh;                ///< GPU grid path (null = immediate mode)
+    std::unique_ptr<BodyMesh> bodyMesh;                         ///< Instanced body path (null = one draw per sphere)
+    Mat4 viewMatrix;                                            ///< Camera transform of the current frame
+    Mat4 projectionMatrix;                                      ///< Projection set by setup3DProjection()
+    Profiler* profiler = nullptr;                               ///< Optional phase timing (not owned)
+    
+    /** Vertical field of view in degrees */
+    static constexpr float FIELD_OF_VIEW = 60.0f;
 
     // Forward declaration for 3D vector
     struct Vec3 { float x, y, z; Vec3(float x=0, float y=0, float z=0) : x(x), y(y), z(z) {} };
@@ -101,21 +147,36 @@ private:
      */
     void setup3DProjection();
 
+    /**
+     * @brief Renders the grid and bodies from the current data source
+     */
+    void renderScene();
+
     /**
      * @brief Renders the 3D spacetime grid that warps around massive objects
+     * @param grid Gravity grid to visualize
+     * 
+     * Uses the retained SpacetimeGridMesh when shaders are available and
+     * immediate mode otherwise.
      */
-    void render3DSpacetimeGrid();
+    void render3DSpacetimeGrid(const GravityGrid& grid);
 
     /**
      * @brief Renders gravitational bodies as 3D spheres above the grid
+     * @param bodies Bodies to render
+     * 
+     * Uses instanced BodyMesh draws when available; otherwise draws each
+     * body from cached sphere geometry at the same level of detail.
      */
-    void render3DGravityBodies();
+    void render3DGravityBodies(const BodyStore& bodies);
 
     /**
      * @brief Renders a 3D sphere at the specified position
      * @param center Center position in 3D space
      * @param radius Radius of the sphere
      * @param segments Number of segments for sphere detail
+     * 
+     * Draws a cached SphereGeometry with one glDrawElements call.
      */
     void render3DSphere(const Vec3& center, float radius, int segments = 12);
 
@@ -8,7 +8,17 @@
 #pragma once
 #include "GravityGrid.h"
 #include "GravityBody.h"
-#include "GravityRenderer.h"
+#include "BodyStore.h"
+#include "IGravityRenderer.h"
+#include "IBodyGenerator.h"
+#include "IForceSolver.h"
+#include "IIntegrator.h"
+#include "ThreadPool.h"
+#include "FrameArena.h"
+#include "CollisionResolver.h"
+#include "Profiler.h"
+#include "TrajectoryRecorder.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -27,8 +37,12 @@ public:
      * @param worldWidth Width of the simulation world
      * @param worldHeight Height of the simulation world
      * @param gridResolution Resolution of the gravity grid
+     * @param forceSolver Algorithm used for body-body forces (defaults to DirectForceSolver)
+     * @param threadCount Threads used for force and grid updates (0 = hardware concurrency)
      */
-    GravitySimulation(float worldWidth, float worldHeight, int gridResolution = 20);
+    GravitySimulation(float worldWidth, float worldHeight, int gridResolution = 20,
+                      std::unique_ptr<IForceSolver> forceSolver = nullptr,
+                      size_t threadCount = 0);
 
     /**
      * @brief Initializes the simulation with default bodies
@@ -38,32 +52,97 @@ public:
     /**
      * @brief Updates the simulation by one time step
      * @param deltaTime Time step for the update
+     * 
+     * Same as stepBodies() followed by updateGrid().
      */
     void update(float deltaTime);
 
+    /**
+     * @brief Advances the bodies by one time step without touching the grid
+     * @param deltaTime Time step for the update
+     * 
+     * Lets several fixed steps per frame share a single grid update.
+     */
+    void stepBodies(float deltaTime);
+
+    /**
+     * @brief Brings the grid field up to date with the current body positions
+     */
+    void updateGrid();
+
     /**
      * @brief Sets up the renderer with current simulation state
-     * @param renderer Gravity renderer to configure
+     * @param renderer Gravity renderer (either backend) to configure
      */
-    void setupRenderer(std::shared_ptr<GravityRenderer> renderer);
+    void setupRenderer(std::shared_ptr<IGravityRenderer> renderer);
 
     /**
      * @brief Adds a gravitational body to the simulation
      * @param body Shared pointer to the body to add
+     * 
+     * The body's state is copied into the body store and the body becomes a
+     * handle to its slot, so later changes through either side stay in sync.
      */
     void addBody(std::shared_ptr<GravityBody> body);
 
+    /**
+     * @brief Reserves body store capacity ahead of several bulk additions
+     * @param count Total number of bodies expected
+     */
+    void reserveBodies(size_t count);
+
+    /**
+     * @brief Appends many bodies at once
+     * @param descriptors First body state
+     * @param count Number of bodies
+     * 
+     * The state is copied straight into the body store; no GravityBody
+     * handles are created until getBodies() asks for them.
+     */
+    void addBodies(const BodyDescriptor* descriptors, size_t count);
+
+    /**
+     * @brief Appends procedurally generated bodies
+     * @param generator Fills the new slots, in parallel on the simulation's threads
+     * @return Index of the first new body
+     */
+    size_t addBodies(const IBodyGenerator& generator);
+
     /**
      * @brief Removes all bodies from the simulation
      */
     void clearBodies();
 
     /**
-     * @brief Gets all gravitational bodies in the simulation
-     * @return Vector of gravitational bodies
+     * @brief Replaces all bodies with the contents of a store in one go
+     * @param store New body state, moved into the simulation
+     * 
+     * Existing handles are unbound and one new handle is created per body.
+     */
+    void replaceBodies(BodyStore store);
+
+    /**
+     * @brief Gets handles to all gravitational bodies in the simulation
+     * @return Vector of gravitational body handles
+     * 
+     * Bodies added in bulk get their handles here, on first request.
      */
-    const std::vector<std::shared_ptr<GravityBody>>& getBodies() const { 
-        return bodies; 
+    const std::vector<std::shared_ptr<GravityBody>>& getBodies() const;
+
+    /**
+     * @brief Gets the number of bodies without creating handles
+     * @return Body count
+     */
+    size_t getBodyCount() const {
+        return bodyStore->size();
+    }
+
+    /**
+     * @brief Gets the structure-of-arrays body state
+     * @return Shared pointer to the body store
+     */
+    std::shared_ptr<const BodyStore> getBodyStore() const { 
+        return bodyStore; 
     }
 
     /**
@@ -80,6 +159,8 @@ public:
      */
     void setGravitationalConstant(float g) { 
         gravitationalConstant = g; 
+        integrator->reset();
+        needsGridUpdate = true;
     }
 
     /**
@@ -90,12 +171,211 @@ public:
         return gravitationalConstant; 
     }
 
+    /**
+     * @brief Hands checkpointed cached state to the active integrator
+     * @param state Arrays saved by IIntegrator::saveState() for the current bodies
+     * @return true if the integrator accepted the state
+     */
+    bool restoreIntegratorState(const IntegratorState& state) {
+        bool restored = integrator->restoreState(state, bodyStore->size());
+        integratorVersion = bodyStore->version;
+        return restored;
+    }
+
+    /**
+     * @brief Makes the integrator recompute its cached forces on the next step
+     * 
+     * Needed after positions were written behind the simulation's back; edits
+     * through GravityBody are detected on their own via BodyStore::version.
+     */
+    void invalidateForces() {
+        integrator->invalidateForces();
+    }
+
+    /**
+     * @brief Checks whether world bounds or collisions moved bodies in the last step
+     * @return true if the integrator's cached forces were invalidated by the last step
+     */
+    bool didLastStepMoveBodies() const {
+        return lastStepMovedBodies;
+    }
+
+    /**
+     * @brief Gets the simulated time advanced since construction (or the restored checkpoint)
+     * @return Simulated seconds
+     */
+    double getSimulationTime() const {
+        return simulationTime;
+    }
+
+    /**
+     * @brief Gets the number of body steps taken
+     * @return Step count
+     */
+    uint64_t getStepCount() const {
+        return stepCount;
+    }
+
+    /**
+     * @brief Sets the simulation clock, e.g. when resuming from a checkpoint
+     * @param time Simulated seconds
+     * @param steps Step count
+     */
+    void setClock(double time, uint64_t steps) {
+        simulationTime = time;
+        stepCount = steps;
+    }
+
+    /**
+     * @brief Replaces the force solver used for body-body forces
+     * @param solver New solver (ignored if null)
+     */
+    void setForceSolver(std::unique_ptr<IForceSolver> solver);
+
+    /**
+     * @brief Gets the active force solver
+     * @return Reference to the current solver
+     */
+    const IForceSolver& getForceSolver() const { 
+        return *forceSolver; 
+    }
+
+    /**
+     * @brief Selects the softening and clamp used for body-body forces
+     * @param law Force law; softeningLength must be positive
+     * @return false (with a message on std::cerr) if the law is rejected
+     * 
+     * Stays in effect when the force solver is replaced. Only the CPU
+     * solvers honour it; GpuNBodySimulation keeps the default law.
+     */
+    bool setForceLaw(const ForceLaw& law);
+
+    /**
+     * @brief Gets the force law used for body-body forces
+     * @return Current law
+     */
+    const ForceLaw& getForceLaw() const {
+        return forceSolver->getForceLaw();
+    }
+
+    /**
+     * @brief Replaces the time integration scheme
+     * @param newIntegrator New integrator (ignored if null)
+     */
+    void setIntegrator(std::unique_ptr<IIntegrator> newIntegrator);
+
+    /**
+     * @brief Gets the active time integration scheme
+     * @return Reference to the current integrator
+     */
+    const IIntegrator& getIntegrator() const { 
+        return *integrator; 
+    }
+
+    /**
+     * @brief Selects the precision positions are accumulated in
+     * @param precision Position precision, kept for integrators set later
+     * @return false if the current integrator only supports single precision
+     * 
+     * The body store stays float, so forces are unaffected; see PositionAccumulator.
+     */
+    bool setPositionPrecision(PositionPrecision precision);
+
+    /**
+     * @brief Gets the requested position precision
+     * @return Precision passed to every integrator
+     */
+    PositionPrecision getPositionPrecision() const {
+        return positionPrecision;
+    }
+
+    /**
+     * @brief Changes the number of threads used for simulation updates
+     * @param threadCount Thread count including the caller (0 = hardware concurrency)
+     * 
+     * Results do not depend on the thread count.
+     */
+    void setThreadCount(size_t threadCount);
+
+    /**
+     * @brief Gets the number of threads used for simulation updates
+     * @return Thread count including the caller
+     */
+    size_t getThreadCount() const { 
+        return threadPool->getThreadCount(); 
+    }
+
+    /**
+     * @brief Gets the scratch arena used by the solver and grid
+     * @return Arena, reset at the end of every stepBodies() and updateGrid()
+     */
+    const FrameArena& getFrameArena() const {
+        return frameArena;
+    }
+
+    /**
+     * @brief Computes the total kinetic plus potential energy of the bodies
+     * @return Energy in simulation units, summed in double precision
+     * 
+     * The potential is that of the softened pair force of the current
+     * ForceLaw (see ForceLawPolicy::potential). The force clamp is not
+     * modelled and wall bounces remove energy, so use it to compare drift
+     * between runs rather than as an absolute conservation check. O(N^2).
+     */
+    double computeTotalEnergy() const;
+
+    /**
+     * @brief Selects how touching bodies are handled after each step
+     * @param mode Collision response (None by default)
+     */
+    void setCollisionMode(CollisionResolver::Mode mode) {
+        collisionResolver->setMode(mode);
+    }
+
+    /**
+     * @brief Gets the collision resolver for configuration and statistics
+     * @return Resolver applied after every body step
+     */
+    CollisionResolver& getCollisionResolver() {
+        return *collisionResolver;
+    }
+
+    /**
+     * @brief Reports the body and grid update times to a profiler
+     * @param profiler Profiler to report to, or null; must outlive the simulation's use of it
+     */
+    void setProfiler(Profiler* profiler) {
+        this->profiler = profiler;
+    }
+
+    /**
+     * @brief Hands the state after every body step to a trajectory recorder
+     * @param recorder Recorder to feed, or null; must outlive the simulation's use of it
+     */
+    void setRecorder(TrajectoryRecorder* recorder) {
+        this->recorder = recorder;
+    }
+
 private:
     std::shared_ptr<GravityGrid> gravityGrid;              ///< The gravity grid
-    std::vector<std::shared_ptr<GravityBody>> bodies;      ///< Gravitational bodies
+    std::shared_ptr<BodyStore> bodyStore;                  ///< Contiguous body state
+    mutable std::vector<std::shared_ptr<GravityBody>> bodies; ///< Handles into bodyStore; may be shorter or hold nulls until getBodies()
     float worldWidth, worldHeight;                         ///< World dimensions
     float gravitationalConstant;                           ///< G constant for physics
-    bool needsGridUpdate;                                  ///< Flag for grid updates
+    bool needsGridUpdate;                                  ///< Grid must be fully recomputed on the next update
+    std::unique_ptr<IForceSolver> forceSolver;             ///< Body-body force algorithm
+    std::unique_ptr<ThreadPool> threadPool;                ///< Persistent workers for updates
+    FrameArena frameArena;                                 ///< Scratch for one step or grid update, reset after each
+    std::unique_ptr<IIntegrator> integrator;               ///< Time stepping scheme
+    PositionPrecision positionPrecision = PositionPrecision::Single; ///< Position accumulation of every integrator
+    std::unique_ptr<CollisionResolver> collisionResolver;  ///< Merges or bounces touching bodies
+    std::vector<size_t> mergedBodies;                      ///< Bodies absorbed by the last collision pass
+    Profiler* profiler = nullptr;                          ///< Optional phase timing (not owned)
+    TrajectoryRecorder* recorder = nullptr;                ///< Optional trajectory output (not owned)
+    double simulationTime = 0.0;                           ///< Simulated seconds so far
+    uint64_t stepCount = 0;                                ///< Body steps taken so far
+    uint64_t integratorVersion = 0;                        ///< Store version the integrator's cached forces were computed for
+    bool lastStepMovedBodies = false;                      ///< Bounds or collisions moved bodies after the last integrator step
 
     /**
      * @brief Creates default demonstration bodies
@@ -103,8 +383,38 @@ private:
     void createDefaultBodies();
 
     /**
-     * @brief Updates body positions (for future animation)
+     * @brief Advances body positions and velocities by one time step
      * @param deltaTime Time step for updates
      */
     void updateBodies(float deltaTime);
+
+    /**
+     * @brief Computes body-body forces with the active solver (integrator callback)
+     * @param store Bodies to evaluate
+     * @param targets Bodies that need forces (null = all)
+     * @param forces Output force per body
+     */
+    void evaluateForces(const BodyStore& store, const std::vector<size_t>* targets,
+                        std::vector<Vec2>& forces);
+
+    /**
+     * @brief Reflects bodies that left the world bounds back inside
+     * @return true if any body was moved
+     */
+    bool applyWorldBounds();
+
+    /**
+     * @brief Applies the collision response and removes merged bodies
+     * @return true if surviving bodies were moved (inelastic bounces); merges reset the integrator
+     */
+    bool resolveCollisions();
+
+    /**
+     * @brief Erases bodies from the store and drops their handles
+     * @param indices Ascending, unique body indices
+     * 
+     * Handles of the removed bodies are unbound and keep their final state;
+     * the remaining handles are rebound to their new indices.
+     */
+    void removeBodies(const std::vector<size_t>& indices);
 };
@@ -0,0 +1,51 @@
+/**
+ * @file IBodyGenerator.h
+ * @brief Abstract interface for procedural initial conditions
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "ThreadPool.h"
+#include <cstddef>
+
+/**
+ * @class IBodyGenerator
+ * @brief Writes a procedurally generated set of bodies straight into a body store
+ *
+ * GravitySimulation::addBodies() grows the store by getBodyCount() slots and
+ * lets the generator fill them, so large scenes are set up without one heap
+ * allocation per body. Implementations fill slots in parallel and must give
+ * the same bodies for any thread count (derive each body's random numbers
+ * from its index, not from a shared sequence).
+ */
+class IBodyGenerator {
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes
+     */
+    virtual ~IBodyGenerator() = default;
+
+    /**
+     * @brief Gets the number of bodies generate() writes
+     * @return Body count
+     */
+    virtual size_t getBodyCount() const = 0;
+
+    /**
+     * @brief Fills a range of already allocated slots
+     * @param bodies Store whose slots [first, first + getBodyCount()) are overwritten
+     * @param first Index of the first slot
+     * @param gravitationalConstant G used to put bodies on equilibrium orbits
+     * @param threadPool Pool to spread the work over (null runs on the calling thread)
+     */
+    virtual void generate(BodyStore& bodies, size_t first, float gravitationalConstant,
+                          ThreadPool* threadPool) const = 0;
+
+    /**
+     * @brief Gets the generator name for diagnostics
+     * @return Short human-readable name
+     */
+    virtual const char* getName() const = 0;
+};
@@ -0,0 +1,94 @@
+/**
+ * @file ICommunicator.h
+ * @brief Abstract interface for the collective operations of a distributed run
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class ICommunicator
+ * @brief Collective byte exchanges between the processes (ranks) of a run
+ *
+ * DistributedSimulation only talks to other ranks through this interface,
+ * so the decomposition, tree exchange and migration logic is the same for
+ * an MPI job and for a single process (SerialCommunicator). Every operation
+ * is collective: all ranks must call the same operations in the same order,
+ * from the thread that created the communicator.
+ *
+ * Buffers are plain bytes; callers pack trivially copyable records. Per-rank
+ * blocks are concatenated in rank order and described by byte counts.
+ */
+class ICommunicator {
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes
+     */
+    virtual ~ICommunicator() = default;
+
+    /**
+     * @brief Gets the index of this process
+     * @return Rank in [0, getSize())
+     */
+    virtual int getRank() const = 0;
+
+    /**
+     * @brief Gets the number of processes in the run
+     * @return Rank count (at least 1)
+     */
+    virtual int getSize() const = 0;
+
+    /**
+     * @brief Sends a block to every rank and receives one from every rank
+     * @param send Blocks for rank 0, 1, ... back to back
+     * @param sendBytes Size of each outgoing block (getSize() entries)
+     * @param receive Incoming blocks in rank order, overwritten
+     * @param receiveBytes Size of each incoming block, overwritten
+     */
+    virtual void allToAll(const std::vector<unsigned char>& send, const std::vector<size_t>& sendBytes,
+                          std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) = 0;
+
+    /**
+     * @brief Gives every rank the blocks of all ranks
+     * @param send This rank's block
+     * @param bytes Size of the block (may differ between ranks)
+     * @param receive All blocks in rank order, overwritten
+     * @param receiveBytes Size of each block, overwritten
+     */
+    virtual void allGather(const void* send, size_t bytes,
+                           std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) = 0;
+
+    /**
+     * @brief Collects the blocks of all ranks on one rank
+     * @param send This rank's block
+     * @param bytes Size of the block (may differ between ranks)
+     * @param receive All blocks in rank order on the root, untouched elsewhere
+     * @param receiveBytes Size of each block on the root, untouched elsewhere
+     * @param root Rank that receives
+     */
+    virtual void gather(const void* send, size_t bytes, std::vector<unsigned char>& receive,
+                        std::vector<size_t>& receiveBytes, int root) = 0;
+
+    /**
+     * @brief Sums values element-wise over all ranks
+     * @param values In: this rank's values; out: the sums, on every rank
+     * @param count Number of values
+     */
+    virtual void allReduceSum(double* values, size_t count) = 0;
+
+    /**
+     * @brief Takes the element-wise maximum over all ranks
+     * @param values In: this rank's values; out: the maxima, on every rank
+     * @param count Number of values
+     */
+    virtual void allReduceMax(double* values, size_t count) = 0;
+
+    /**
+     * @brief Gets a human readable name for logging
+     * @return Communicator name
+     */
+    virtual const char* getName() const = 0;
+};
@@ -0,0 +1,101 @@
+/**
+ * @file IForceSolver.h
+ * @brief Abstract interface for N-body force solvers
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "ForceLaw.h"
+#include "FrameArena.h"
+#include "ThreadPool.h"
+#include "Vec2.h"
+#include <vector>
+
+/**
+ * @class IForceSolver
+ * @brief Abstract interface for algorithms that compute body-body gravity
+ * 
+ * GravitySimulation delegates the force accumulation step to an IForceSolver
+ * so the O(N^2) direct sum and approximate solvers (e.g. Barnes-Hut) are
+ * interchangeable. Follows the Open/Closed Principle: new solvers can be
+ * added without modifying the simulation.
+ */
+class IForceSolver {
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes
+     */
+    virtual ~IForceSolver() = default;
+
+    /**
+     * @brief Computes the net gravitational force acting on every body
+     * @param bodies Body store holding the current positions and masses
+     * @param gravitationalConstant G constant for force calculations
+     * @param forces Output vector, resized to bodies.size() and overwritten
+     * @param threadPool Pool to spread the work over (null runs on the calling thread)
+     * 
+     * Implementations must produce the same result for any thread count.
+     */
+    virtual void computeForces(const BodyStore& bodies,
+                               float gravitationalConstant,
+                               std::vector<Vec2>& forces,
+                               ThreadPool* threadPool) = 0;
+
+    /**
+     * @brief Computes the net gravitational force on a subset of bodies
+     * @param bodies Body store holding the current positions and masses
+     * @param gravitationalConstant G constant for force calculations
+     * @param targets Indices of the bodies that need forces
+     * @param forces Output vector indexed by body; resized to bodies.size() if
+     *               needed, only the target entries are overwritten
+     * @param threadPool Pool to spread the work over (null runs on the calling thread)
+     * 
+     * Used by block timestep integrators, which only recompute forces for the
+     * bodies whose step ends. Every body still acts as a source. The default
+     * evaluates all bodies; solvers override it to only do the targets' work.
+     */
+    virtual void computeForcesOn(const BodyStore& bodies,
+                                 float gravitationalConstant,
+                                 const std::vector<size_t>& targets,
+                                 std::vector<Vec2>& forces,
+                                 ThreadPool* threadPool) {
+        std::vector<Vec2> allForces;
+        computeForces(bodies, gravitationalConstant, allForces, threadPool);
+        forces.resize(bodies.size());
+        for (size_t target : targets) {
+            forces[target] = allForces[target];
+        }
+    }
+
+    /**
+     * @brief Selects the softening and clamp used for body-body forces
+     * @param law Force law; applies from the next computeForces() call
+     * 
+     * Solvers resolve the law to a ForceLawPolicy once per call, never per
+     * interaction.
+     */
+    virtual void setForceLaw(const ForceLaw& law) = 0;
+
+    /**
+     * @brief Gets the force law in use
+     * @return Current law (ForceLaw::pair() unless changed)
+     */
+    virtual const ForceLaw& getForceLaw() const = 0;
+
+    /**
+     * @brief Provides per-step scratch memory
+     * @param arena Arena reset by the owner after every step (null to use the solver's own)
+     * 
+     * Solvers that build temporary structures (trees, work lists) take them
+     * from the arena instead of the heap. The default ignores it.
+     */
+    virtual void setFrameArena(FrameArena* arena) { (void)arena; }
+
+    /**
+     * @brief Gets a human readable name for logging
+     * @return Solver name
+     */
+    virtual const char* getName() const = 0;
+};
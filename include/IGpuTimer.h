@@ -0,0 +1,62 @@
+/**
+ * @file IGpuTimer.h
+ * @brief Abstract interface for GPU timestamp queries
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class IGpuTimer
+ * @brief A fixed set of GPU timestamp queries addressed by index
+ *
+ * Profiler times GPU scopes through this interface so that it, and the
+ * GravitySimulation that reports to it, carry no graphics API dependency;
+ * headless tools link the profiler without any GL library. The windowed
+ * application injects the OpenGL implementation, GpuTimer.
+ *
+ * Every method belongs to the thread owning the graphics context.
+ */
+class IGpuTimer {
+public:
+    /**
+     * @brief Virtual destructor; releases the queries (needs the context)
+     */
+    virtual ~IGpuTimer() = default;
+
+    /**
+     * @brief Creates the queries
+     * @param queryCount Number of queries, addressed 0 .. queryCount - 1
+     * @return false if the device cannot record timestamps
+     */
+    virtual bool initialize(size_t queryCount) = 0;
+
+    /**
+     * @brief Records the GPU time once the commands issued so far have completed
+     * @param query Query index
+     */
+    virtual void writeTimestamp(size_t query) = 0;
+
+    /**
+     * @brief Checks without waiting whether a query's result has arrived
+     * @param query Query index
+     * @return true if getTimestamp() will not stall
+     */
+    virtual bool isAvailable(size_t query) const = 0;
+
+    /**
+     * @brief Reads a recorded timestamp
+     * @param query Query index
+     * @return GPU time in nanoseconds
+     */
+    virtual uint64_t getTimestamp(size_t query) const = 0;
+
+    /**
+     * @brief Reads the GPU clock now
+     * @return GPU time in nanoseconds, on the same time line as getTimestamp()
+     */
+    virtual uint64_t getCurrentTime() const = 0;
+};
@@ -0,0 +1,86 @@
+/**
+ * @file IGravityRenderer.h
+ * @brief Abstract interface for gravity visualization renderers
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IRenderer.h"
+#include "BodyStore.h"
+#include "TripleBuffer.h"
+#include <memory>
+
+class GravityGrid;
+class GpuNBodySimulation;
+class CameraController;
+class Profiler;
+class UIRenderer;
+struct SimulationSnapshot;
+
+/**
+ * @class IGravityRenderer
+ * @brief Contract shared by the legacy fixed-function and the core-profile renderer
+ *
+ * The application and simulation only talk to this interface, so the
+ * rendering backend can be chosen at startup (and fall back to the legacy
+ * one on machines without a core-profile context) without touching them.
+ */
+class IGravityRenderer : public IRenderer {
+public:
+    /**
+     * @brief Renders the gravity grid and bodies using injected camera and UI components
+     * @param cameraController Camera system for view transformation
+     * @param uiRenderer UI system for overlays (optional)
+     */
+    virtual void render(const CameraController& cameraController, UIRenderer* uiRenderer = nullptr) = 0;
+    using IRenderer::render;
+
+    /**
+     * @brief Sets the gravity grid to render
+     * @param grid Shared pointer to the gravity grid
+     */
+    virtual void setGravityGrid(std::shared_ptr<GravityGrid> grid) = 0;
+
+    /**
+     * @brief Sets the body store to render bodies from
+     * @param store Shared, read-only body store owned by the simulation
+     * 
+     * Read in place every frame, so bodies the simulation adds later are
+     * drawn without calling this again; per-body data is only rebuilt when
+     * BodyStore::version changes.
+     */
+    virtual void setBodyStore(std::shared_ptr<const BodyStore> store) = 0;
+
+    /**
+     * @brief Renders from snapshots published by a simulation thread
+     * @param source Snapshot buffer to consume, or null to render the shared grid and store directly
+     */
+    virtual void setSnapshotSource(TripleBuffer<SimulationSnapshot>* source) = 0;
+
+    /**
+     * @brief Renders bodies and grid field straight from a GPU simulation's buffers
+     * @param simulation Simulation to draw, or null to go back to the grid and store
+     * @return false if this renderer cannot draw GPU buffers (the simulation is not used)
+     */
+    virtual bool setGpuSimulation(std::shared_ptr<const GpuNBodySimulation> simulation) = 0;
+
+    /**
+     * @brief Reports grid and body drawing times (CPU and GPU) to a profiler
+     * @param profiler Profiler to report to, or null
+     */
+    virtual void setProfiler(Profiler* profiler) = 0;
+
+    /**
+     * @brief Sets the maximum force value for color scaling
+     * @param maxForce Maximum force magnitude for visualization
+     */
+    virtual void setMaxForceForVisualization(float maxForce) = 0;
+
+    /**
+     * @brief Updates viewport dimensions
+     * @param width New viewport width
+     * @param height New viewport height
+     */
+    virtual void setViewportSize(float width, float height) = 0;
+};
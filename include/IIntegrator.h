@@ -0,0 +1,189 @@
+/**
+ * @file IIntegrator.h
+ * @brief Abstract interface for time integration schemes
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "PositionPrecision.h"
+#include "Vec2.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @struct IntegratorState
+ * @brief Named per-body arrays an integrator needs to resume exactly where it stopped
+ * 
+ * Arrays are referenced, not copied: when saving they point into the
+ * integrator's own buffers, when restoring into a loaded (possibly memory
+ * mapped) checkpoint. Elements are 4 bytes wide, or 8 for Float64.
+ */
+struct IntegratorState {
+    /** Element type of a state array */
+    enum class ElementType : unsigned { Float32, Int32, Float64 };
+
+    /**
+     * @brief Gets the width of an element
+     * @param type Element type
+     * @return Bytes per element, 0 for an unknown type
+     */
+    static size_t getElementSize(ElementType type) {
+        switch (type) {
+            case ElementType::Float32:
+            case ElementType::Int32: return 4;
+            case ElementType::Float64: return 8;
+            default: return 0;
+        }
+    }
+
+    /** One contiguous array */
+    struct Array {
+        std::string name;    ///< Key, unique within the integrator
+        ElementType type;    ///< Element type
+        const void* data;    ///< First element
+        size_t count;        ///< Number of elements
+    };
+
+    std::vector<Array> arrays;   ///< All arrays of the state
+
+    /** Adds a float array */
+    void add(const std::string& name, const std::vector<float>& values) {
+        arrays.push_back({name, ElementType::Float32, values.data(), values.size()});
+    }
+    /** Adds an integer array */
+    void add(const std::string& name, const std::vector<int>& values) {
+        arrays.push_back({name, ElementType::Int32, values.data(), values.size()});
+    }
+    /** Adds a vector array, stored as interleaved x, y floats */
+    void add(const std::string& name, const std::vector<Vec2>& values) {
+        arrays.push_back({name, ElementType::Float32, values.data(), 2 * values.size()});
+    }
+    /** Adds a double vector array, stored as interleaved x, y doubles */
+    void add(const std::string& name, const std::vector<Vec2d>& values) {
+        static_assert(sizeof(Vec2d) == 2 * sizeof(double), "Vec2d must be two packed doubles");
+        arrays.push_back({name, ElementType::Float64, values.data(), 2 * values.size()});
+    }
+
+    /**
+     * @brief Looks up an array by name and shape
+     * @param name Array key
+     * @param type Required element type
+     * @param count Required element count
+     * @return First element, or null if missing or mismatched
+     */
+    const void* find(const std::string& name, ElementType type, size_t count) const {
+        for (const Array& array : arrays) {
+            if (array.name == name) {
+                return array.type == type && array.count == count ? array.data : nullptr;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * @class IIntegrator
+ * @brief Advances body positions and velocities by one time step
+ * 
+ * GravitySimulation delegates time stepping to an IIntegrator so schemes can
+ * be swapped without touching the force solvers. Integrators call back into
+ * the simulation whenever they need forces for the current positions, which
+ * lets multi-stage schemes evaluate forces several times per step.
+ */
+class IIntegrator {
+public:
+    /**
+     * Computes net forces for the current positions into forces, which the
+     * callee resizes to bodies.size(). A null target list means every body;
+     * otherwise only the listed entries are overwritten.
+     */
+    using ForceEvaluator = std::function<void(const BodyStore& bodies,
+                                              const std::vector<size_t>* targets,
+                                              std::vector<Vec2>& forces)>;
+
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes
+     */
+    virtual ~IIntegrator() = default;
+
+    /**
+     * @brief Advances all bodies by one time step
+     * @param bodies Body state to update in place
+     * @param deltaTime Time step duration
+     * @param evaluateForces Callback computing forces for the current positions
+     */
+    virtual void step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) = 0;
+
+    /**
+     * @brief Discards cached state such as accelerations from the previous step
+     * 
+     * Called when bodies are added or removed or the force law changes.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Marks cached forces stale because positions changed outside step()
+     * 
+     * Called after world bounds, collision bounces or editing moved bodies.
+     * Unlike reset() the extra position precision is kept; schemes without
+     * cached forces ignore it.
+     */
+    virtual void invalidateForces() {}
+
+    /**
+     * @brief Gets the number of force evaluations per step (for cost estimates)
+     * @return Force evaluations performed by one call to step()
+     */
+    virtual int getForceEvaluationsPerStep() const = 0;
+
+    /**
+     * @brief Gets a human readable name for logging
+     * @return Integrator name
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * @brief Lists the cached state that a checkpoint must keep for an exact resume
+     * @param state Receives references to the integrator's buffers, valid until the next step()
+     * 
+     * Stateless schemes add nothing.
+     */
+    virtual void saveState(IntegratorState& state) const { (void)state; }
+
+    /**
+     * @brief Restores state written by saveState()
+     * @param state Arrays loaded from a checkpoint
+     * @param bodyCount Number of bodies the state must describe
+     * @return true if the state was complete; otherwise the integrator is reset
+     *         and rebuilds its caches on the next step
+     */
+    virtual bool restoreState(const IntegratorState& state, size_t bodyCount) {
+        (void)state;
+        (void)bodyCount;
+        reset();
+        return true;
+    }
+
+    /**
+     * @brief Selects the precision positions are accumulated in
+     * @param precision Position precision for the following steps
+     * @return false if the scheme only supports single precision
+     * 
+     * Forces are still computed from the float positions of the body store.
+     */
+    virtual bool setPositionPrecision(PositionPrecision precision) {
+        return precision == PositionPrecision::Single;
+    }
+
+    /**
+     * @brief Gets the precision positions are accumulated in
+     * @return Current position precision
+     */
+    virtual PositionPrecision getPositionPrecision() const {
+        return PositionPrecision::Single;
+    }
+};
@@ -59,6 +59,15 @@ public:
      */
     virtual void swapBuffers() = 0;
     
+    /**
+     * @brief Sets how many vertical blanks swapBuffers() waits for
+     * @param interval 1 to sync to the display, 0 to swap immediately
+     * 
+     * Drivers may override this setting, so callers should not rely on it
+     * alone for frame pacing.
+     */
+    virtual void setSwapInterval(int interval) = 0;
+    
     /**
      * @brief Processes pending window events
      * 
@@ -0,0 +1,240 @@
+/**
+ * @file Integrators.h
+ * @brief Concrete time integration schemes
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IIntegrator.h"
+#include "PositionAccumulator.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class EulerIntegrator
+ * @brief Legacy semi-implicit Euler with light velocity damping
+ * 
+ * First order and not symplectic; the damping keeps it from blowing up at
+ * the cost of slowly draining orbital energy. Kept for comparison with the
+ * original behaviour.
+ */
+class EulerIntegrator : public IIntegrator {
+public:
+    void step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) override;
+    void reset() override { positions.reset(); }
+    int getForceEvaluationsPerStep() const override { return 1; }
+    const char* getName() const override { return "euler"; }
+    void saveState(IntegratorState& state) const override { positions.saveState(state); }
+    bool restoreState(const IntegratorState& state, size_t bodyCount) override;
+    bool setPositionPrecision(PositionPrecision precision) override {
+        positions.setPrecision(precision);
+        return true;
+    }
+    PositionPrecision getPositionPrecision() const override { return positions.getPrecision(); }
+
+private:
+    std::vector<Vec2> forces;    ///< Scratch force buffer
+    PositionAccumulator positions; ///< Adds displacements at the selected precision
+
+    /** Velocity damping per step, as in GravityBody::applyForce */
+    static constexpr float DAMPING_FACTOR = 0.9999f;
+};
+
+/**
+ * @class LeapfrogIntegrator
+ * @brief Second order symplectic kick-drift-kick leapfrog
+ * 
+ * Half kick, full drift, force evaluation, half kick. The accelerations at
+ * the end of a step are reused at the start of the next, so each step costs
+ * a single force evaluation. Energy error stays bounded instead of drifting.
+ */
+class LeapfrogIntegrator : public IIntegrator {
+public:
+    void step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) override;
+    void reset() override {
+        hasForces = false;
+        positions.reset();
+    }
+    void invalidateForces() override { hasForces = false; }
+    int getForceEvaluationsPerStep() const override { return 1; }
+    const char* getName() const override { return "leapfrog"; }
+    void saveState(IntegratorState& state) const override;
+    bool restoreState(const IntegratorState& state, size_t bodyCount) override;
+    bool setPositionPrecision(PositionPrecision precision) override {
+        positions.setPrecision(precision);
+        return true;
+    }
+    PositionPrecision getPositionPrecision() const override { return positions.getPrecision(); }
+
+private:
+    std::vector<Vec2> forces;    ///< Forces at the current positions
+    bool hasForces = false;      ///< forces matches the current positions
+    PositionAccumulator positions; ///< Adds displacements at the selected precision
+};
+
+/**
+ * @class VelocityVerletIntegrator
+ * @brief Second order symplectic velocity Verlet
+ * 
+ * Position update from the current velocity and acceleration, then a
+ * velocity update from the average of the old and new accelerations.
+ * One force evaluation per step with cached accelerations.
+ */
+class VelocityVerletIntegrator : public IIntegrator {
+public:
+    void step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) override;
+    void reset() override {
+        hasForces = false;
+        positions.reset();
+    }
+    void invalidateForces() override { hasForces = false; }
+    int getForceEvaluationsPerStep() const override { return 1; }
+    const char* getName() const override { return "verlet"; }
+    void saveState(IntegratorState& state) const override;
+    bool restoreState(const IntegratorState& state, size_t bodyCount) override;
+    bool setPositionPrecision(PositionPrecision precision) override {
+        positions.setPrecision(precision);
+        return true;
+    }
+    PositionPrecision getPositionPrecision() const override { return positions.getPrecision(); }
+
+private:
+    std::vector<Vec2> forces;    ///< Forces at the current positions
+    std::vector<Vec2> newForces; ///< Forces at the updated positions
+    bool hasForces = false;      ///< forces matches the current positions
+    PositionAccumulator positions; ///< Adds displacements at the selected precision
+};
+
+/**
+ * @class YoshidaIntegrator
+ * @brief Fourth order symplectic Yoshida integrator
+ * 
+ * Composes three leapfrog sub-steps with weights chosen to cancel the
+ * second order error terms: four drifts and three kicks per step, i.e.
+ * three force evaluations. Much smaller energy error than leapfrog at the
+ * same step size, so far larger steps are possible for a given accuracy.
+ */
+class YoshidaIntegrator : public IIntegrator {
+public:
+    void step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) override;
+    void reset() override { positions.reset(); }
+    int getForceEvaluationsPerStep() const override { return 3; }
+    const char* getName() const override { return "yoshida4"; }
+    void saveState(IntegratorState& state) const override { positions.saveState(state); }
+    bool restoreState(const IntegratorState& state, size_t bodyCount) override;
+    bool setPositionPrecision(PositionPrecision precision) override {
+        positions.setPrecision(precision);
+        return true;
+    }
+    PositionPrecision getPositionPrecision() const override { return positions.getPrecision(); }
+
+private:
+    std::vector<Vec2> forces;    ///< Scratch force buffer
+    PositionAccumulator positions; ///< Adds displacements at the selected precision
+};
+
+/**
+ * @class BlockTimestepIntegrator
+ * @brief Kick-drift-kick leapfrog with individual power-of-two timesteps
+ * 
+ * Each body is assigned a level l and advances with step deltaTime / 2^l,
+ * chosen from its acceleration a and jerk j (estimated from the change in
+ * acceleration over its last step) as accuracy * |a| / |j|, further limited
+ * by sqrt(2 * accuracy * softening / |a|). Bodies in deep potential wells
+ * substep while slow outer bodies take the whole frame in one step.
+ * 
+ * All bodies drift together to the next time at which some body's step
+ * ends; only those bodies (the active set) get new forces and are kicked.
+ * Steps are aligned to their own size, so every body is synchronised again
+ * at the end of step(). A body may move to a finer level at any of its step
+ * boundaries but to a coarser one only by one level at a time and only when
+ * the coarser step would start at that boundary.
+ */
+class BlockTimestepIntegrator : public IIntegrator {
+public:
+    /**
+     * @brief Constructs a block timestep integrator
+     * @param maxLevel Finest level; the smallest step is deltaTime / 2^maxLevel
+     * @param accuracy Dimensionless timestep factor (smaller is more accurate)
+     */
+    explicit BlockTimestepIntegrator(int maxLevel = 8, float accuracy = 0.02f);
+
+    void step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) override;
+    void reset() override {
+        hasForces = false;
+        positions.reset();
+    }
+    void invalidateForces() override { hasForces = false; }
+    int getForceEvaluationsPerStep() const override { return 1; }
+    const char* getName() const override { return "block"; }
+    void saveState(IntegratorState& state) const override;
+    bool restoreState(const IntegratorState& state, size_t bodyCount) override;
+    bool setPositionPrecision(PositionPrecision precision) override {
+        positions.setPrecision(precision);
+        return true;
+    }
+    PositionPrecision getPositionPrecision() const override { return positions.getPrecision(); }
+
+    /**
+     * @brief Gets the current timestep level of every body
+     * @return Levels indexed by body (0 = full frame step)
+     */
+    const std::vector<int>& getLevels() const { return levels; }
+
+    /**
+     * @brief Gets the number of per-body force evaluations done by the last step
+     * @return Sum of active set sizes over all force evaluations
+     * 
+     * A shared-timestep integrator running every body at the finest level in
+     * use would need bodies.size() * 2^maxUsedLevel evaluations.
+     */
+    size_t getLastBodyEvaluationCount() const { return lastBodyEvaluations; }
+
+    /**
+     * @brief Gets the number of force solver calls made by the last step
+     * @return Number of active set evaluations
+     */
+    size_t getLastSubstepCount() const { return lastSubsteps; }
+
+private:
+    int maxLevel;                       ///< Finest allowed level
+    float accuracy;                     ///< Timestep factor (eta)
+    std::vector<Vec2> forces;           ///< Forces at each body's last kick
+    std::vector<Vec2> lastAcceleration; ///< Acceleration before the last force update
+    std::vector<float> lastStepLength;  ///< Duration of each body's last step (0 = unknown)
+    std::vector<int> levels;            ///< Current level of each body
+    std::vector<size_t> active;         ///< Bodies whose step ends at the current time
+    bool hasForces = false;             ///< forces/levels match the current bodies
+    size_t lastBodyEvaluations = 0;     ///< Per-body force evaluations in the last step
+    size_t lastSubsteps = 0;            ///< Active set evaluations in the last step
+    PositionAccumulator positions;      ///< Adds displacements at the selected precision
+
+    /** Levels deeper than this would overflow the integer tick counter */
+    static constexpr int MAX_SUPPORTED_LEVEL = 30;
+
+    /**
+     * @brief Picks the level matching a body's desired timestep
+     * @param bodies Body state with the body's current force in forces
+     * @param body Body index
+     * @param deltaTime Full frame step
+     * @return Level in [0, maxLevel]
+     */
+    int chooseLevel(const BodyStore& bodies, size_t body, float deltaTime) const;
+
+    /**
+     * @brief Records the previous acceleration and step length before new forces arrive
+     * @param bodies Body state
+     * @param body Body index
+     * @param stepLength Duration of the step that just ended
+     */
+    void rememberAcceleration(const BodyStore& bodies, size_t body, float stepLength);
+};
+
+/**
+ * @brief Creates an integrator from its command line name
+ * @param name "euler", "leapfrog", "verlet", "yoshida4" or "block"
+ * @return Integrator instance, or nullptr when the name is unknown
+ */
+std::unique_ptr<IIntegrator> createIntegrator(const std::string& name);
@@ -0,0 +1,71 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Maps a file into memory read-only so it can be used in place
+ *
+ * Pages are loaded lazily by the OS on first access, so opening a large file
+ * is cheap and only the parts that are read cost I/O. Uses mmap on POSIX and
+ * a file mapping object on Windows. Movable, not copyable.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    /**
+     * @brief Unmaps the file
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Maps a file, replacing any previous mapping
+     * @param path File to map
+     * @return true on success; errors are reported on std::cerr
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the file (safe to call when nothing is mapped)
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a file is mapped
+     * @return true if data() is valid
+     */
+    bool isOpen() const { return mapping != nullptr; }
+
+    /**
+     * @brief Gets the first byte of the mapped file
+     * @return Pointer valid until close(), or null
+     */
+    const unsigned char* data() const { return static_cast<const unsigned char*>(mapping); }
+
+    /**
+     * @brief Gets the mapped size
+     * @return File size in bytes
+     */
+    size_t size() const { return mappedSize; }
+
+private:
+    void* mapping = nullptr;       ///< Start of the view
+    size_t mappedSize = 0;         ///< Bytes mapped
+#ifdef _WIN32
+    void* fileHandle = nullptr;    ///< HANDLE of the open file
+    void* mappingHandle = nullptr; ///< HANDLE of the file mapping object
+#endif
+};
@@ -0,0 +1,159 @@
+/**
+ * @file Mat4.h
+ * @brief 4x4 matrix utilities for shader-based rendering
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <cmath>
+
+/**
+ * @struct Mat4
+ * @brief Column-major 4x4 float matrix, laid out as OpenGL expects
+ *
+ * Provides the handful of constructors that mirror the fixed-function calls
+ * the legacy renderer uses (glTranslatef, glRotatef, glFrustum, glOrtho), so the
+ * core-profile renderer produces exactly the same transforms.
+ */
+struct Mat4 {
+    float m[16];  ///< Elements in column-major order: m[column * 4 + row]
+
+    /**
+     * @brief Default constructor initializes to the identity matrix
+     */
+    Mat4() : m{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1} {}
+
+    /**
+     * @brief Gets a pointer suitable for glUniformMatrix4fv / glMultMatrixf
+     * @return Pointer to the 16 column-major elements
+     */
+    const float* data() const {
+        return m;
+    }
+
+    /**
+     * @brief Matrix multiplication operator
+     * @param other Matrix applied first
+     * @return this * other
+     */
+    Mat4 operator*(const Mat4& other) const {
+        Mat4 result;
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    sum += m[k * 4 + row] * other.m[column * 4 + k];
+                }
+                result.m[column * 4 + row] = sum;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Creates a translation matrix (as glTranslatef)
+     * @param x Translation along X
+     * @param y Translation along Y
+     * @param z Translation along Z
+     * @return Translation matrix
+     */
+    static Mat4 translation(float x, float y, float z) {
+        Mat4 result;
+        result.m[12] = x;
+        result.m[13] = y;
+        result.m[14] = z;
+        return result;
+    }
+
+    /**
+     * @brief Creates a rotation matrix (as glRotatef)
+     * @param angleDegrees Rotation angle in degrees, counter-clockwise about the axis
+     * @param x Axis X component
+     * @param y Axis Y component
+     * @param z Axis Z component
+     * @return Rotation matrix
+     */
+    static Mat4 rotation(float angleDegrees, float x, float y, float z) {
+        float length = std::sqrt(x * x + y * y + z * z);
+        if (length == 0.0f) return Mat4();
+        x /= length;
+        y /= length;
+        z /= length;
+
+        float radians = angleDegrees * 3.14159265358979323846f / 180.0f;
+        float c = std::cos(radians);
+        float s = std::sin(radians);
+        float t = 1.0f - c;
+
+        Mat4 result;
+        result.m[0] = x * x * t + c;
+        result.m[1] = y * x * t + z * s;
+        result.m[2] = x * z * t - y * s;
+        result.m[4] = x * y * t - z * s;
+        result.m[5] = y * y * t + c;
+        result.m[6] = y * z * t + x * s;
+        result.m[8] = x * z * t + y * s;
+        result.m[9] = y * z * t - x * s;
+        result.m[10] = z * z * t + c;
+        return result;
+    }
+
+    /**
+     * @brief Creates a perspective projection from frustum planes (as glFrustum)
+     * @param left Left clipping plane at the near distance
+     * @param right Right clipping plane at the near distance
+     * @param bottom Bottom clipping plane at the near distance
+     * @param top Top clipping plane at the near distance
+     * @param zNear Distance to the near plane (> 0)
+     * @param zFar Distance to the far plane
+     * @return Projection matrix
+     */
+    static Mat4 frustum(float left, float right, float bottom, float top, float zNear, float zFar) {
+        Mat4 result;
+        result.m[0] = 2.0f * zNear / (right - left);
+        result.m[5] = 2.0f * zNear / (top - bottom);
+        result.m[8] = (right + left) / (right - left);
+        result.m[9] = (top + bottom) / (top - bottom);
+        result.m[10] = -(zFar + zNear) / (zFar - zNear);
+        result.m[11] = -1.0f;
+        result.m[14] = -2.0f * zFar * zNear / (zFar - zNear);
+        result.m[15] = 0.0f;
+        return result;
+    }
+
+    /**
+     * @brief Creates a parallel projection (as glOrtho)
+     * @param left Left clipping plane
+     * @param right Right clipping plane
+     * @param bottom Bottom clipping plane
+     * @param top Top clipping plane
+     * @param zNear Near clipping plane
+     * @param zFar Far clipping plane
+     * @return Projection matrix
+     */
+    static Mat4 orthographic(float left, float right, float bottom, float top, float zNear, float zFar) {
+        Mat4 result;
+        result.m[0] = 2.0f / (right - left);
+        result.m[5] = 2.0f / (top - bottom);
+        result.m[10] = -2.0f / (zFar - zNear);
+        result.m[12] = -(right + left) / (right - left);
+        result.m[13] = -(top + bottom) / (top - bottom);
+        result.m[14] = -(zFar + zNear) / (zFar - zNear);
+        return result;
+    }
+
+    /**
+     * @brief Creates a symmetric perspective projection
+     * @param fovyDegrees Vertical field of view in degrees
+     * @param aspect Viewport width divided by height
+     * @param zNear Distance to the near plane (> 0)
+     * @param zFar Distance to the far plane
+     * @return Projection matrix
+     */
+    static Mat4 perspective(float fovyDegrees, float aspect, float zNear, float zFar) {
+        float halfHeight = std::tan(fovyDegrees * 3.14159265358979323846f / 360.0f) * zNear;
+        float halfWidth = halfHeight * aspect;
+        return frustum(-halfWidth, halfWidth, -halfHeight, halfHeight, zNear, zFar);
+    }
+};
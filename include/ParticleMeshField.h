@@ -0,0 +1,95 @@
+/**
+ * @file ParticleMeshField.h
+ * @brief FFT based particle-mesh evaluation of the gravity field on a regular grid
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "FFT.h"
+#include "FrameArena.h"
+#include "ThreadPool.h"
+#include "Vec2.h"
+#include <vector>
+
+/**
+ * @class ParticleMeshField
+ * @brief Computes the field of all bodies at every grid point in O(G log G)
+ *
+ * Masses are deposited onto the grid points with cloud-in-cell weights, and
+ * the field is the convolution of that density with the force kernel, the
+ * analytic gradient of the softened -G/r potential. The convolution is done
+ * with FFTs over a zero-padded domain at least twice the grid size, so the
+ * result is the isolated (non-periodic) field rather than that of a periodic
+ * lattice of copies. The kernel's transform is computed once; each update is
+ * a deposit, one forward and one inverse 2D FFT of Fx + i*Fy.
+ *
+ * The cost does not depend on the number of bodies. Bodies closer than about
+ * one grid spacing are smoothed by the deposit, and the per-body force clamp
+ * of the direct sum is applied to the summed field instead.
+ */
+class ParticleMeshField {
+public:
+    /**
+     * @brief Prepares the padded FFT domain and kernel transform
+     * @param gridWidth Grid points along x
+     * @param gridHeight Grid points along y
+     * @param spacingX World distance between neighbouring points along x
+     * @param spacingY World distance between neighbouring points along y
+     */
+    ParticleMeshField(int gridWidth, int gridHeight, float spacingX, float spacingY);
+
+    /**
+     * @brief Computes the field force on a unit mass at every grid point
+     * @param bodies Body store providing the attracting masses
+     * @param gravitationalConstant G constant for force calculations
+     * @param forces Output array of gridWidth * gridHeight forces, row-major (overwritten)
+     * @param threadPool Pool to spread the FFT passes over (null runs on the calling thread)
+     * @param arena Scratch for the column passes, with a lane for every pool thread
+     *
+     * Grid point (x, y) sits at world position (x * spacingX, y * spacingY);
+     * bodies outside the grid are deposited on its nearest edge.
+     */
+    void compute(const BodyStore& bodies, float gravitationalConstant, Vec2* forces,
+                 ThreadPool* threadPool, FrameArena& arena);
+
+private:
+    using Complex = FFT::Complex;
+
+    int gridWidth, gridHeight;           ///< Output grid size
+    float spacingX, spacingY;            ///< Grid spacing in world units
+    FFT rowTransform;                    ///< Transform along x (padded width)
+    FFT columnTransform;                 ///< Transform along y (padded height)
+    std::vector<Complex> kernelSpectrum; ///< FFT of Kx + i*Ky, pre-divided by the domain size
+    std::vector<Complex> workspace;      ///< Padded density, then its spectrum, then the field
+
+    /** Columns transformed per parallel task */
+    static constexpr size_t COLUMNS_PER_TASK = 16;
+
+    /**
+     * @brief Transforms the padded domain in 2D
+     * @param data Padded row-major values
+     * @param inverse true for the inverse transform
+     * @param activeRows Leading rows that are non-zero (forward) or needed afterwards (inverse)
+     * @param threadPool Pool to spread rows and columns over
+     * @param arena Scratch for the gathered column blocks
+     *
+     * The density only occupies the first gridHeight rows and only those rows
+     * of the field are read, so the row pass skips the rest of the padding.
+     */
+    void transform2D(Complex* data, bool inverse, size_t activeRows, ThreadPool* threadPool,
+                     FrameArena& arena) const;
+
+    /**
+     * @brief Gets the padded width
+     * @return Row length of the padded domain
+     */
+    size_t paddedWidth() const { return rowTransform.getSize(); }
+
+    /**
+     * @brief Gets the padded height
+     * @return Number of rows of the padded domain
+     */
+    size_t paddedHeight() const { return columnTransform.getSize(); }
+};
@@ -0,0 +1,147 @@
+/**
+ * @file PositionAccumulator.h
+ * @brief Adds per-step displacements to body positions at a chosen precision
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "IIntegrator.h"
+#include "PositionPrecision.h"
+#include "Vec2.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class PositionAccumulator
+ * @brief Owns the extra position bits an integrator keeps between steps
+ *
+ * A float coordinate near 4000 resolves about 0.0002 world units, so the
+ * small displacement of a slow body loses most of its digits each step and
+ * orbits drift over long runs. Integrators route every position update
+ * through advance(), which either adds in float as before, keeps each
+ * rounded-off remainder in a Kahan residual that is added back next step,
+ * or keeps a double copy of every position. Either way the body store is
+ * left holding the float rounding of the accurate position, so the force
+ * kernels run unchanged at full float SIMD width.
+ *
+ * Positions written by anyone else (world bounds, collisions, editing) are
+ * picked up on the next step: the double copy is resynchronised whenever it
+ * no longer rounds to the stored float, and a stale residual is below the
+ * float's own resolution. The compensated sum assumes, as for positions
+ * against per-step displacements, that the coordinate is the larger term.
+ * The code must not be built with -ffast-math, which would fold both away.
+ */
+class PositionAccumulator {
+public:
+    /**
+     * @brief Selects the precision; switching discards the accumulated bits
+     * @param newPrecision Precision for the following steps
+     */
+    void setPrecision(PositionPrecision newPrecision) {
+        if (newPrecision != precision) reset();
+        precision = newPrecision;
+    }
+
+    /**
+     * @brief Gets the current precision
+     * @return Position precision
+     */
+    PositionPrecision getPrecision() const { return precision; }
+
+    /**
+     * @brief Discards the accumulated bits (e.g. after bodies were removed)
+     */
+    void reset() {
+        residuals.clear();
+        precise.clear();
+    }
+
+    /**
+     * @brief Adds a displacement to every body's position
+     * @param bodies Body store whose x/y are updated
+     * @param displacement Callable returning the Vec2 displacement of body i
+     */
+    template <class Displacement>
+    void advance(BodyStore& bodies, const Displacement& displacement) {
+        const size_t count = bodies.size();
+        float* xs = bodies.x.data();
+        float* ys = bodies.y.data();
+
+        if (precision == PositionPrecision::Single) {
+            for (size_t i = 0; i < count; ++i) {
+                Vec2 delta = displacement(i);
+                xs[i] += delta.x;
+                ys[i] += delta.y;
+            }
+        } else if (precision == PositionPrecision::Compensated) {
+            if (residuals.size() != count) residuals.assign(count, Vec2());
+            Vec2* residual = residuals.data();
+            for (size_t i = 0; i < count; ++i) {
+                Vec2 delta = displacement(i);
+                // Fast2Sum: what the rounded sum lost is carried into the next step
+                float addX = delta.x + residual[i].x;
+                float addY = delta.y + residual[i].y;
+                float sumX = xs[i] + addX;
+                float sumY = ys[i] + addY;
+                residual[i].x = addX - (sumX - xs[i]);
+                residual[i].y = addY - (sumY - ys[i]);
+                xs[i] = sumX;
+                ys[i] = sumY;
+            }
+        } else {
+            synchronizePrecise(bodies);
+            Vec2d* position = precise.data();
+            for (size_t i = 0; i < count; ++i) {
+                Vec2 delta = displacement(i);
+                if (static_cast<float>(position[i].x) != xs[i]) position[i].x = xs[i];
+                if (static_cast<float>(position[i].y) != ys[i]) position[i].y = ys[i];
+                position[i].x += delta.x;
+                position[i].y += delta.y;
+                xs[i] = static_cast<float>(position[i].x);
+                ys[i] = static_cast<float>(position[i].y);
+            }
+        }
+    }
+
+    /**
+     * @brief Moves every body along its velocity: x += v * dt
+     * @param bodies Body store whose x/y are updated
+     * @param deltaTime Drift duration
+     */
+    void drift(BodyStore& bodies, float deltaTime) {
+        const float* vxs = bodies.vx.data();
+        const float* vys = bodies.vy.data();
+        advance(bodies, [&](size_t i) { return Vec2(vxs[i] * deltaTime, vys[i] * deltaTime); });
+    }
+
+    /**
+     * @brief Adds the accumulated bits to an integrator checkpoint
+     * @param state Receives "positionResidual" (compensated: the Kahan residual per body)
+     *              or "positionPrecise" (double: the full double position per body)
+     *
+     * Nothing is added in single precision.
+     */
+    void saveState(IntegratorState& state) const;
+
+    /**
+     * @brief Takes the accumulated bits back from a checkpoint
+     * @param state Arrays saved by saveState()
+     * @param bodyCount Number of bodies the state must describe
+     *
+     * A missing or mis-sized array just restarts from the stored floats.
+     */
+    void restoreState(const IntegratorState& state, size_t bodyCount);
+
+private:
+    PositionPrecision precision = PositionPrecision::Single;  ///< Current mode
+    std::vector<Vec2> residuals;           ///< Kahan residuals (compensated mode)
+    std::vector<Vec2d> precise;            ///< Double positions (double mode)
+
+    /**
+     * @brief Sizes the double positions to the store, seeding them from the floats
+     * @param bodies Body store
+     */
+    void synchronizePrecise(const BodyStore& bodies);
+};
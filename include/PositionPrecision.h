@@ -0,0 +1,56 @@
+/**
+ * @file PositionPrecision.h
+ * @brief Precision in which body positions are accumulated
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <string>
+
+/**
+ * @enum PositionPrecision
+ * @brief How integrators add each step's displacement to the positions
+ *
+ * The body store always holds float positions, which is what the force
+ * kernels, grid and renderers read, so separations and forces stay in
+ * single precision whatever is chosen here. The modes only differ in how much
+ * of each displacement survives being added to a large coordinate.
+ */
+enum class PositionPrecision {
+    Single,       ///< x += dx in float (rounding error grows with the step count)
+    Compensated,  ///< Float with a per-body Kahan residual carrying the rounded-off part
+    Double        ///< Per-body double positions, rounded into the store after every step
+};
+
+/**
+ * @brief Gets a printable name for a position precision
+ * @param precision Precision to name
+ * @return "single", "compensated" or "double"
+ */
+inline const char* getPositionPrecisionName(PositionPrecision precision) {
+    switch (precision) {
+    case PositionPrecision::Compensated: return "compensated";
+    case PositionPrecision::Double: return "double";
+    default: return "single";
+    }
+}
+
+/**
+ * @brief Parses a position precision from its name
+ * @param name "single", "compensated" or "double"
+ * @param precision Receives the parsed precision
+ * @return false (and precision is unchanged) when the name is unknown
+ */
+inline bool parsePositionPrecision(const std::string& name, PositionPrecision& precision) {
+    if (name == "single") {
+        precision = PositionPrecision::Single;
+    } else if (name == "compensated") {
+        precision = PositionPrecision::Compensated;
+    } else if (name == "double") {
+        precision = PositionPrecision::Double;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file Profiler.h
+ * @brief Per-phase CPU and GPU frame timing with a Chrome trace export
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "IGpuTimer.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class Profiler
+ * @brief Collects how long each phase of a frame takes
+ *
+ * Code under measurement opens a Profiler::Scope around a phase. Scopes are
+ * cheap (two clock reads and a short lock) and do nothing while the profiler
+ * is disabled or the pointer is null, so components keep a nullable
+ * Profiler* injected at setup. CPU scopes may close on any thread; the
+ * simulation thread's ticks of a frame are summed into that frame.
+ *
+ * GPU scopes also bracket the phase with timestamp queries of an injected
+ * IGpuTimer, so the profiler itself has no GL dependency. Results are read
+ * GPU_LATENCY_FRAMES frames later, only once available, so measuring never
+ * stalls the pipeline; the GPU times of a frame fill in late.
+ *
+ * The last HISTORY_FRAMES frames are kept as FrameStats in a ring buffer for
+ * the on-screen graph, and the last TRACE_CAPACITY scopes as trace events
+ * that writeChromeTrace() exports for chrome://tracing or Perfetto.
+ *
+ * beginFrame(), endFrame(), GPU scopes and the getters belong to the thread
+ * owning the GL context.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Measured phases of a frame
+     */
+    enum class Phase {
+        Bodies,         ///< GravitySimulation::updateBodies (or the GPU step)
+        Grid,           ///< GravityGrid::updateGrid (or the GPU field kernel)
+        GridRender,     ///< Drawing the spacetime grid
+        BodyRender,     ///< Drawing the bodies
+        UI,             ///< Building and drawing the UI overlay
+        Swap,           ///< Presenting the frame
+        Count
+    };
+
+    /** Number of measured phases */
+    static constexpr size_t PHASE_COUNT = static_cast<size_t>(Phase::Count);
+
+    /**
+     * @struct FrameStats
+     * @brief Timings of one frame in milliseconds
+     */
+    struct FrameStats {
+        uint64_t frameNumber = 0;                 ///< Frame counter at beginFrame()
+        float frameMs = 0.0f;                     ///< beginFrame() to endFrame()
+        float intervalMs = 0.0f;                  ///< Since the previous beginFrame() (1000 / FPS)
+        std::array<float, PHASE_COUNT> cpuMs{};   ///< CPU time per phase
+        std::array<float, PHASE_COUNT> gpuMs{};   ///< GPU time per phase (GPU scopes only)
+        bool hasGpuTimes = false;                 ///< gpuMs has been filled in
+    };
+
+    /**
+     * @class Scope
+     * @brief Times a phase from construction to destruction
+     */
+    class Scope {
+    public:
+        /**
+         * @brief Starts timing
+         * @param profiler Profiler to report to (may be null)
+         * @param phase Phase being measured
+         * @param gpu Also time the GL commands issued inside the scope (GL thread only)
+         */
+        Scope(Profiler* profiler, Phase phase, bool gpu = false);
+
+        /**
+         * @brief Stops timing and records the phase
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Profiler* profiler;                                  ///< Null when not measuring
+        Phase phase;                                         ///< Phase being measured
+        int gpuQuery = -1;                                   ///< GPU scope slot, or -1
+        std::chrono::steady_clock::time_point start;         ///< CPU start time
+    };
+
+    /**
+     * @brief Creates a disabled profiler
+     */
+    Profiler();
+
+    /**
+     * @brief Releases the GPU timer (needs its context if one was set)
+     */
+    ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * @brief Creates the timestamp queries of a GPU timer and takes it over
+     * @param timer Timer on the current context, e.g. GpuTimer
+     * @return true if GPU scopes will be timed; otherwise the timer is dropped
+     */
+    bool initializeGpuTimers(std::unique_ptr<IGpuTimer> timer);
+
+    /**
+     * @brief Turns measuring on or off
+     * @param enabled true to record scopes
+     */
+    void setEnabled(bool enabled) {
+        this->enabled.store(enabled);
+    }
+
+    /**
+     * @brief Checks whether scopes are recorded
+     * @return true if enabled
+     */
+    bool isEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Starts a frame and collects GPU results that have become available
+     */
+    void beginFrame();
+
+    /**
+     * @brief Ends the frame and appends it to the history
+     */
+    void endFrame();
+
+    /**
+     * @brief Gets the number of frames in the history
+     * @return Up to HISTORY_FRAMES
+     */
+    size_t getFrameCount() const {
+        return frameCount;
+    }
+
+    /**
+     * @brief Gets a recorded frame
+     * @param age 0 for the newest frame, up to getFrameCount() - 1
+     * @return Frame timings
+     */
+    const FrameStats& getFrame(size_t age) const;
+
+    /**
+     * @brief Averages the newest frames
+     * @param frames Number of frames to average (clamped to the history)
+     * @return Mean timings; GPU times average the frames that have them
+     */
+    FrameStats getAverage(size_t frames) const;
+
+    /**
+     * @brief Writes the recorded trace events as Chrome trace JSON
+     * @param path Output file
+     * @return true if the file was written
+     */
+    bool writeChromeTrace(const std::string& path) const;
+
+    /**
+     * @brief Gets the display name of a phase
+     * @param phase Phase
+     * @return Name used in the overlay and the trace
+     */
+    static const char* getPhaseName(Phase phase);
+
+    /** Frames kept for the graph */
+    static constexpr size_t HISTORY_FRAMES = 240;
+
+    /** Trace events kept for writeChromeTrace() */
+    static constexpr size_t TRACE_CAPACITY = 65536;
+
+    /** Frames between issuing GPU queries and reading them back */
+    static constexpr size_t GPU_LATENCY_FRAMES = 4;
+
+    /** GPU scopes timed per frame; further ones are only timed on the CPU */
+    static constexpr size_t GPU_SCOPES_PER_FRAME = 16;
+
+private:
+    /**
+     * @struct TraceEvent
+     * @brief One completed scope
+     */
+    struct TraceEvent {
+        const char* name;       ///< Phase or "frame"
+        uint32_t thread;        ///< Trace thread id (0 = GPU)
+        double startUs;         ///< Start time since the profiler was created
+        double durationUs;      ///< Duration
+    };
+
+    /**
+     * @struct GpuScope
+     * @brief Timestamp query pair of one GPU scope
+     */
+    struct GpuScope {
+        size_t queries[2];      ///< Start and end query indices in the GPU timer
+        Phase phase;            ///< Phase measured
+    };
+
+    /**
+     * @struct GpuFrame
+     * @brief GPU scopes issued during one frame
+     */
+    struct GpuFrame {
+        std::array<GpuScope, GPU_SCOPES_PER_FRAME> scopes;
+        size_t scopeCount = 0;  ///< Scopes issued
+        uint64_t frameNumber = 0; ///< Frame they belong to
+    };
+
+    std::atomic<bool> enabled;                        ///< Scopes are recorded
+    std::chrono::steady_clock::time_point epoch;      ///< Zero of the trace time line
+    std::thread::id ownerThread;                      ///< Thread calling beginFrame()
+
+    // Frame history ring (GL thread only)
+    std::vector<FrameStats> history;
+    size_t newestFrame = 0;
+    size_t frameCount = 0;
+    uint64_t frameNumber = 0;
+    bool inFrame = false;
+    std::chrono::steady_clock::time_point frameStart;
+    std::chrono::steady_clock::time_point previousFrameStart;
+
+    // Shared with scopes closing on other threads
+    mutable std::mutex mutex;
+    std::array<float, PHASE_COUNT> currentCpuMs{};    ///< Phase totals of the frame in progress
+    std::vector<TraceEvent> trace;                    ///< Trace event ring
+    size_t traceNext = 0;                             ///< Next slot to overwrite
+    bool traceWrapped = false;                        ///< trace is full and wrapping
+    std::vector<std::thread::id> threadIds;           ///< Trace thread id - 1 per thread seen
+
+    // GPU timing (GL thread only)
+    std::unique_ptr<IGpuTimer> gpuTimer;              ///< Null while GPU scopes are not timed
+    std::array<GpuFrame, GPU_LATENCY_FRAMES> gpuFrames;
+    double gpuClockOffsetUs = 0.0;                    ///< GPU timestamp to trace time
+
+    /**
+     * @brief Reserves a GPU scope slot and issues its start query
+     * @param phase Phase measured
+     * @return Slot index, or -1 if GPU timing is unavailable or the frame is full
+     */
+    int beginGpuScope(Phase phase);
+
+    /**
+     * @brief Issues the end query of a GPU scope
+     * @param slot Slot from beginGpuScope()
+     */
+    void endGpuScope(int slot);
+
+    /**
+     * @brief Reads back the queries of a GPU frame if the GPU has finished it
+     * @param gpuFrame Frame slot to collect
+     */
+    void collectGpuFrame(GpuFrame& gpuFrame);
+
+    /**
+     * @brief Records a completed CPU scope
+     */
+    void recordCpu(Phase phase, std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point end);
+
+    /**
+     * @brief Appends a trace event (caller holds the mutex)
+     */
+    void pushTraceEvent(const TraceEvent& event);
+
+    /**
+     * @brief Gets the trace thread id of the calling thread (caller holds the mutex)
+     * @return 1 for the first thread seen, 2 for the next, ...
+     */
+    uint32_t traceThreadId();
+
+    /**
+     * @brief Converts a time point to microseconds since the epoch
+     */
+    double toTraceUs(std::chrono::steady_clock::time_point time) const {
+        return std::chrono::duration<double, std::micro>(time - epoch).count();
+    }
+};
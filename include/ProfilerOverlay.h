@@ -0,0 +1,63 @@
+/**
+ * @file ProfilerOverlay.h
+ * @brief On-screen frame graph of the Profiler's timings
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "Profiler.h"
+#include "UIRenderer.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ProfilerOverlay
+ * @brief Draws recent frame timings through UIRenderer
+ *
+ * The panel in the top-right corner shows one stacked bar of per-phase CPU
+ * time per frame for the last GRAPH_FRAMES frames, a white tick at the GPU
+ * total (once GPU times are in), guides at 60 and 30 FPS and a legend with
+ * phase averages. The legend text is refreshed every TEXT_REFRESH_FRAMES
+ * frames so it stays readable and UIRenderer's layout cache stays small.
+ *
+ * Must be drawn between UIRenderer::beginUIMode() and endUIMode().
+ */
+class ProfilerOverlay {
+public:
+    /**
+     * @brief Queues the panel into the UI batch
+     * @param ui UI renderer in UI mode
+     * @param profiler Profiler to show
+     */
+    void render(UIRenderer& ui, const Profiler& profiler);
+
+    /** Frames drawn as bars, one pixel wide each */
+    static constexpr size_t GRAPH_FRAMES = 220;
+
+    /** Milliseconds covered by the graph height */
+    static constexpr float GRAPH_RANGE_MS = 40.0f;
+
+    /** Frames averaged for the legend */
+    static constexpr size_t AVERAGE_FRAMES = 30;
+
+    /** Frames between legend updates */
+    static constexpr uint64_t TEXT_REFRESH_FRAMES = 15;
+
+private:
+    std::vector<std::string> legend;          ///< Header line, then one line per phase
+    uint64_t legendFrame = 0;                 ///< Frame the legend was built for
+    bool hasLegend = false;                   ///< legend has been built
+
+    /**
+     * @brief Rebuilds the legend text from the profiler's averages
+     */
+    void updateLegend(const Profiler& profiler);
+
+    static constexpr float PANEL_MARGIN = 10.0f;
+    static constexpr float PANEL_PADDING = 6.0f;
+    static constexpr float GRAPH_HEIGHT = 80.0f;
+    static constexpr float LINE_HEIGHT = 14.0f;
+    static constexpr float SWATCH_SIZE = 8.0f;
+};
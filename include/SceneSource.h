@@ -0,0 +1,65 @@
+/**
+ * @file SceneSource.h
+ * @brief Resolves which grid and bodies a renderer should draw this frame
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "GravityGrid.h"
+#include "BodyStore.h"
+#include "SimulationSnapshot.h"
+#include "TripleBuffer.h"
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class SceneSource
+ * @brief Data source shared by the renderer backends
+ *
+ * Renders either the grid and body store shared with the simulation, or,
+ * when a simulation thread is attached, the newest published snapshot with
+ * body positions interpolated between its previous and current tick. With
+ * a thread attached the shared store is never read, since the thread writes
+ * it; frames before the first snapshot are empty.
+ *
+ * Nothing is copied for the shared store: renderers read it in place and
+ * compare BodyStore::version and GravityGrid::getVersion() with what they
+ * last uploaded, so bodies added at any time show up on the next frame and
+ * unchanged state is not uploaded again.
+ */
+class SceneSource {
+public:
+    /**
+     * @brief Grid and bodies to draw for one frame (either may be null)
+     */
+    struct Frame {
+        const GravityGrid* grid = nullptr;
+        const BodyStore* bodies = nullptr;
+    };
+
+    void setGravityGrid(std::shared_ptr<GravityGrid> grid) { gravityGrid = grid; }
+    void setBodyStore(std::shared_ptr<const BodyStore> store) { bodyStore = store; }
+    void setSnapshotSource(TripleBuffer<SimulationSnapshot>* source) { snapshotSource = source; }
+
+    /**
+     * @brief Picks up the newest snapshot if one is attached
+     * @return Grid and bodies valid until the next call; both null while an
+     *         attached snapshot source has not published yet
+     */
+    Frame acquire();
+
+private:
+    std::shared_ptr<GravityGrid> gravityGrid;                   ///< Grid shared with the simulation
+    std::shared_ptr<const BodyStore> bodyStore;                 ///< Bodies shared with the simulation
+    TripleBuffer<SimulationSnapshot>* snapshotSource = nullptr; ///< Threaded simulation output (optional)
+    BodyStore interpolatedBodies;                               ///< Bodies blended between snapshot states
+    uint64_t interpolatedSource = 0;                            ///< Version of the snapshot bodies blended last
+    float interpolatedAlpha = -1.0f;                            ///< Interpolation factor blended last
+
+    /**
+     * @brief Blends snapshot body positions between the previous and current tick
+     * @param snapshot Snapshot to interpolate
+     */
+    void interpolateBodies(const SimulationSnapshot& snapshot);
+};
@@ -0,0 +1,147 @@
+/**
+ * @file ShaderProgram.h
+ * @brief Small RAII wrapper around a linked GLSL program
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <GL/glew.h>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ShaderProgram
+ * @brief Compiles, links and owns a GLSL program object
+ *
+ * Compile and link errors are reported to std::cerr together with the
+ * driver's info log, and leave the program invalid so callers can fall
+ * back to another rendering path.
+ */
+class ShaderProgram {
+public:
+    /** Attribute name bound to a fixed location before linking (for GLSL without layout qualifiers) */
+    using AttributeBinding = std::pair<GLuint, const char*>;
+
+    /**
+     * @brief GLSL dialect to compile for
+     *
+     * Shader bodies written against the macros IN, OUT and FRAG_COLOR
+     * (and TEXTURE_2D for sampling a sampler2D in fragment shaders)
+     * compile unchanged for both; see versionHeader().
+     */
+    enum class Profile {
+        Legacy,     ///< GLSL 1.20 for 2.1 / compatibility contexts
+        Core        ///< GLSL 3.30 core for 3.3+ core-profile contexts
+    };
+
+    ShaderProgram() = default;
+
+    /**
+     * @brief Deletes the program
+     */
+    ~ShaderProgram();
+
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+    /**
+     * @brief Builds a program from vertex and fragment shader sources
+     * @param vertexSource GLSL vertex shader
+     * @param fragmentSource GLSL fragment shader
+     * @param attributes Attribute locations to bind before linking
+     * @return true if both shaders compiled and the program linked
+     */
+    bool build(const char* vertexSource, const char* fragmentSource,
+               const std::vector<AttributeBinding>& attributes = {});
+
+    /**
+     * @brief Builds a program from shader stages given as several source strings each
+     * @param vertexSources Strings concatenated into the vertex shader
+     * @param fragmentSources Strings concatenated into the fragment shader
+     * @param attributes Attribute locations to bind before linking
+     * @return true if both shaders compiled and the program linked
+     */
+    bool build(const std::vector<const char*>& vertexSources, const std::vector<const char*>& fragmentSources,
+               const std::vector<AttributeBinding>& attributes = {});
+
+    /**
+     * @brief Builds a compute program (OpenGL 4.3)
+     * @param computeSources Strings concatenated into the compute shader
+     * @return true if the shader compiled and the program linked
+     */
+    bool buildCompute(const std::vector<const char*>& computeSources);
+
+    /**
+     * @brief Gets the #version line and dialect macros for a profile and stage
+     * @param profile GLSL dialect
+     * @param stage GL_VERTEX_SHADER, GL_FRAGMENT_SHADER or GL_COMPUTE_SHADER
+     * @return Source to put in front of a shader body
+     *
+     * Compute shaders always get GLSL 4.30 core, whatever the profile.
+     */
+    static const char* versionHeader(Profile profile, GLenum stage);
+
+    /**
+     * @brief Connects a uniform block to a buffer binding point
+     * @param blockName Name of the uniform block in the shader
+     * @param bindingPoint Binding point the buffer is bound to with glBindBufferBase
+     */
+    void bindUniformBlock(const char* blockName, GLuint bindingPoint) const;
+
+    /**
+     * @brief Deletes the program (safe to call more than once)
+     */
+    void release();
+
+    /**
+     * @brief Makes the program current
+     */
+    void use() const {
+        glUseProgram(program);
+    }
+
+    /**
+     * @brief Looks up a uniform
+     * @param name Uniform name
+     * @return Location, or -1 if the uniform does not exist or was optimised out
+     */
+    GLint getUniformLocation(const char* name) const {
+        return glGetUniformLocation(program, name);
+    }
+
+    /**
+     * @brief Checks whether the program linked successfully
+     * @return true if the program can be used
+     */
+    bool isValid() const {
+        return program != 0;
+    }
+
+    /**
+     * @brief Gets the OpenGL program object
+     * @return Program name (0 if invalid)
+     */
+    GLuint getId() const {
+        return program;
+    }
+
+private:
+    GLuint program = 0;    ///< Linked program object
+
+    /**
+     * @brief Compiles one shader stage
+     * @param type Shader stage, e.g. GL_VERTEX_SHADER
+     * @param sources GLSL source strings, concatenated in order
+     * @return Shader object, or 0 on failure
+     */
+    static GLuint compile(GLenum type, const std::vector<const char*>& sources);
+
+    /**
+     * @brief Links compiled stages into this program
+     * @param shaders Shader objects to attach (deleted afterwards)
+     * @param attributes Attribute locations to bind before linking
+     * @return true on success
+     */
+    bool link(const std::vector<GLuint>& shaders, const std::vector<AttributeBinding>& attributes);
+};
@@ -0,0 +1,45 @@
+/**
+ * @file SimulationSnapshot.h
+ * @brief Immutable copy of simulation state handed from the physics thread to the renderer
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "GravityGrid.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct SimulationSnapshot
+ * @brief State at the end of one physics tick plus the positions before it
+ * 
+ * Holding both the previous and current positions lets the renderer
+ * interpolate body motion between ticks when it renders faster or slower
+ * than the physics rate.
+ */
+struct SimulationSnapshot {
+    BodyStore bodies;                           ///< Body state after the tick
+    std::vector<float> previousX, previousY;    ///< Body positions before the tick
+    GravityGrid grid;                           ///< Field grid after the tick
+    double simulationTime = 0.0;                ///< Simulated time after the tick
+    uint64_t tick = 0;                          ///< Number of ticks simulated so far
+    float tickInterval = 0.0f;                  ///< Wall-clock seconds between ticks
+    std::chrono::steady_clock::time_point publishTime; ///< When the tick was published
+
+    SimulationSnapshot() : grid(1.0f, 1.0f) {}
+
+    /**
+     * @brief Computes how far the renderer is between the previous and current state
+     * @param now Current wall-clock time
+     * @return Interpolation factor in [0, 1]
+     */
+    float interpolationFactor(std::chrono::steady_clock::time_point now) const {
+        if (tickInterval <= 0.0f) return 1.0f;
+        float elapsed = std::chrono::duration<float>(now - publishTime).count();
+        float alpha = elapsed / tickInterval;
+        return alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    }
+};
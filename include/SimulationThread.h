@@ -0,0 +1,99 @@
+/**
+ * @file SimulationThread.h
+ * @brief Runs a GravitySimulation on its own thread at a fixed tick rate
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "GravitySimulation.h"
+#include "SimulationSnapshot.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <thread>
+
+/**
+ * @class SimulationThread
+ * @brief Steps the simulation independently of the render loop
+ * 
+ * The simulation advances at a fixed tick rate (e.g. 240 Hz) on a dedicated
+ * thread and publishes a SimulationSnapshot after every tick into a lock-free
+ * triple buffer. The renderer consumes the newest snapshot at display rate, so
+ * a slow frame never slows physics and a slow tick never blocks a frame.
+ * 
+ * While the thread runs, the simulation must not be touched from other threads.
+ */
+class SimulationThread {
+public:
+    /**
+     * @brief Creates a simulation thread (not started)
+     * @param simulation Simulation to step; must outlive this object
+     * @param tickRate Physics ticks per second
+     */
+    SimulationThread(GravitySimulation& simulation, float tickRate = 240.0f);
+
+    /**
+     * @brief Stops the thread if it is still running
+     */
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * @brief Starts stepping the simulation
+     */
+    void start();
+
+    /**
+     * @brief Stops stepping and joins the thread
+     */
+    void stop();
+
+    /**
+     * @brief Checks whether the thread is running
+     * @return true if started and not stopped
+     */
+    bool isRunning() const { return running.load(); }
+
+    /**
+     * @brief Sets the simulated time advanced per second of wall time
+     * @param scale Time multiplier (1 = real time)
+     */
+    void setTimeScale(float scale) { timeScale.store(scale); }
+
+    /**
+     * @brief Gets the physics tick rate
+     * @return Ticks per second
+     */
+    float getTickRate() const { return tickRate; }
+
+    /**
+     * @brief Gets the buffer snapshots are published into
+     * @return Triple buffer for the render thread to consume
+     */
+    TripleBuffer<SimulationSnapshot>& getSnapshotBuffer() { return snapshots; }
+
+private:
+    GravitySimulation& simulation;             ///< Simulation being stepped
+    float tickRate;                            ///< Physics ticks per second
+    std::atomic<float> timeScale;              ///< Simulated seconds per wall second
+    std::atomic<bool> running;                 ///< Thread should keep ticking
+    std::thread worker;                        ///< The physics thread
+    TripleBuffer<SimulationSnapshot> snapshots; ///< Published tick results
+    uint64_t tickCount;                        ///< Ticks simulated so far
+
+    /** Upper bound on catch-up ticks after a stall, to avoid a spiral of death */
+    static constexpr int MAX_CATCH_UP_TICKS = 8;
+
+    /**
+     * @brief Body of the physics thread
+     */
+    void run();
+
+    /**
+     * @brief Runs one tick and publishes its snapshot
+     * @param deltaTime Simulated time step
+     */
+    void tick(float deltaTime);
+};
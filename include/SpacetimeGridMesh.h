@@ -0,0 +1,217 @@
+/**
+ * @file SpacetimeGridMesh.h
+ * @brief Retained-mode GPU mesh for the warped spacetime grid
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "GravityGrid.h"
+#include "CameraUniformBuffer.h"
+#include "Frustum.h"
+#include "Mat4.h"
+#include "ShaderProgram.h"
+#include "StreamingBuffer.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SpacetimeGridMesh
+ * @brief Draws the spacetime grid surface and lines from GPU buffers
+ *
+ * The grid topology (vertex positions plus triangle and line index buffers)
+ * is built once per grid size and stays on the GPU. Each frame only the
+ * grid's force magnitudes, one float per point, are streamed; the vertex
+ * shader turns them into the downward displacement and the blue-to-red
+ * color of the immediate mode renderer. This replaces several immediate
+ * mode vertices and sqrt calls per grid point with one memcpy and two
+ * multi-draw calls, so grid resolution is limited by the GPU rather than the
+ * driver.
+ *
+ * The grid is split into tiles of TILE_CELLS x TILE_CELLS cells, each with
+ * index ranges for LOD_LEVEL_COUNT levels that keep every 1st, 2nd, 4th ...
+ * grid point. Every frame, tiles outside the view frustum are skipped and
+ * each remaining tile draws the coarsest level whose cells still cover at
+ * least TARGET_CELL_PIXELS on screen and whose height error, estimated from
+ * the tile's steepest curvature, stays under MAX_ERROR_PIXELS. Gravity wells
+ * and the area around the camera stay at full resolution while distant, flat
+ * tiles shrink to a few triangles. Tile borders are always drawn at full
+ * resolution, so neighbours at different levels meet without cracks.
+ */
+class SpacetimeGridMesh {
+public:
+    SpacetimeGridMesh() = default;
+
+    /**
+     * @brief Releases GPU resources
+     */
+    ~SpacetimeGridMesh();
+
+    SpacetimeGridMesh(const SpacetimeGridMesh&) = delete;
+    SpacetimeGridMesh& operator=(const SpacetimeGridMesh&) = delete;
+
+    /**
+     * @brief Compiles the shader for the current context
+     * @param profile Legacy (OpenGL 2.0, fixed-function matrices) or
+     *        Core (OpenGL 3.3, matrices from CameraUniformBuffer)
+     * @return true if the mesh can be used, false to fall back to immediate mode
+     */
+    bool initialize(ShaderProgram::Profile profile = ShaderProgram::Profile::Legacy);
+
+    /**
+     * @brief Uploads the current field, rebuilding the topology if the grid size changed
+     * @param grid Grid whose force magnitudes displace the mesh
+     *
+     * Skips the upload when the grid's version is the one already uploaded.
+     */
+    void update(const GravityGrid& grid);
+
+    /**
+     * @brief Reads the field from a GPU buffer instead of uploading it
+     * @param magnitudes Buffer of width * height row-major float magnitudes
+     *        (e.g. GpuNBodySimulation::getFieldMagnitudeBuffer)
+     * @param width Grid points along x
+     * @param height Grid points along y
+     */
+    void updateFromBuffer(GLuint magnitudes, int width, int height);
+
+    /**
+     * @brief Draws the visible tiles' surface and grid lines with the current matrices
+     * @param maxForceVisualization Height that maps to full red
+     * @param view World-to-eye transform the matrices were set up with
+     * @param projection Eye-to-clip transform the matrices were set up with
+     * @param pixelScale Viewport pixels per world unit at unit depth (see BodyMesh::pixelScaleFor)
+     */
+    void draw(float maxForceVisualization, const Mat4& view, const Mat4& projection, float pixelScale);
+
+    /**
+     * @brief Gets the number of tiles the last draw() did not cull
+     * @return Tile count
+     */
+    size_t getDrawnTileCount() const {
+        return drawnTiles;
+    }
+
+    /**
+     * @brief Gets the number of surface triangles the last draw() submitted
+     * @return Triangle count
+     */
+    size_t getDrawnTriangleCount() const {
+        return drawnTriangles;
+    }
+
+    /**
+     * @brief Deletes all GPU resources (safe to call more than once)
+     */
+    void release();
+
+    /** Render-space width and depth covered by the grid, as in the immediate mode path */
+    static constexpr float GRID_SCALE = 600.0f;
+
+    /** Displacement per unit of force magnitude */
+    static constexpr float HEIGHT_SCALE = 0.5f;
+
+    /** Maximum downward displacement */
+    static constexpr float MAX_HEIGHT = 200.0f;
+
+    /** Grid cells along each side of a culling / LOD tile */
+    static constexpr int TILE_CELLS = 16;
+
+    /** Detail levels per tile; level l keeps every 2^l-th grid point */
+    static constexpr int LOD_LEVEL_COUNT = 5;
+
+    /** Coarser levels are used while their cells stay at least this many pixels across */
+    static constexpr float TARGET_CELL_PIXELS = 6.0f;
+
+    /** Largest on-screen height error a coarser level may introduce */
+    static constexpr float MAX_ERROR_PIXELS = 1.0f;
+
+private:
+    ShaderProgram program;                     ///< Displacement and coloring shader
+    GLuint vertexArray = 0;                    ///< Vertex array object (core profile only)
+    StreamingBuffer magnitudeBuffer;           ///< Per-frame force magnitudes
+    GLuint positionBuffer = 0;                 ///< Static x/z position of every grid point
+    GLuint surfaceIndexBuffer = 0;             ///< Two triangles per grid cell
+    GLuint lineIndexBuffer = 0;                ///< Horizontal and vertical grid lines
+    GLsizei surfaceIndexCount = 0;             ///< Indices in surfaceIndexBuffer
+    GLsizei lineIndexCount = 0;                ///< Indices in lineIndexBuffer
+    GLintptr magnitudeOffset = 0;              ///< Offset of this frame's data in magnitudeBuffer
+    GLuint externalMagnitudes = 0;             ///< Caller's magnitude buffer (0 = magnitudeBuffer)
+    uint64_t uploadedVersion = 0;              ///< GravityGrid::getVersion() in magnitudeBuffer (0 = none)
+    int gridWidth = 0, gridHeight = 0;         ///< Size the topology was built for
+
+    /**
+     * @struct TileLevel
+     * @brief Index ranges of one tile at one detail level
+     */
+    struct TileLevel {
+        GLintptr surfaceOffset = 0;            ///< Byte offset into surfaceIndexBuffer
+        GLsizei surfaceCount = 0;              ///< Triangle indices
+        GLintptr lineOffset = 0;               ///< Byte offset into lineIndexBuffer
+        GLsizei lineCount = 0;                 ///< Line indices
+    };
+
+    /**
+     * @struct Tile
+     * @brief A block of grid cells culled and refined as a unit
+     */
+    struct Tile {
+        int x0, y0, x1, y1;                    ///< First and last grid point along each axis
+        float minX, maxX, minZ, maxZ;          ///< Render-space footprint
+        float minHeight = 0.0f;                ///< Smallest displacement in the tile
+        float maxHeight = MAX_HEIGHT;          ///< Largest displacement in the tile
+        float curvature = -1.0f;               ///< Largest second difference of the height (< 0 = unknown)
+        TileLevel levels[LOD_LEVEL_COUNT];     ///< Index ranges per level
+    };
+
+    std::vector<Tile> tiles;                   ///< Row-major tiles of the current topology
+    std::vector<GLsizei> surfaceCounts, lineCounts;         ///< Per-frame multi-draw counts
+    std::vector<const void*> surfaceOffsets, lineOffsets;   ///< Per-frame multi-draw offsets
+    size_t drawnTiles = 0;                     ///< Tiles drawn by the last draw()
+    size_t drawnTriangles = 0;                 ///< Triangles drawn by the last draw()
+
+    // Uniform locations
+    GLint maxForceLocation = -1;
+    GLint heightScaleLocation = -1;
+    GLint maxHeightLocation = -1;
+    GLint lineColorWeightLocation = -1;
+
+    /** Attribute locations bound before linking */
+    static constexpr GLuint POSITION_ATTRIBUTE = 0;
+    static constexpr GLuint MAGNITUDE_ATTRIBUTE = 1;
+
+    /**
+     * @brief Builds the position and index buffers for a grid size
+     * @param width Grid points along x
+     * @param height Grid points along y
+     */
+    void buildTopology(int width, int height);
+
+    /**
+     * @brief Appends one tile's indices at one detail level
+     * @param tile Tile to tessellate
+     * @param step Grid points between kept points
+     * @param surface Triangle indices to append to
+     * @param lines Line indices to append to
+     */
+    void tessellateTile(const Tile& tile, int step, std::vector<uint32_t>& surface,
+                        std::vector<uint32_t>& lines) const;
+
+    /**
+     * @brief Refreshes each tile's height range and curvature from the field
+     * @param magnitudes Row-major force magnitudes, or null when they only live on the GPU
+     */
+    void updateTileHeights(const float* magnitudes);
+
+    /**
+     * @brief Picks the detail level of a tile for the current view
+     * @param tile Tile to draw
+     * @param cameraX Camera position in render space
+     * @param cameraY Camera position in render space
+     * @param cameraZ Camera position in render space
+     * @param pixelScale Viewport pixels per world unit at unit depth
+     * @return Level index
+     */
+    int selectLevel(const Tile& tile, float cameraX, float cameraY, float cameraZ, float pixelScale) const;
+};
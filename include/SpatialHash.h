@@ -0,0 +1,108 @@
+/**
+ * @file SpatialHash.h
+ * @brief Uniform grid broad phase for finding nearby body pairs
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SpatialHash
+ * @brief Bins bodies into square cells over the world to find close pairs in O(N)
+ *
+ * Cells cover the world rectangle from the origin, the same way GravityGrid
+ * maps world positions to grid cells (clamped at the edges, so bodies that
+ * stray outside still land in a border cell). build() counting-sorts the body
+ * indices by cell into one flat array: a cell's bodies are contiguous and
+ * located through a prefix sum of cell counts, which keeps rebuilding every
+ * step allocation free and cache friendly.
+ *
+ * With cells at least as wide as the largest query distance, every pair
+ * closer than that distance lies in the same or an adjacent cell, so a query
+ * only visits a 3x3 block of cells around each body.
+ */
+class SpatialHash {
+public:
+    /** A pair of body indices with first < second */
+    using BodyPair = std::pair<uint32_t, uint32_t>;
+
+    /**
+     * @brief Creates an empty broad phase over a world
+     * @param worldWidth World width in simulation units
+     * @param worldHeight World height in simulation units
+     */
+    SpatialHash(float worldWidth, float worldHeight);
+
+    /**
+     * @brief Bins all bodies into cells of the given size
+     * @param bodies Body positions to bin
+     * @param cellSize Cell edge length; no smaller than the largest query distance
+     *
+     * The size grows if needed to keep the cell count at or below MAX_CELLS.
+     */
+    void build(const BodyStore& bodies, float cellSize);
+
+    /**
+     * @brief Finds all pairs closer than the sum of their radii plus a margin
+     * @param bodies Bodies that were passed to build()
+     * @param margin Extra separation below which a pair still counts as touching
+     * @param pairs Output pairs, cleared first, in ascending (first, second) order
+     *
+     * Needs a cell size of at least twice the largest radius plus the margin.
+     */
+    void findOverlappingPairs(const BodyStore& bodies, float margin, std::vector<BodyPair>& pairs) const;
+
+    /**
+     * @brief Finds all pairs closer than a fixed distance
+     * @param bodies Bodies that were passed to build()
+     * @param distance Pair separation threshold; at most the cell size
+     * @param pairs Output pairs, cleared first, in ascending (first, second) order
+     */
+    void findPairsWithin(const BodyStore& bodies, float distance, std::vector<BodyPair>& pairs) const;
+
+    /**
+     * @brief Gets the cell size used by the last build()
+     * @return Cell edge length
+     */
+    float getCellSize() const { return cellSize; }
+
+    /**
+     * @brief Gets the cell grid dimensions of the last build()
+     * @return Pair of (columns, rows)
+     */
+    std::pair<int, int> getCellDimensions() const { return {columns, rows}; }
+
+    /** Upper bound on the number of cells, to bound memory for tiny cell sizes */
+    static constexpr size_t MAX_CELLS = 1 << 22;
+
+private:
+    float worldWidth, worldHeight;          ///< World covered by the cells
+    float cellSize = 0.0f;                  ///< Cell edge length
+    int columns = 0, rows = 0;              ///< Cell grid dimensions
+    std::vector<uint32_t> cellStart;        ///< Prefix sum: cell c holds sortedBodies[cellStart[c], cellStart[c + 1])
+    std::vector<uint32_t> sortedBodies;     ///< Body indices ordered by cell
+    std::vector<uint32_t> bodyCell;         ///< Cell of every body
+    std::vector<uint32_t> cellFill;         ///< Scatter cursor per cell during build()
+
+    /**
+     * @brief Maps a world position to its (clamped) cell
+     * @param x World X coordinate
+     * @param y World Y coordinate
+     * @return Row-major cell index
+     */
+    uint32_t cellOf(float x, float y) const;
+
+    /**
+     * @brief Visits every candidate pair and keeps those accepted by a predicate
+     * @param accept Called with (i, j), i < j; returns true to report the pair
+     * @param pairs Output pairs in ascending order
+     */
+    template <typename Accept>
+    void collectPairs(Accept accept, std::vector<BodyPair>& pairs) const;
+};
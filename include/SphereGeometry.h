@@ -0,0 +1,37 @@
+/**
+ * @file SphereGeometry.h
+ * @brief Precomputed unit sphere meshes for body rendering
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct SphereGeometry
+ * @brief Latitude/longitude unit sphere as an indexed triangle list
+ *
+ * Same tessellation as the original per-frame GL_QUAD_STRIP spheres, but
+ * computed once per segment count so drawing a body needs no trigonometry.
+ */
+struct SphereGeometry {
+    int segments = 0;                  ///< Latitude rings and longitude slices
+    std::vector<float> positions;      ///< Vertex positions (xyz), also the normals
+    std::vector<uint32_t> indices;     ///< Triangle indices, two per original quad
+
+    /**
+     * @brief Builds a unit sphere
+     * @param segments Latitude rings and longitude slices (at least 3)
+     * @return Sphere geometry
+     */
+    static SphereGeometry build(int segments);
+
+    /**
+     * @brief Gets a lazily built, cached sphere (main thread only)
+     * @param segments Latitude rings and longitude slices
+     * @return Geometry that stays valid for the rest of the program
+     */
+    static const SphereGeometry& cached(int segments);
+};
@@ -0,0 +1,98 @@
+/**
+ * @file StreamingBuffer.h
+ * @brief GPU buffer for data that is re-uploaded every frame
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+/**
+ * @class StreamingBuffer
+ * @brief Per-frame vertex data upload without stalling on the GPU
+ *
+ * With GL 4.4 / ARB_buffer_storage the buffer is persistently mapped and
+ * split into REGION_COUNT regions used round-robin; a fence per region
+ * makes sure the CPU never overwrites data the GPU is still reading. Without
+ * it the buffer is orphaned (glBufferData with no data) before every upload,
+ * which lets the driver hand out fresh storage instead of synchronising.
+ *
+ * Usage per frame: upload(), draw using the returned offset, then fence().
+ */
+class StreamingBuffer {
+public:
+    /**
+     * @brief Creates an empty streaming buffer
+     * @param target Binding target, e.g. GL_ARRAY_BUFFER
+     */
+    explicit StreamingBuffer(GLenum target = GL_ARRAY_BUFFER);
+
+    /**
+     * @brief Releases the GL buffer
+     */
+    ~StreamingBuffer();
+
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    /**
+     * @brief Copies data into the next free region, growing the buffer if needed
+     * @param data Bytes to upload
+     * @param bytes Number of bytes
+     * @return Byte offset of the uploaded data within the buffer (leaves it bound)
+     */
+    GLintptr upload(const void* data, size_t bytes);
+
+    /**
+     * @brief Marks the last uploaded region as in use by the commands issued so far
+     *
+     * Call after the draw calls that read the data. No-op when not persistent.
+     */
+    void fence();
+
+    /**
+     * @brief Binds the buffer to its target
+     */
+    void bind() const {
+        glBindBuffer(target, buffer);
+    }
+
+    /**
+     * @brief Deletes the GL buffer and any pending fences (safe to call more than once)
+     */
+    void release();
+
+    /**
+     * @brief Checks whether the buffer uses persistent mapping
+     * @return true if uploads write straight into mapped GPU memory
+     */
+    bool isPersistent() const {
+        return persistent;
+    }
+
+private:
+    GLenum target;                         ///< Binding target
+    GLuint buffer = 0;                     ///< GL buffer object
+    size_t regionCapacity = 0;             ///< Bytes available per region
+    int currentRegion = 0;                 ///< Region written by the last upload
+    bool persistent = false;               ///< Persistently mapped ring in use
+    unsigned char* mapped = nullptr;       ///< Mapped pointer to region 0 (persistent only)
+
+    /** Regions in flight: one written by the CPU, up to two read by the GPU */
+    static constexpr int REGION_COUNT = 3;
+    GLsync fences[REGION_COUNT] = {};      ///< GPU completion fence per region
+
+    /**
+     * @brief (Re)creates the buffer storage
+     * @param regionBytes Minimum bytes per region
+     */
+    void allocate(size_t regionBytes);
+
+    /**
+     * @brief Waits until the GPU has finished with a region
+     * @param region Region index
+     */
+    void waitForRegion(int region);
+};
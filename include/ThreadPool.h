@@ -0,0 +1,182 @@
+/**
+ * @file ThreadPool.h
+ * @brief Persistent work-stealing thread pool for data-parallel loops
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that execute parallel-for loops
+ * 
+ * Workers are created once and sleep between jobs, so per-frame work does not
+ * spawn threads. A loop is cut into chunks of a fixed grain size which are
+ * dealt out to per-thread queues; a thread that runs out of work steals chunks
+ * from the back of another thread's queue, which balances uneven workloads
+ * such as tree walks.
+ * 
+ * Chunk boundaries depend only on the range and grain, never on the thread
+ * count, and parallelReduce() combines chunk results in chunk order. Results
+ * are therefore identical for any number of threads.
+ * 
+ * Submitting a loop performs no heap allocation: loop bodies are passed by
+ * reference and each queue is a range of chunk indices.
+ */
+class ThreadPool {
+public:
+    /**
+     * @class RangeTask
+     * @brief Non-owning reference to a loop body: void(size_t begin, size_t end)
+     * 
+     * Binds to any callable, typically a lambda written at the call site,
+     * without copying it (a std::function would allocate for captures
+     * larger than two pointers). The callable must outlive the loop, which
+     * a temporary passed to parallelFor() or run() always does.
+     */
+    class RangeTask {
+    public:
+        template <typename Function,
+                  typename = std::enable_if_t<!std::is_same<std::decay_t<Function>, RangeTask>::value>>
+        RangeTask(Function&& function)
+            : callable(const_cast<void*>(static_cast<const void*>(&function))),
+              invoke([](void* target, size_t begin, size_t end) {
+                  (*static_cast<std::remove_reference_t<Function>*>(target))(begin, end);
+              }) {}
+
+        void operator()(size_t begin, size_t end) const { invoke(callable, begin, end); }
+
+    private:
+        void* callable;                                 ///< The referenced callable
+        void (*invoke)(void*, size_t, size_t);          ///< Calls callable with its real type
+    };
+
+    /**
+     * @brief Creates the pool
+     * @param threadCount Total threads including the caller (0 = hardware concurrency)
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Stops and joins all worker threads
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Gets the number of threads that execute work, including the caller
+     * @return Thread count
+     */
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+    /**
+     * @brief Gets the index of the calling thread within the pool running it
+     * @return 1 .. getThreadCount() - 1 on a worker, 0 on any other thread
+     * 
+     * Lets tasks pick per-thread scratch (see FrameArena) without locking.
+     */
+    static size_t getCurrentThreadIndex();
+
+    /**
+     * @brief Runs a loop body over [begin, end) in parallel and waits for completion
+     * @param begin First index
+     * @param end One past the last index
+     * @param grain Number of indices per chunk (>= 1)
+     * @param task Loop body called once per chunk
+     * 
+     * The calling thread participates. Calls made from inside a running task
+     * execute serially on the calling thread.
+     */
+    void parallelFor(size_t begin, size_t end, size_t grain, const RangeTask& task);
+
+    /**
+     * @brief Runs a chunked loop on a pool, or serially with the same chunking if pool is null
+     * @param pool Pool to use (may be null)
+     * @param begin First index
+     * @param end One past the last index
+     * @param grain Number of indices per chunk
+     * @param task Loop body called once per chunk
+     */
+    static void run(ThreadPool* pool, size_t begin, size_t end, size_t grain, const RangeTask& task);
+
+    /**
+     * @brief Parallel reduction with a deterministic combination order
+     * @param begin First index
+     * @param end One past the last index
+     * @param grain Number of indices per chunk
+     * @param identity Initial value of the reduction
+     * @param chunkFunction Computes the partial result of one chunk: T(size_t begin, size_t end)
+     * @return identity + partial(chunk 0) + partial(chunk 1) + ...
+     */
+    template <typename T, typename ChunkFunction>
+    T parallelReduce(size_t begin, size_t end, size_t grain, T identity, ChunkFunction chunkFunction) {
+        if (end <= begin) return identity;
+        grain = grain > 0 ? grain : 1;
+        std::vector<T> partials((end - begin + grain - 1) / grain, identity);
+        parallelFor(begin, end, grain, [&](size_t chunkBegin, size_t chunkEnd) {
+            partials[(chunkBegin - begin) / grain] = chunkFunction(chunkBegin, chunkEnd);
+        });
+        T total = identity;
+        for (const T& partial : partials) {
+            total = total + partial;
+        }
+        return total;
+    }
+
+private:
+    /**
+     * @struct WorkQueue
+     * @brief Contiguous chunk indices [front, back) owned by one thread; others steal from the back
+     */
+    struct WorkQueue {
+        std::mutex mutex;
+        size_t front = 0;
+        size_t back = 0;
+    };
+
+    std::vector<std::thread> workers;                 ///< Background threads (caller is queue 0)
+    std::vector<std::unique_ptr<WorkQueue>> queues;   ///< One queue per participating thread
+
+    std::mutex submitMutex;                           ///< Serializes concurrent parallelFor callers
+    std::mutex jobMutex;                              ///< Guards job generation and shutdown
+    std::condition_variable jobAvailable;             ///< Wakes workers for a new job
+    std::condition_variable jobFinished;              ///< Wakes the caller when all chunks are done
+    uint64_t jobGeneration;                           ///< Incremented for every submitted job
+    bool stopping;                                    ///< Set when the pool shuts down
+
+    const RangeTask* currentTask;                     ///< Body of the job in progress
+    size_t jobBegin, jobEnd, jobGrain;                ///< Range and chunking of the job in progress
+    std::atomic<size_t> remainingChunks;              ///< Chunks not yet completed
+
+    /**
+     * @brief Main loop of a background worker
+     * @param queueIndex Index of the worker's own queue
+     */
+    void workerLoop(size_t queueIndex);
+
+    /**
+     * @brief Executes chunks until no queue has work left
+     * @param queueIndex Index of the calling thread's own queue
+     */
+    void processChunks(size_t queueIndex);
+
+    /**
+     * @brief Takes the next chunk from the own queue or steals one
+     * @param queueIndex Index of the calling thread's own queue
+     * @param chunk Receives the chunk index
+     * @return true if a chunk was obtained
+     */
+    bool acquireChunk(size_t queueIndex, size_t& chunk);
+};
@@ -0,0 +1,130 @@
+/**
+ * @file TrajectoryFormat.h
+ * @brief On-disk layout and frame codec of recorded trajectories
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct TrajectoryFileHeader
+ * @brief Fixed-size header at the start of a trajectory file
+ *
+ * The file is this header, a sequence of frames (each a TrajectoryFrameHeader
+ * and its payload) and, once recording finished cleanly, an index of every
+ * frame followed by a TrajectoryFooter at the very end. A file without a
+ * footer (recording interrupted) can still be read by walking the frames.
+ *
+ * Keyframes are raw and hold every body's position, velocity, mass and
+ * radius, so decoding can start at any keyframe. The frames in between hold
+ * only positions and velocities, XOR-delta encoded against the previous
+ * frame (see TrajectoryCodec); masses and radii carry over from the
+ * keyframe, and the writer emits a new keyframe whenever they change. All
+ * values are in the writer's native byte order.
+ */
+struct TrajectoryFileHeader {
+    char magic[8];                  ///< "BHSTRAJ" and a terminating zero
+    uint32_t version;               ///< CURRENT_VERSION when written
+    uint32_t headerSize;            ///< sizeof(TrajectoryFileHeader)
+    uint32_t byteOrder;             ///< BYTE_ORDER_MARK in the writer's byte order
+    uint32_t decimation;            ///< Simulation steps per recorded frame
+    uint32_t keyframeInterval;      ///< Frames between raw keyframes (1 = uncompressed)
+    float gravitationalConstant;    ///< G of the recorded simulation
+    float worldWidth, worldHeight;  ///< World dimensions of the recorded simulation
+    uint8_t reserved[24];           ///< Zero; pads the header to 64 bytes
+
+    static constexpr uint32_t CURRENT_VERSION = 2;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+};
+
+/**
+ * @struct TrajectoryFrameHeader
+ * @brief Header in front of every recorded frame
+ */
+struct TrajectoryFrameHeader {
+    /** Payload encoding */
+    enum Encoding : uint32_t {
+        Raw = 0,        ///< Keyframe: RAW_ARRAYS * bodyCount floats, x[], y[], vx[], vy[], mass[], radius[]
+        XorDelta = 1    ///< TrajectoryCodec::encodeXorDelta() of DELTA_ARRAYS * bodyCount floats, x[] to vy[]
+    };
+
+    uint32_t magic;                 ///< FRAME_MAGIC, to resynchronise when scanning
+    uint32_t encoding;              ///< Encoding of the payload
+    uint64_t step;                  ///< Simulation step count of the frame
+    double time;                    ///< Simulated seconds of the frame
+    uint32_t bodyCount;             ///< Bodies in the frame
+    uint32_t payloadSize;           ///< Payload bytes following this header
+
+    static constexpr uint32_t FRAME_MAGIC = 0x4D524654u;  // "TFRM"
+    static constexpr size_t RAW_ARRAYS = 6;                ///< Arrays in a keyframe payload
+    static constexpr size_t DELTA_ARRAYS = 4;              ///< Arrays in a delta payload
+};
+
+/**
+ * @struct TrajectoryIndexEntry
+ * @brief Position of one frame, for seeking without scanning
+ */
+struct TrajectoryIndexEntry {
+    double time;                    ///< Simulated seconds of the frame
+    uint64_t step;                  ///< Simulation step count of the frame
+    uint64_t offset;                ///< Byte offset of the frame header
+    uint64_t keyframe;              ///< Non-zero if the frame is raw
+};
+
+/**
+ * @struct TrajectoryFooter
+ * @brief Last bytes of a cleanly closed file, locating the frame index
+ */
+struct TrajectoryFooter {
+    uint32_t magic;                 ///< FOOTER_MAGIC
+    uint32_t reserved;              ///< Zero
+    uint64_t indexOffset;           ///< Byte offset of the first TrajectoryIndexEntry
+    uint64_t frameCount;            ///< Number of index entries
+
+    static constexpr uint32_t FOOTER_MAGIC = 0x58444954u;  // "TIDX"
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == 64, "trajectory header layout changed");
+static_assert(sizeof(TrajectoryFrameHeader) == 32, "trajectory frame header layout changed");
+static_assert(sizeof(TrajectoryIndexEntry) == 32, "trajectory index layout changed");
+static_assert(sizeof(TrajectoryFooter) == 24, "trajectory footer layout changed");
+
+/**
+ * @class TrajectoryCodec
+ * @brief Lossless XOR-delta compression of consecutive float frames
+ *
+ * Bodies move little between frames, so a value's bit pattern usually
+ * differs from the previous frame's only in the low mantissa bits. Each
+ * value is XORed with its predecessor and only the significant low-order
+ * bytes of the result are stored (0 to 4), with the byte count kept in a
+ * 4-bit control code. The payload is all control codes (two per byte) then
+ * all data bytes. Decoding reproduces the input bit for bit.
+ */
+class TrajectoryCodec {
+public:
+    /**
+     * @brief Encodes values relative to their predecessors
+     * @param current Bit patterns of the new frame
+     * @param previous Bit patterns of the previous frame (same count)
+     * @param count Number of values
+     * @param output Receives the payload (appended)
+     */
+    static void encodeXorDelta(const uint32_t* current, const uint32_t* previous, size_t count,
+                               std::vector<uint8_t>& output);
+
+    /**
+     * @brief Decodes a payload written by encodeXorDelta()
+     * @param payload Encoded bytes
+     * @param payloadSize Number of encoded bytes
+     * @param previous Bit patterns of the previous frame
+     * @param count Number of values
+     * @param current Receives the decoded bit patterns (may alias previous)
+     * @return false if the payload is malformed
+     */
+    static bool decodeXorDelta(const uint8_t* payload, size_t payloadSize, const uint32_t* previous,
+                               size_t count, uint32_t* current);
+};
@@ -0,0 +1,114 @@
+/**
+ * @file TrajectoryPlayer.h
+ * @brief Plays a recorded trajectory back through the renderer without running physics
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "GravityGrid.h"
+#include "ThreadPool.h"
+#include "TrajectoryReader.h"
+#include <memory>
+#include <string>
+
+/**
+ * @class TrajectoryPlayer
+ * @brief Decodes recorded frames into a body store and grid that a renderer draws
+ *
+ * The player owns the BodyStore and GravityGrid handed to the renderer in
+ * place of the simulation's. seek() decodes the frame showing the requested
+ * time and, if grid updates are enabled, refreshes the grid for it; nothing
+ * happens when the frame did not change. Playback therefore costs one frame
+ * decode (plus the grid) per displayed frame, however many bodies were
+ * simulated or however long each step took to compute.
+ */
+class TrajectoryPlayer {
+public:
+    /**
+     * @brief Creates a player whose grid has the given density
+     * @param gridResolution Grid points per 100 world units, as for GravitySimulation
+     * @param threadCount Threads for grid updates including the caller (0 = hardware concurrency)
+     */
+    explicit TrajectoryPlayer(int gridResolution = 25, size_t threadCount = 0);
+
+    /**
+     * @brief Opens a recording and shows its first frame
+     * @param path File written by TrajectoryRecorder
+     * @return true on success; errors go to std::cerr
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Shows the frame recorded at or just before a moment
+     * @param time Simulated seconds, clamped to the recording
+     * @return true if a different frame is now shown
+     */
+    bool seek(double time);
+
+    /**
+     * @brief Enables or disables refreshing the grid for shown frames
+     * @param enabled false leaves the grid showing the field of the first frame
+     */
+    void setGridUpdates(bool enabled) { gridUpdates = enabled; }
+
+    /**
+     * @brief Selects how the grid field is evaluated; call before open()
+     * @param method Direct summation, or particle-mesh for large recordings
+     */
+    void setFieldMethod(GravityGrid::FieldMethod method) { fieldMethod = method; }
+
+    /**
+     * @brief Gets the simulated time of the first frame
+     * @return Seconds
+     */
+    double getStartTime() const { return reader.getFrameInfo(0).time; }
+
+    /**
+     * @brief Gets the simulated time of the last frame
+     * @return Seconds
+     */
+    double getEndTime() const { return reader.getFrameInfo(reader.getFrameCount() - 1).time; }
+
+    /**
+     * @brief Gets the number of the frame shown
+     * @return Frame number
+     */
+    size_t getCurrentFrame() const { return currentFrame; }
+
+    /**
+     * @brief Gets the trajectory file being played
+     * @return Reader for header and index access
+     */
+    const TrajectoryReader& getReader() const { return reader; }
+
+    /**
+     * @brief Gets the bodies of the shown frame
+     * @return Store to hand to IGravityRenderer::setBodyStore()
+     */
+    std::shared_ptr<const BodyStore> getBodyStore() const { return bodyStore; }
+
+    /**
+     * @brief Gets the grid of the shown frame
+     * @return Grid to hand to IGravityRenderer::setGravityGrid() (null until open() succeeded)
+     */
+    std::shared_ptr<GravityGrid> getGravityGrid() const { return gravityGrid; }
+
+private:
+    TrajectoryReader reader;                    ///< The mapped recording
+    std::shared_ptr<BodyStore> bodyStore;       ///< Bodies of the shown frame
+    std::shared_ptr<GravityGrid> gravityGrid;   ///< Field of the shown frame
+    std::unique_ptr<ThreadPool> threadPool;     ///< Workers for grid updates
+    int gridResolution;                         ///< Grid density for the recording's world
+    bool gridUpdates = true;                    ///< Refresh the grid for each shown frame
+    GravityGrid::FieldMethod fieldMethod = GravityGrid::FieldMethod::Direct; ///< Grid field evaluation
+    size_t currentFrame = 0;                    ///< Frame in bodyStore
+
+    /**
+     * @brief Decodes a frame into bodyStore and refreshes the grid
+     * @param frame Frame number
+     * @return false if the frame is corrupt
+     */
+    bool show(size_t frame);
+};
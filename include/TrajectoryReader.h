@@ -0,0 +1,99 @@
+/**
+ * @file TrajectoryReader.h
+ * @brief Random access to recorded trajectories through a memory mapping
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "MappedFile.h"
+#include "TrajectoryFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class TrajectoryReader
+ * @brief A validated, memory-mapped trajectory file
+ *
+ * open() maps the file and takes the frame index from the footer, or walks
+ * the frames when the recording was interrupted before the footer was
+ * written (a torn last frame is ignored). Payloads are only decoded on
+ * request: readFrame() starts from the nearest keyframe at or before the
+ * frame, or continues from the previously decoded frame when that is closer,
+ * so stepping forward frame by frame decodes each frame exactly once.
+ */
+class TrajectoryReader {
+public:
+    /**
+     * @brief Maps and indexes a trajectory file
+     * @param path File written by TrajectoryRecorder
+     * @return true if the file is a readable recording with at least one frame; errors go to std::cerr
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Gets the file header
+     * @return Header inside the mapping
+     */
+    const TrajectoryFileHeader& getHeader() const { return *header; }
+
+    /**
+     * @brief Gets the number of frames in the file
+     * @return Frame count
+     */
+    size_t getFrameCount() const { return frames.size(); }
+
+    /**
+     * @brief Gets the time and position of a frame
+     * @param frame Frame number
+     * @return Index entry
+     */
+    const TrajectoryIndexEntry& getFrameInfo(size_t frame) const { return frames[frame]; }
+
+    /**
+     * @brief Finds the frame showing a moment
+     * @param time Simulated seconds
+     * @return Last frame recorded at or before time (the first frame if time precedes it)
+     */
+    size_t findFrame(double time) const;
+
+    /**
+     * @brief Decodes one frame
+     * @param frame Frame number
+     * @param bodies Receives the positions, velocities, masses and radii (resized to the frame's body count)
+     * @return false if the file is corrupt
+     */
+    bool readFrame(size_t frame, BodyStore& bodies);
+
+private:
+    /** Marks that no frame is held in decodedBits */
+    static constexpr size_t NO_FRAME = static_cast<size_t>(-1);
+
+    MappedFile file;                            ///< The mapped recording
+    const TrajectoryFileHeader* header = nullptr; ///< Header inside the mapping
+    std::vector<TrajectoryIndexEntry> frames;   ///< Every usable frame, in file order
+    std::vector<uint32_t> decodedBits;          ///< Values of decodedFrame, raw payload layout
+    size_t decodedFrame = NO_FRAME;             ///< Frame held in decodedBits
+
+    /**
+     * @brief Reads a frame header and checks that it and its payload lie inside the file
+     * @param offset Byte offset of the frame header
+     * @param frame Receives the header (frames are packed, so it is copied rather than referenced)
+     * @return false if there is no complete frame at offset
+     */
+    bool frameAt(uint64_t offset, TrajectoryFrameHeader& frame) const;
+
+    /**
+     * @brief Builds the frame list by walking the file from the first frame
+     */
+    void scanFrames();
+
+    /**
+     * @brief Applies one frame's payload to decodedBits
+     * @param frame Frame number; must be a keyframe or follow decodedFrame
+     * @return false if the payload is malformed
+     */
+    bool decodeFrame(size_t frame);
+};
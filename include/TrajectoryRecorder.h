@@ -0,0 +1,154 @@
+/**
+ * @file TrajectoryRecorder.h
+ * @brief Records body trajectories to disk from a background writer thread
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "BodyStore.h"
+#include "TrajectoryFormat.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class TrajectoryRecorder
+ * @brief Copies body state into a lock-free ring that a writer thread drains to a file
+ *
+ * record() runs on the simulation thread after every step. For every
+ * decimation-th step it copies positions and velocities into the next free
+ * ring slot (slots keep their capacity, so this is six memcpys) and publishes
+ * it with a release store; it never locks, allocates (in steady state) or
+ * touches the file. When the ring is full the frame is dropped and counted
+ * rather than stalling the simulation.
+ *
+ * The writer thread encodes frames (see TrajectoryFormat.h) and writes them
+ * in order, then writes the frame index and footer when recording stops.
+ *
+ * record() and stop() must be called from the same thread (or otherwise not
+ * concurrently).
+ */
+class TrajectoryRecorder {
+public:
+    /**
+     * @brief Recording options
+     */
+    struct Settings {
+        int decimation = 1;                 ///< Record every n-th step
+        bool compress = true;               ///< XOR-delta encode frames between keyframes
+        int keyframeInterval = 64;          ///< Frames between raw keyframes when compressing
+        size_t ringFrames = 32;             ///< Frames buffered between simulation and writer
+    };
+
+    TrajectoryRecorder() = default;
+
+    /**
+     * @brief Stops recording and finishes the file
+     */
+    ~TrajectoryRecorder();
+
+    TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+    TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+    /**
+     * @brief Creates the file and starts the writer thread
+     * @param path Output file
+     * @param settings Decimation, compression and buffering
+     * @param gravitationalConstant G stored in the header
+     * @param worldWidth World width stored in the header
+     * @param worldHeight World height stored in the header
+     * @return true if the file could be created
+     */
+    bool start(const std::string& path, const Settings& settings, float gravitationalConstant,
+               float worldWidth, float worldHeight);
+
+    /**
+     * @brief Writes the remaining frames and the index, then closes the file
+     */
+    void stop();
+
+    /**
+     * @brief Offers the state after a simulation step
+     * @param bodies Body state to copy
+     * @param time Simulated seconds
+     * @param step Simulation step count
+     */
+    void record(const BodyStore& bodies, double time, uint64_t step);
+
+    /**
+     * @brief Checks whether recording is active
+     * @return true between start() and stop()
+     */
+    bool isRecording() const { return recording; }
+
+    /**
+     * @brief Gets the number of frames handed to the writer
+     * @return Frames queued so far
+     */
+    uint64_t getRecordedFrameCount() const { return recordedFrames; }
+
+    /**
+     * @brief Gets the number of frames lost because the ring was full
+     * @return Dropped frames so far
+     */
+    uint64_t getDroppedFrameCount() const { return droppedFrames; }
+
+    /**
+     * @brief Gets the number of bytes written to the file
+     * @return Bytes, updated by the writer thread
+     */
+    uint64_t getBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+
+private:
+    /** One buffered frame */
+    struct Frame {
+        std::vector<float> x, y, vx, vy;    ///< Copied body state
+        std::vector<float> mass, radius;    ///< Copied body properties, written with keyframes
+        double time = 0.0;                  ///< Simulated seconds
+        uint64_t step = 0;                  ///< Step count
+    };
+
+    Settings settings;                      ///< Active options
+    std::vector<Frame> ring;                ///< Slots shared by producer and writer
+    std::atomic<uint64_t> head{0};          ///< Frames published (producer)
+    std::atomic<uint64_t> tail{0};          ///< Frames written (writer)
+    std::atomic<bool> running{false};       ///< Writer should keep polling
+    std::atomic<uint64_t> bytesWritten{0};  ///< File size so far
+    std::thread writer;                     ///< Background writer
+    bool recording = false;                 ///< Between start() and stop()
+    uint64_t stepsSinceFrame = 0;           ///< Steps since the last recorded one (producer)
+    uint64_t recordedFrames = 0;            ///< Frames published (producer)
+    uint64_t droppedFrames = 0;             ///< Frames lost to a full ring (producer)
+
+    // Writer thread state
+    std::ofstream file;                     ///< Output
+    std::vector<uint32_t> previousBits;     ///< Last written frame, for delta encoding and keyframe checks
+    std::vector<uint32_t> currentBits;      ///< Frame being encoded
+    std::vector<uint8_t> payload;           ///< Encoded frame
+    std::vector<TrajectoryIndexEntry> index; ///< Every written frame
+    uint64_t fileOffset = 0;                ///< Current write position
+
+    /** How long the writer sleeps when the ring is empty */
+    static constexpr std::chrono::milliseconds WRITER_POLL_INTERVAL{2};
+
+    /**
+     * @brief Body of the writer thread
+     */
+    void runWriter();
+
+    /**
+     * @brief Encodes and writes one frame
+     * @param frame Frame to write
+     */
+    void writeFrame(const Frame& frame);
+
+    /**
+     * @brief Appends bytes to the file
+     */
+    void writeBytes(const void* data, size_t size);
+};
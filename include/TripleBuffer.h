@@ -0,0 +1,91 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Lock-free single-producer/single-consumer triple buffer
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief Hands the latest complete value from one thread to another without locks
+ * 
+ * The producer always writes into a private back slot and publishes it by
+ * swapping it with the shared middle slot. The consumer swaps the middle slot
+ * into its private front slot when a newer value is available. Neither side
+ * ever waits for the other, and the consumer always sees the most recently
+ * published value in full.
+ * 
+ * @tparam T Value type; slots are reused, so assignment can recycle capacity
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), back(2), front(0) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Gets the slot the producer may write into
+     * @return Reference to the producer's back slot
+     */
+    T& getWriteSlot() { return slots[back]; }
+
+    /**
+     * @brief Publishes the write slot as the newest value (producer only)
+     */
+    void publish() {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(back | FRESH_BIT), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Swaps in the newest published value if there is one (consumer only)
+     * @return true if a new value was acquired since the last call
+     */
+    bool acquire() {
+        if (!(middle.load(std::memory_order_acquire) & FRESH_BIT)) {
+            return false;
+        }
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Gets the value most recently acquired by the consumer
+     * @return Reference to the consumer's front slot
+     */
+    const T& getReadSlot() const { return slots[front]; }
+
+    /**
+     * @brief Checks whether anything has been published since construction
+     * @return true once the consumer has acquired at least one value
+     */
+    bool hasValue() const { return everAcquired; }
+
+    /**
+     * @brief Acquires if possible and reports whether a value is readable
+     * @return true if getReadSlot() holds a published value
+     */
+    bool acquireLatest() {
+        if (acquire()) {
+            everAcquired = true;
+        }
+        return everAcquired;
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    T slots[3];                    ///< Storage for the three values
+    std::atomic<uint8_t> middle;   ///< Shared slot index plus "fresh" flag
+    uint8_t back;                  ///< Producer's private slot
+    uint8_t front;                 ///< Consumer's private slot
+    bool everAcquired = false;     ///< Consumer has seen a published value
+};
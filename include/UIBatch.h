@@ -0,0 +1,131 @@
+/**
+ * @file UIBatch.h
+ * @brief Per-frame vertex batch for the 2D UI overlay
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#pragma once
+#include "GlyphAtlas.h"
+#include "Mat4.h"
+#include "ShaderProgram.h"
+#include "StreamingBuffer.h"
+#include <GL/glew.h>
+#include <vector>
+
+/**
+ * @class UIBatch
+ * @brief Collects textured, colored UI triangles and draws them in one call
+ *
+ * Text and untextured quads both sample the GlyphAtlas (untextured quads
+ * use its solid cell), so everything queued between clear() and flush()
+ * shares one texture, one vertex buffer and one glDrawArrays. Vertices are
+ * streamed through a StreamingBuffer in the same GLSL dialect as the other
+ * meshes; legacy contexts without GLSL 1.20 fall back to immediate mode
+ * from the same vertex array.
+ */
+class UIBatch {
+public:
+    /**
+     * @struct Vertex
+     * @brief Interleaved vertex of the batch
+     */
+    struct Vertex {
+        float x, y;          ///< Position in window pixels
+        float u, v;          ///< Atlas texture coordinate
+        float r, g, b, a;    ///< Color multiplied with the atlas texel
+    };
+
+    UIBatch() = default;
+
+    /**
+     * @brief Releases GPU resources
+     */
+    ~UIBatch();
+
+    UIBatch(const UIBatch&) = delete;
+    UIBatch& operator=(const UIBatch&) = delete;
+
+    /**
+     * @brief Compiles the shader for a GLSL dialect
+     * @param profile Dialect matching the current context
+     * @return true if the batch draws through shaders; false means immediate mode (legacy only)
+     */
+    bool initialize(ShaderProgram::Profile profile = ShaderProgram::Profile::Legacy);
+
+    /**
+     * @brief Drops all queued vertices
+     */
+    void clear() {
+        vertices.clear();
+    }
+
+    /**
+     * @brief Queues an axis-aligned quad as two triangles
+     * @param x0 Left edge in pixels
+     * @param y0 Top edge in pixels
+     * @param x1 Right edge in pixels
+     * @param y1 Bottom edge in pixels
+     * @param glyph Atlas rectangle mapped onto the quad
+     * @param color RGBA color
+     */
+    void addQuad(float x0, float y0, float x1, float y1, const GlyphAtlas::Glyph& glyph, const float color[4]);
+
+    /**
+     * @brief Appends the two triangles of a quad to a vertex array
+     * @param out Array to append to
+     * @see addQuad()
+     */
+    static void appendQuad(std::vector<Vertex>& out, float x0, float y0, float x1, float y1,
+                           const GlyphAtlas::Glyph& glyph, const float color[4]);
+
+    /**
+     * @brief Queues pre-built vertices, moved and recolored
+     * @param layout Vertices relative to the origin (their colors are ignored)
+     * @param dx Horizontal offset in pixels
+     * @param dy Vertical offset in pixels
+     * @param color RGBA color applied to every vertex
+     */
+    void addVertices(const std::vector<Vertex>& layout, float dx, float dy, const float color[4]);
+
+    /**
+     * @brief Draws everything queued and keeps the vertices until clear()
+     * @param projection Pixel-to-clip transform
+     * @param texture Atlas texture
+     * @return Number of draw calls issued (0 when the batch is empty)
+     */
+    int flush(const Mat4& projection, GLuint texture);
+
+    /**
+     * @brief Gets the number of queued vertices
+     * @return Vertex count
+     */
+    size_t getVertexCount() const {
+        return vertices.size();
+    }
+
+    /**
+     * @brief Deletes the GL objects (safe to call more than once)
+     */
+    void release();
+
+    /** Vertex attribute locations */
+    static constexpr GLuint POSITION_ATTRIBUTE = 0;
+    static constexpr GLuint TEXCOORD_ATTRIBUTE = 1;
+    static constexpr GLuint COLOR_ATTRIBUTE = 2;
+
+private:
+    std::vector<Vertex> vertices;        ///< Triangles queued this frame
+    ShaderProgram program;               ///< Textured, vertex-colored program
+    StreamingBuffer vertexBuffer;        ///< Per-frame vertex upload
+    GLuint vertexArray = 0;              ///< Vertex array object (core profile only)
+    GLint projectionLocation = -1;       ///< Uniform location of the projection
+    GLint atlasLocation = -1;            ///< Uniform location of the atlas sampler
+
+    /**
+     * @brief Draws the vertices with glBegin/glEnd when no shader is available
+     * @param projection Pixel-to-clip transform
+     * @param texture Atlas texture
+     */
+    void drawImmediate(const Mat4& projection, GLuint texture) const;
+};
@@ -9,54 +9,104 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <utility>
 #include <functional>
 #include "Camera.h"
+#include "GlyphAtlas.h"
+#include "ShaderProgram.h"
+#include "UIBatch.h"
 
 /**
  * @brief Handles UI rendering and interaction in 2D overlay
  * Following Single Responsibility Principle: focused only on UI rendering
+ *
+ * Everything drawn between beginUIMode() and endUIMode() is queued into one
+ * UIBatch and drawn by endUIMode() with a single draw call: text as quads
+ * from a GlyphAtlas, rectangles from the atlas' solid cell. The quads of
+ * each string are laid out once and reused while the string stays on screen.
  */
 class UIRenderer {
 public:
     UIRenderer(int windowWidth, int windowHeight);
     ~UIRenderer() = default;
 
+    /**
+     * @brief Builds the glyph atlas and the batch shader (needs a current GL context)
+     * @param profile GLSL dialect of the context
+     * @return true if the overlay can be drawn
+     */
+    bool initialize(ShaderProgram::Profile profile = ShaderProgram::Profile::Legacy);
+
     // Core UI rendering operations
     void beginUIMode();
     void endUIMode();
     void renderText(const std::string& text, float x, float y, float scale = 1.0f);
+    void renderRectangle(float x, float y, float width, float height);
     void renderPopupMenu(bool showMenu, int mouseX, int mouseY, CameraController::CameraMode currentMode);
-    
+
+    /**
+     * @brief Sets the color of the text and rectangles queued next
+     */
+    void setColor(float r, float g, float b, float a = 1.0f);
+
+    /**
+     * @brief Gets the draw calls the last endUIMode() issued
+     * @return 0 if nothing was queued, otherwise 1
+     */
+    int getLastDrawCallCount() const {
+        return lastDrawCallCount;
+    }
+
     // Window management
     void setWindowSize(int width, int height);
     void getWindowSize(int& width, int& height) const;
-    
+
     // Interaction handling
     bool isMouseOverMenu(int mouseX, int mouseY) const;
     CameraController::CameraMode getSelectedCameraMode(int mouseX, int mouseY) const;
 
 private:
+    /**
+     * @struct CachedLayout
+     * @brief Glyph quads of one string, relative to its top-left corner
+     */
+    struct CachedLayout {
+        std::vector<UIBatch::Vertex> vertices;
+        unsigned long lastUsedFrame = 0;
+    };
+
     // Text rendering internals
-    void drawCharacter(char c, float x, float y, float scale = 1.0f);
-    void getBitmapFontData(char c, int& width, int& height, unsigned char*& data);
-    
+    const CachedLayout& layoutText(const std::string& text, float scale);
+
     // Menu rendering
     void renderMenuBackground(float x, float y, float width, float height);
     void renderMenuItem(const std::string& text, float x, float y, bool isHighlighted);
-    
+
     // State management
     int windowWidth, windowHeight;
-    
+    GlyphAtlas atlas;
+    UIBatch batch;
+    bool isInitialized = false;
+    float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    int lastDrawCallCount = 0;
+
+    // Layouts keyed by string and scale; dropped after going unused for LAYOUT_CACHE_FRAMES
+    std::map<std::pair<std::string, float>, CachedLayout> layoutCache;
+    unsigned long frameIndex = 0;
+    static constexpr unsigned long LAYOUT_CACHE_FRAMES = 120;
+
     // Menu configuration
     static constexpr float MENU_WIDTH = 200.0f;
     static constexpr float MENU_HEIGHT = 120.0f;
     static constexpr float MENU_ITEM_HEIGHT = 25.0f;
     static constexpr float MENU_PADDING = 10.0f;
-    
-    // Character dimensions for bitmap font
-    static constexpr int CHAR_WIDTH = 8;
-    static constexpr int CHAR_HEIGHT = 12;
-    
+    static constexpr float MENU_BORDER_WIDTH = 1.0f;
+
+    // Character dimensions of the glyph atlas font
+    static constexpr int CHAR_WIDTH = GlyphAtlas::CELL_WIDTH;
+    static constexpr int CHAR_HEIGHT = GlyphAtlas::CELL_HEIGHT;
+
     // Menu position and state
     mutable float lastMenuX = 0.0f;
     mutable float lastMenuY = 0.0f;
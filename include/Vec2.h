@@ -9,34 +9,45 @@
 #include <cmath>
 
 /**
- * @struct Vec2
+ * @struct Vec2T
  * @brief 2D vector structure for position, velocity, and force calculations
- * 
+ * @tparam Scalar Component type
+ *
  * Provides basic 2D vector operations needed for physics simulations.
  * Follows the Single Responsibility Principle by handling only vector math.
+ * Vec2 (float) is what the body store, kernels and renderers use; Vec2d
+ * holds positions that are accumulated in double precision.
  */
-struct Vec2 {
-    float x, y;  ///< X and Y components of the vector
+template <class Scalar>
+struct Vec2T {
+    Scalar x, y;  ///< X and Y components of the vector
 
     /**
      * @brief Default constructor initializes to zero vector
      */
-    Vec2() : x(0.0f), y(0.0f) {}
+    Vec2T() : x(Scalar(0)), y(Scalar(0)) {}
 
     /**
      * @brief Constructs vector with specified components
      * @param x X component
      * @param y Y component
      */
-    Vec2(float x, float y) : x(x), y(y) {}
+    Vec2T(Scalar x, Scalar y) : x(x), y(y) {}
+
+    /**
+     * @brief Converts from a vector of another precision
+     * @param other Vector to convert (rounded when narrowing)
+     */
+    template <class Other>
+    explicit Vec2T(const Vec2T<Other>& other) : x(static_cast<Scalar>(other.x)), y(static_cast<Scalar>(other.y)) {}
 
     /**
      * @brief Vector addition operator
      * @param other Vector to add
      * @return Sum of the two vectors
      */
-    Vec2 operator+(const Vec2& other) const {
-        return Vec2(x + other.x, y + other.y);
+    Vec2T operator+(const Vec2T& other) const {
+        return Vec2T(x + other.x, y + other.y);
     }
 
     /**
@@ -44,8 +55,8 @@ struct Vec2 {
      * @param other Vector to subtract
      * @return Difference of the two vectors
      */
-    Vec2 operator-(const Vec2& other) const {
-        return Vec2(x - other.x, y - other.y);
+    Vec2T operator-(const Vec2T& other) const {
+        return Vec2T(x - other.x, y - other.y);
     }
 
     /**
@@ -53,8 +64,8 @@ struct Vec2 {
      * @param scalar Value to multiply by
      * @return Scaled vector
      */
-    Vec2 operator*(float scalar) const {
-        return Vec2(x * scalar, y * scalar);
+    Vec2T operator*(Scalar scalar) const {
+        return Vec2T(x * scalar, y * scalar);
     }
 
     /**
@@ -62,8 +73,8 @@ struct Vec2 {
      * @param scalar Value to divide by
      * @return Divided vector
      */
-    Vec2 operator/(float scalar) const {
-        return Vec2(x / scalar, y / scalar);
+    Vec2T operator/(Scalar scalar) const {
+        return Vec2T(x / scalar, y / scalar);
     }
 
     /**
@@ -71,7 +82,7 @@ struct Vec2 {
      * @param other Vector to add
      * @return Reference to this vector
      */
-    Vec2& operator+=(const Vec2& other) {
+    Vec2T& operator+=(const Vec2T& other) {
         x += other.x;
         y += other.y;
         return *this;
@@ -82,7 +93,7 @@ struct Vec2 {
      * @param scalar Value to multiply by
      * @return Reference to this vector
      */
-    Vec2& operator*=(float scalar) {
+    Vec2T& operator*=(Scalar scalar) {
         x *= scalar;
         y *= scalar;
         return *this;
@@ -92,7 +103,7 @@ struct Vec2 {
      * @brief Calculates the squared magnitude of the vector
      * @return Squared magnitude (avoids expensive sqrt operation)
      */
-    float magnitudeSquared() const {
+    Scalar magnitudeSquared() const {
         return x * x + y * y;
     }
 
@@ -100,7 +111,7 @@ struct Vec2 {
      * @brief Calculates the magnitude of the vector
      * @return Magnitude of the vector
      */
-    float magnitude() const {
+    Scalar magnitude() const {
         return std::sqrt(magnitudeSquared());
     }
 
@@ -108,11 +119,17 @@ struct Vec2 {
      * @brief Returns a normalized version of the vector
      * @return Unit vector in the same direction
      */
-    Vec2 normalized() const {
-        float mag = magnitude();
-        if (mag > 0.0f) {
-            return Vec2(x / mag, y / mag);
+    Vec2T normalized() const {
+        Scalar mag = magnitude();
+        if (mag > Scalar(0)) {
+            return Vec2T(x / mag, y / mag);
         }
-        return Vec2(0.0f, 0.0f);
+        return Vec2T(Scalar(0), Scalar(0));
     }
 };
+
+/** Single precision vector used throughout the body store, solvers and renderers */
+using Vec2 = Vec2T<float>;
+
+/** Double precision vector for accumulated positions */
+using Vec2d = Vec2T<double>;
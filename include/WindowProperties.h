@@ -19,13 +19,45 @@ struct WindowProperties {
     int width;          ///< Width of the window in pixels
     int height;         ///< Height of the window in pixels
     const char* title;  ///< Title displayed in the window's title bar
+    int contextMajor;   ///< Requested OpenGL major version
+    int contextMinor;   ///< Requested OpenGL minor version
+    bool coreProfile;   ///< Request a forward-compatible core profile instead of the default one
+    bool visible;       ///< Show the window; hidden windows only provide a context for offscreen rendering
     
     /**
      * @brief Constructs WindowProperties with specified or default values
      * @param w Window width in pixels (default: 800)
      * @param h Window height in pixels (default: 600)
      * @param t Window title (default: "OpenGL Application")
+     * 
+     * The context defaults to OpenGL 2.1 so immediate mode and the
+     * fixed-function matrix stack are available.
      */
     WindowProperties(int w = 800, int h = 600, const char* t = "OpenGL Application")
-        : width(w), height(h), title(t) {}
+        : width(w), height(h), title(t), contextMajor(2), contextMinor(1), coreProfile(false),
+          visible(true) {}
+    
+    /**
+     * @brief Requests a core-profile context of at least the given version
+     * @param major OpenGL major version (3 or later)
+     * @param minor OpenGL minor version
+     * @return Copy of these properties with the core profile requested
+     */
+    WindowProperties withCoreProfile(int major, int minor) const {
+        WindowProperties properties = *this;
+        properties.contextMajor = major;
+        properties.contextMinor = minor;
+        properties.coreProfile = true;
+        return properties;
+    }
+
+    /**
+     * @brief Requests a window that is never shown
+     * @return Copy of these properties with the window hidden
+     */
+    WindowProperties hidden() const {
+        WindowProperties properties = *this;
+        properties.visible = false;
+        return properties;
+    }
 };
@@ -8,29 +8,216 @@
 #include "include/Application.h"
 #include "include/GLFWWindow.h"
 #include "include/GravityRenderer.h"
+#include "include/CoreGravityRenderer.h"
+#include "include/GpuNBodySimulation.h"
 #include "include/GravitySimulation.h"
+#include "include/SimulationThread.h"
+#include "include/Integrators.h"
+#include "include/DirectForceSolver.h"
+#include "include/BarnesHutSolver.h"
+#include "include/BodyGenerators.h"
 #include "include/Camera.h"
 #include "include/UIRenderer.h"
+#include "include/Profiler.h"
+#include "include/GpuTimer.h"
+#include "include/ProfilerOverlay.h"
+#include "include/FrameScheduler.h"
+#include "include/Checkpoint.h"
+#include "include/TrajectoryRecorder.h"
+#include "include/TrajectoryPlayer.h"
+#include "include/FrameCapture.h"
 #include "include/WindowProperties.h"
 #include <memory>
 #include <iostream>
-#include <chrono>
-#include <thread>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
 #include <GLFW/glfw3.h>
 
+/**
+ * @brief Startup options parsed from the command line
+ */
+struct LaunchOptions {
+    bool threadedSimulation = false;   ///< Step physics on its own thread (--threaded-sim)
+    float simulationRate = 240.0f;     ///< Physics tick rate in threaded mode (--sim-rate=HZ)
+    std::string solver = "direct";     ///< Body-body force solver (--solver=direct|barnes-hut)
+    float theta = 0.5f;                ///< Barnes-Hut opening angle (--theta=T)
+    std::string integrator = "leapfrog"; ///< Time integration scheme (--integrator=NAME)
+    bool customIntegrator = false;     ///< --integrator was given
+    PositionPrecision positionPrecision = PositionPrecision::Single; ///< Position accumulation (--precision=single|compensated|double)
+    bool particleMeshField = false;    ///< Evaluate the grid field with FFTs (--field=pm)
+    bool coreRenderer = false;         ///< Render through the OpenGL 3.3 core backend (--renderer=core)
+    bool gpuCompute = false;           ///< Step bodies and grid in compute shaders (--compute=gpu, implies core)
+    bool showProfiler = false;         ///< Start with the frame-time overlay visible (--profile)
+    std::string tracePath;             ///< Chrome trace written on exit (--trace=FILE)
+    FrameScheduler::Mode frameMode = FrameScheduler::Mode::VSync; ///< Frame pacing (--frame-rate=vsync|uncapped|HZ)
+    float targetFrameRate = 60.0f;     ///< Frame cap when pacing with --frame-rate=HZ
+    std::string checkpointPath;        ///< Saved with F5 and on exit, reloaded with F9 (--checkpoint=FILE)
+    std::string resumePath;            ///< Checkpoint loaded at startup (--resume=FILE)
+    CollisionResolver::Mode collisions = CollisionResolver::Mode::None; ///< Touching bodies (--collisions=none|merge|inelastic)
+    std::string recordPath;            ///< Trajectory file written while running (--record=FILE)
+    TrajectoryRecorder::Settings recording; ///< Decimation (--record-every=N) and compression (--record-raw)
+    std::string playPath;              ///< Recording shown instead of simulating (--play=FILE)
+    bool playbackGrid = true;          ///< Refresh the grid for every shown frame (--play-grid=on|off)
+    std::string capturePath;           ///< Render offscreen to a PNG pattern or "|encoder command" (--capture=OUTPUT)
+    int captureWidth = 1920;           ///< Captured frame width (--capture-size=WxH)
+    int captureHeight = 1080;          ///< Captured frame height
+    int captureFrames = 600;           ///< Frames to capture before exiting (--capture-frames=N)
+    float captureFrameRate = 60.0f;    ///< Video frame rate; sets the simulated time per frame (--capture-fps=HZ)
+    ForceLaw forceLaw;                 ///< Body-body softening (--softening=clamped|plummer, --softening-length=L) and clamp (--force-clamp=on|off)
+    bool customForceLaw = false;       ///< Any force law option was given
+    std::string scene = "solar";       ///< Initial bodies (--scene=solar|plummer|disc|galaxies)
+    size_t sceneBodies = 2000;         ///< Bodies in a generated scene (--scene-bodies=N)
+
+    /**
+     * @brief Parses command line arguments, ignoring unknown ones
+     * @param argc Argument count
+     * @param argv Argument values
+     * @return Parsed options
+     */
+    static LaunchOptions parse(int argc, char** argv) {
+        LaunchOptions options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--threaded-sim") {
+                options.threadedSimulation = true;
+            } else if (arg.rfind("--sim-rate=", 0) == 0) {
+                options.simulationRate = std::strtof(arg.c_str() + 11, nullptr);
+            } else if (arg.rfind("--solver=", 0) == 0) {
+                options.solver = arg.substr(9);
+            } else if (arg.rfind("--theta=", 0) == 0) {
+                options.theta = std::strtof(arg.c_str() + 8, nullptr);
+            } else if (arg.rfind("--integrator=", 0) == 0) {
+                options.integrator = arg.substr(13);
+                options.customIntegrator = true;
+            } else if (arg.rfind("--precision=", 0) == 0) {
+                if (!parsePositionPrecision(arg.substr(12), options.positionPrecision)) {
+                    std::cerr << "Ignoring unknown precision: " << arg.substr(12) << "\n";
+                }
+            } else if (arg == "--field=pm") {
+                options.particleMeshField = true;
+            } else if (arg == "--field=direct") {
+                options.particleMeshField = false;
+            } else if (arg == "--renderer=core") {
+                options.coreRenderer = true;
+            } else if (arg == "--renderer=legacy") {
+                options.coreRenderer = false;
+            } else if (arg == "--compute=gpu") {
+                options.gpuCompute = true;
+            } else if (arg == "--compute=cpu") {
+                options.gpuCompute = false;
+            } else if (arg == "--profile") {
+                options.showProfiler = true;
+            } else if (arg.rfind("--trace=", 0) == 0) {
+                options.tracePath = arg.substr(8);
+            } else if (arg.rfind("--checkpoint=", 0) == 0) {
+                options.checkpointPath = arg.substr(13);
+            } else if (arg.rfind("--resume=", 0) == 0) {
+                options.resumePath = arg.substr(9);
+            } else if (arg.rfind("--record=", 0) == 0) {
+                options.recordPath = arg.substr(9);
+            } else if (arg.rfind("--record-every=", 0) == 0) {
+                options.recording.decimation = std::max(1, std::atoi(arg.c_str() + 15));
+            } else if (arg == "--record-raw") {
+                options.recording.compress = false;
+            } else if (arg.rfind("--play=", 0) == 0) {
+                options.playPath = arg.substr(7);
+            } else if (arg == "--play-grid=on") {
+                options.playbackGrid = true;
+            } else if (arg == "--play-grid=off") {
+                options.playbackGrid = false;
+            } else if (arg.rfind("--capture=", 0) == 0) {
+                options.capturePath = arg.substr(10);
+            } else if (arg.rfind("--capture-size=", 0) == 0) {
+                std::sscanf(arg.c_str() + 15, "%dx%d", &options.captureWidth, &options.captureHeight);
+            } else if (arg.rfind("--capture-frames=", 0) == 0) {
+                options.captureFrames = std::atoi(arg.c_str() + 17);
+            } else if (arg.rfind("--capture-fps=", 0) == 0) {
+                options.captureFrameRate = std::strtof(arg.c_str() + 14, nullptr);
+            } else if (arg == "--softening=clamped") {
+                options.forceLaw.softening = Softening::Clamped;
+                options.customForceLaw = true;
+            } else if (arg == "--softening=plummer") {
+                options.forceLaw.softening = Softening::Plummer;
+                options.customForceLaw = true;
+            } else if (arg.rfind("--softening-length=", 0) == 0) {
+                options.forceLaw.softeningLength = std::strtof(arg.c_str() + 19, nullptr);
+                options.customForceLaw = true;
+            } else if (arg == "--force-clamp=on") {
+                options.forceLaw.clampForce = true;
+                options.customForceLaw = true;
+            } else if (arg == "--force-clamp=off") {
+                options.forceLaw.clampForce = false;
+                options.customForceLaw = true;
+            } else if (arg.rfind("--scene=", 0) == 0) {
+                options.scene = arg.substr(8);
+            } else if (arg.rfind("--scene-bodies=", 0) == 0) {
+                options.sceneBodies = static_cast<size_t>(std::max(1L, std::atol(arg.c_str() + 15)));
+            } else if (arg == "--collisions=none") {
+                options.collisions = CollisionResolver::Mode::None;
+            } else if (arg == "--collisions=merge") {
+                options.collisions = CollisionResolver::Mode::Merge;
+            } else if (arg == "--collisions=inelastic") {
+                options.collisions = CollisionResolver::Mode::Inelastic;
+            } else if (arg == "--frame-rate=vsync") {
+                options.frameMode = FrameScheduler::Mode::VSync;
+            } else if (arg == "--frame-rate=uncapped") {
+                options.frameMode = FrameScheduler::Mode::Uncapped;
+            } else if (arg.rfind("--frame-rate=", 0) == 0 && std::strtof(arg.c_str() + 13, nullptr) > 0.0f) {
+                options.frameMode = FrameScheduler::Mode::Capped;
+                options.targetFrameRate = std::strtof(arg.c_str() + 13, nullptr);
+            } else {
+                std::cerr << "Ignoring unknown option: " << arg << "\n";
+            }
+        }
+        if (!options.capturePath.empty()) {
+            // Captured frames advance simulated time by exactly one video frame each
+            options.frameMode = FrameScheduler::Mode::Offline;
+            options.targetFrameRate = options.captureFrameRate > 0.0f ? options.captureFrameRate : 60.0f;
+        }
+        return options;
+    }
+
+    /**
+     * @brief Creates the force solver selected by --solver and --theta
+     * @return Solver instance; unknown names fall back to the direct solver
+     */
+    std::unique_ptr<IForceSolver> createForceSolver() const {
+        if (solver == "barnes-hut") {
+            return std::make_unique<BarnesHutSolver>(std::max(0.0f, theta));
+        }
+        if (solver != "direct") {
+            std::cerr << "Unknown solver '" << solver << "', using direct\n";
+        }
+        return std::make_unique<DirectForceSolver>();
+    }
+
+    /**
+     * @brief Creates the integrator selected by --integrator
+     * @return Integrator instance, or nullptr when the name is unknown
+     */
+    std::unique_ptr<IIntegrator> createIntegrator() const {
+        return ::createIntegrator(integrator);
+    }
+};
+
 /**
  * @brief Modern application following SOLID principles with component separation
  */
 class ModernGravityApplication : public Application {
 public:
-    ModernGravityApplication(std::unique_ptr<IWindow> window, std::unique_ptr<GravityRenderer> renderer)
-        : Application(std::move(window), std::move(renderer)) {
-        gravityRenderer = static_cast<GravityRenderer*>(this->renderer.get());
-        gravitySimulation = std::make_unique<GravitySimulation>(800.0f, 600.0f, 25);
+    ModernGravityApplication(std::unique_ptr<IWindow> window, std::unique_ptr<IGravityRenderer> renderer,
+                             const LaunchOptions& options = LaunchOptions())
+        : Application(std::move(window), std::move(renderer)), options(options),
+          frameScheduler(options.frameMode, options.targetFrameRate, SIMULATION_STEP_RATE) {
+        gravityRenderer = static_cast<IGravityRenderer*>(this->renderer.get());
+        gravitySimulation = std::make_unique<GravitySimulation>(800.0f, 600.0f, 25, options.createForceSolver());
         
         // Initialize separated components following SOLID principles
         cameraController = std::make_unique<CameraController>();
         uiRenderer = std::make_unique<UIRenderer>(800, 600);
+        profiler = std::make_unique<Profiler>();
     }
 
     bool initialize() override {
@@ -38,8 +225,65 @@ public:
             return false;
         }
         
+        if (options.particleMeshField) {
+            gravitySimulation->getGravityGrid()->setFieldMethod(GravityGrid::FieldMethod::ParticleMesh);
+        }
         gravitySimulation->initialize();
+        if (options.scene != "solar") {
+            generateScene();
+        }
+        gravitySimulation->setCollisionMode(options.collisions);
+        if (options.customForceLaw && gravitySimulation->setForceLaw(options.forceLaw)) {
+            std::cout << "Force law: " << ForceLaw::getSofteningName(options.forceLaw.softening)
+                      << " softening at " << options.forceLaw.softeningLength << ", force clamp "
+                      << (options.forceLaw.clampForce ? "on" : "off") << "\n";
+        }
+        if (options.positionPrecision != PositionPrecision::Single) {
+            gravitySimulation->setPositionPrecision(options.positionPrecision);
+            std::cout << "Positions accumulated in " << getPositionPrecisionName(options.positionPrecision)
+                      << " precision\n";
+        }
+        if (auto selectedIntegrator = options.createIntegrator()) {
+            gravitySimulation->setIntegrator(std::move(selectedIntegrator));
+        } else {
+            std::cerr << "Unknown integrator '" << options.integrator << "', using "
+                      << gravitySimulation->getIntegrator().getName() << "\n";
+        }
+        // A checkpoint brings its own integrator and cached state, which the resume must keep
+        if (!options.resumePath.empty() && Checkpoint::load(*gravitySimulation, options.resumePath)) {
+            std::cout << "Resumed " << gravitySimulation->getBodyCount() << " bodies at t="
+                      << gravitySimulation->getSimulationTime() << " from " << options.resumePath << "\n";
+            if (options.customIntegrator && options.integrator != gravitySimulation->getIntegrator().getName()) {
+                std::cerr << options.resumePath << " continues with its saved integrator "
+                          << gravitySimulation->getIntegrator().getName() << "; ignoring --integrator="
+                          << options.integrator << "\n";
+            }
+        }
         setupSimulationRenderer();
+        if (!options.playPath.empty()) {
+            startPlayback();
+        }
+        if (!options.recordPath.empty()) {
+            startRecording();
+        }
+        setupProfiler();
+        if (!uiRenderer->initialize(options.coreRenderer ? ShaderProgram::Profile::Core
+                                                         : ShaderProgram::Profile::Legacy)) {
+            std::cerr << "UI overlay unavailable\n";
+        }
+        if (options.gpuCompute) {
+            startGpuSimulation();
+        }
+        
+        if (!options.capturePath.empty() && !startCapture()) {
+            return false;
+        }
+        
+        if (options.threadedSimulation && !gpuSimulation) {
+            // Physics runs at its own fixed rate; the renderer consumes published snapshots
+            simulationThread = std::make_unique<SimulationThread>(*gravitySimulation, options.simulationRate);
+            gravityRenderer->setSnapshotSource(&simulationThread->getSnapshotBuffer());
+        }
         return true;
     }
 
@@ -52,6 +296,10 @@ public:
         std::cout << "Starting main loop (Press ESC to exit)\n";
         std::cout << "Camera Controls:\n";
         std::cout << "  - M: Open camera mode menu\n";
+        std::cout << "  - P: Toggle the frame-time profiler\n";
+        if (!options.checkpointPath.empty()) {
+            std::cout << "  - F5: Save checkpoint, F9: Reload it (also saved on exit)\n";
+        }
         std::cout << "  - Mouse: Hold left button and drag to rotate camera\n";
         std::cout << "  - W/S: Move forward/backward\n";
         std::cout << "  - A/D: Move left/right\n";
@@ -61,7 +309,6 @@ public:
         std::cout << "  - SPACE: Hold to accelerate time (5x speed)\n";
         std::cout << "Current Mode: Free-flight\n";
         
-        float baseTimeStep = 0.016f; // ~60 FPS base time step
         float timeMultiplier = 1.0f;
         
         // Variables for mouse tracking
@@ -69,6 +316,12 @@ public:
         bool firstMouse = true;
         GLFWwindow* glfwWindow = static_cast<GLFWwindow*>(window->getNativeWindow());
         
+        // Pacing comes from the scheduler, not from sleeping a fixed time
+        window->setSwapInterval(frameScheduler.getSwapInterval());
+        if (simulationThread) {
+            simulationThread->start();
+        }
+        
         // Main application loop with separated components
         while (!window->shouldClose()) {
             // Check for ESC key to exit
@@ -83,66 +336,340 @@ public:
                 timeMultiplier = 1.0f; // Normal speed
             }
             
-            float deltaTime = baseTimeStep * timeMultiplier;
+            float frameTime = frameScheduler.beginFrame();
             
             // Handle input using separated input system
-            handleInput(glfwWindow, lastMouseX, lastMouseY, firstMouse, deltaTime);
+            handleInput(glfwWindow, lastMouseX, lastMouseY, firstMouse, frameTime);
             
-            // Update simulation
-            gravitySimulation->update(deltaTime);
+            profiler->beginFrame();
+            
+            // Run the fixed steps that are due, then refresh the grid once for all of them
+            // (the simulation thread keeps its own clock in threaded mode)
+            float deltaTime = frameScheduler.getFixedTimeStep() * timeMultiplier;
+            if (trajectoryPlayer) {
+                // Recorded time advances like simulated time would; only the shown frame is decoded
+                while (frameScheduler.takeSimulationStep()) {
+                    playbackTime += deltaTime;
+                }
+                if (playbackTime > trajectoryPlayer->getEndTime()) {
+                    playbackTime = trajectoryPlayer->getStartTime();
+                }
+                Profiler::Scope scope(profiler.get(), Profiler::Phase::Bodies);
+                trajectoryPlayer->seek(playbackTime);
+            } else if (gpuSimulation) {
+                float g = gravitySimulation->getGravitationalConstant();
+                int steps = 0;
+                while (frameScheduler.takeSimulationStep()) {
+                    Profiler::Scope scope(profiler.get(), Profiler::Phase::Bodies, true);
+                    gpuSimulation->step(deltaTime, g);
+                    ++steps;
+                }
+                if (steps > 0) {
+                    Profiler::Scope scope(profiler.get(), Profiler::Phase::Grid, true);
+                    gpuSimulation->updateField(g);
+                    // The CPU simulation keeps the clock for checkpoints
+                    gravitySimulation->setClock(gravitySimulation->getSimulationTime() + steps * deltaTime,
+                                                gravitySimulation->getStepCount() + steps);
+                }
+            } else if (simulationThread) {
+                simulationThread->setTimeScale(timeMultiplier);
+            } else {
+                int steps = 0;
+                while (frameScheduler.takeSimulationStep()) {
+                    gravitySimulation->stepBodies(deltaTime);
+                    ++steps;
+                }
+                if (steps > 0) {
+                    gravitySimulation->updateGrid();
+                }
+            }
             
             // Render using new separated components
+            frameCapture.beginFrame();
             renderFrame();
+            frameCapture.endFrame();
             
-            // Swap buffers and poll events
-            window->swapBuffers();
+            // Swap buffers and poll events; captured frames never reach the hidden window
+            if (!frameCapture.isActive()) {
+                Profiler::Scope scope(profiler.get(), Profiler::Phase::Swap);
+                window->swapBuffers();
+            } else if (frameCapture.getCapturedFrameCount() >= static_cast<uint64_t>(options.captureFrames)) {
+                glfwSetWindowShouldClose(glfwWindow, GLFW_TRUE);
+            }
+            profiler->endFrame();
             window->pollEvents();
-            
-            // Small delay to control frame rate
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            frameScheduler.endFrame();
+        }
+        
+        if (simulationThread) {
+            simulationThread->stop();
+        }
+        if (frameCapture.isActive()) {
+            frameCapture.finish();
+            std::cout << "Captured " << frameCapture.getCapturedFrameCount() << " frames to " << options.capturePath;
+            if (frameCapture.getFailedFrameCount() > 0) {
+                std::cout << " (" << frameCapture.getFailedFrameCount() << " could not be written)";
+            }
+            std::cout << "\n";
+        }
+        if (!options.checkpointPath.empty()) {
+            saveCheckpoint();
+        }
+        if (trajectoryRecorder.isRecording()) {
+            trajectoryRecorder.stop();
+            std::cout << "Recorded " << trajectoryRecorder.getRecordedFrameCount() << " frames ("
+                      << trajectoryRecorder.getBytesWritten() / 1024 << " KiB) to " << options.recordPath;
+            if (trajectoryRecorder.getDroppedFrameCount() > 0) {
+                std::cout << ", dropped " << trajectoryRecorder.getDroppedFrameCount() << " while the writer fell behind";
+            }
+            std::cout << "\n";
+        }
+        if (frameScheduler.getDroppedStepCount() > 0) {
+            std::cout << "Dropped " << frameScheduler.getDroppedStepCount()
+                      << " simulation steps to catch up after slow frames\n";
+        }
+        if (!options.tracePath.empty() && profiler->writeChromeTrace(options.tracePath)) {
+            std::cout << "Wrote frame trace to " << options.tracePath << "\n";
         }
         
         std::cout << "Main loop ended\n";
     }
 
 private:
+    LaunchOptions options;
+    TrajectoryRecorder trajectoryRecorder;              // Outlives the simulation that feeds it
+    std::unique_ptr<TrajectoryPlayer> trajectoryPlayer; // Replaces the simulation for the renderer when set
+    double playbackTime = 0.0;                          // Recorded time shown by trajectoryPlayer
     std::unique_ptr<GravitySimulation> gravitySimulation;
-    GravityRenderer* gravityRenderer; // Non-owning pointer
+    std::unique_ptr<Profiler> profiler;                 // Outlives the simulation thread that reports to it
+    std::unique_ptr<SimulationThread> simulationThread; // Declared after the simulation it steps
+    std::shared_ptr<GpuNBodySimulation> gpuSimulation;  // Replaces the CPU update when set
+    IGravityRenderer* gravityRenderer; // Non-owning pointer
     
     // Separated components following SOLID principles
     std::unique_ptr<CameraController> cameraController;
     std::unique_ptr<UIRenderer> uiRenderer;
+    ProfilerOverlay profilerOverlay;
+    FrameScheduler frameScheduler;
+    FrameCapture frameCapture;                          // Offscreen target when --capture is given
+    
+    /** Fixed simulation steps per second of wall time (unthreaded CPU and GPU modes) */
+    static constexpr float SIMULATION_STEP_RATE = 60.0f;
+    
+    /** Frame rate the camera's per-frame movement speeds were tuned for */
+    static constexpr float CAMERA_REFERENCE_RATE = 60.0f;
     
     // UI state
     bool menuVisible = false;
+    bool profilerVisible = false;
     CameraController::CameraMode selectedCameraMode = CameraController::CameraMode::FreeFlight;
 
     void setupSimulationRenderer() {
-        auto gravityRendererShared = std::shared_ptr<GravityRenderer>(
-            gravityRenderer, [](GravityRenderer*){} // Empty deleter since we don't own it
+        auto gravityRendererShared = std::shared_ptr<IGravityRenderer>(
+            gravityRenderer, [](IGravityRenderer*){} // Empty deleter since we don't own it
         );
         gravitySimulation->setupRenderer(gravityRendererShared);
     }
 
+    /**
+     * @brief Replaces the default bodies with the scene given by --scene
+     */
+    void generateScene() {
+        auto world = gravitySimulation->getGravityGrid()->getWorldDimensions();
+        auto generator = createSceneGenerator(options.scene, options.sceneBodies, world.first, world.second);
+        if (!generator) {
+            std::cerr << "Unknown scene '" << options.scene << "', keeping the solar system\n";
+            return;
+        }
+        gravitySimulation->clearBodies();
+        gravitySimulation->reserveBodies(generator->getBodyCount());
+        gravitySimulation->addBodies(*generator);
+        std::cout << "Generated " << generator->getName() << " scene with "
+                  << gravitySimulation->getBodyCount() << " bodies\n";
+    }
+
+    /**
+     * @brief Connects the profiler to the timed components
+     * 
+     * It records only while the overlay is shown or a trace was requested.
+     */
+    void setupProfiler() {
+        profilerVisible = options.showProfiler;
+        profiler->setEnabled(profilerVisible || !options.tracePath.empty());
+        profiler->initializeGpuTimers(std::make_unique<GpuTimer>());
+        gravitySimulation->setProfiler(profiler.get());
+        gravityRenderer->setProfiler(profiler.get());
+    }
+
+    /**
+     * @brief Points the renderer at the recording given with --play instead of the simulation
+     * 
+     * Options that act on a running simulation are switched off. Falls back
+     * to simulating if the recording cannot be read.
+     */
+    void startPlayback() {
+        auto player = std::make_unique<TrajectoryPlayer>(25);
+        player->setGridUpdates(options.playbackGrid);
+        if (options.particleMeshField) {
+            player->setFieldMethod(GravityGrid::FieldMethod::ParticleMesh);
+        }
+        if (!player->open(options.playPath)) {
+            std::cerr << "Cannot play " << options.playPath << ", simulating instead\n";
+            return;
+        }
+        gravityRenderer->setGravityGrid(player->getGravityGrid());
+        gravityRenderer->setBodyStore(player->getBodyStore());
+        playbackTime = player->getStartTime();
+        std::cout << "Playing " << player->getReader().getFrameCount() << " frames (t=" << player->getStartTime()
+                  << " to " << player->getEndTime() << ") from " << options.playPath << "\n";
+
+        if (options.threadedSimulation || options.gpuCompute || !options.recordPath.empty() ||
+            !options.checkpointPath.empty()) {
+            std::cerr << "--threaded-sim, --compute=gpu, --record and --checkpoint have no effect with --play\n";
+        }
+        options.threadedSimulation = false;
+        options.gpuCompute = false;
+        options.recordPath.clear();
+        options.checkpointPath.clear();
+        trajectoryPlayer = std::move(player);
+    }
+
+    /**
+     * @brief Renders into an offscreen framebuffer of the --capture-size instead of the window
+     * @return false if capturing is impossible
+     */
+    bool startCapture() {
+        if (!frameCapture.initialize(options.captureWidth, options.captureHeight, options.capturePath)) {
+            return false;
+        }
+        gravityRenderer->setViewportSize(static_cast<float>(options.captureWidth),
+                                         static_cast<float>(options.captureHeight));
+        std::cout << "Capturing " << options.captureFrames << " " << options.captureWidth << "x"
+                  << options.captureHeight << " frames at " << options.targetFrameRate << " fps to "
+                  << options.capturePath << "\n";
+        if (options.threadedSimulation) {
+            std::cerr << "--threaded-sim steps on the wall clock, so captured motion will not match the frame rate\n";
+        }
+        return true;
+    }
+
+    /**
+     * @brief Streams every body step of the CPU simulation to --record
+     */
+    void startRecording() {
+        auto world = gravitySimulation->getGravityGrid()->getWorldDimensions();
+        if (trajectoryRecorder.start(options.recordPath, options.recording,
+                                     gravitySimulation->getGravitationalConstant(), world.first, world.second)) {
+            gravitySimulation->setRecorder(&trajectoryRecorder);
+            std::cout << "Recording every " << options.recording.decimation << " step(s) to " << options.recordPath
+                      << (options.recording.compress ? " (delta compressed)\n" : " (raw)\n");
+        }
+    }
+
+    /**
+     * @brief Moves the initial bodies into a compute-shader simulation the renderer draws from
+     * 
+     * Falls back to the CPU simulation if the kernels cannot be built.
+     */
+    void startGpuSimulation() {
+        auto simulation = std::make_shared<GpuNBodySimulation>(800.0f, 600.0f);
+        if (!simulation->initialize() || !gravityRenderer->setGpuSimulation(simulation)) {
+            std::cerr << "GPU simulation unavailable, simulating on the CPU\n";
+            return;
+        }
+        
+        auto dimensions = gravitySimulation->getGravityGrid()->getGridDimensions();
+        simulation->upload(*gravitySimulation->getBodyStore());
+        simulation->setGridDimensions(dimensions.first, dimensions.second);
+        simulation->updateField(gravitySimulation->getGravitationalConstant());
+        gpuSimulation = simulation;
+        
+        std::cout << "Simulating " << simulation->getBodyCount() << " bodies in compute shaders (leapfrog, direct sum)\n";
+        if (options.threadedSimulation) {
+            std::cerr << "--threaded-sim has no effect with --compute=gpu\n";
+        }
+        if (trajectoryRecorder.isRecording()) {
+            std::cerr << "--record has no effect with --compute=gpu\n";
+        }
+        if (options.customForceLaw) {
+            std::cerr << "--softening and --force-clamp have no effect with --compute=gpu\n";
+        }
+    }
+
+    /**
+     * @brief Writes the current state to --checkpoint, pausing the simulation thread meanwhile
+     */
+    void saveCheckpoint() {
+        bool paused = simulationThread && simulationThread->isRunning();
+        if (paused) simulationThread->stop();
+        
+        bool saved;
+        if (gpuSimulation) {
+            // Bodies live on the GPU; its fixed leapfrog keeps no state worth saving
+            BodyStore bodies;
+            gpuSimulation->download(bodies);
+            Checkpoint::Info info;
+            info.gravitationalConstant = gravitySimulation->getGravitationalConstant();
+            auto world = gravitySimulation->getGravityGrid()->getWorldDimensions();
+            info.worldWidth = world.first;
+            info.worldHeight = world.second;
+            info.simulationTime = gravitySimulation->getSimulationTime();
+            info.stepCount = gravitySimulation->getStepCount();
+            info.integrator = "leapfrog";
+            saved = Checkpoint::write(options.checkpointPath, bodies, info, IntegratorState());
+        } else {
+            saved = Checkpoint::save(*gravitySimulation, options.checkpointPath);
+        }
+        if (saved) {
+            std::cout << "Saved checkpoint at t=" << gravitySimulation->getSimulationTime()
+                      << " to " << options.checkpointPath << "\n";
+        }
+        
+        if (paused) simulationThread->start();
+    }
+
+    /**
+     * @brief Restores the state saved in --checkpoint
+     */
+    void loadCheckpoint() {
+        bool paused = simulationThread && simulationThread->isRunning();
+        if (paused) simulationThread->stop();
+        
+        if (Checkpoint::load(*gravitySimulation, options.checkpointPath)) {
+            if (gpuSimulation) {
+                gpuSimulation->upload(*gravitySimulation->getBodyStore());
+                gpuSimulation->updateField(gravitySimulation->getGravitationalConstant());
+            }
+            std::cout << "Reloaded checkpoint at t=" << gravitySimulation->getSimulationTime() << "\n";
+        }
+        
+        if (paused) simulationThread->start();
+    }
+
     void renderFrame() {
         // Use the new separated rendering approach
         gravityRenderer->render(*cameraController, uiRenderer.get());
         
-        // Handle UI overlay if menu is visible
-        if (menuVisible) {
-            // Get current mouse position for menu interaction
-            GLFWwindow* glfwWindow = static_cast<GLFWwindow*>(window->getNativeWindow());
-            double mouseX, mouseY;
-            glfwGetCursorPos(glfwWindow, &mouseX, &mouseY);
-            
+        // Handle UI overlays (camera menu and frame-time graph)
+        if (menuVisible || profilerVisible) {
+            Profiler::Scope scope(profiler.get(), Profiler::Phase::UI, true);
             uiRenderer->beginUIMode();
-            uiRenderer->renderPopupMenu(menuVisible, static_cast<int>(mouseX), static_cast<int>(mouseY), 
-                                      cameraController->getCurrentMode());
+            if (menuVisible) {
+                // Get current mouse position for menu interaction
+                GLFWwindow* glfwWindow = static_cast<GLFWwindow*>(window->getNativeWindow());
+                double mouseX, mouseY;
+                glfwGetCursorPos(glfwWindow, &mouseX, &mouseY);
+                uiRenderer->renderPopupMenu(menuVisible, static_cast<int>(mouseX), static_cast<int>(mouseY), 
+                                          cameraController->getCurrentMode());
+            }
+            if (profilerVisible) {
+                profilerOverlay.render(*uiRenderer, *profiler);
+            }
             uiRenderer->endUIMode();
         }
     }
 
-    void handleInput(GLFWwindow* glfwWindow, double& lastMouseX, double& lastMouseY, bool& firstMouse, float deltaTime) {
+    void handleInput(GLFWwindow* glfwWindow, double& lastMouseX, double& lastMouseY, bool& firstMouse, float frameTime) {
         // Check for menu toggle (M key)
         static bool mPressed = false;
         bool mCurrentlyPressed = glfwGetKey(glfwWindow, GLFW_KEY_M) == GLFW_PRESS;
@@ -152,6 +679,26 @@ private:
         }
         mPressed = mCurrentlyPressed;
         
+        // Check for profiler toggle (P key); recording continues while a trace is requested
+        static bool pPressed = false;
+        bool pCurrentlyPressed = glfwGetKey(glfwWindow, GLFW_KEY_P) == GLFW_PRESS;
+        if (pCurrentlyPressed && !pPressed) {
+            profilerVisible = !profilerVisible;
+            profiler->setEnabled(profilerVisible || !options.tracePath.empty());
+        }
+        pPressed = pCurrentlyPressed;
+        
+        // Checkpoint save (F5) and reload (F9)
+        static bool saveKeyPressed = false, loadKeyPressed = false;
+        bool saveKeyCurrentlyPressed = glfwGetKey(glfwWindow, GLFW_KEY_F5) == GLFW_PRESS;
+        bool loadKeyCurrentlyPressed = glfwGetKey(glfwWindow, GLFW_KEY_F9) == GLFW_PRESS;
+        if (!options.checkpointPath.empty()) {
+            if (saveKeyCurrentlyPressed && !saveKeyPressed) saveCheckpoint();
+            if (loadKeyCurrentlyPressed && !loadKeyPressed) loadCheckpoint();
+        }
+        saveKeyPressed = saveKeyCurrentlyPressed;
+        loadKeyPressed = loadKeyCurrentlyPressed;
+        
         // Handle mouse input
         double mouseX, mouseY;
         glfwGetCursorPos(glfwWindow, &mouseX, &mouseY);
@@ -214,24 +761,55 @@ private:
             if (glfwGetKey(glfwWindow, GLFW_KEY_Q) == GLFW_PRESS) up = 1.0f;
             if (glfwGetKey(glfwWindow, GLFW_KEY_E) == GLFW_PRESS) up = -1.0f;
             
-            cameraController->updateFromKeyboard(forward, right, up);
+            // Camera speeds are per frame at CAMERA_REFERENCE_RATE; scale so motion follows wall time
+            float movementScale = frameTime * CAMERA_REFERENCE_RATE;
+            cameraController->updateFromKeyboard(forward * movementScale, right * movementScale, up * movementScale);
         }
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
     try {
+        LaunchOptions options = LaunchOptions::parse(argc, argv);
+        
         // Create window properties for the solar system simulation
         WindowProperties props(800, 600, "Solar System Simulator - SOLID Architecture");
+        if (!options.capturePath.empty()) {
+            props = props.hidden();  // Frames go to the capture framebuffer; the window only provides a context
+        }
         
-        // Create window instance
-        auto window = std::make_unique<GLFWWindow>(props);
-        
-        // Create gravity renderer with viewport dimensions
-        auto gravityRenderer = std::make_unique<GravityRenderer>(800.0f, 600.0f);
+        // Create window and renderer; the core backend falls back to the legacy one when unavailable
+        std::unique_ptr<IWindow> window;
+        std::unique_ptr<IGravityRenderer> gravityRenderer;
+        if (options.gpuCompute) {
+            // Compute shaders need a 4.3 context and the core backend to draw their buffers
+            auto computeWindow = std::make_unique<GLFWWindow>(props.withCoreProfile(4, 3));
+            if (computeWindow->initialize() && GpuNBodySimulation::isSupported()) {
+                window = std::move(computeWindow);
+                gravityRenderer = std::make_unique<CoreGravityRenderer>(800.0f, 600.0f);
+                options.coreRenderer = true;
+            } else {
+                std::cerr << "OpenGL 4.3 compute shaders unavailable, simulating on the CPU\n";
+                options.gpuCompute = false;
+            }
+        }
+        if (options.coreRenderer && !gravityRenderer) {
+            auto coreWindow = std::make_unique<GLFWWindow>(props.withCoreProfile(3, 3));
+            if (coreWindow->initialize() && CoreGravityRenderer::isSupported()) {
+                window = std::move(coreWindow);
+                gravityRenderer = std::make_unique<CoreGravityRenderer>(800.0f, 600.0f);
+            } else {
+                std::cerr << "OpenGL 3.3 core profile unavailable, using the legacy renderer\n";
+                options.coreRenderer = false;
+            }
+        }
+        if (!gravityRenderer) {
+            window = std::make_unique<GLFWWindow>(props);
+            gravityRenderer = std::make_unique<GravityRenderer>(800.0f, 600.0f);
+        }
         
         // Create modern application with separated components following SOLID principles
-        ModernGravityApplication app(std::move(window), std::move(gravityRenderer));
+        ModernGravityApplication app(std::move(window), std::move(gravityRenderer), options);
         
         // Initialize and run
         if (!app.initialize()) {
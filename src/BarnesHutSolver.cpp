@@ -0,0 +1,300 @@
+/**
+ * @file BarnesHutSolver.cpp
+ * @brief Implementation of the Barnes-Hut quadtree force solver
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/BarnesHutSolver.h"
+#include <algorithm>
+#include <cmath>
+
+BarnesHutSolver::BarnesHutSolver(float theta, int leafCapacity)
+    : theta(theta), leafCapacity(std::max(1, leafCapacity)), nodes(ownArena), bodyOrder(ownArena) {}
+
+void BarnesHutSolver::computeForces(const BodyStore& bodies,
+                                    float gravitationalConstant,
+                                    std::vector<Vec2>& forces,
+                                    ThreadPool* threadPool) {
+    forces.assign(bodies.size(), Vec2(0.0f, 0.0f));
+    if (bodies.size() < 2) return;
+
+    store = &bodies;
+    buildTree(frameArena ? *frameArena : ownArena);
+
+    // The tree is read-only from here on, so walks for different bodies run in parallel
+    visitForceLaw(forceLaw, [&](auto policy) {
+        using Law = decltype(policy);
+        ThreadPool::run(threadPool, 0, bodies.size(), BODIES_PER_TASK, [&](size_t begin, size_t end) {
+            int stack[STACK_CAPACITY];
+            for (size_t i = begin; i < end; ++i) {
+                forces[i] = computeForceOn<Law>(static_cast<int>(i), gravitationalConstant, stack);
+            }
+        });
+    });
+    releaseTree();
+}
+
+void BarnesHutSolver::computeForcesOn(const BodyStore& bodies,
+                                      float gravitationalConstant,
+                                      const std::vector<size_t>& targets,
+                                      std::vector<Vec2>& forces,
+                                      ThreadPool* threadPool) {
+    forces.resize(bodies.size());
+    if (bodies.size() < 2) {
+        for (size_t target : targets) {
+            forces[target] = Vec2(0.0f, 0.0f);
+        }
+        return;
+    }
+
+    // The tree still covers every body; only the walks are limited to the targets
+    store = &bodies;
+    buildTree(frameArena ? *frameArena : ownArena);
+
+    visitForceLaw(forceLaw, [&](auto policy) {
+        using Law = decltype(policy);
+        ThreadPool::run(threadPool, 0, targets.size(), BODIES_PER_TASK, [&](size_t begin, size_t end) {
+            int stack[STACK_CAPACITY];
+            for (size_t k = begin; k < end; ++k) {
+                forces[targets[k]] = computeForceOn<Law>(static_cast<int>(targets[k]), gravitationalConstant,
+                                                         stack);
+            }
+        });
+    });
+    releaseTree();
+}
+
+void BarnesHutSolver::summarize(const BodyStore& bodies, const Region* regions, size_t regionCount,
+                                std::vector<PointMass>* summaries, ThreadPool* threadPool) {
+    for (size_t r = 0; r < regionCount; ++r) {
+        summaries[r].clear();
+    }
+    if (bodies.size() == 0) return;
+
+    store = &bodies;
+    buildTree(frameArena ? *frameArena : ownArena);
+    ThreadPool::run(threadPool, 0, regionCount, 1, [&](size_t begin, size_t end) {
+        int stack[STACK_CAPACITY];
+        for (size_t r = begin; r < end; ++r) {
+            summarizeFor(regions[r], summaries[r], stack);
+        }
+    });
+    releaseTree();
+}
+
+void BarnesHutSolver::buildTree(FrameArena& arena) {
+    // The private arena only ever holds one tree; a shared one is reset by its owner
+    if (&arena == &ownArena) ownArena.reset();
+    const size_t count = store->size();
+    nodes = ArenaArray<Node>(arena);
+    nodes.reserve(lastNodeCount + lastNodeCount / 4 + 64);
+    bodyOrder = ArenaArray<int>(arena);
+    bodyOrder.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        bodyOrder[i] = static_cast<int>(i);
+    }
+
+    // Root square encloses every body
+    float minX = store->x[0], maxX = store->x[0];
+    float minY = store->y[0], maxY = store->y[0];
+    for (size_t i = 1; i < count; ++i) {
+        minX = std::min(minX, store->x[i]);
+        maxX = std::max(maxX, store->x[i]);
+        minY = std::min(minY, store->y[i]);
+        maxY = std::max(maxY, store->y[i]);
+    }
+    float halfSize = 0.5f * std::max(maxX - minX, maxY - minY);
+    halfSize = std::max(halfSize, 1.0f) * 1.0001f; // Keep boundary bodies strictly inside
+
+    Node root;
+    root.centerX = 0.5f * (minX + maxX);
+    root.centerY = 0.5f * (minY + maxY);
+    root.halfSize = halfSize;
+    root.firstChild = -1;
+    root.firstBody = 0;
+    root.bodyCount = static_cast<int>(count);
+    nodes.push_back(root);
+
+    subdivide(0, 0);
+    lastNodeCount = nodes.size();
+}
+
+void BarnesHutSolver::releaseTree() {
+    nodes = ArenaArray<Node>(ownArena);
+    bodyOrder = ArenaArray<int>(ownArena);
+    store = nullptr;
+}
+
+void BarnesHutSolver::subdivide(int nodeIndex, int depth) {
+    // Note: nodes may reallocate during recursion, so always index instead of holding references
+    int first = nodes[nodeIndex].firstBody;
+    int count = nodes[nodeIndex].bodyCount;
+    const float* xs = store->x.data();
+    const float* ys = store->y.data();
+    const float* masses = store->mass.data();
+
+    if (count <= leafCapacity || depth >= MAX_DEPTH) {
+        // Leaf: accumulate mass and center of mass directly
+        float mass = 0.0f, comX = 0.0f, comY = 0.0f;
+        for (int k = first; k < first + count; ++k) {
+            int b = bodyOrder[k];
+            mass += masses[b];
+            comX += masses[b] * xs[b];
+            comY += masses[b] * ys[b];
+        }
+        Node& node = nodes[nodeIndex];
+        node.mass = mass;
+        node.comX = mass > 0.0f ? comX / mass : node.centerX;
+        node.comY = mass > 0.0f ? comY / mass : node.centerY;
+        return;
+    }
+
+    float cx = nodes[nodeIndex].centerX;
+    float cy = nodes[nodeIndex].centerY;
+    float childHalf = nodes[nodeIndex].halfSize * 0.5f;
+
+    // Partition the body range into quadrants: [SW | SE | NW | NE]
+    int* begin = bodyOrder.begin() + first;
+    int* end = begin + count;
+    int* southEnd = std::partition(begin, end, [&](int b) { return ys[b] < cy; });
+    int* swEnd = std::partition(begin, southEnd, [&](int b) { return xs[b] < cx; });
+    int* nwEnd = std::partition(southEnd, end, [&](int b) { return xs[b] < cx; });
+    int bounds[5] = {
+        first,
+        static_cast<int>(swEnd - bodyOrder.begin()),
+        static_cast<int>(southEnd - bodyOrder.begin()),
+        static_cast<int>(nwEnd - bodyOrder.begin()),
+        first + count
+    };
+
+    int firstChild = static_cast<int>(nodes.size());
+    nodes[nodeIndex].firstChild = firstChild;
+    for (int q = 0; q < 4; ++q) {
+        Node child;
+        child.centerX = cx + ((q & 1) ? childHalf : -childHalf);
+        child.centerY = cy + ((q & 2) ? childHalf : -childHalf);
+        child.halfSize = childHalf;
+        child.mass = 0.0f;
+        child.comX = child.centerX;
+        child.comY = child.centerY;
+        child.firstChild = -1;
+        child.firstBody = bounds[q];
+        child.bodyCount = bounds[q + 1] - bounds[q];
+        nodes.push_back(child);
+    }
+
+    float mass = 0.0f, comX = 0.0f, comY = 0.0f;
+    for (int q = 0; q < 4; ++q) {
+        int childIndex = firstChild + q;
+        if (nodes[childIndex].bodyCount > 0) {
+            subdivide(childIndex, depth + 1);
+        }
+        const Node& child = nodes[childIndex];
+        mass += child.mass;
+        comX += child.mass * child.comX;
+        comY += child.mass * child.comY;
+    }
+
+    Node& node = nodes[nodeIndex];
+    node.mass = mass;
+    node.comX = mass > 0.0f ? comX / mass : cx;
+    node.comY = mass > 0.0f ? comY / mass : cy;
+}
+
+template <class Law>
+Vec2 BarnesHutSolver::computeForceOn(int bodyIndex, float gravitationalConstant, int* traversalStack) const {
+    const float* xs = store->x.data();
+    const float* ys = store->y.data();
+    const float* masses = store->mass.data();
+    Vec2 position(xs[bodyIndex], ys[bodyIndex]);
+    float gm = gravitationalConstant * masses[bodyIndex];
+    const float softeningSquared = forceLaw.softeningLength * forceLaw.softeningLength;
+    const float maxForce = forceLaw.maxForce;
+    float thetaSquared = theta * theta;
+    Vec2 totalForce(0.0f, 0.0f);
+
+    size_t stackSize = 0;
+    traversalStack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        int nodeIndex = traversalStack[--stackSize];
+        const Node& node = nodes[nodeIndex];
+        if (node.bodyCount == 0) continue;
+
+        if (node.firstChild < 0) {
+            // Leaf: exact interaction with each contained body
+            for (int k = node.firstBody; k < node.firstBody + node.bodyCount; ++k) {
+                int other = bodyOrder[k];
+                if (other == bodyIndex) continue;
+                totalForce += Law::force(Vec2(xs[other], ys[other]) - position, gm * masses[other],
+                                         softeningSquared, maxForce);
+            }
+            continue;
+        }
+
+        // Never approximate a node that contains the body itself
+        bool containsBody = std::fabs(position.x - node.centerX) <= node.halfSize &&
+                            std::fabs(position.y - node.centerY) <= node.halfSize;
+
+        float dx = node.comX - position.x;
+        float dy = node.comY - position.y;
+        float distanceSquared = dx * dx + dy * dy;
+        float size = node.halfSize * 2.0f;
+
+        if (!containsBody && size * size < thetaSquared * distanceSquared) {
+            // Far enough away: treat the whole node as a single mass
+            totalForce += Law::force(Vec2(node.comX, node.comY) - position, gm * node.mass,
+                                     softeningSquared, maxForce);
+        } else {
+            for (int q = 3; q >= 0; --q) {
+                traversalStack[stackSize++] = node.firstChild + q;
+            }
+        }
+    }
+
+    return totalForce;
+}
+
+void BarnesHutSolver::summarizeFor(const Region& region, std::vector<PointMass>& summary,
+                                   int* traversalStack) const {
+    const float* xs = store->x.data();
+    const float* ys = store->y.data();
+    const float* masses = store->mass.data();
+    float thetaSquared = theta * theta;
+
+    size_t stackSize = 0;
+    traversalStack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        int nodeIndex = traversalStack[--stackSize];
+        const Node& node = nodes[nodeIndex];
+        if (node.bodyCount == 0 || !(node.mass > 0.0f)) continue;
+
+        if (node.firstChild < 0) {
+            for (int k = node.firstBody; k < node.firstBody + node.bodyCount; ++k) {
+                int body = bodyOrder[k];
+                if (masses[body] > 0.0f) summary.push_back({xs[body], ys[body], masses[body]});
+            }
+            continue;
+        }
+
+        // A node overlapping the region may contain a target body, which is never approximated
+        bool overlaps = node.centerX + node.halfSize >= region.minX && node.centerX - node.halfSize <= region.maxX &&
+                        node.centerY + node.halfSize >= region.minY && node.centerY - node.halfSize <= region.maxY;
+
+        // Closest point of the region to the center of mass gives the strictest test
+        float dx = std::max({region.minX - node.comX, 0.0f, node.comX - region.maxX});
+        float dy = std::max({region.minY - node.comY, 0.0f, node.comY - region.maxY});
+        float distanceSquared = dx * dx + dy * dy;
+        float size = node.halfSize * 2.0f;
+
+        if (!overlaps && size * size < thetaSquared * distanceSquared) {
+            summary.push_back({node.comX, node.comY, node.mass});
+        } else {
+            for (int q = 3; q >= 0; --q) {
+                traversalStack[stackSize++] = node.firstChild + q;
+            }
+        }
+    }
+}
@@ -0,0 +1,201 @@
+/**
+ * @file BodyGenerators.cpp
+ * @brief Implementation of the Plummer, Keplerian disc and galaxy pair generators
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/BodyGenerators.h"
+#include "../include/GravityBody.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+/** Bodies per parallel chunk */
+constexpr size_t GENERATE_GRAIN = 4096;
+
+/**
+ * @class IndexRandom
+ * @brief Random stream owned by one body, independent of thread scheduling
+ *
+ * splitmix64 seeded from a hash of (seed, body index), so every body draws
+ * the same numbers whichever thread fills its slot.
+ */
+class IndexRandom {
+public:
+    IndexRandom(uint32_t seed, size_t index)
+        : state(mix(static_cast<uint64_t>(seed) ^ mix(static_cast<uint64_t>(index)))) {}
+
+    /** Uniform in [0, 1) */
+    double uniform() {
+        state += 0x9E3779B97F4A7C15ull;
+        return (mix(state) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t state;
+
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+/**
+ * @brief Draws an isotropic 3D direction of the given length and drops its z component
+ */
+Vec2 projectedIsotropic(IndexRandom& random, double length) {
+    double cosTheta = 2.0 * random.uniform() - 1.0;
+    double sinTheta = std::sqrt(std::max(0.0, 1.0 - cosTheta * cosTheta));
+    double phi = 2.0 * M_PI * random.uniform();
+    return Vec2(static_cast<float>(length * sinTheta * std::cos(phi)),
+                static_cast<float>(length * sinTheta * std::sin(phi)));
+}
+
+} // namespace
+
+void PlummerSphereGenerator::generate(BodyStore& bodies, size_t first, float gravitationalConstant,
+                                      ThreadPool* threadPool) const {
+    if (settings.count == 0) return;
+    const double a = settings.scaleRadius;
+    const double cut = std::max(settings.maxRadius, settings.scaleRadius * 0.1f) / a;
+    // Cumulative mass fraction inside maxRadius: M(<r)/M = r^3 / (r^2 + a^2)^(3/2)
+    const double massFraction = cut * cut * cut / std::pow(1.0 + cut * cut, 1.5);
+    const double escapeScale = std::sqrt(2.0 * gravitationalConstant * settings.totalMass);
+    const float bodyMass = settings.totalMass / settings.count;
+
+    ThreadPool::run(threadPool, 0, settings.count, GENERATE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            IndexRandom random(settings.seed, i);
+            double m = std::max(random.uniform() * massFraction, 1e-12);
+            double r = a / std::sqrt(1.0 / std::cbrt(m * m) - 1.0);
+
+            // Speed as a fraction q of the local escape speed, from g(q) = q^2 (1 - q^2)^(7/2)
+            double q = 0.0;
+            for (;;) {
+                q = random.uniform();
+                double t = 1.0 - q * q;
+                if (0.1 * random.uniform() < q * q * t * t * t * std::sqrt(t)) break;
+            }
+            double speed = q * escapeScale / std::sqrt(std::sqrt(r * r + a * a));
+
+            Vec2 position = projectedIsotropic(random, r);
+            Vec2 velocity = projectedIsotropic(random, speed);
+            bodies.set(first + i, {settings.center + position, settings.velocity + velocity,
+                                   bodyMass, settings.bodyRadius});
+        }
+    });
+}
+
+void KeplerianDiscGenerator::generate(BodyStore& bodies, size_t first, float gravitationalConstant,
+                                      ThreadPool* threadPool) const {
+    size_t discFirst = first;
+    if (settings.centralMass > 0.0f) {
+        bodies.set(discFirst++, {settings.center, settings.velocity, settings.centralMass, settings.centralRadius});
+    }
+    if (settings.count == 0) return;
+
+    const double inner = std::max(0.0f, std::min(settings.innerRadius, settings.outerRadius));
+    const double outer = settings.outerRadius;
+    const double area = outer * outer - inner * inner;
+    const double direction = settings.clockwise ? -1.0 : 1.0;
+    const float bodyMass = settings.discMass / settings.count;
+
+    ThreadPool::run(threadPool, 0, settings.count, GENERATE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            IndexRandom random(settings.seed, i);
+            // Uniform surface density between the edges
+            double r = std::sqrt(inner * inner + area * random.uniform());
+            double angle = 2.0 * M_PI * random.uniform();
+            double enclosed = settings.centralMass + (area > 0.0 ? settings.discMass * (r * r - inner * inner) / area : 0.0);
+            double speed = direction * std::sqrt(gravitationalConstant * enclosed /
+                                                 std::max(r, static_cast<double>(GravityBody::PAIR_MIN_DISTANCE)));
+
+            Vec2 position(static_cast<float>(r * std::cos(angle)), static_cast<float>(r * std::sin(angle)));
+            Vec2 velocity(static_cast<float>(-speed * std::sin(angle)), static_cast<float>(speed * std::cos(angle)));
+            bodies.set(discFirst + i, {settings.center + position, settings.velocity + velocity,
+                                       bodyMass, settings.bodyRadius});
+        }
+    });
+}
+
+size_t GalaxyPairGenerator::getBodyCount() const {
+    return KeplerianDiscGenerator(settings.primary).getBodyCount() +
+           KeplerianDiscGenerator(settings.secondary).getBodyCount();
+}
+
+void GalaxyPairGenerator::generate(BodyStore& bodies, size_t first, float gravitationalConstant,
+                                   ThreadPool* threadPool) const {
+    KeplerianDiscGenerator::Settings primary = settings.primary;
+    KeplerianDiscGenerator::Settings secondary = settings.secondary;
+    const double primaryMass = KeplerianDiscGenerator(primary).getTotalMass();
+    const double secondaryMass = KeplerianDiscGenerator(secondary).getTotalMass();
+    const double totalMass = primaryMass + secondaryMass;
+    if (!(totalMass > 0.0)) return;
+
+    // Relative motion of two point masses; each galaxy takes its share about the centre of mass
+    Vec2 offset(settings.separation, settings.impactParameter);
+    double distance = std::max(static_cast<double>(offset.magnitude()),
+                               static_cast<double>(GravityBody::PAIR_MIN_DISTANCE));
+    double speed = settings.approachSpeed * std::sqrt(2.0 * gravitationalConstant * totalMass / distance);
+    Vec2 relativeVelocity(static_cast<float>(-speed), 0.0f);
+
+    float primaryShare = static_cast<float>(secondaryMass / totalMass);
+    float secondaryShare = static_cast<float>(primaryMass / totalMass);
+    primary.center = settings.center - offset * primaryShare;
+    primary.velocity = relativeVelocity * -primaryShare;
+    secondary.center = settings.center + offset * secondaryShare;
+    secondary.velocity = relativeVelocity * secondaryShare;
+
+    KeplerianDiscGenerator primaryGenerator(primary);
+    primaryGenerator.generate(bodies, first, gravitationalConstant, threadPool);
+    KeplerianDiscGenerator(secondary).generate(bodies, first + primaryGenerator.getBodyCount(),
+                                               gravitationalConstant, threadPool);
+}
+
+std::unique_ptr<IBodyGenerator> createSceneGenerator(const std::string& name, size_t bodyCount,
+                                                     float worldWidth, float worldHeight) {
+    const Vec2 center(worldWidth * 0.5f, worldHeight * 0.5f);
+    const float size = std::min(worldWidth, worldHeight);
+    if (name == "plummer") {
+        PlummerSphereGenerator::Settings settings;
+        settings.center = center;
+        settings.count = bodyCount;
+        settings.scaleRadius = size * 0.08f;
+        settings.maxRadius = size * 0.4f;
+        return std::make_unique<PlummerSphereGenerator>(settings);
+    }
+    if (name == "disc") {
+        KeplerianDiscGenerator::Settings settings;
+        settings.center = center;
+        settings.count = bodyCount > 0 ? bodyCount - 1 : 0;
+        settings.innerRadius = size * 0.05f;
+        settings.outerRadius = size * 0.4f;
+        return std::make_unique<KeplerianDiscGenerator>(settings);
+    }
+    if (name == "galaxies") {
+        GalaxyPairGenerator::Settings settings;
+        settings.center = center;
+        settings.separation = worldWidth * 0.45f;
+        settings.impactParameter = worldHeight * 0.15f;
+        settings.approachSpeed = 0.8f;   // Bound, so the galaxies merge after a few passes
+        KeplerianDiscGenerator::Settings galaxy;
+        galaxy.count = bodyCount > 2 ? bodyCount / 2 - 1 : 0;
+        galaxy.innerRadius = size * 0.03f;
+        galaxy.outerRadius = size * 0.15f;
+        galaxy.discMass = 500.0f;
+        galaxy.centralMass = 2500.0f;
+        settings.primary = galaxy;
+        galaxy.seed = 2;
+        galaxy.clockwise = true;
+        settings.secondary = galaxy;
+        return std::make_unique<GalaxyPairGenerator>(settings);
+    }
+    return nullptr;
+}
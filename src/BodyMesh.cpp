@@ -0,0 +1,542 @@
+/**
+ * @file BodyMesh.cpp
+ * @brief Implementation of instanced body rendering
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/BodyMesh.h"
+#include "../include/Frustum.h"
+#include "../include/GpuNBodySimulation.h"
+#include "../include/SpacetimeGridMesh.h"
+#include "../include/SphereGeometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace {
+
+const char* SPHERE_VERTEX_SHADER = R"(
+IN vec3 position;           // unit sphere vertex
+IN vec4 centerRadius;       // per instance: render-space center and radius
+IN vec4 instanceColor;      // per instance: body color
+uniform float radiusScale;
+uniform vec4 glowColor;
+uniform float glowWeight;   // 0 for the body pass, 1 for the glow pass
+OUT vec4 color;
+
+void main() {
+    vec3 world = centerRadius.xyz + position * (centerRadius.w * radiusScale);
+    color = mix(instanceColor, glowColor, glowWeight);
+    gl_Position = viewProjection * vec4(world, 1.0);
+}
+)";
+
+const char* SPHERE_FRAGMENT_SHADER = R"(
+IN vec4 color;
+
+void main() {
+    FRAG_COLOR = color;
+}
+)";
+
+// One point per body, sized to cover its glow; the body disc is the inner 1/radiusScale
+const char* SPRITE_VERTEX_SHADER = R"(
+IN vec4 centerRadius;
+IN vec4 instanceColor;
+uniform float pixelScale;   // viewport pixels per unit at unit depth
+uniform float radiusScale;  // glow radius relative to the body
+OUT vec4 bodyColor;
+
+void main() {
+    vec4 eye = view * vec4(centerRadius.xyz, 1.0);
+    gl_Position = projection * eye;
+    gl_PointSize = max(1.0, 2.0 * centerRadius.w * radiusScale * pixelScale / max(-eye.z, 1.0));
+    bodyColor = instanceColor;
+}
+)";
+
+const char* SPRITE_FRAGMENT_SHADER = R"(
+IN vec4 bodyColor;
+uniform vec4 glowColor;
+uniform float radiusScale;
+
+void main() {
+    float r = length(gl_PointCoord * 2.0 - 1.0);
+    if (r > 1.0) discard;
+    FRAG_COLOR = r * radiusScale <= 1.0 ? bodyColor : glowColor;
+}
+)";
+
+// GPU version of instanceFor() and levelFor(); each body is appended to its
+// level's region of the instance buffer and counted in the indirect commands
+const char* BINNING_KERNEL = R"(
+layout(local_size_x = WORKGROUP_SIZE) in;
+layout(std430, binding = BODY_BINDING) readonly buffer Bodies { Body bodies[]; };
+struct Instance {
+    vec4 centerRadius;
+    vec4 color;
+};
+layout(std430, binding = INSTANCE_BINDING) writeonly buffer Instances { Instance instances[]; };
+layout(std430, binding = COMMAND_BINDING) buffer Commands { uint commands[]; };
+uniform uint bodyCount;
+uniform uint capacity;      // instance slots per group
+uniform mat4 view;
+uniform float pixelScale;
+
+const float minPixelRadius[LOD_LEVEL_COUNT] = float[](MIN_PIXEL_RADII);
+
+void main() {
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= bodyCount) return;
+
+    Body body = bodies[i];
+    vec3 center = vec3((body.position.x / 800.0 - 0.5) * GRID_SCALE, BODY_ELEVATION,
+                       (body.position.y / 600.0 - 0.5) * GRID_SCALE);
+    float radius = max(5.0, min(50.0, body.mass / 1000.0));
+    float massRatio = min(1.0, body.mass / 50000.0);
+
+    // Behind the camera is clipped anyway, so use the cheapest sphere
+    uint group = uint(LOD_LEVEL_COUNT - 1);
+    float depth = -(view * vec4(center, 1.0)).z;
+    if (depth > 0.0) {
+        float pixelRadius = radius * pixelScale / depth;
+        group = uint(LOD_LEVEL_COUNT);
+        for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+            if (pixelRadius >= minPixelRadius[level]) {
+                group = uint(level);
+                break;
+            }
+        }
+    }
+
+    uint slot;
+    if (group < uint(LOD_LEVEL_COUNT)) {
+        slot = atomicAdd(commands[group * ELEMENTS_COMMAND_WORDS + 1u], 1u);
+        atomicAdd(commands[(group + uint(LOD_LEVEL_COUNT)) * ELEMENTS_COMMAND_WORDS + 1u], 1u);
+    } else {
+        slot = atomicAdd(commands[SPRITE_COMMAND_WORD], 1u);
+    }
+    instances[group * capacity + slot] = Instance(vec4(center, radius), vec4(1.0, 1.0 - massRatio, 0.0, 1.0));
+}
+)";
+
+/** Storage buffer bindings of the binning kernel besides the body buffer */
+constexpr GLuint INSTANCE_BINDING = 1;
+constexpr GLuint COMMAND_BINDING = 2;
+
+// Glow color of the original renderer; the alpha makes it translucent
+const float GLOW_COLOR[4] = {1.0f, 0.8f, 0.0f, 0.3f};
+
+/**
+ * @brief Issues an instanced draw with the core entry point or ARB_draw_instanced
+ */
+void drawElementsInstanced(GLsizei count, size_t indexOffset, GLsizei instanceCount) {
+    const void* offset = reinterpret_cast<const void*>(indexOffset);
+    if (GLEW_VERSION_3_1) {
+        glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, offset, instanceCount);
+    } else {
+        glDrawElementsInstancedARB(GL_TRIANGLES, count, GL_UNSIGNED_INT, offset, instanceCount);
+    }
+}
+
+/**
+ * @brief Sets an attribute divisor with the core entry point or ARB_instanced_arrays
+ */
+void vertexAttribDivisor(GLuint index, GLuint divisor) {
+    if (GLEW_VERSION_3_3) {
+        glVertexAttribDivisor(index, divisor);
+    } else {
+        glVertexAttribDivisorARB(index, divisor);
+    }
+}
+
+} // namespace
+
+BodyMesh::~BodyMesh() {
+    release();
+}
+
+bool BodyMesh::isSupported(ShaderProgram::Profile profile) {
+    if (profile == ShaderProgram::Profile::Core) {
+        return GLEW_VERSION_3_3;
+    }
+    return GLEW_VERSION_2_0 && (GLEW_VERSION_3_1 || GLEW_ARB_draw_instanced) &&
+           (GLEW_VERSION_3_3 || GLEW_ARB_instanced_arrays);
+}
+
+bool BodyMesh::initialize(ShaderProgram::Profile shaderProfile) {
+    profile = shaderProfile;
+    if (!isSupported(profile)) {
+        return false;
+    }
+
+    const char* vertexHeader = ShaderProgram::versionHeader(profile, GL_VERTEX_SHADER);
+    const char* fragmentHeader = ShaderProgram::versionHeader(profile, GL_FRAGMENT_SHADER);
+    const char* camera = CameraUniformBuffer::glslDeclaration(profile);
+    if (!sphereProgram.build({vertexHeader, camera, SPHERE_VERTEX_SHADER}, {fragmentHeader, SPHERE_FRAGMENT_SHADER},
+                             {{POSITION_ATTRIBUTE, "position"},
+                              {CENTER_RADIUS_ATTRIBUTE, "centerRadius"},
+                              {COLOR_ATTRIBUTE, "instanceColor"}}) ||
+        !spriteProgram.build({vertexHeader, camera, SPRITE_VERTEX_SHADER}, {fragmentHeader, SPRITE_FRAGMENT_SHADER},
+                             {{CENTER_RADIUS_ATTRIBUTE, "centerRadius"}, {COLOR_ATTRIBUTE, "instanceColor"}})) {
+        release();
+        return false;
+    }
+
+    sphereRadiusScaleLocation = sphereProgram.getUniformLocation("radiusScale");
+    sphereGlowColorLocation = sphereProgram.getUniformLocation("glowColor");
+    sphereGlowWeightLocation = sphereProgram.getUniformLocation("glowWeight");
+    spritePixelScaleLocation = spriteProgram.getUniformLocation("pixelScale");
+    spriteRadiusScaleLocation = spriteProgram.getUniformLocation("radiusScale");
+    spriteGlowColorLocation = spriteProgram.getUniformLocation("glowColor");
+
+    if (profile == ShaderProgram::Profile::Core) {
+        sphereProgram.bindUniformBlock(CameraUniformBuffer::BLOCK_NAME, CameraUniformBuffer::BINDING_POINT);
+        spriteProgram.bindUniformBlock(CameraUniformBuffer::BLOCK_NAME, CameraUniformBuffer::BINDING_POINT);
+        // Core profiles cannot draw without a vertex array object
+        glGenVertexArrays(1, &vertexArray);
+    }
+    buildSpheres();
+    if (profile == ShaderProgram::Profile::Core && GLEW_VERSION_4_3) {
+        buildBinning();
+    }
+    return true;
+}
+
+BodyMesh::Instance BodyMesh::instanceFor(const BodyStore& bodies, size_t index) {
+    const float gridScale = SpacetimeGridMesh::GRID_SCALE;
+    float mass = bodies.mass[index];
+    float massRatio = std::min(1.0f, mass / 50000.0f);
+
+    Instance instance;
+    instance.x = (bodies.x[index] / 800.0f - 0.5f) * gridScale; // Map 0-800 to -300 to +300
+    instance.y = BODY_ELEVATION;
+    instance.z = (bodies.y[index] / 600.0f - 0.5f) * gridScale; // Map 0-600 to -300 to +300
+    instance.radius = std::max(5.0f, std::min(50.0f, mass / 1000.0f));
+    instance.r = 1.0f;
+    instance.g = 1.0f - massRatio; // Yellow to red gradient
+    instance.b = 0.0f;
+    instance.a = 1.0f;
+    return instance;
+}
+
+float BodyMesh::pixelScaleFor(float fovyDegrees, float viewportHeight) {
+    return viewportHeight / (2.0f * std::tan(fovyDegrees * 3.14159265358979323846f / 360.0f));
+}
+
+int BodyMesh::levelFor(const Instance& instance, const Mat4& view, float pixelScale) {
+    const float* m = view.data();
+    float depth = -(m[2] * instance.x + m[6] * instance.y + m[10] * instance.z + m[14]);
+    if (depth <= 0.0f) {
+        // Behind the camera and clipped anyway; keep it as cheap as possible
+        return LOD_LEVEL_COUNT - 1;
+    }
+
+    float pixelRadius = instance.radius * pixelScale / depth;
+    for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+        if (pixelRadius >= LOD_LEVELS[level].minPixelRadius) return level;
+    }
+    return LOD_LEVEL_COUNT;
+}
+
+void BodyMesh::update(const BodyStore& bodies, const Mat4& view, const Mat4& projection, float pixelScale) {
+    if (bodies.version != 0 && bodies.version == instancedVersion && pixelScale == currentPixelScale &&
+        std::memcmp(view.m, instancedView.m, sizeof(view.m)) == 0 &&
+        std::memcmp(projection.m, instancedProjection.m, sizeof(projection.m)) == 0) {
+        return;
+    }
+    instancedVersion = bodies.version;
+    instancedView = view;
+    instancedProjection = projection;
+    currentPixelScale = pixelScale;
+    binnedBodyCount = 0;
+
+    // Counting sort by level so each group is a contiguous instance range;
+    // bodies outside the frustum are marked with GROUP_COUNT and dropped
+    const Frustum frustum = Frustum::fromMatrix(projection * view);
+    const size_t count = bodies.size();
+    bodyInstances.resize(count);
+    levels.resize(count);
+    size_t groupSize[GROUP_COUNT] = {};
+    size_t visible = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Instance& instance = bodyInstances[i] = instanceFor(bodies, i);
+        if (!frustum.intersectsSphere(instance.x, instance.y, instance.z, instance.radius * GLOW_SCALE)) {
+            levels[i] = GROUP_COUNT;
+            continue;
+        }
+        int level = levelFor(instance, view, pixelScale);
+        levels[i] = static_cast<uint8_t>(level);
+        ++groupSize[level];
+        ++visible;
+    }
+    instances.resize(visible);
+    size_t next[GROUP_COUNT];
+    size_t start = 0;
+    for (int group = 0; group < GROUP_COUNT; ++group) {
+        groupStart[group] = next[group] = start;
+        groupCount[group] = static_cast<GLsizei>(groupSize[group]);
+        start += groupSize[group];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (levels[i] < GROUP_COUNT) instances[next[levels[i]]++] = bodyInstances[i];
+    }
+
+    if (visible > 0) {
+        instanceOffset = instanceBuffer.upload(instances.data(), visible * sizeof(Instance));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
+
+void BodyMesh::updateFromBuffer(GLuint bodyBuffer, GLsizei bodyCount, const Mat4& view, float pixelScale) {
+    currentPixelScale = pixelScale;
+    instancedVersion = 0;
+    instances.clear();
+    binnedBodyCount = binningProgram.isValid() ? bodyCount : 0;
+    if (binnedBodyCount == 0) return;
+
+    if (bodyCount > binnedCapacity) {
+        binnedCapacity = bodyCount;
+        glBindBuffer(GL_ARRAY_BUFFER, binnedBuffer);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(GROUP_COUNT) * binnedCapacity * sizeof(Instance),
+                     nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Commands with zero instances; the kernel counts the bodies in.
+    // Spheres find their region through baseInstance, sprites through first.
+    const GLuint capacity = static_cast<GLuint>(binnedCapacity);
+    GLuint commands[SPRITE_COMMAND_WORD + ARRAYS_COMMAND_WORDS] = {};
+    for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+        const SphereRange* spheres[2] = {&bodySpheres[level], &glowSpheres[level]};
+        for (int pass = 0; pass < 2; ++pass) {
+            GLuint* command = commands + (pass * LOD_LEVEL_COUNT + level) * ELEMENTS_COMMAND_WORDS;
+            command[0] = static_cast<GLuint>(spheres[pass]->indexCount);
+            command[2] = static_cast<GLuint>(spheres[pass]->indexOffset / sizeof(uint32_t));
+            command[4] = level * capacity;
+        }
+    }
+    commands[SPRITE_COMMAND_WORD + 1] = 1;
+    commands[SPRITE_COMMAND_WORD + 2] = LOD_LEVEL_COUNT * capacity;
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(commands), commands);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    binningProgram.use();
+    glUniform1ui(binningBodyCountLocation, static_cast<GLuint>(bodyCount));
+    glUniform1ui(binningCapacityLocation, capacity);
+    glUniformMatrix4fv(binningViewLocation, 1, GL_FALSE, view.data());
+    glUniform1f(binningPixelScaleLocation, pixelScale);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GpuNBodySimulation::BODY_BINDING, bodyBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INSTANCE_BINDING, binnedBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, commandBuffer);
+    glDispatchCompute((static_cast<GLuint>(bodyCount) + GpuNBodySimulation::WORKGROUP_SIZE - 1) /
+                      GpuNBodySimulation::WORKGROUP_SIZE, 1, 1);
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GpuNBodySimulation::BODY_BINDING, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INSTANCE_BINDING, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, 0);
+    glUseProgram(0);
+}
+
+void BodyMesh::draw() {
+    lastDrawCalls = 0;
+    const bool binned = binnedBodyCount > 0;
+    if (!sphereProgram.isValid() || (!binned && instances.empty())) return;
+
+    if (vertexArray) glBindVertexArray(vertexArray);
+
+    sphereProgram.use();
+    glUniform4fv(sphereGlowColorLocation, 1, GLOW_COLOR);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glEnableVertexAttribArray(POSITION_ATTRIBUTE);
+    glVertexAttribPointer(POSITION_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glEnableVertexAttribArray(CENTER_RADIUS_ATTRIBUTE);
+    glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+
+    if (binned) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+
+    drawSpheres(false);
+    drawSpheres(true);
+    glDisableVertexAttribArray(POSITION_ATTRIBUTE);
+    drawSprites();
+    if (binned) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    } else {
+        instanceBuffer.fence();
+    }
+
+    // Divisors and enabled arrays live in the default vertex array in legacy contexts
+    vertexAttribDivisor(CENTER_RADIUS_ATTRIBUTE, 0);
+    vertexAttribDivisor(COLOR_ATTRIBUTE, 0);
+    glDisableVertexAttribArray(CENTER_RADIUS_ATTRIBUTE);
+    glDisableVertexAttribArray(COLOR_ATTRIBUTE);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (vertexArray) glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+void BodyMesh::release() {
+    if (vertexBuffer) glDeleteBuffers(1, &vertexBuffer);
+    if (indexBuffer) glDeleteBuffers(1, &indexBuffer);
+    if (vertexArray) glDeleteVertexArrays(1, &vertexArray);
+    if (binnedBuffer) glDeleteBuffers(1, &binnedBuffer);
+    if (commandBuffer) glDeleteBuffers(1, &commandBuffer);
+    vertexBuffer = indexBuffer = vertexArray = binnedBuffer = commandBuffer = 0;
+    binnedCapacity = binnedBodyCount = 0;
+    for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+        bodySpheres[level] = glowSpheres[level] = SphereRange();
+    }
+    instances.clear();
+    instanceBuffer.release();
+    sphereProgram.release();
+    spriteProgram.release();
+    binningProgram.release();
+}
+
+void BodyMesh::buildSpheres() {
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+
+    auto append = [&](int segments) {
+        const SphereGeometry& sphere = SphereGeometry::cached(segments);
+        uint32_t baseVertex = static_cast<uint32_t>(positions.size() / 3);
+        SphereRange range;
+        range.indexOffset = indices.size() * sizeof(uint32_t);
+        range.indexCount = static_cast<GLsizei>(sphere.indices.size());
+        positions.insert(positions.end(), sphere.positions.begin(), sphere.positions.end());
+        for (uint32_t index : sphere.indices) {
+            indices.push_back(baseVertex + index);
+        }
+        return range;
+    };
+    for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+        bodySpheres[level] = append(LOD_LEVELS[level].bodySegments);
+        glowSpheres[level] = append(LOD_LEVELS[level].glowSegments);
+    }
+
+    glGenBuffers(1, &vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(positions.size() * sizeof(float)),
+                 positions.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)),
+                 indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void BodyMesh::buildBinning() {
+    std::ostringstream defines;
+    defines << std::showpoint
+            << "#define WORKGROUP_SIZE " << GpuNBodySimulation::WORKGROUP_SIZE << "\n"
+            << "#define BODY_BINDING " << GpuNBodySimulation::BODY_BINDING << "\n"
+            << "#define INSTANCE_BINDING " << INSTANCE_BINDING << "\n"
+            << "#define COMMAND_BINDING " << COMMAND_BINDING << "\n"
+            << "#define ELEMENTS_COMMAND_WORDS " << ELEMENTS_COMMAND_WORDS << "u\n"
+            << "#define SPRITE_COMMAND_WORD " << SPRITE_COMMAND_WORD << "u\n"
+            << "#define LOD_LEVEL_COUNT " << LOD_LEVEL_COUNT << "\n"
+            << "#define GRID_SCALE " << SpacetimeGridMesh::GRID_SCALE << "\n"
+            << "#define BODY_ELEVATION " << BODY_ELEVATION << "\n"
+            << "#define MIN_PIXEL_RADII ";
+    for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+        defines << (level ? ", " : "") << LOD_LEVELS[level].minPixelRadius;
+    }
+    defines << "\n";
+    const std::string definesSource = defines.str();
+
+    if (!binningProgram.buildCompute({ShaderProgram::versionHeader(profile, GL_COMPUTE_SHADER),
+                                      definesSource.c_str(), GpuNBodySimulation::GLSL_BODY_STRUCT,
+                                      BINNING_KERNEL})) {
+        return;
+    }
+    binningBodyCountLocation = binningProgram.getUniformLocation("bodyCount");
+    binningCapacityLocation = binningProgram.getUniformLocation("capacity");
+    binningViewLocation = binningProgram.getUniformLocation("view");
+    binningPixelScaleLocation = binningProgram.getUniformLocation("pixelScale");
+
+    glGenBuffers(1, &binnedBuffer);
+    glGenBuffers(1, &commandBuffer);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, (SPRITE_COMMAND_WORD + ARRAYS_COMMAND_WORDS) * sizeof(GLuint),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void BodyMesh::bindInstances(int group, GLuint divisor) {
+    GLintptr offset = 0;
+    if (binnedBodyCount > 0) {
+        // Binned draws select their group through the indirect command
+        glBindBuffer(GL_ARRAY_BUFFER, binnedBuffer);
+    } else {
+        // No base-instance draws before GL 4.2, so offset the attribute pointers instead
+        offset = instanceOffset + static_cast<GLintptr>(groupStart[group] * sizeof(Instance));
+        instanceBuffer.bind();
+    }
+    const GLsizei stride = sizeof(Instance);
+
+    glVertexAttribPointer(CENTER_RADIUS_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offset + offsetof(Instance, x)));
+    glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offset + offsetof(Instance, r)));
+    vertexAttribDivisor(CENTER_RADIUS_ATTRIBUTE, divisor);
+    vertexAttribDivisor(COLOR_ATTRIBUTE, divisor);
+}
+
+void BodyMesh::drawSpheres(bool glow) {
+    glUniform1f(sphereRadiusScaleLocation, glow ? GLOW_SCALE : 1.0f);
+    glUniform1f(sphereGlowWeightLocation, glow ? 1.0f : 0.0f);
+
+    if (binnedBodyCount > 0) {
+        // One multi-draw over the levels' commands; empty levels draw nothing
+        bindInstances(0, 1);
+        const size_t firstCommand = glow ? LOD_LEVEL_COUNT : 0;
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                    reinterpret_cast<const void*>(firstCommand * ELEMENTS_COMMAND_WORDS * sizeof(GLuint)),
+                                    LOD_LEVEL_COUNT, 0);
+        ++lastDrawCalls;
+        return;
+    }
+
+    for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+        if (groupCount[level] == 0) continue;
+        const SphereRange& sphere = glow ? glowSpheres[level] : bodySpheres[level];
+        bindInstances(level, 1);
+        drawElementsInstanced(sphere.indexCount, sphere.indexOffset, groupCount[level]);
+        ++lastDrawCalls;
+    }
+}
+
+void BodyMesh::drawSprites() {
+    const int group = LOD_LEVEL_COUNT;
+    const bool binned = binnedBodyCount > 0;
+    if (!binned && groupCount[group] == 0) return;
+
+    spriteProgram.use();
+    glUniform1f(spritePixelScaleLocation, currentPixelScale);
+    glUniform1f(spriteRadiusScaleLocation, GLOW_SCALE);
+    glUniform4fv(spriteGlowColorLocation, 1, GLOW_COLOR);
+
+    // gl_PointSize needs program point size; legacy contexts also need sprites enabled for gl_PointCoord
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    if (profile == ShaderProgram::Profile::Legacy) glEnable(GL_POINT_SPRITE);
+
+    bindInstances(group, 0);
+    if (binned) {
+        glDrawArraysIndirect(GL_POINTS, reinterpret_cast<const void*>(SPRITE_COMMAND_WORD * sizeof(GLuint)));
+    } else {
+        glDrawArrays(GL_POINTS, 0, groupCount[group]);
+    }
+    ++lastDrawCalls;
+
+    if (profile == ShaderProgram::Profile::Legacy) glDisable(GL_POINT_SPRITE);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+}
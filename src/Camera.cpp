@@ -27,6 +27,14 @@ void FreeFlightCamera::applyTransform() const {
     glTranslatef(posX, posY, posZ);
 }
 
+Mat4 FreeFlightCamera::getViewMatrix() const {
+    // Same order as applyTransform
+    return Mat4::translation(0.0f, 0.0f, -distance) *
+           Mat4::rotation(angleX, 1.0f, 0.0f, 0.0f) *
+           Mat4::rotation(angleY, 0.0f, 1.0f, 0.0f) *
+           Mat4::translation(posX, posY, posZ);
+}
+
 void FreeFlightCamera::updateFromMouse(float deltaX, float deltaY, bool isMousePressed) {
     if (isMousePressed) {
         angleY += deltaX * mouseSensitivity;
@@ -104,6 +112,13 @@ void GameStyleCamera::applyTransform() const {
     glTranslatef(-posX, -(eyeHeight), -posZ);
 }
 
+Mat4 GameStyleCamera::getViewMatrix() const {
+    // Same order as applyTransform
+    return Mat4::rotation(-pitch, 1.0f, 0.0f, 0.0f) *
+           Mat4::rotation(-yaw, 0.0f, 1.0f, 0.0f) *
+           Mat4::translation(-posX, -eyeHeight, -posZ);
+}
+
 void GameStyleCamera::updateFromMouse(float deltaX, float deltaY, bool isMousePressed) {
     if (isMousePressed) {
         yaw += deltaX * mouseSensitivity;
@@ -172,6 +187,10 @@ void CameraController::applyTransform() const {
     currentCamera->applyTransform();
 }
 
+Mat4 CameraController::getViewMatrix() const {
+    return currentCamera->getViewMatrix();
+}
+
 void CameraController::updateFromMouse(float deltaX, float deltaY, bool isMousePressed) {
     currentCamera->updateFromMouse(deltaX, deltaY, isMousePressed);
 }
@@ -0,0 +1,50 @@
+/**
+ * @file CameraUniformBuffer.cpp
+ * @brief Implementation of the camera uniform buffer
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/CameraUniformBuffer.h"
+#include <cstring>
+
+namespace {
+
+// Matches GLSL_BLOCK under std140: mat4 columns are vec4, so no padding
+constexpr size_t MATRIX_BYTES = 16 * sizeof(float);
+constexpr size_t BLOCK_BYTES = 3 * MATRIX_BYTES;
+
+} // namespace
+
+CameraUniformBuffer::~CameraUniformBuffer() {
+    release();
+}
+
+void CameraUniformBuffer::initialize() {
+    if (!buffer) glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(BLOCK_BYTES), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, buffer);
+}
+
+void CameraUniformBuffer::update(const Mat4& projection, const Mat4& view) {
+    if (!buffer) return;
+
+    Mat4 viewProjection = projection * view;
+    unsigned char block[BLOCK_BYTES];
+    std::memcpy(block, projection.data(), MATRIX_BYTES);
+    std::memcpy(block + MATRIX_BYTES, view.data(), MATRIX_BYTES);
+    std::memcpy(block + 2 * MATRIX_BYTES, viewProjection.data(), MATRIX_BYTES);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(BLOCK_BYTES), block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void CameraUniformBuffer::release() {
+    if (buffer) {
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+}
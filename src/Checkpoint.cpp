@@ -0,0 +1,265 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief Implementation of checkpoint writing, validation and restore
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/Checkpoint.h"
+#include "../include/GravitySimulation.h"
+#include "../include/Integrators.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const char MAGIC[8] = {'B', 'H', 'S', 'C', 'K', 'P', 'T', '\0'};
+
+/** Body sections in file order, with the store array each maps to */
+struct BodyArray {
+    const char* name;
+    std::vector<float> BodyStore::*member;
+};
+
+const BodyArray BODY_ARRAYS[] = {
+    {"body.x", &BodyStore::x},       {"body.y", &BodyStore::y},
+    {"body.vx", &BodyStore::vx},     {"body.vy", &BodyStore::vy},
+    {"body.mass", &BodyStore::mass}, {"body.radius", &BodyStore::radius},
+};
+
+const char INTEGRATOR_PREFIX[] = "integrator.";
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/** Bytes per element of a section */
+uint64_t sectionElementSize(const CheckpointSection& section) {
+    return IntegratorState::getElementSize(static_cast<IntegratorState::ElementType>(section.type));
+}
+
+/** Copies a string into a fixed zero-terminated field, truncating if needed */
+void copyName(char* destination, size_t capacity, const std::string& source) {
+    std::memset(destination, 0, capacity);
+    std::memcpy(destination, source.c_str(), std::min(source.size(), capacity - 1));
+}
+
+} // namespace
+
+bool CheckpointFile::open(const std::string& path) {
+    header = nullptr;
+    sections = nullptr;
+    if (!file.open(path)) return false;
+
+    const unsigned char* base = file.data();
+    const uint64_t size = file.size();
+    if (size < sizeof(CheckpointHeader) || std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << path << " is not a checkpoint\n";
+        return false;
+    }
+    const CheckpointHeader* candidate = reinterpret_cast<const CheckpointHeader*>(base);
+    if (candidate->byteOrder != CheckpointHeader::BYTE_ORDER_MARK) {
+        std::cerr << path << " was written on a machine with a different byte order\n";
+        return false;
+    }
+    if (candidate->version != CheckpointHeader::CURRENT_VERSION || candidate->headerSize != sizeof(CheckpointHeader)) {
+        std::cerr << path << " has unsupported checkpoint version " << candidate->version << "\n";
+        return false;
+    }
+    const uint64_t tableEnd = sizeof(CheckpointHeader) + uint64_t(candidate->sectionCount) * sizeof(CheckpointSection);
+    if (candidate->fileSize != size || tableEnd > size) {
+        std::cerr << path << " is truncated\n";
+        return false;
+    }
+
+    const CheckpointSection* table = reinterpret_cast<const CheckpointSection*>(base + sizeof(CheckpointHeader));
+    for (uint32_t i = 0; i < candidate->sectionCount; ++i) {
+        const CheckpointSection& section = table[i];
+        const size_t elementSize =
+            IntegratorState::getElementSize(static_cast<IntegratorState::ElementType>(section.type));
+        bool valid = std::memchr(section.name, '\0', sizeof(section.name)) != nullptr && elementSize > 0 &&
+                     section.offset % Checkpoint::SECTION_ALIGNMENT == 0 && section.offset >= tableEnd &&
+                     section.offset <= size && section.count <= (size - section.offset) / elementSize;
+        if (!valid) {
+            std::cerr << path << " has a corrupt section table\n";
+            return false;
+        }
+    }
+
+    header = candidate;
+    sections = table;
+    return true;
+}
+
+const void* CheckpointFile::findSection(const char* name, IntegratorState::ElementType type, uint64_t count) const {
+    if (!header) return nullptr;
+    for (uint32_t i = 0; i < header->sectionCount; ++i) {
+        const CheckpointSection& section = sections[i];
+        if (std::strcmp(section.name, name) == 0) {
+            bool matches = section.type == static_cast<uint32_t>(type) && section.count == count;
+            return matches ? file.data() + section.offset : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+const float* CheckpointFile::getBodyArray(const char* name) const {
+    return static_cast<const float*>(findSection(name, IntegratorState::ElementType::Float32,
+                                                 header ? header->bodyCount : 0));
+}
+
+IntegratorState CheckpointFile::getIntegratorState() const {
+    IntegratorState state;
+    if (!header) return state;
+    const size_t prefixLength = sizeof(INTEGRATOR_PREFIX) - 1;
+    for (uint32_t i = 0; i < header->sectionCount; ++i) {
+        const CheckpointSection& section = sections[i];
+        if (std::strncmp(section.name, INTEGRATOR_PREFIX, prefixLength) == 0) {
+            state.arrays.push_back({section.name + prefixLength,
+                                    static_cast<IntegratorState::ElementType>(section.type),
+                                    file.data() + section.offset, static_cast<size_t>(section.count)});
+        }
+    }
+    return state;
+}
+
+bool Checkpoint::write(const std::string& path, const BodyStore& bodies, const Info& info,
+                       const IntegratorState& integratorState) {
+    // Section table: body arrays then integrator arrays, each at an aligned offset
+    std::vector<CheckpointSection> table;
+    std::vector<const void*> payloads;
+    for (const BodyArray& array : BODY_ARRAYS) {
+        CheckpointSection section{};
+        copyName(section.name, sizeof(section.name), array.name);
+        section.type = static_cast<uint32_t>(IntegratorState::ElementType::Float32);
+        section.count = (bodies.*array.member).size();
+        table.push_back(section);
+        payloads.push_back((bodies.*array.member).data());
+    }
+    for (const IntegratorState::Array& array : integratorState.arrays) {
+        CheckpointSection section{};
+        copyName(section.name, sizeof(section.name), INTEGRATOR_PREFIX + array.name);
+        section.type = static_cast<uint32_t>(array.type);
+        section.count = array.count;
+        table.push_back(section);
+        payloads.push_back(array.data);
+    }
+    uint64_t offset = sizeof(CheckpointHeader) + table.size() * sizeof(CheckpointSection);
+    for (CheckpointSection& section : table) {
+        offset = alignUp(offset, SECTION_ALIGNMENT);
+        section.offset = offset;
+        offset += section.count * sectionElementSize(section);
+    }
+
+    CheckpointHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = CheckpointHeader::CURRENT_VERSION;
+    header.headerSize = sizeof(CheckpointHeader);
+    header.byteOrder = CheckpointHeader::BYTE_ORDER_MARK;
+    header.sectionCount = static_cast<uint32_t>(table.size());
+    header.bodyCount = bodies.size();
+    header.stepCount = info.stepCount;
+    header.fileSize = offset;
+    header.simulationTime = info.simulationTime;
+    header.gravitationalConstant = info.gravitationalConstant;
+    header.worldWidth = info.worldWidth;
+    header.worldHeight = info.worldHeight;
+    copyName(header.integrator, sizeof(header.integrator), info.integrator);
+
+    // Write next to the target and swap it in, so a failed save never destroys the last checkpoint
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Cannot write checkpoint " << temporaryPath << "\n";
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(CheckpointSection));
+        const char padding[SECTION_ALIGNMENT] = {};
+        uint64_t position = sizeof(CheckpointHeader) + table.size() * sizeof(CheckpointSection);
+        for (size_t i = 0; i < table.size(); ++i) {
+            const uint64_t bytes = table[i].count * sectionElementSize(table[i]);
+            out.write(padding, static_cast<std::streamsize>(table[i].offset - position));
+            out.write(static_cast<const char*>(payloads[i]), static_cast<std::streamsize>(bytes));
+            position = table[i].offset + bytes;
+        }
+        if (!out.flush()) {
+            std::cerr << "Failed writing checkpoint " << temporaryPath << "\n";
+            out.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    std::remove(path.c_str());  // rename() does not replace existing files on Windows
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Cannot move checkpoint into place at " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool Checkpoint::save(const GravitySimulation& simulation, const std::string& path) {
+    Info info;
+    info.gravitationalConstant = simulation.getGravitationalConstant();
+    auto world = simulation.getGravityGrid()->getWorldDimensions();
+    info.worldWidth = world.first;
+    info.worldHeight = world.second;
+    info.simulationTime = simulation.getSimulationTime();
+    info.stepCount = simulation.getStepCount();
+    info.integrator = simulation.getIntegrator().getName();
+
+    IntegratorState state;
+    simulation.getIntegrator().saveState(state);
+    return write(path, *simulation.getBodyStore(), info, state);
+}
+
+bool Checkpoint::load(GravitySimulation& simulation, const std::string& path) {
+    CheckpointFile file;
+    if (!file.open(path)) return false;
+    const CheckpointHeader& header = file.getHeader();
+
+    auto world = simulation.getGravityGrid()->getWorldDimensions();
+    if (header.worldWidth != world.first || header.worldHeight != world.second) {
+        std::cerr << path << " is for a " << header.worldWidth << "x" << header.worldHeight
+                  << " world, this simulation is " << world.first << "x" << world.second << "\n";
+        return false;
+    }
+
+    BodyStore store;
+    for (const BodyArray& array : BODY_ARRAYS) {
+        const float* values = file.getBodyArray(array.name);
+        if (!values) {
+            std::cerr << path << " is missing " << array.name << "\n";
+            return false;
+        }
+        (store.*array.member).assign(values, values + header.bodyCount);
+    }
+
+    simulation.replaceBodies(std::move(store));
+    simulation.setGravitationalConstant(header.gravitationalConstant);
+    simulation.setClock(header.simulationTime, header.stepCount);
+
+    const char* nameEnd = std::find(header.integrator, header.integrator + sizeof(header.integrator), '\0');
+    std::string integratorName(header.integrator, nameEnd);
+    if (integratorName != simulation.getIntegrator().getName()) {
+        if (auto integrator = createIntegrator(integratorName)) {
+            simulation.setIntegrator(std::move(integrator));
+        } else {
+            std::cerr << path << " uses unknown integrator '" << integratorName << "', keeping "
+                      << simulation.getIntegrator().getName() << "\n";
+        }
+    }
+    
+    // Cached state only means something to the integrator that wrote it
+    IntegratorState state = file.getIntegratorState();
+    if (integratorName == simulation.getIntegrator().getName() && !state.arrays.empty() &&
+        !simulation.restoreIntegratorState(state)) {
+        std::cerr << "Integrator state in " << path << " does not match its bodies; resuming with fresh forces\n";
+    }
+    return true;
+}
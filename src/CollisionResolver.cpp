@@ -0,0 +1,105 @@
+/**
+ * @file CollisionResolver.cpp
+ * @brief Implementation of body merging and inelastic collisions
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/CollisionResolver.h"
+#include <algorithm>
+#include <cmath>
+
+CollisionResolver::CollisionResolver(float worldWidth, float worldHeight)
+    : broadPhase(worldWidth, worldHeight) {}
+
+void CollisionResolver::setRestitution(float value) {
+    restitution = std::max(0.0f, std::min(1.0f, value));
+}
+
+size_t CollisionResolver::resolve(BodyStore& bodies, std::vector<size_t>& removed) {
+    removed.clear();
+    lastCollisionCount = 0;
+    if (mode == Mode::None || bodies.size() < 2) return 0;
+
+    // Cells as wide as the largest body keep every touching pair in neighbouring cells
+    float maxRadius = *std::max_element(bodies.radius.begin(), bodies.radius.end());
+    broadPhase.build(bodies, 2.0f * maxRadius);
+    broadPhase.findOverlappingPairs(bodies, 0.0f, pairs);
+    if (pairs.empty()) return 0;
+
+    absorbed.assign(bodies.size(), 0);
+    for (const SpatialHash::BodyPair& pair : pairs) {
+        size_t first = pair.first, second = pair.second;
+        if (absorbed[first] || absorbed[second] || !touching(bodies, first, second)) continue;
+
+        if (mode == Mode::Merge) {
+            if (bodies.mass[second] > bodies.mass[first]) std::swap(first, second);
+            merge(bodies, first, second);
+            absorbed[second] = 1;
+        } else {
+            bounce(bodies, first, second);
+        }
+        ++lastCollisionCount;
+    }
+
+    for (size_t i = 0; i < absorbed.size(); ++i) {
+        if (absorbed[i]) removed.push_back(i);
+    }
+    return lastCollisionCount;
+}
+
+void CollisionResolver::merge(BodyStore& bodies, size_t into, size_t from) {
+    const float m1 = bodies.mass[into];
+    const float m2 = bodies.mass[from];
+    const float total = m1 + m2;
+    if (total > 0.0f) {
+        bodies.x[into] = (m1 * bodies.x[into] + m2 * bodies.x[from]) / total;
+        bodies.y[into] = (m1 * bodies.y[into] + m2 * bodies.y[from]) / total;
+        bodies.vx[into] = (m1 * bodies.vx[into] + m2 * bodies.vx[from]) / total;
+        bodies.vy[into] = (m1 * bodies.vy[into] + m2 * bodies.vy[from]) / total;
+    }
+    bodies.mass[into] = total;
+    bodies.radius[into] = std::sqrt(bodies.radius[into] * bodies.radius[into] +
+                                    bodies.radius[from] * bodies.radius[from]);
+}
+
+bool CollisionResolver::bounce(BodyStore& bodies, size_t first, size_t second) const {
+    float dx = bodies.x[second] - bodies.x[first];
+    float dy = bodies.y[second] - bodies.y[first];
+    float distance = std::sqrt(dx * dx + dy * dy);
+    float nx = 1.0f, ny = 0.0f;
+    if (distance > 0.0f) {
+        nx = dx / distance;
+        ny = dy / distance;
+    }
+
+    const float inverse1 = bodies.mass[first] > 0.0f ? 1.0f / bodies.mass[first] : 0.0f;
+    const float inverse2 = bodies.mass[second] > 0.0f ? 1.0f / bodies.mass[second] : 0.0f;
+    const float inverseSum = inverse1 + inverse2;
+    if (inverseSum <= 0.0f) return false;
+
+    // Push apart until the surfaces just touch
+    float overlap = bodies.radius[first] + bodies.radius[second] - distance;
+    bodies.x[first] -= nx * overlap * inverse1 / inverseSum;
+    bodies.y[first] -= ny * overlap * inverse1 / inverseSum;
+    bodies.x[second] += nx * overlap * inverse2 / inverseSum;
+    bodies.y[second] += ny * overlap * inverse2 / inverseSum;
+
+    // Only approaching bodies get an impulse; separating ones are left alone
+    float approach = (bodies.vx[second] - bodies.vx[first]) * nx + (bodies.vy[second] - bodies.vy[first]) * ny;
+    if (approach >= 0.0f) return false;
+
+    float impulse = -(1.0f + restitution) * approach / inverseSum;
+    bodies.vx[first] -= impulse * inverse1 * nx;
+    bodies.vy[first] -= impulse * inverse1 * ny;
+    bodies.vx[second] += impulse * inverse2 * nx;
+    bodies.vy[second] += impulse * inverse2 * ny;
+    return true;
+}
+
+bool CollisionResolver::touching(const BodyStore& bodies, size_t first, size_t second) {
+    float dx = bodies.x[second] - bodies.x[first];
+    float dy = bodies.y[second] - bodies.y[first];
+    float reach = bodies.radius[first] + bodies.radius[second];
+    return dx * dx + dy * dy < reach * reach;
+}
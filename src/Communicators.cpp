@@ -0,0 +1,147 @@
+/**
+ * @file Communicators.cpp
+ * @brief Implementation of the serial and MPI communicators
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/Communicators.h"
+#include <cstring>
+
+#ifdef BLACKHOLE_WITH_MPI
+#include <mpi.h>
+#include <climits>
+#include <iostream>
+#endif
+
+void SerialCommunicator::allToAll(const std::vector<unsigned char>& send, const std::vector<size_t>& sendBytes,
+                                  std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) {
+    receive.assign(send.begin(), send.begin() + (sendBytes.empty() ? 0 : sendBytes[0]));
+    receiveBytes.assign(1, receive.size());
+}
+
+void SerialCommunicator::allGather(const void* send, size_t bytes,
+                                   std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) {
+    receive.resize(bytes);
+    if (bytes > 0) std::memcpy(receive.data(), send, bytes);
+    receiveBytes.assign(1, bytes);
+}
+
+void SerialCommunicator::gather(const void* send, size_t bytes, std::vector<unsigned char>& receive,
+                                std::vector<size_t>& receiveBytes, int root) {
+    (void)root;
+    allGather(send, bytes, receive, receiveBytes);
+}
+
+#ifdef BLACKHOLE_WITH_MPI
+
+namespace {
+
+/**
+ * @brief Converts a byte count to an MPI count, aborting the job when it does not fit
+ */
+int toMpiCount(size_t bytes) {
+    if (bytes > static_cast<size_t>(INT_MAX)) {
+        std::cerr << "MPI exchange of " << bytes << " bytes exceeds the 2 GiB per-message limit" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    return static_cast<int>(bytes);
+}
+
+/**
+ * @brief Fills displacements from counts and returns the total
+ */
+size_t prefixOffsets(const std::vector<int>& counts, std::vector<int>& offsets) {
+    offsets.resize(counts.size());
+    size_t total = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        offsets[i] = toMpiCount(total);
+        total += static_cast<size_t>(counts[i]);
+    }
+    toMpiCount(total);
+    return total;
+}
+
+} // namespace
+
+MpiCommunicator::MpiCommunicator(int* argc, char*** argv) {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        int provided = 0;
+        MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provided);
+        ownsMpi = true;
+        if (provided < MPI_THREAD_FUNNELED) {
+            std::cerr << "Warning: MPI library does not support MPI_THREAD_FUNNELED; use --threads=1" << std::endl;
+        }
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+}
+
+MpiCommunicator::~MpiCommunicator() {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (ownsMpi && !finalized) MPI_Finalize();
+}
+
+void MpiCommunicator::allToAll(const std::vector<unsigned char>& send, const std::vector<size_t>& sendBytes,
+                               std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) {
+    counts.resize(size);
+    for (int r = 0; r < size; ++r) {
+        counts[r] = toMpiCount(sendBytes[r]);
+    }
+    peerCounts.resize(size);
+    MPI_Alltoall(counts.data(), 1, MPI_INT, peerCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    prefixOffsets(counts, offsets);
+    receive.resize(prefixOffsets(peerCounts, peerOffsets));
+    MPI_Alltoallv(send.data(), counts.data(), offsets.data(), MPI_BYTE,
+                  receive.data(), peerCounts.data(), peerOffsets.data(), MPI_BYTE, MPI_COMM_WORLD);
+    receiveBytes.assign(peerCounts.begin(), peerCounts.end());
+}
+
+void MpiCommunicator::allGather(const void* send, size_t bytes,
+                                std::vector<unsigned char>& receive, std::vector<size_t>& receiveBytes) {
+    int count = toMpiCount(bytes);
+    peerCounts.resize(size);
+    MPI_Allgather(&count, 1, MPI_INT, peerCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    receive.resize(prefixOffsets(peerCounts, peerOffsets));
+    MPI_Allgatherv(send, count, MPI_BYTE, receive.data(), peerCounts.data(), peerOffsets.data(),
+                   MPI_BYTE, MPI_COMM_WORLD);
+    receiveBytes.assign(peerCounts.begin(), peerCounts.end());
+}
+
+void MpiCommunicator::gather(const void* send, size_t bytes, std::vector<unsigned char>& receive,
+                             std::vector<size_t>& receiveBytes, int root) {
+    int count = toMpiCount(bytes);
+    peerCounts.resize(size);
+    MPI_Gather(&count, 1, MPI_INT, peerCounts.data(), 1, MPI_INT, root, MPI_COMM_WORLD);
+    unsigned char* target = nullptr;
+    if (rank == root) {
+        receive.resize(prefixOffsets(peerCounts, peerOffsets));
+        target = receive.data();
+        receiveBytes.assign(peerCounts.begin(), peerCounts.end());
+    }
+    MPI_Gatherv(send, count, MPI_BYTE, target, peerCounts.data(), peerOffsets.data(), MPI_BYTE,
+                root, MPI_COMM_WORLD);
+}
+
+void MpiCommunicator::allReduceSum(double* values, size_t count) {
+    MPI_Allreduce(MPI_IN_PLACE, values, toMpiCount(count), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+}
+
+void MpiCommunicator::allReduceMax(double* values, size_t count) {
+    MPI_Allreduce(MPI_IN_PLACE, values, toMpiCount(count), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+}
+
+#endif
+
+std::unique_ptr<ICommunicator> createCommunicator(int* argc, char*** argv) {
+#ifdef BLACKHOLE_WITH_MPI
+    return std::make_unique<MpiCommunicator>(argc, argv);
+#else
+    (void)argc;
+    (void)argv;
+    return std::make_unique<SerialCommunicator>();
+#endif
+}
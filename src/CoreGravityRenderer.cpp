@@ -0,0 +1,126 @@
+/**
+ * @file CoreGravityRenderer.cpp
+ * @brief Implementation of the core-profile gravity renderer
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/CoreGravityRenderer.h"
+#include "../include/Camera.h"
+#include "../include/GpuNBodySimulation.h"
+#include <iostream>
+
+CoreGravityRenderer::CoreGravityRenderer(float viewportWidth, float viewportHeight)
+    : viewportWidth(viewportWidth), viewportHeight(viewportHeight),
+      maxForceVisualization(500.0f), isInitialized(false) {}
+
+bool CoreGravityRenderer::isSupported() {
+    return GLEW_VERSION_3_3;
+}
+
+void CoreGravityRenderer::initialize() {
+    if (!isSupported()) {
+        std::cerr << "CoreGravityRenderer requires OpenGL 3.3" << std::endl;
+        return;
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glViewport(0, 0, static_cast<GLsizei>(viewportWidth), static_cast<GLsizei>(viewportHeight));
+
+    cameraUniforms.initialize();
+
+    gridMesh = std::make_unique<SpacetimeGridMesh>();
+    bodyMesh = std::make_unique<BodyMesh>();
+    if (!gridMesh->initialize(ShaderProgram::Profile::Core) || !bodyMesh->initialize(ShaderProgram::Profile::Core)) {
+        std::cerr << "CoreGravityRenderer failed to build its shaders" << std::endl;
+        cleanup();
+        return;
+    }
+
+    isInitialized = true;
+    std::cout << "CoreGravityRenderer initialized with " << viewportWidth << "x" << viewportHeight
+              << " viewport (" << glGetString(GL_VERSION) << ")" << std::endl;
+}
+
+void CoreGravityRenderer::render(const CameraController& cameraController, UIRenderer*) {
+    if (!isInitialized) {
+        std::cerr << "Warning: CoreGravityRenderer not initialized" << std::endl;
+        return;
+    }
+    renderFrame(cameraController.getViewMatrix());
+}
+
+void CoreGravityRenderer::render() {
+    if (!isInitialized) {
+        std::cerr << "Warning: CoreGravityRenderer not initialized" << std::endl;
+        return;
+    }
+    renderFrame(Mat4::translation(0.0f, 0.0f, -DEFAULT_CAMERA_DISTANCE));
+}
+
+bool CoreGravityRenderer::setGpuSimulation(std::shared_ptr<const GpuNBodySimulation> simulation) {
+    if (simulation && (!isInitialized || !bodyMesh->canDrawBodyBuffers())) {
+        std::cerr << "CoreGravityRenderer needs OpenGL 4.3 to draw GPU simulation buffers" << std::endl;
+        return false;
+    }
+    gpuSimulation = std::move(simulation);
+    return true;
+}
+
+void CoreGravityRenderer::cleanup() {
+    gpuSimulation.reset();
+    gridMesh.reset();
+    bodyMesh.reset();
+    cameraUniforms.release();
+    isInitialized = false;
+    std::cout << "CoreGravityRenderer cleaned up" << std::endl;
+}
+
+void CoreGravityRenderer::setViewportSize(float width, float height) {
+    viewportWidth = width;
+    viewportHeight = height;
+
+    if (isInitialized) {
+        glViewport(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+    }
+}
+
+void CoreGravityRenderer::renderFrame(const Mat4& view) {
+    glClearColor(0.0f, 0.0f, 0.05f, 1.0f); // Dark blue background
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    const Mat4 projection = projectionMatrix();
+    cameraUniforms.update(projection, view);
+    const float pixelScale = BodyMesh::pixelScaleFor(FIELD_OF_VIEW, viewportHeight);
+
+    if (gpuSimulation) {
+        {
+            Profiler::Scope scope(profiler, Profiler::Phase::GridRender, true);
+            auto dimensions = gpuSimulation->getGridDimensions();
+            gridMesh->updateFromBuffer(gpuSimulation->getFieldMagnitudeBuffer(), dimensions.first, dimensions.second);
+            gridMesh->draw(maxForceVisualization, view, projection, pixelScale);
+        }
+        Profiler::Scope scope(profiler, Profiler::Phase::BodyRender, true);
+        bodyMesh->updateFromBuffer(gpuSimulation->getBodyBuffer(), gpuSimulation->getBodyCount(), view, pixelScale);
+        bodyMesh->draw();
+        return;
+    }
+
+    SceneSource::Frame frame = sceneSource.acquire();
+    if (frame.grid) {
+        Profiler::Scope scope(profiler, Profiler::Phase::GridRender, true);
+        gridMesh->update(*frame.grid);
+        gridMesh->draw(maxForceVisualization, view, projection, pixelScale);
+    }
+    if (frame.bodies) {
+        Profiler::Scope scope(profiler, Profiler::Phase::BodyRender, true);
+        bodyMesh->update(*frame.bodies, view, projection, pixelScale);
+        bodyMesh->draw();
+    }
+}
+
+Mat4 CoreGravityRenderer::projectionMatrix() const {
+    return Mat4::perspective(FIELD_OF_VIEW, viewportWidth / viewportHeight, Z_NEAR, Z_FAR);
+}
@@ -0,0 +1,29 @@
+#include "../include/DirectForceSolver.h"
+#include "../include/ForceKernels.h"
+
+void DirectForceSolver::computeForces(const BodyStore& bodies,
+                                      float gravitationalConstant,
+                                      std::vector<Vec2>& forces,
+                                      ThreadPool* threadPool) {
+    forces.assign(bodies.size(), Vec2(0.0f, 0.0f));
+    
+    // Vectorized over target bodies; every body is a source for every target.
+    // Each chunk owns a disjoint range of targets, so no reduction is needed.
+    ThreadPool::run(threadPool, 0, bodies.size(), TARGETS_PER_TASK, [&](size_t begin, size_t end) {
+        ForceKernels::computePairForces(bodies, begin, end, gravitationalConstant, forces.data(), forceLaw);
+    });
+}
+
+void DirectForceSolver::computeForcesOn(const BodyStore& bodies,
+                                        float gravitationalConstant,
+                                        const std::vector<size_t>& targets,
+                                        std::vector<Vec2>& forces,
+                                        ThreadPool* threadPool) {
+    forces.resize(bodies.size());
+    
+    // Same kernels, with the targets gathered per chunk; chunks write disjoint entries
+    ThreadPool::run(threadPool, 0, targets.size(), TARGETS_PER_TASK, [&](size_t begin, size_t end) {
+        ForceKernels::computePairForcesOn(bodies, targets.data() + begin, end - begin,
+                                          gravitationalConstant, forces.data(), forceLaw);
+    });
+}
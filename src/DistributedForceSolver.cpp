@@ -0,0 +1,135 @@
+/**
+ * @file DistributedForceSolver.cpp
+ * @brief Implementation of the locally essential tree exchange
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/DistributedForceSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+DistributedForceSolver::DistributedForceSolver(ICommunicator& communicator, float theta)
+    : communicator(communicator), localSolver(theta) {
+}
+
+void DistributedForceSolver::computeForces(const BodyStore& bodies,
+                                           float gravitationalConstant,
+                                           std::vector<Vec2>& forces,
+                                           ThreadPool* threadPool) {
+    auto start = std::chrono::steady_clock::now();
+    ++statistics.evaluations;
+    if (communicator.getSize() == 1) {
+        localSolver.computeForces(bodies, gravitationalConstant, forces, threadPool);
+        statistics.forceSeconds += secondsSince(start);
+        return;
+    }
+
+    gatherSources(bodies, threadPool);
+    localTargets.resize(bodies.size());
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        localTargets[i] = i;
+    }
+    localSolver.computeForcesOn(sources, gravitationalConstant, localTargets, sourceForces, threadPool);
+    forces.assign(sourceForces.begin(), sourceForces.begin() + bodies.size());
+    statistics.forceSeconds += secondsSince(start);
+}
+
+void DistributedForceSolver::computeForcesOn(const BodyStore& bodies,
+                                             float gravitationalConstant,
+                                             const std::vector<size_t>& targets,
+                                             std::vector<Vec2>& forces,
+                                             ThreadPool* threadPool) {
+    auto start = std::chrono::steady_clock::now();
+    ++statistics.evaluations;
+    if (communicator.getSize() == 1) {
+        localSolver.computeForcesOn(bodies, gravitationalConstant, targets, forces, threadPool);
+        statistics.forceSeconds += secondsSince(start);
+        return;
+    }
+
+    // Local bodies keep their indices in the source store, so the targets carry over unchanged
+    gatherSources(bodies, threadPool);
+    localSolver.computeForcesOn(sources, gravitationalConstant, targets, sourceForces, threadPool);
+    forces.resize(bodies.size());
+    for (size_t target : targets) {
+        forces[target] = sourceForces[target];
+    }
+    statistics.forceSeconds += secondsSince(start);
+}
+
+void DistributedForceSolver::gatherSources(const BodyStore& bodies, ThreadPool* threadPool) {
+    auto start = std::chrono::steady_clock::now();
+    const int rank = communicator.getRank();
+    const int size = communicator.getSize();
+    const size_t local = bodies.size();
+
+    // Bounding rectangle of the bodies here; an empty rank sends an inverted one
+    BarnesHutSolver::Region own = {1.0f, 1.0f, -1.0f, -1.0f};
+    if (local > 0) {
+        own = {bodies.x[0], bodies.y[0], bodies.x[0], bodies.y[0]};
+        for (size_t i = 1; i < local; ++i) {
+            own.minX = std::min(own.minX, bodies.x[i]);
+            own.maxX = std::max(own.maxX, bodies.x[i]);
+            own.minY = std::min(own.minY, bodies.y[i]);
+            own.maxY = std::max(own.maxY, bodies.y[i]);
+        }
+    }
+    communicator.allGather(&own, sizeof(own), receiveBuffer, receiveBytes);
+
+    // Summaries only for the other ranks that hold bodies; the rest get empty blocks
+    regions.clear();
+    exportRanks.clear();
+    for (int r = 0; r < size; ++r) {
+        BarnesHutSolver::Region region;
+        std::memcpy(&region, receiveBuffer.data() + r * sizeof(region), sizeof(region));
+        if (r == rank || region.minX > region.maxX) continue;
+        regions.push_back(region);
+        exportRanks.push_back(r);
+    }
+    summaries.resize(regions.size());
+    localSolver.summarize(bodies, regions.data(), regions.size(), summaries.data(), threadPool);
+
+    size_t exported = 0;
+    sendBytes.assign(size, 0);
+    for (size_t k = 0; k < exportRanks.size(); ++k) {
+        sendBytes[exportRanks[k]] = summaries[k].size() * sizeof(BarnesHutSolver::PointMass);
+        exported += summaries[k].size();
+    }
+    sendBuffer.resize(exported * sizeof(BarnesHutSolver::PointMass));
+    size_t offset = 0;
+    for (size_t k = 0; k < exportRanks.size(); ++k) {
+        size_t bytes = summaries[k].size() * sizeof(BarnesHutSolver::PointMass);
+        if (bytes > 0) std::memcpy(sendBuffer.data() + offset, summaries[k].data(), bytes);
+        offset += bytes;
+    }
+    communicator.allToAll(sendBuffer, sendBytes, receiveBuffer, receiveBytes);
+
+    // Local bodies first so their indices are unchanged, then the imported masses
+    const size_t imported = receiveBuffer.size() / sizeof(BarnesHutSolver::PointMass);
+    sources.resize(local + imported);
+    std::copy(bodies.x.begin(), bodies.x.end(), sources.x.begin());
+    std::copy(bodies.y.begin(), bodies.y.end(), sources.y.begin());
+    std::copy(bodies.mass.begin(), bodies.mass.end(), sources.mass.begin());
+    const unsigned char* cursor = receiveBuffer.data();
+    for (size_t i = 0; i < imported; ++i, cursor += sizeof(BarnesHutSolver::PointMass)) {
+        BarnesHutSolver::PointMass point;
+        std::memcpy(&point, cursor, sizeof(point));
+        sources.x[local + i] = point.x;
+        sources.y[local + i] = point.y;
+        sources.mass[local + i] = point.mass;
+    }
+
+    statistics.exportedMasses += exported;
+    statistics.importedMasses += imported;
+    statistics.exchangeSeconds += secondsSince(start);
+}
@@ -0,0 +1,260 @@
+/**
+ * @file DistributedSimulation.cpp
+ * @brief Implementation of domain-decomposed stepping, migration and snapshots
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/DistributedSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+DistributedSimulation::DistributedSimulation(ICommunicator& communicator, float worldWidth, float worldHeight,
+                                             float theta, size_t threadCount)
+    : communicator(communicator), forceSolver(nullptr),
+      simulation(worldWidth, worldHeight, 1, nullptr, threadCount),
+      decomposition(worldWidth, worldHeight, communicator.getSize()) {
+    auto solver = std::make_unique<DistributedForceSolver>(communicator, theta);
+    forceSolver = solver.get();
+    simulation.setForceSolver(std::move(solver));
+    simulation.setCollisionMode(CollisionResolver::Mode::None);
+}
+
+bool DistributedSimulation::setIntegrator(std::unique_ptr<IIntegrator> integrator) {
+    if (!integrator) return false;
+    if (std::string(integrator->getName()) == "block") {
+        std::cerr << "Block timesteps evaluate forces a varying number of times per step "
+                     "and cannot run distributed" << std::endl;
+        return false;
+    }
+    simulation.setIntegrator(std::move(integrator));
+    return true;
+}
+
+size_t DistributedSimulation::populate(const IBodyGenerator& generator) {
+    simulation.clearBodies();
+    simulation.addBodies(generator);
+    const BodyStore& scene = *simulation.getBodyStore();
+    const size_t total = scene.size();
+
+    // Each rank samples its own slice of the (identical) scene for the first cuts
+    const size_t rank = static_cast<size_t>(communicator.getRank());
+    const size_t size = static_cast<size_t>(communicator.getSize());
+    size_t first = total * rank / size;
+    size_t last = total * (rank + 1) / size;
+    decomposition.rebalance(scene, first, last - first, communicator);
+
+    BodyStore local;
+    ids.clear();
+    for (size_t i = 0; i < total; ++i) {
+        if (decomposition.ownerOf(scene.x[i], scene.y[i]) != communicator.getRank()) continue;
+        local.add(scene.getPosition(i), scene.getVelocity(i), scene.mass[i], scene.radius[i]);
+        ids.push_back(i);
+    }
+    simulation.replaceBodies(std::move(local));
+    costAtRebalance = forceSolver->getStatistics().forceSeconds - forceSolver->getStatistics().exchangeSeconds;
+    return total;
+}
+
+void DistributedSimulation::step(float deltaTime) {
+    auto start = std::chrono::steady_clock::now();
+    simulation.stepBodies(deltaTime);
+    ++statistics.steps;
+
+    auto migrationStart = std::chrono::steady_clock::now();
+    if (rebalanceInterval > 0 && statistics.steps % static_cast<size_t>(rebalanceInterval) == 0) {
+        rebalance();
+    }
+    migrate();
+    statistics.migrationSeconds += secondsSince(migrationStart);
+    statistics.stepSeconds += secondsSince(start);
+}
+
+void DistributedSimulation::rebalance() {
+    // Time spent walking trees here, excluding the wait for other ranks inside the exchange
+    const DistributedForceSolver::Statistics& forces = forceSolver->getStatistics();
+    double cost = forces.forceSeconds - forces.exchangeSeconds;
+    decomposition.rebalance(*simulation.getBodyStore(), cost - costAtRebalance, communicator);
+    costAtRebalance = cost;
+    ++statistics.rebalances;
+}
+
+void DistributedSimulation::migrate() {
+    const BodyStore& bodies = *simulation.getBodyStore();
+    const int rank = communicator.getRank();
+    const int size = communicator.getSize();
+    const size_t count = bodies.size();
+
+    // World bounds that moved bodies dropped that rank's cached forces; drop everyone's so all ranks
+    // evaluate forces equally often and carry the same arrays
+    double boundsMoved = simulation.didLastStepMoveBodies() ? 1.0 : 0.0;
+    communicator.allReduceMax(&boundsMoved, 1);
+    const bool forcesDropped = boundsMoved > 0.0;
+    if (forcesDropped) simulation.invalidateForces();
+
+    // Per-body width of every integrator array; ranks without bodies learn it from the others
+    IntegratorState saved;
+    simulation.getIntegrator().saveState(saved);
+    double arrayCounts[2] = {static_cast<double>(saved.arrays.size()), -static_cast<double>(saved.arrays.size())};
+    communicator.allReduceMax(arrayCounts, 2);
+    bool consistent = arrayCounts[0] == -arrayCounts[1];
+    std::vector<double> widths(consistent ? saved.arrays.size() : 0, 0.0);
+    for (size_t a = 0; a < widths.size(); ++a) {
+        if (count > 0) widths[a] = static_cast<double>(saved.arrays[a].count / count);
+    }
+    if (!widths.empty()) communicator.allReduceMax(widths.data(), widths.size());
+
+    // Bytes of every array per body; Float64 arrays (double positions) move at full width
+    std::vector<size_t> strides(widths.size());
+    size_t stateBytes = 0;
+    for (size_t a = 0; a < widths.size(); ++a) {
+        size_t width = static_cast<size_t>(widths[a]);
+        consistent = consistent && saved.arrays[a].count == width * count;
+        strides[a] = width * IntegratorState::getElementSize(saved.arrays[a].type);
+        stateBytes += strides[a];
+    }
+    const size_t recordBytes = sizeof(BodyRecord) + stateBytes;
+
+    // Copies body i (its record and its slice of every state array) to a buffer
+    auto pack = [&](size_t i, unsigned char* out) {
+        BodyRecord record = {bodies.x[i], bodies.y[i], bodies.vx[i], bodies.vy[i],
+                             bodies.mass[i], bodies.radius[i], ids[i]};
+        std::memcpy(out, &record, sizeof(record));
+        out += sizeof(record);
+        for (size_t a = 0; a < widths.size(); ++a) {
+            if (consistent) {
+                std::memcpy(out, static_cast<const unsigned char*>(saved.arrays[a].data) + i * strides[a],
+                            strides[a]);
+            } else {
+                std::memset(out, 0, strides[a]);
+            }
+            out += strides[a];
+        }
+    };
+
+    // Bucket the leaving bodies by destination; rank is the local block of the buffer
+    std::vector<int> owners(count);
+    std::vector<size_t> perRank(size, 0);
+    for (size_t i = 0; i < count; ++i) {
+        owners[i] = decomposition.ownerOf(bodies.x[i], bodies.y[i]);
+        ++perRank[owners[i]];
+    }
+    std::vector<size_t> cursor(size, 0);
+    size_t leaving = 0;
+    for (int r = 0; r < size; ++r) {
+        cursor[r] = leaving;
+        if (r != rank) leaving += perRank[r];
+    }
+    sendBuffer.resize(leaving * recordBytes);
+    sendBytes.assign(size, 0);
+    for (int r = 0; r < size; ++r) {
+        if (r != rank) sendBytes[r] = perRank[r] * recordBytes;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (owners[i] == rank) continue;
+        pack(i, sendBuffer.data() + cursor[owners[i]]++ * recordBytes);
+    }
+    communicator.allToAll(sendBuffer, sendBytes, receiveBuffer, receiveBytes);
+    const size_t arriving = receiveBuffer.size() / recordBytes;
+    statistics.migratedBodies += leaving;
+
+    bool restored = true;
+    if (leaving > 0 || arriving > 0) {
+        // Staying bodies keep their order, arrivals follow in rank order
+        const size_t kept = count - leaving;
+        const size_t total = kept + arriving;
+        std::vector<unsigned char> staying(kept * recordBytes);
+        size_t k = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (owners[i] == rank) pack(i, staying.data() + k++ * recordBytes);
+        }
+
+        BodyStore next;
+        next.reserve(total);
+        std::vector<uint64_t> nextIds;
+        nextIds.reserve(total);
+        // 8-byte words keep Float64 arrays aligned
+        std::vector<std::vector<uint64_t>> state(widths.size());
+        for (size_t a = 0; a < widths.size(); ++a) {
+            state[a].resize((total * strides[a] + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        }
+        auto unpack = [&](const unsigned char* in, size_t index) {
+            BodyRecord record;
+            std::memcpy(&record, in, sizeof(record));
+            in += sizeof(record);
+            next.add(Vec2(record.x, record.y), Vec2(record.vx, record.vy), record.mass, record.radius);
+            nextIds.push_back(record.id);
+            for (size_t a = 0; a < widths.size(); ++a) {
+                std::memcpy(reinterpret_cast<unsigned char*>(state[a].data()) + index * strides[a], in, strides[a]);
+                in += strides[a];
+            }
+        };
+        for (size_t i = 0; i < kept; ++i) unpack(staying.data() + i * recordBytes, i);
+        for (size_t i = 0; i < arriving; ++i) unpack(receiveBuffer.data() + i * recordBytes, kept + i);
+
+        // saved points into the integrator, so its names and types are read before the reset
+        IntegratorState moved;
+        for (size_t a = 0; a < widths.size(); ++a) {
+            moved.arrays.push_back({saved.arrays[a].name, saved.arrays[a].type, state[a].data(),
+                                    total * static_cast<size_t>(widths[a])});
+        }
+        simulation.replaceBodies(std::move(next));
+        ids.swap(nextIds);
+        // Without cached forces the state is incomplete by design; only the rest must carry over
+        bool complete = simulation.restoreIntegratorState(moved);
+        restored = consistent && (complete || forcesDropped);
+    }
+
+    // A rank whose integrator had to reset would evaluate forces one extra time; make everyone reset together
+    double failed = restored ? 0.0 : 1.0;
+    communicator.allReduceMax(&failed, 1);
+    if (failed > 0.0) {
+        simulation.restoreIntegratorState(IntegratorState());
+        ++statistics.stateResets;
+    }
+}
+
+void DistributedSimulation::gatherSnapshot(size_t decimation, BodyStore& snapshot, int root) {
+    const BodyStore& bodies = *simulation.getBodyStore();
+    decimation = std::max<size_t>(decimation, 1);
+    std::vector<BodyRecord> picked;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (ids[i] % decimation != 0) continue;
+        picked.push_back({bodies.x[i], bodies.y[i], bodies.vx[i], bodies.vy[i],
+                          bodies.mass[i], bodies.radius[i], ids[i]});
+    }
+    communicator.gather(picked.data(), picked.size() * sizeof(BodyRecord), receiveBuffer, receiveBytes, root);
+    if (communicator.getRank() != root) return;
+
+    std::vector<BodyRecord> records(receiveBuffer.size() / sizeof(BodyRecord));
+    if (!records.empty()) std::memcpy(records.data(), receiveBuffer.data(), records.size() * sizeof(BodyRecord));
+    std::sort(records.begin(), records.end(), [](const BodyRecord& a, const BodyRecord& b) { return a.id < b.id; });
+    snapshot.clear();
+    appendRecords(records.data(), records.size(), snapshot);
+    snapshot.touch();
+}
+
+void DistributedSimulation::resetStatistics() {
+    statistics = Statistics();
+    forceSolver->resetStatistics();
+    costAtRebalance = 0.0;
+}
+
+void DistributedSimulation::appendRecords(const BodyRecord* records, size_t count, BodyStore& store) {
+    store.reserve(store.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        store.add(Vec2(records[i].x, records[i].y), Vec2(records[i].vx, records[i].vy),
+                  records[i].mass, records[i].radius);
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file DomainDecomposition.cpp
+ * @brief Implementation of the orthogonal recursive bisection
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/DomainDecomposition.h"
+#include <algorithm>
+#include <cstring>
+
+DomainDecomposition::DomainDecomposition(float worldWidth, float worldHeight, int rankCount)
+    : worldWidth(worldWidth), worldHeight(worldHeight), domains(std::max(1, rankCount)) {
+    split({0.0f, 0.0f, worldWidth, worldHeight}, 0, static_cast<int>(domains.size()), 0, 0);
+}
+
+void DomainDecomposition::rebalance(const BodyStore& bodies, double cost, ICommunicator& communicator) {
+    std::vector<Sample> local;
+    sampleRange(bodies, 0, bodies.size(), cost > 0.0 ? cost : static_cast<double>(bodies.size()), local);
+    build(local, communicator);
+}
+
+void DomainDecomposition::rebalance(const BodyStore& bodies, size_t first, size_t count,
+                                    ICommunicator& communicator) {
+    std::vector<Sample> local;
+    sampleRange(bodies, first, count, static_cast<double>(count), local);
+    build(local, communicator);
+}
+
+int DomainDecomposition::ownerOf(float x, float y) const {
+    int index = 0;
+    while (cuts[index].axis >= 0) {
+        const Cut& cut = cuts[index];
+        index = (cut.axis == 0 ? x : y) < cut.position ? cut.low : cut.high;
+    }
+    return cuts[index].rank;
+}
+
+void DomainDecomposition::build(const std::vector<Sample>& local, ICommunicator& communicator) {
+    std::vector<unsigned char> gathered;
+    std::vector<size_t> bytes;
+    communicator.allGather(local.data(), local.size() * sizeof(Sample), gathered, bytes);
+    samples.resize(gathered.size() / sizeof(Sample));
+    if (!samples.empty()) std::memcpy(samples.data(), gathered.data(), samples.size() * sizeof(Sample));
+
+    cuts.clear();
+    split({0.0f, 0.0f, worldWidth, worldHeight}, 0, static_cast<int>(domains.size()), 0, samples.size());
+}
+
+int DomainDecomposition::split(const DomainBox& box, int firstRank, int rankCount, size_t begin, size_t end) {
+    int index = static_cast<int>(cuts.size());
+    cuts.push_back({-1, 0.0f, -1, -1, firstRank});
+    if (rankCount == 1) {
+        domains[firstRank] = box;
+        return index;
+    }
+
+    // Cut across the longer side so domains stay close to square (less surface to exchange)
+    int axis = (box.maxX - box.minX >= box.maxY - box.minY) ? 0 : 1;
+    int lowRanks = rankCount / 2;
+    double fraction = static_cast<double>(lowRanks) / rankCount;
+    float lower = axis == 0 ? box.minX : box.minY;
+    float upper = axis == 0 ? box.maxX : box.maxY;
+    auto coordinate = [axis](const Sample& sample) { return axis == 0 ? sample.x : sample.y; };
+
+    // Weighted quantile of the samples; an empty box is cut by area
+    float position = static_cast<float>(lower + (upper - lower) * fraction);
+    double total = 0.0;
+    for (size_t i = begin; i < end; ++i) total += samples[i].weight;
+    if (total > 0.0) {
+        std::sort(samples.begin() + begin, samples.begin() + end, [axis](const Sample& a, const Sample& b) {
+            float ka = axis == 0 ? a.x : a.y, kb = axis == 0 ? b.x : b.y;
+            if (ka != kb) return ka < kb;
+            float oa = axis == 0 ? a.y : a.x, ob = axis == 0 ? b.y : b.x;
+            return oa < ob;
+        });
+        double target = total * fraction, running = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            running += samples[i].weight;
+            if (running >= target) {
+                // Halfway to the next sample, so neither lands on the cut
+                float next = i + 1 < end ? coordinate(samples[i + 1]) : upper;
+                position = 0.5f * (coordinate(samples[i]) + next);
+                break;
+            }
+        }
+    }
+    position = std::min(std::max(position, lower), upper);
+
+    size_t middle = static_cast<size_t>(std::partition(samples.begin() + begin, samples.begin() + end,
+                                                       [&](const Sample& sample) {
+                                                           return coordinate(sample) < position;
+                                                       }) - samples.begin());
+    DomainBox lowBox = box, highBox = box;
+    (axis == 0 ? lowBox.maxX : lowBox.maxY) = position;
+    (axis == 0 ? highBox.minX : highBox.minY) = position;
+    int low = split(lowBox, firstRank, lowRanks, begin, middle);
+    int high = split(highBox, firstRank + lowRanks, rankCount - lowRanks, middle, end);
+    cuts[index] = {axis, position, low, high, -1};
+    return index;
+}
+
+void DomainDecomposition::sampleRange(const BodyStore& bodies, size_t first, size_t count, double cost,
+                                      std::vector<Sample>& out) {
+    out.clear();
+    size_t sampleCount = std::min(count, SAMPLES_PER_RANK);
+    if (sampleCount == 0) return;
+    float weight = static_cast<float>(cost / sampleCount);
+    out.reserve(sampleCount);
+    for (size_t i = 0; i < sampleCount; ++i) {
+        size_t index = first + static_cast<size_t>((i + 0.5) * count / sampleCount);
+        out.push_back({bodies.x[index], bodies.y[index], weight});
+    }
+}
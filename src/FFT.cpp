@@ -0,0 +1,68 @@
+/**
+ * @file FFT.cpp
+ * @brief Implementation of the radix-2 FFT
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/FFT.h"
+#include <cmath>
+#include <utility>
+
+FFT::FFT(size_t size) : size(size), bitReversed(size), twiddles(size / 2) {
+    int bits = 0;
+    while ((size_t(1) << bits) < size) {
+        ++bits;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        size_t reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bitReversed[i] = reversed;
+    }
+
+    // Twiddles in double precision so large sizes keep float accuracy
+    const double pi = 3.14159265358979323846;
+    for (size_t k = 0; k < size / 2; ++k) {
+        double angle = -2.0 * pi * static_cast<double>(k) / static_cast<double>(size);
+        twiddles[k] = Complex(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+}
+
+void FFT::transform(Complex* data, bool inverse) const {
+    for (size_t i = 0; i < size; ++i) {
+        if (i < bitReversed[i]) {
+            std::swap(data[i], data[bitReversed[i]]);
+        }
+    }
+
+    const float sign = inverse ? -1.0f : 1.0f;
+    for (size_t length = 2; length <= size; length <<= 1) {
+        const size_t half = length / 2;
+        const size_t stride = size / length;
+        for (size_t start = 0; start < size; start += length) {
+            for (size_t k = 0; k < half; ++k) {
+                // Complex multiply written out: std::complex operator* does NaN/inf recovery
+                const Complex& w = twiddles[k * stride];
+                float wr = w.real();
+                float wi = sign * w.imag();
+                Complex& a = data[start + k];
+                Complex& b = data[start + k + half];
+                float br = b.real() * wr - b.imag() * wi;
+                float bi = b.real() * wi + b.imag() * wr;
+                b = Complex(a.real() - br, a.imag() - bi);
+                a = Complex(a.real() + br, a.imag() + bi);
+            }
+        }
+    }
+}
+
+size_t FFT::nextPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
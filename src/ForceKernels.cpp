@@ -0,0 +1,487 @@
+/**
+ * @file ForceKernels.cpp
+ * @brief Scalar, SSE, AVX2 and NEON gravity kernels and their runtime dispatch
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/ForceKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FORCE_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#define FORCE_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// AVX2 code is compiled per function via target attributes so the rest of the
+// program keeps the baseline instruction set; this needs GCC or Clang.
+#if defined(FORCE_KERNELS_X86) && defined(__GNUC__)
+#define FORCE_KERNELS_AVX2 1
+#define FORCE_KERNELS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FORCE_KERNELS_TARGET(isa)
+#endif
+
+namespace {
+
+/**
+ * @struct KernelArgs
+ * @brief Inputs shared by every kernel implementation
+ */
+struct KernelArgs {
+    const float* targetX;
+    const float* targetY;
+    const float* targetMass;       ///< Unused by unit-target (field) kernels
+    size_t targetCount;
+    const float* sourceX;
+    const float* sourceY;
+    const float* sourceMass;
+    size_t sourceCount;
+    float gravitationalConstant;
+    float softeningSquared;        ///< Epsilon^2 of the force law
+    float maxForce;                ///< Clamp on the force magnitude (clamping laws only)
+    Vec2* forces;                  ///< Output, one entry per target
+};
+
+/** Kernels return how many leading targets they handled; the rest fall back to scalar */
+using KernelFunction = size_t (*)(const KernelArgs&);
+
+/*
+ * Every kernel is a template over the force law policy and over whether the
+ * targets have unit mass, so each of the combinations is its own loop with
+ * no per-interaction branches on either.
+ */
+
+template <class Law, bool UnitTarget>
+void scalarKernel(const KernelArgs& a, size_t first) {
+    for (size_t i = first; i < a.targetCount; ++i) {
+        Vec2 target(a.targetX[i], a.targetY[i]);
+        float gm = UnitTarget ? a.gravitationalConstant : a.gravitationalConstant * a.targetMass[i];
+        Vec2 total(0.0f, 0.0f);
+        
+        for (size_t j = 0; j < a.sourceCount; ++j) {
+            Vec2 direction(a.sourceX[j] - target.x, a.sourceY[j] - target.y);
+            total += Law::force(direction, gm * a.sourceMass[j], a.softeningSquared, a.maxForce);
+        }
+        
+        a.forces[i] = total;
+    }
+}
+
+size_t scalarOnly(const KernelArgs&) {
+    return 0;
+}
+
+#if defined(FORCE_KERNELS_X86)
+template <class Law, bool UnitTarget>
+FORCE_KERNELS_TARGET("sse2")
+size_t sseKernel(const KernelArgs& a) {
+    const size_t width = 4;
+    const size_t blocked = a.targetCount / width * width;
+    
+    const __m128 g = _mm_set1_ps(a.gravitationalConstant);
+    const __m128 eps2 = _mm_set1_ps(a.softeningSquared);
+    const __m128 invEps2 = _mm_set1_ps(1.0f / a.softeningSquared);
+    const __m128 maxF = _mm_set1_ps(a.maxForce);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 tiny = _mm_set1_ps(FLT_MIN);
+    
+    alignas(16) float outX[4];
+    alignas(16) float outY[4];
+    
+    for (size_t i = 0; i < blocked; i += width) {
+        __m128 tx = _mm_loadu_ps(a.targetX + i);
+        __m128 ty = _mm_loadu_ps(a.targetY + i);
+        __m128 gm = UnitTarget ? g : _mm_mul_ps(g, _mm_loadu_ps(a.targetMass + i));
+        __m128 fx = _mm_setzero_ps();
+        __m128 fy = _mm_setzero_ps();
+        
+        for (size_t j = 0; j < a.sourceCount; ++j) {
+            __m128 dx = _mm_sub_ps(_mm_set1_ps(a.sourceX[j]), tx);
+            __m128 dy = _mm_sub_ps(_mm_set1_ps(a.sourceY[j]), ty);
+            __m128 r2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 gmm = _mm_mul_ps(gm, _mm_set1_ps(a.sourceMass[j]));
+            __m128 scale;
+            
+            if constexpr (Law::SOFTENING == Softening::Clamped) {
+                // 1/r from rsqrt plus one Newton-Raphson step
+                __m128 invR = _mm_rsqrt_ps(r2);
+                invR = _mm_mul_ps(invR, _mm_sub_ps(threeHalves,
+                                                  _mm_mul_ps(_mm_mul_ps(half, r2), _mm_mul_ps(invR, invR))));
+                
+                // Softening: 1/max(r^2, epsilon^2) as a masked select
+                __m128 soft = _mm_cmplt_ps(r2, eps2);
+                __m128 invD2 = _mm_or_ps(_mm_and_ps(soft, invEps2),
+                                         _mm_andnot_ps(soft, _mm_mul_ps(invR, invR)));
+                __m128 force = _mm_mul_ps(gmm, invD2);
+                if constexpr (Law::CLAMP) {
+                    force = _mm_min_ps(force, maxF);
+                }
+                
+                // Zero separation has no direction (matches Vec2::normalized)
+                scale = _mm_and_ps(_mm_cmpgt_ps(r2, tiny), _mm_mul_ps(force, invR));
+            } else {
+                // Plummer: G m1 m2 / (r^2 + epsilon^2)^(3/2), finite everywhere
+                __m128 s2 = _mm_add_ps(r2, eps2);
+                __m128 invS = _mm_rsqrt_ps(s2);
+                invS = _mm_mul_ps(invS, _mm_sub_ps(threeHalves,
+                                                  _mm_mul_ps(_mm_mul_ps(half, s2), _mm_mul_ps(invS, invS))));
+                scale = _mm_mul_ps(gmm, _mm_mul_ps(invS, _mm_mul_ps(invS, invS)));
+                if constexpr (Law::CLAMP) {
+                    // |F| <= maxForce means scale <= maxForce / r; no limit needed at r = 0
+                    __m128 invR = _mm_rsqrt_ps(r2);
+                    invR = _mm_mul_ps(invR, _mm_sub_ps(threeHalves,
+                                                      _mm_mul_ps(_mm_mul_ps(half, r2), _mm_mul_ps(invR, invR))));
+                    scale = _mm_min_ps(scale, _mm_and_ps(_mm_cmpgt_ps(r2, tiny), _mm_mul_ps(maxF, invR)));
+                }
+            }
+            
+            fx = _mm_add_ps(fx, _mm_mul_ps(dx, scale));
+            fy = _mm_add_ps(fy, _mm_mul_ps(dy, scale));
+        }
+        
+        _mm_store_ps(outX, fx);
+        _mm_store_ps(outY, fy);
+        for (size_t k = 0; k < width; ++k) {
+            a.forces[i + k] = Vec2(outX[k], outY[k]);
+        }
+    }
+    
+    return blocked;
+}
+#endif
+
+#if defined(FORCE_KERNELS_AVX2)
+template <class Law, bool UnitTarget>
+FORCE_KERNELS_TARGET("avx2,fma")
+size_t avx2Kernel(const KernelArgs& a) {
+    const size_t width = 8;
+    const size_t blocked = a.targetCount / width * width;
+    
+    const __m256 g = _mm256_set1_ps(a.gravitationalConstant);
+    const __m256 eps2 = _mm256_set1_ps(a.softeningSquared);
+    const __m256 invEps2 = _mm256_set1_ps(1.0f / a.softeningSquared);
+    const __m256 maxF = _mm256_set1_ps(a.maxForce);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    const __m256 tiny = _mm256_set1_ps(FLT_MIN);
+    
+    alignas(32) float outX[8];
+    alignas(32) float outY[8];
+    
+    for (size_t i = 0; i < blocked; i += width) {
+        __m256 tx = _mm256_loadu_ps(a.targetX + i);
+        __m256 ty = _mm256_loadu_ps(a.targetY + i);
+        __m256 gm = UnitTarget ? g : _mm256_mul_ps(g, _mm256_loadu_ps(a.targetMass + i));
+        __m256 fx = _mm256_setzero_ps();
+        __m256 fy = _mm256_setzero_ps();
+        
+        for (size_t j = 0; j < a.sourceCount; ++j) {
+            __m256 dx = _mm256_sub_ps(_mm256_set1_ps(a.sourceX[j]), tx);
+            __m256 dy = _mm256_sub_ps(_mm256_set1_ps(a.sourceY[j]), ty);
+            __m256 r2 = _mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy));
+            __m256 gmm = _mm256_mul_ps(gm, _mm256_set1_ps(a.sourceMass[j]));
+            __m256 scale;
+            
+            if constexpr (Law::SOFTENING == Softening::Clamped) {
+                // 1/r from rsqrt plus one Newton-Raphson step
+                __m256 invR = _mm256_rsqrt_ps(r2);
+                __m256 invR2 = _mm256_mul_ps(invR, invR);
+                invR = _mm256_mul_ps(invR, _mm256_fnmadd_ps(_mm256_mul_ps(half, r2), invR2, threeHalves));
+                invR2 = _mm256_mul_ps(invR, invR);
+                
+                // Softening: 1/max(r^2, epsilon^2) as a masked select
+                __m256 soft = _mm256_cmp_ps(r2, eps2, _CMP_LT_OQ);
+                __m256 invD2 = _mm256_blendv_ps(invR2, invEps2, soft);
+                __m256 force = _mm256_mul_ps(gmm, invD2);
+                if constexpr (Law::CLAMP) {
+                    force = _mm256_min_ps(force, maxF);
+                }
+                
+                // Zero separation has no direction (matches Vec2::normalized)
+                scale = _mm256_and_ps(_mm256_cmp_ps(r2, tiny, _CMP_GT_OQ), _mm256_mul_ps(force, invR));
+            } else {
+                // Plummer: G m1 m2 / (r^2 + epsilon^2)^(3/2), finite everywhere
+                __m256 s2 = _mm256_add_ps(r2, eps2);
+                __m256 invS = _mm256_rsqrt_ps(s2);
+                invS = _mm256_mul_ps(invS, _mm256_fnmadd_ps(_mm256_mul_ps(half, s2), _mm256_mul_ps(invS, invS),
+                                                            threeHalves));
+                scale = _mm256_mul_ps(gmm, _mm256_mul_ps(invS, _mm256_mul_ps(invS, invS)));
+                if constexpr (Law::CLAMP) {
+                    // |F| <= maxForce means scale <= maxForce / r; no limit needed at r = 0
+                    __m256 invR = _mm256_rsqrt_ps(r2);
+                    invR = _mm256_mul_ps(invR, _mm256_fnmadd_ps(_mm256_mul_ps(half, r2), _mm256_mul_ps(invR, invR),
+                                                                threeHalves));
+                    scale = _mm256_min_ps(scale, _mm256_and_ps(_mm256_cmp_ps(r2, tiny, _CMP_GT_OQ),
+                                                               _mm256_mul_ps(maxF, invR)));
+                }
+            }
+            
+            fx = _mm256_fmadd_ps(dx, scale, fx);
+            fy = _mm256_fmadd_ps(dy, scale, fy);
+        }
+        
+        _mm256_store_ps(outX, fx);
+        _mm256_store_ps(outY, fy);
+        for (size_t k = 0; k < width; ++k) {
+            a.forces[i + k] = Vec2(outX[k], outY[k]);
+        }
+    }
+    
+    return blocked;
+}
+#endif
+
+#if defined(FORCE_KERNELS_NEON)
+template <class Law, bool UnitTarget>
+size_t neonKernel(const KernelArgs& a) {
+    const size_t width = 4;
+    const size_t blocked = a.targetCount / width * width;
+    
+    const float32x4_t g = vdupq_n_f32(a.gravitationalConstant);
+    const float32x4_t eps2 = vdupq_n_f32(a.softeningSquared);
+    const float32x4_t invEps2 = vdupq_n_f32(1.0f / a.softeningSquared);
+    const float32x4_t maxF = vdupq_n_f32(a.maxForce);
+    const float32x4_t tiny = vdupq_n_f32(FLT_MIN);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    
+    float outX[4];
+    float outY[4];
+    
+    for (size_t i = 0; i < blocked; i += width) {
+        float32x4_t tx = vld1q_f32(a.targetX + i);
+        float32x4_t ty = vld1q_f32(a.targetY + i);
+        float32x4_t gm = UnitTarget ? g : vmulq_f32(g, vld1q_f32(a.targetMass + i));
+        float32x4_t fx = zero;
+        float32x4_t fy = zero;
+        
+        for (size_t j = 0; j < a.sourceCount; ++j) {
+            float32x4_t dx = vsubq_f32(vdupq_n_f32(a.sourceX[j]), tx);
+            float32x4_t dy = vsubq_f32(vdupq_n_f32(a.sourceY[j]), ty);
+            float32x4_t r2 = vmlaq_f32(vmulq_f32(dy, dy), dx, dx);
+            float32x4_t gmm = vmulq_f32(gm, vdupq_n_f32(a.sourceMass[j]));
+            float32x4_t scale;
+            
+            if constexpr (Law::SOFTENING == Softening::Clamped) {
+                // 1/r from the reciprocal square root estimate plus one Newton-Raphson step
+                float32x4_t invR = vrsqrteq_f32(r2);
+                invR = vmulq_f32(invR, vrsqrtsq_f32(vmulq_f32(r2, invR), invR));
+                float32x4_t invR2 = vmulq_f32(invR, invR);
+                
+                // Softening: 1/max(r^2, epsilon^2) as a masked select
+                float32x4_t invD2 = vbslq_f32(vcltq_f32(r2, eps2), invEps2, invR2);
+                float32x4_t force = vmulq_f32(gmm, invD2);
+                if constexpr (Law::CLAMP) {
+                    force = vminq_f32(force, maxF);
+                }
+                
+                // Zero separation has no direction (matches Vec2::normalized)
+                scale = vbslq_f32(vcgtq_f32(r2, tiny), vmulq_f32(force, invR), zero);
+            } else {
+                // Plummer: G m1 m2 / (r^2 + epsilon^2)^(3/2), finite everywhere
+                float32x4_t s2 = vaddq_f32(r2, eps2);
+                float32x4_t invS = vrsqrteq_f32(s2);
+                invS = vmulq_f32(invS, vrsqrtsq_f32(vmulq_f32(s2, invS), invS));
+                scale = vmulq_f32(gmm, vmulq_f32(invS, vmulq_f32(invS, invS)));
+                if constexpr (Law::CLAMP) {
+                    // |F| <= maxForce means scale <= maxForce / r; no limit needed at r = 0
+                    float32x4_t invR = vrsqrteq_f32(r2);
+                    invR = vmulq_f32(invR, vrsqrtsq_f32(vmulq_f32(r2, invR), invR));
+                    scale = vminq_f32(scale, vbslq_f32(vcgtq_f32(r2, tiny), vmulq_f32(maxF, invR), zero));
+                }
+            }
+            
+            fx = vmlaq_f32(fx, dx, scale);
+            fy = vmlaq_f32(fy, dy, scale);
+        }
+        
+        vst1q_f32(outX, fx);
+        vst1q_f32(outY, fy);
+        for (size_t k = 0; k < width; ++k) {
+            a.forces[i + k] = Vec2(outX[k], outY[k]);
+        }
+    }
+    
+    return blocked;
+}
+#endif
+
+template <class Law, bool UnitTarget>
+KernelFunction kernelFor(ForceKernels::InstructionSet instructionSet) {
+    switch (instructionSet) {
+#if defined(FORCE_KERNELS_AVX2)
+        case ForceKernels::InstructionSet::AVX2: return avx2Kernel<Law, UnitTarget>;
+#endif
+#if defined(FORCE_KERNELS_X86)
+        case ForceKernels::InstructionSet::SSE: return sseKernel<Law, UnitTarget>;
+#endif
+#if defined(FORCE_KERNELS_NEON)
+        case ForceKernels::InstructionSet::NEON: return neonKernel<Law, UnitTarget>;
+#endif
+        default: return scalarOnly;
+    }
+}
+
+ForceKernels::InstructionSet detectBestInstructionSet() {
+    const ForceKernels::InstructionSet preferred[] = {
+        ForceKernels::InstructionSet::AVX2,
+        ForceKernels::InstructionSet::NEON,
+        ForceKernels::InstructionSet::SSE
+    };
+    for (auto instructionSet : preferred) {
+        if (ForceKernels::isSupported(instructionSet)) {
+            return instructionSet;
+        }
+    }
+    return ForceKernels::InstructionSet::Scalar;
+}
+
+std::atomic<ForceKernels::InstructionSet>& activeInstructionSet() {
+    static std::atomic<ForceKernels::InstructionSet> instructionSet(detectBestInstructionSet());
+    return instructionSet;
+}
+
+/**
+ * Picks the specialization for the law once per call; the kernels then loop
+ * over every target/source pair without looking at the law again.
+ */
+template <bool UnitTarget>
+void runKernel(KernelArgs& args, const ForceLaw& law) {
+    args.softeningSquared = law.softeningLength * law.softeningLength;
+    args.maxForce = law.maxForce;
+    ForceKernels::InstructionSet instructionSet = activeInstructionSet().load(std::memory_order_relaxed);
+    visitForceLaw(law, [&](auto policy) {
+        using Law = decltype(policy);
+        size_t handled = kernelFor<Law, UnitTarget>(instructionSet)(args);
+        scalarKernel<Law, UnitTarget>(args, handled);
+    });
+}
+
+} // namespace
+
+void ForceKernels::computePairForces(const BodyStore& bodies, size_t begin, size_t end,
+                                     float gravitationalConstant, Vec2* forces, const ForceLaw& law) {
+    if (begin >= end) return;
+    
+    KernelArgs args;
+    args.targetX = bodies.x.data() + begin;
+    args.targetY = bodies.y.data() + begin;
+    args.targetMass = bodies.mass.data() + begin;
+    args.targetCount = end - begin;
+    args.sourceX = bodies.x.data();
+    args.sourceY = bodies.y.data();
+    args.sourceMass = bodies.mass.data();
+    args.sourceCount = bodies.size();
+    args.gravitationalConstant = gravitationalConstant;
+    args.forces = forces + begin;
+    runKernel<false>(args, law);
+}
+
+void ForceKernels::computePairForcesOn(const BodyStore& bodies, const size_t* targets, size_t targetCount,
+                                       float gravitationalConstant, Vec2* forces, const ForceLaw& law) {
+    if (targetCount == 0) return;
+    
+    // Per-thread scratch so parallel callers never share buffers
+    thread_local std::vector<float> gatheredX, gatheredY, gatheredMass;
+    thread_local std::vector<Vec2> gatheredForces;
+    gatheredX.resize(targetCount);
+    gatheredY.resize(targetCount);
+    gatheredMass.resize(targetCount);
+    gatheredForces.resize(targetCount);
+    for (size_t k = 0; k < targetCount; ++k) {
+        gatheredX[k] = bodies.x[targets[k]];
+        gatheredY[k] = bodies.y[targets[k]];
+        gatheredMass[k] = bodies.mass[targets[k]];
+    }
+    
+    KernelArgs args;
+    args.targetX = gatheredX.data();
+    args.targetY = gatheredY.data();
+    args.targetMass = gatheredMass.data();
+    args.targetCount = targetCount;
+    args.sourceX = bodies.x.data();
+    args.sourceY = bodies.y.data();
+    args.sourceMass = bodies.mass.data();
+    args.sourceCount = bodies.size();
+    args.gravitationalConstant = gravitationalConstant;
+    args.forces = gatheredForces.data();
+    runKernel<false>(args, law);
+    
+    for (size_t k = 0; k < targetCount; ++k) {
+        forces[targets[k]] = gatheredForces[k];
+    }
+}
+
+void ForceKernels::computeFieldForces(const float* pointX, const float* pointY, size_t pointCount,
+                                      const BodyStore& bodies, float gravitationalConstant,
+                                      Vec2* forces, const ForceLaw& law) {
+    KernelArgs args;
+    args.targetX = pointX;
+    args.targetY = pointY;
+    args.targetMass = nullptr;
+    args.targetCount = pointCount;
+    args.sourceX = bodies.x.data();
+    args.sourceY = bodies.y.data();
+    args.sourceMass = bodies.mass.data();
+    args.sourceCount = bodies.size();
+    args.gravitationalConstant = gravitationalConstant;
+    args.forces = forces;
+    runKernel<true>(args, law);
+}
+
+ForceKernels::InstructionSet ForceKernels::getInstructionSet() {
+    return activeInstructionSet().load();
+}
+
+bool ForceKernels::setInstructionSet(InstructionSet instructionSet) {
+    if (!isSupported(instructionSet)) {
+        return false;
+    }
+    activeInstructionSet().store(instructionSet);
+    return true;
+}
+
+bool ForceKernels::isSupported(InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            return true;
+        case InstructionSet::SSE:
+#if defined(FORCE_KERNELS_X86) && defined(__GNUC__)
+            return __builtin_cpu_supports("sse2");
+#elif defined(FORCE_KERNELS_X86)
+            return true;
+#else
+            return false;
+#endif
+        case InstructionSet::AVX2:
+#if defined(FORCE_KERNELS_AVX2)
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+            return false;
+#endif
+        case InstructionSet::NEON:
+#if defined(FORCE_KERNELS_NEON)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* ForceKernels::getInstructionSetName(InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::Scalar: return "scalar";
+        case InstructionSet::SSE: return "sse";
+        case InstructionSet::AVX2: return "avx2";
+        case InstructionSet::NEON: return "neon";
+    }
+    return "unknown";
+}
@@ -0,0 +1,118 @@
+/**
+ * @file FrameArena.cpp
+ * @brief Implementation of the per-thread scratch arena
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/FrameArena.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+/**
+ * @brief Finds the first suitably aligned offset in a block
+ * @return Offset from base, or SIZE_MAX if bytes do not fit
+ */
+size_t fitInBlock(const unsigned char* base, size_t capacity, size_t used, size_t bytes, size_t alignment) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(base) + used;
+    uintptr_t aligned = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    size_t offset = used + static_cast<size_t>(aligned - address);
+    return offset <= capacity && bytes <= capacity - offset ? offset : SIZE_MAX;
+}
+
+} // namespace
+
+FrameArena::FrameArena(size_t laneCount, size_t initialLaneBytes)
+    : initialLaneBytes(std::max<size_t>(initialLaneBytes, 64)) {
+    reserveLanes(laneCount);
+}
+
+void FrameArena::reserveLanes(size_t laneCount) {
+    laneCount = std::max<size_t>(laneCount, 1);
+    while (lanes.size() < laneCount) {
+        auto lane = std::make_unique<Lane>();
+        lane->block.reset(new unsigned char[initialLaneBytes]);
+        lane->capacity = initialLaneBytes;
+        lane->allocations = 1;
+        lanes.push_back(std::move(lane));
+    }
+}
+
+FrameArena::Lane& FrameArena::currentLane() {
+    // Threads of a pool larger than reserveLanes() was told share the first lane,
+    // which is a usage error; clamping keeps it from indexing out of bounds
+    size_t index = ThreadPool::getCurrentThreadIndex();
+    return *lanes[index < lanes.size() ? index : 0];
+}
+
+void* FrameArena::allocateBytes(size_t bytes, size_t alignment) {
+    Lane& lane = currentLane();
+    unsigned char* current = lane.overflow.empty() ? lane.block.get() : lane.overflow.back().get();
+    size_t currentCapacity = lane.overflow.empty() ? lane.capacity : lane.overflowCapacity;
+
+    size_t offset = fitInBlock(current, currentCapacity, lane.used, bytes, alignment);
+    if (offset == SIZE_MAX) {
+        // Out of room this step: chain another block; reset() folds the chain into one
+        size_t size = std::max(bytes + alignment, 2 * currentCapacity);
+        lane.overflow.emplace_back(new unsigned char[size]);
+        lane.overflowCapacity = size;
+        lane.filled += lane.used;
+        lane.used = 0;
+        ++lane.allocations;
+        current = lane.overflow.back().get();
+        offset = fitInBlock(current, size, 0, bytes, alignment);
+    }
+
+    lane.used = offset + bytes;
+    return current + offset;
+}
+
+FrameArena::Scope::Scope(FrameArena& arena)
+    : lane(&arena.currentLane()), blockCount(lane->overflow.size()), used(lane->used) {
+}
+
+FrameArena::Scope::~Scope() {
+    if (lane->overflow.size() == blockCount) {
+        lane->used = used;
+    }
+}
+
+void FrameArena::reset() {
+    for (auto& lane : lanes) {
+        if (!lane->overflow.empty()) {
+            // Regrow to the step's peak, with headroom, so the next step fits in one block
+            size_t peak = lane->filled + lane->used;
+            size_t size = std::max(2 * lane->capacity, peak + peak / 2);
+            lane->overflow.clear();
+            lane->block.reset(new unsigned char[size]);
+            lane->capacity = size;
+            lane->filled = 0;
+            ++lane->allocations;
+        }
+        lane->used = 0;
+    }
+}
+
+size_t FrameArena::getUsedBytes() const {
+    size_t total = 0;
+    for (const auto& lane : lanes) total += lane->filled + lane->used;
+    return total;
+}
+
+size_t FrameArena::getCapacityBytes() const {
+    size_t total = 0;
+    for (const auto& lane : lanes) {
+        total += lane->capacity;
+        if (!lane->overflow.empty()) total += lane->filled + lane->overflowCapacity;
+    }
+    return total;
+}
+
+size_t FrameArena::getHeapAllocationCount() const {
+    size_t total = 0;
+    for (const auto& lane : lanes) total += lane->allocations;
+    return total;
+}
@@ -0,0 +1,353 @@
+/**
+ * @file FrameCapture.cpp
+ * @brief Implementation of offscreen capture, PBO readback and the frame writer
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/FrameCapture.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#define PIPE_MODE "wb"
+#else
+#define PIPE_MODE "w"
+#endif
+
+namespace {
+
+/** CRC-32 (ISO 3309) as used by PNG chunks */
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            entries[n] = c;
+        }
+        return entries;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<uint8_t>(value >> shift));
+}
+
+/** Appends a PNG chunk, computing its length and CRC */
+void appendChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size) {
+    appendBigEndian(out, static_cast<uint32_t>(size));
+    size_t typeStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    appendBigEndian(out, crc32(out.data() + typeStart, size + 4));
+}
+
+/**
+ * Encodes top-down RGB24 pixels as a PNG whose zlib stream uses stored
+ * blocks only: larger files, but no compression library and almost no CPU.
+ */
+void encodePng(const uint8_t* rgb, int width, int height, std::vector<uint8_t>& out) {
+    static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.assign(SIGNATURE, SIGNATURE + 8);
+
+    std::vector<uint8_t> header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header.insert(header.end(), {8, 2, 0, 0, 0});  // 8-bit RGB, deflate, adaptive filters, no interlace
+    appendChunk(out, "IHDR", header.data(), header.size());
+
+    // Filter type 0 (none) in front of every row
+    const size_t rowBytes = static_cast<size_t>(width) * 3;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = 0; y < height; ++y) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb + y * rowBytes, rgb + (y + 1) * rowBytes);
+    }
+
+    const size_t MAX_BLOCK = 65535;
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    zlib.reserve(raw.size() + raw.size() / MAX_BLOCK * 5 + 16);
+    uint32_t adlerA = 1, adlerB = 0;
+    for (size_t offset = 0;; offset += MAX_BLOCK) {
+        size_t length = std::min(MAX_BLOCK, raw.size() - offset);
+        bool last = offset + length >= raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(length));
+        zlib.push_back(static_cast<uint8_t>(length >> 8));
+        zlib.push_back(static_cast<uint8_t>(~length));
+        zlib.push_back(static_cast<uint8_t>(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        for (size_t i = offset; i < offset + length; ++i) {
+            adlerA = (adlerA + raw[i]) % 65521;
+            adlerB = (adlerB + adlerA) % 65521;
+        }
+        if (last) break;
+    }
+    appendBigEndian(zlib, (adlerB << 16) | adlerA);
+    appendChunk(out, "IDAT", zlib.data(), zlib.size());
+    appendChunk(out, "IEND", nullptr, 0);
+}
+
+/**
+ * Checks that a PNG path pattern is safe to hand to snprintf with one int:
+ * exactly one %d (flags and width allowed, e.g. %05d) and otherwise only %%
+ */
+bool isFramePattern(const std::string& pattern) {
+    int conversions = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] != '%') continue;
+        if (++i < pattern.size() && pattern[i] == '%') continue;
+        while (i < pattern.size() && std::strchr("-+ #0", pattern[i])) ++i;
+        while (i < pattern.size() && pattern[i] >= '0' && pattern[i] <= '9') ++i;
+        if (i >= pattern.size() || pattern[i] != 'd') return false;
+        ++conversions;
+    }
+    return conversions == 1;
+}
+
+} // namespace
+
+FrameCapture::~FrameCapture() {
+    finish();
+}
+
+bool FrameCapture::initialize(int frameWidth, int frameHeight, const std::string& output) {
+    finish();
+    if (frameWidth <= 0 || frameHeight <= 0 || output.empty()) {
+        std::cerr << "Frame capture needs a size and an output\n";
+        return false;
+    }
+    if (!GLEW_VERSION_3_0 && !GLEW_ARB_framebuffer_object) {
+        std::cerr << "Frame capture needs framebuffer objects (OpenGL 3.0)\n";
+        return false;
+    }
+    width = frameWidth;
+    height = frameHeight;
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete) {
+        std::cerr << "Cannot create a " << width << "x" << height << " offscreen framebuffer\n";
+        releaseGL();
+        return false;
+    }
+
+    const GLsizeiptr frameBytes = static_cast<GLsizeiptr>(width) * height * 4;
+    glGenBuffers(PBO_COUNT, pixelBuffers);
+    for (GLuint buffer : pixelBuffers) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (output[0] == '|') {
+        pipe = popen(output.c_str() + 1, PIPE_MODE);
+        if (!pipe) {
+            std::cerr << "Cannot start encoder: " << output.c_str() + 1 << "\n";
+            releaseGL();
+            return false;
+        }
+        pattern.clear();
+    } else {
+        if (!isFramePattern(output)) {
+            std::cerr << "Capture output " << output << " needs exactly one frame number pattern such as %05d"
+                      << " (write %% for a literal percent sign)\n";
+            releaseGL();
+            return false;
+        }
+        pattern = output;
+    }
+
+    images.assign(QUEUE_FRAMES, std::vector<uint8_t>(static_cast<size_t>(frameBytes)));
+    ready.clear();
+    freeImages.clear();
+    for (size_t i = 0; i < QUEUE_FRAMES; ++i) freeImages.push_back(i);
+    stopping = false;
+    failedFrames = 0;
+    capturedFrames = 0;
+    collectedFrames = 0;
+    writer = std::thread(&FrameCapture::runWriter, this);
+    active = true;
+    return true;
+}
+
+void FrameCapture::beginFrame() {
+    if (!active) return;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+}
+
+void FrameCapture::endFrame() {
+    if (!active) return;
+
+    // Start the transfer; with a pack buffer bound glReadPixels returns without waiting
+    const int slot = static_cast<int>(capturedFrames % PBO_COUNT);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[slot]);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (GLEW_VERSION_3_2 || GLEW_ARB_sync) {
+        fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ++capturedFrames;
+
+    // The oldest transfer was issued PBO_COUNT - 1 frames ago
+    if (capturedFrames - collectedFrames >= static_cast<uint64_t>(PBO_COUNT)) {
+        collectOldestFrame();
+    }
+}
+
+void FrameCapture::finish() {
+    if (!active) return;
+    while (collectedFrames < capturedFrames) {
+        collectOldestFrame();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+
+    if (pipe) {
+        pclose(pipe);
+        pipe = nullptr;
+    }
+    releaseGL();
+    images.clear();
+    active = false;
+}
+
+uint64_t FrameCapture::getFailedFrameCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failedFrames;
+}
+
+void FrameCapture::collectOldestFrame() {
+    const int slot = static_cast<int>(collectedFrames % PBO_COUNT);
+    if (fences[slot]) {
+        glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fences[slot]);
+        fences[slot] = nullptr;
+    }
+
+    size_t image;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return !freeImages.empty(); });
+        image = freeImages.back();
+        freeImages.pop_back();
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[slot]);
+    const void* pixels = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    bool mapped = pixels != nullptr;
+    if (mapped) {
+        std::memcpy(images[image].data(), pixels, images[image].size());
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    ++collectedFrames;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (mapped) {
+            ready.push_back(image);
+        } else {
+            freeImages.push_back(image);
+            ++failedFrames;
+        }
+    }
+    changed.notify_all();
+}
+
+void FrameCapture::runWriter() {
+    uint64_t number = 0;
+    for (;;) {
+        size_t image;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return stopping || !ready.empty(); });
+            if (ready.empty()) return;
+            image = ready.front();
+            ready.pop_front();
+        }
+
+        bool written = writeImage(images[image], number++);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            freeImages.push_back(image);
+            if (!written) ++failedFrames;
+        }
+        changed.notify_all();
+    }
+}
+
+bool FrameCapture::writeImage(const std::vector<uint8_t>& pixels, uint64_t number) {
+    // GL rows run bottom-up; images and encoders expect top-down
+    rgb.resize(static_cast<size_t>(width) * height * 3);
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* source = pixels.data() + static_cast<size_t>(height - 1 - y) * width * 4;
+        uint8_t* destination = rgb.data() + static_cast<size_t>(y) * width * 3;
+        for (int x = 0; x < width; ++x) {
+            destination[3 * x] = source[4 * x];
+            destination[3 * x + 1] = source[4 * x + 1];
+            destination[3 * x + 2] = source[4 * x + 2];
+        }
+    }
+
+    if (pipe) {
+        return std::fwrite(rgb.data(), 1, rgb.size(), pipe) == rgb.size();
+    }
+
+    char path[1024];
+    std::snprintf(path, sizeof(path), pattern.c_str(), static_cast<int>(number));
+    encodePng(rgb.data(), width, height, encoded);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    if (!file) {
+        std::cerr << "Cannot write frame " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+void FrameCapture::releaseGL() {
+    for (GLsync& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (pixelBuffers[0]) {
+        glDeleteBuffers(PBO_COUNT, pixelBuffers);
+        for (GLuint& buffer : pixelBuffers) buffer = 0;
+    }
+    if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+    if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    depthBuffer = colorBuffer = framebuffer = 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file FrameScheduler.cpp
+ * @brief Implementation of frame pacing and the fixed-timestep accumulator
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/FrameScheduler.h"
+#include <cmath>
+#include <thread>
+
+FrameScheduler::FrameScheduler(Mode mode, float targetFrameRate, float simulationRate)
+    : mode(mode), fixedTimeStep(1.0f / (simulationRate > 0.0f ? simulationRate : 60.0f)) {
+    if (targetFrameRate <= 0.0f) targetFrameRate = 60.0f;
+    frameInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFrameRate));
+    // Derived from the step so that e.g. 60 Hz video of a 60 Hz simulation is exactly one step per frame
+    offlineFrameTime = fixedTimeStep * ((simulationRate > 0.0f ? simulationRate : 60.0f) / targetFrameRate);
+}
+
+float FrameScheduler::beginFrame() {
+    Clock::time_point now = Clock::now();
+    if (!started) {
+        lastFrameStart = now;
+        nextDeadline = now + frameInterval;
+        started = true;
+    }
+
+    frameTime = mode == Mode::Offline ? offlineFrameTime : std::chrono::duration<float>(now - lastFrameStart).count();
+    lastFrameStart = now;
+    accumulator += frameTime;
+    stepsThisFrame = 0;
+
+    // Drop what cannot be caught up this frame rather than falling further behind
+    double maxBacklog = static_cast<double>(fixedTimeStep) * MAX_STEPS_PER_FRAME;
+    if (accumulator > maxBacklog) {
+        double excess = accumulator - maxBacklog;
+        droppedSteps += static_cast<unsigned long long>(std::ceil(excess / fixedTimeStep));
+        accumulator = maxBacklog;
+    }
+    return frameTime;
+}
+
+bool FrameScheduler::takeSimulationStep() {
+    if (accumulator < fixedTimeStep || stepsThisFrame >= MAX_STEPS_PER_FRAME) {
+        return false;
+    }
+    accumulator -= fixedTimeStep;
+    ++stepsThisFrame;
+    return true;
+}
+
+void FrameScheduler::endFrame() {
+    if (mode != Mode::Capped) return;
+
+    // Sleep most of the way, then spin; a missed deadline restarts the schedule
+    Clock::time_point now = Clock::now();
+    if (now >= nextDeadline) {
+        nextDeadline = now + frameInterval;
+        return;
+    }
+    if (nextDeadline - now > SPIN_WINDOW) {
+        std::this_thread::sleep_until(nextDeadline - SPIN_WINDOW);
+    }
+    while (Clock::now() < nextDeadline) {
+        std::this_thread::yield();
+    }
+    nextDeadline += frameInterval;
+}
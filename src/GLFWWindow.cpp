@@ -38,10 +38,18 @@ bool GLFWWindow::initializeGLFW() {
         return false;
     }
 
-    // Use default OpenGL context (should support immediate mode)
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-    // Don't specify profile - use default
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, properties.contextMajor);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, properties.contextMinor);
+    if (properties.coreProfile) {
+        // Forward compatibility is required for core contexts on macOS and harmless elsewhere
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+    } else {
+        // Default profile so immediate mode keeps working
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_ANY_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_FALSE);
+    }
+    glfwWindowHint(GLFW_VISIBLE, properties.visible ? GLFW_TRUE : GLFW_FALSE);
 
     return true;
 }
@@ -58,10 +66,15 @@ bool GLFWWindow::createWindow() {
 }
 
 bool GLFWWindow::initializeGLEW() {
+    // Core contexts have no glGetString(GL_EXTENSIONS); let GLEW load entry points regardless
+    glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) {
         std::cerr << "Failed to initialize GLEW\n";
         return false;
     }
+    // glewInit can leave a spurious GL_INVALID_ENUM behind on core contexts
+    while (glGetError() != GL_NO_ERROR) {
+    }
     return true;
 }
 
@@ -87,6 +100,13 @@ void GLFWWindow::swapBuffers() {
     }
 }
 
+void GLFWWindow::setSwapInterval(int interval) {
+    if (window) {
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(interval);
+    }
+}
+
 void GLFWWindow::pollEvents() {
     glfwPollEvents();
 }
@@ -0,0 +1,221 @@
+/**
+ * @file GlyphAtlas.cpp
+ * @brief Stroke font table and atlas rasterization
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/GlyphAtlas.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct Segment
+ * @brief One stroke of a glyph, in glyph units inside the 8 x 12 cell
+ */
+struct Segment {
+    float x0, y0, x1, y1;
+};
+
+/**
+ * @struct StrokeGlyph
+ * @brief Line segments drawing one character
+ */
+struct StrokeGlyph {
+    char character;
+    std::vector<Segment> segments;
+};
+
+// Letters are the shapes of the original immediate mode font; digits and
+// punctuation follow the same 1..6 x 1..10 box
+const std::vector<StrokeGlyph> STROKE_FONT = {
+    {'A', {{1, 10, 4, 1}, {4, 1, 7, 10}, {2, 6, 6, 6}}},
+    {'B', {{1, 1, 1, 10}, {1, 1, 5, 1}, {1, 5.5f, 5, 5.5f}, {1, 10, 5, 10}, {5, 1, 5, 5.5f}, {5, 5.5f, 5, 10}}},
+    {'C', {{6, 2, 2, 2}, {2, 2, 2, 9}, {2, 9, 6, 9}}},
+    {'D', {{1, 1, 1, 10}, {1, 1, 5, 1}, {1, 10, 5, 10}, {5, 1, 6, 3}, {6, 3, 6, 8}, {6, 8, 5, 10}}},
+    {'E', {{1, 1, 1, 10}, {1, 1, 6, 1}, {1, 5.5f, 5, 5.5f}, {1, 10, 6, 10}}},
+    {'F', {{1, 1, 1, 10}, {1, 1, 6, 1}, {1, 5.5f, 5, 5.5f}}},
+    {'G', {{6, 2, 2, 2}, {2, 2, 2, 9}, {2, 9, 6, 9}, {6, 9, 6, 6}, {6, 6, 4, 6}}},
+    {'H', {{1, 1, 1, 10}, {6, 1, 6, 10}, {1, 5.5f, 6, 5.5f}}},
+    {'I', {{2, 1, 5, 1}, {3.5f, 1, 3.5f, 10}, {2, 10, 5, 10}}},
+    {'J', {{2, 1, 6, 1}, {5, 1, 5, 9}, {5, 9, 1, 9}, {1, 9, 1, 7}}},
+    {'K', {{1, 1, 1, 10}, {1, 5.5f, 6, 1}, {1, 5.5f, 6, 10}}},
+    {'L', {{1, 1, 1, 10}, {1, 10, 6, 10}}},
+    {'M', {{1, 10, 1, 1}, {1, 1, 3.5f, 6}, {3.5f, 6, 6, 1}, {6, 1, 6, 10}}},
+    {'N', {{1, 10, 1, 1}, {1, 1, 6, 10}, {6, 10, 6, 1}}},
+    {'O', {{2, 2, 5, 2}, {5, 2, 5, 9}, {5, 9, 2, 9}, {2, 9, 2, 2}}},
+    {'P', {{1, 1, 1, 10}, {1, 1, 5, 1}, {5, 1, 5, 5.5f}, {5, 5.5f, 1, 5.5f}}},
+    {'Q', {{2, 2, 5, 2}, {5, 2, 5, 9}, {5, 9, 2, 9}, {2, 9, 2, 2}, {4, 7, 6, 10}}},
+    {'R', {{1, 1, 1, 10}, {1, 1, 5, 1}, {5, 1, 5, 5.5f}, {5, 5.5f, 1, 5.5f}, {3, 5.5f, 6, 10}}},
+    {'S', {{6, 2, 2, 2}, {2, 2, 2, 5.5f}, {2, 5.5f, 5, 5.5f}, {5, 5.5f, 5, 9}, {5, 9, 1, 9}}},
+    {'T', {{1, 1, 6, 1}, {3.5f, 1, 3.5f, 10}}},
+    {'U', {{1, 1, 1, 9}, {1, 9, 6, 9}, {6, 9, 6, 1}}},
+    {'V', {{1, 1, 3.5f, 10}, {3.5f, 10, 6, 1}}},
+    {'W', {{1, 1, 2, 10}, {2, 10, 3.5f, 6}, {3.5f, 6, 5, 10}, {5, 10, 6, 1}}},
+    {'X', {{1, 1, 6, 10}, {6, 1, 1, 10}}},
+    {'Y', {{1, 1, 3.5f, 5.5f}, {6, 1, 3.5f, 5.5f}, {3.5f, 5.5f, 3.5f, 10}}},
+    {'Z', {{1, 1, 6, 1}, {6, 1, 1, 10}, {1, 10, 6, 10}}},
+    {'0', {{1, 1, 6, 1}, {6, 1, 6, 10}, {6, 10, 1, 10}, {1, 10, 1, 1}, {6, 1, 1, 10}}},
+    {'1', {{2, 3, 3.5f, 1}, {3.5f, 1, 3.5f, 10}, {2, 10, 5, 10}}},
+    {'2', {{1, 1, 6, 1}, {6, 1, 6, 5.5f}, {6, 5.5f, 1, 5.5f}, {1, 5.5f, 1, 10}, {1, 10, 6, 10}}},
+    {'3', {{1, 1, 6, 1}, {6, 1, 6, 10}, {6, 10, 1, 10}, {2, 5.5f, 6, 5.5f}}},
+    {'4', {{1, 1, 1, 5.5f}, {1, 5.5f, 6, 5.5f}, {5, 1, 5, 10}}},
+    {'5', {{6, 1, 1, 1}, {1, 1, 1, 5.5f}, {1, 5.5f, 6, 5.5f}, {6, 5.5f, 6, 10}, {6, 10, 1, 10}}},
+    {'6', {{6, 1, 1, 1}, {1, 1, 1, 10}, {1, 10, 6, 10}, {6, 10, 6, 5.5f}, {6, 5.5f, 1, 5.5f}}},
+    {'7', {{1, 1, 6, 1}, {6, 1, 3, 10}}},
+    {'8', {{1, 1, 6, 1}, {1, 5.5f, 6, 5.5f}, {1, 10, 6, 10}, {1, 1, 1, 10}, {6, 1, 6, 10}}},
+    {'9', {{6, 5.5f, 1, 5.5f}, {1, 5.5f, 1, 1}, {1, 1, 6, 1}, {6, 1, 6, 10}, {6, 10, 1, 10}}},
+    {':', {{3, 3, 4, 3}, {3, 8, 4, 8}}},
+    {'.', {{3, 9.5f, 4, 9.5f}}},
+    {',', {{4, 9, 3, 11}}},
+    {'-', {{2, 5.5f, 6, 5.5f}}},
+    {'+', {{2, 5.5f, 6, 5.5f}, {4, 3.5f, 4, 7.5f}}},
+    {'=', {{2, 4, 6, 4}, {2, 7, 6, 7}}},
+    {'/', {{6, 1, 1, 10}}},
+    {'(', {{5, 1, 3, 3}, {3, 3, 3, 8}, {3, 8, 5, 10}}},
+    {')', {{2, 1, 4, 3}, {4, 3, 4, 8}, {4, 8, 2, 10}}},
+    {'%', {{6, 1, 1, 10}, {1, 2, 2, 2}, {5, 9, 6, 9}}},
+    {' ', {}},
+};
+
+// Box drawn for characters the font does not cover
+const std::vector<Segment> UNKNOWN_GLYPH = {{1, 2, 6, 2}, {6, 2, 6, 9}, {6, 9, 1, 9}, {1, 9, 1, 2}};
+
+/**
+ * @brief Finds the strokes of a character
+ * @return Segments, or UNKNOWN_GLYPH when the font has no such character
+ */
+const std::vector<Segment>& strokesFor(int c) {
+    char upper = static_cast<char>(std::toupper(c));
+    for (const StrokeGlyph& glyph : STROKE_FONT) {
+        if (glyph.character == upper) return glyph.segments;
+    }
+    return UNKNOWN_GLYPH;
+}
+
+/**
+ * @brief Distance from a point to a segment
+ */
+float distanceToSegment(float px, float py, const Segment& s) {
+    float dx = s.x1 - s.x0;
+    float dy = s.y1 - s.y0;
+    float lengthSquared = dx * dx + dy * dy;
+    float t = lengthSquared > 0.0f ? ((px - s.x0) * dx + (py - s.y0) * dy) / lengthSquared : 0.0f;
+    t = std::max(0.0f, std::min(1.0f, t));
+    float ex = s.x0 + t * dx - px;
+    float ey = s.y0 + t * dy - py;
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+} // namespace
+
+GlyphAtlas::~GlyphAtlas() {
+    release();
+}
+
+bool GlyphAtlas::initialize() {
+    release();
+
+    const int cellTexelsX = CELL_WIDTH * OVERSAMPLE;
+    const int cellTexelsY = CELL_HEIGHT * OVERSAMPLE;
+    const int rows = (CELL_COUNT + COLUMNS - 1) / COLUMNS;
+    int width = COLUMNS * cellTexelsX;
+    int height = rows * cellTexelsY;
+
+    // Coverage of every cell: distance to the nearest stroke, one texel of anti-aliasing
+    std::vector<uint8_t> alpha(static_cast<size_t>(width) * height, 0);
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int originX = (cell % COLUMNS) * cellTexelsX;
+        int originY = (cell / COLUMNS) * cellTexelsY;
+        const std::vector<Segment>& strokes = cell == UNKNOWN_CELL ? UNKNOWN_GLYPH : strokesFor(FIRST_CHARACTER + cell);
+
+        for (int ty = 0; ty < cellTexelsY; ++ty) {
+            for (int tx = 0; tx < cellTexelsX; ++tx) {
+                float coverage = 1.0f;
+                if (cell != SOLID_CELL) {
+                    float px = (tx + 0.5f) / OVERSAMPLE;
+                    float py = (ty + 0.5f) / OVERSAMPLE;
+                    float nearest = 1e9f;
+                    for (const Segment& segment : strokes) {
+                        nearest = std::min(nearest, distanceToSegment(px, py, segment));
+                    }
+                    coverage = std::max(0.0f, std::min(1.0f, (STROKE_HALF_WIDTH - nearest) * OVERSAMPLE + 0.5f));
+                }
+                alpha[static_cast<size_t>(originY + ty) * width + originX + tx] =
+                    static_cast<uint8_t>(coverage * 255.0f + 0.5f);
+            }
+        }
+
+        Glyph& glyph = glyphs[cell];
+        glyph.u0 = static_cast<float>(originX) / width;
+        glyph.v0 = static_cast<float>(originY) / height;
+        glyph.u1 = static_cast<float>(originX + cellTexelsX) / width;
+        glyph.v1 = static_cast<float>(originY + cellTexelsY) / height;
+    }
+
+    // Sample the middle of the solid cell so no filtering ever reaches its neighbours
+    Glyph& solid = glyphs[SOLID_CELL];
+    float centerU = (solid.u0 + solid.u1) * 0.5f;
+    float centerV = (solid.v0 + solid.v1) * 0.5f;
+    solid = {centerU, centerV, centerU, centerV};
+
+    glGenTextures(1, &texture);
+    if (!texture) return false;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, MIP_LEVELS);
+
+    // Cells are multiples of 4 texels, so 2x2 box-filtered levels keep them aligned
+    std::vector<uint8_t> rgba;
+    for (int level = 0; level <= MIP_LEVELS; ++level) {
+        if (level > 0) {
+            int halfWidth = width / 2;
+            int halfHeight = height / 2;
+            std::vector<uint8_t> reduced(static_cast<size_t>(halfWidth) * halfHeight);
+            for (int y = 0; y < halfHeight; ++y) {
+                for (int x = 0; x < halfWidth; ++x) {
+                    const uint8_t* top = &alpha[static_cast<size_t>(2 * y) * width + 2 * x];
+                    const uint8_t* bottom = top + width;
+                    reduced[static_cast<size_t>(y) * halfWidth + x] =
+                        static_cast<uint8_t>((top[0] + top[1] + bottom[0] + bottom[1] + 2) / 4);
+                }
+            }
+            alpha.swap(reduced);
+            width = halfWidth;
+            height = halfHeight;
+        }
+
+        rgba.assign(alpha.size() * 4, 255);
+        for (size_t i = 0; i < alpha.size(); ++i) {
+            rgba[i * 4 + 3] = alpha[i];
+        }
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+void GlyphAtlas::release() {
+    if (texture) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::getGlyph(char c) const {
+    int index = static_cast<unsigned char>(c) - FIRST_CHARACTER;
+    if (index < 0 || index >= PRINTABLE_COUNT) {
+        return glyphs[UNKNOWN_CELL];
+    }
+    return glyphs[index];
+}
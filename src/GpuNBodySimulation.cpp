@@ -0,0 +1,325 @@
+/**
+ * @file GpuNBodySimulation.cpp
+ * @brief Implementation of the compute-shader N-body simulation
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/GpuNBodySimulation.h"
+#include "../include/GravityBody.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+const char* GpuNBodySimulation::GLSL_BODY_STRUCT = R"(
+struct Body {
+    vec2 position;
+    vec2 velocity;
+    float mass;
+    float radius;
+    vec2 acceleration;
+};
+)";
+
+namespace {
+
+// Tiled direct sum: the group stages WORKGROUP_SIZE sources in shared memory,
+// then every invocation accumulates the tile for its own target
+const char* FORCE_KERNEL = R"(
+layout(local_size_x = WORKGROUP_SIZE) in;
+layout(std430, binding = BODY_BINDING) buffer Bodies { Body bodies[]; };
+uniform uint bodyCount;
+uniform float gravitationalConstant;
+
+shared vec3 tile[WORKGROUP_SIZE];   // source position and mass
+
+void main() {
+    uint i = gl_GlobalInvocationID.x;
+    bool inRange = i < bodyCount;
+    vec2 target = inRange ? bodies[i].position : vec2(0.0);
+    float targetMass = inRange ? bodies[i].mass : 0.0;
+    float gm = gravitationalConstant * targetMass;
+    vec2 total = vec2(0.0);
+
+    for (uint base = 0u; base < bodyCount; base += WORKGROUP_SIZE) {
+        uint j = base + gl_LocalInvocationID.x;
+        tile[gl_LocalInvocationID.x] = j < bodyCount ? vec3(bodies[j].position, bodies[j].mass) : vec3(0.0);
+        barrier();
+
+        uint tileSize = min(uint(WORKGROUP_SIZE), bodyCount - base);
+        for (uint k = 0u; k < tileSize; ++k) {
+            vec2 direction = tile[k].xy - target;
+            float distanceSquared = dot(direction, direction);
+            // Zero separation (the target itself) has no direction
+            if (distanceSquared > 0.0) {
+                float force = min(gm * tile[k].z / max(distanceSquared, PAIR_MIN_DISTANCE_SQUARED), PAIR_MAX_FORCE);
+                total += direction * (force * inversesqrt(distanceSquared));
+            }
+        }
+        barrier();
+    }
+
+    if (inRange) {
+        bodies[i].acceleration = total / targetMass;
+    }
+}
+)";
+
+// Leapfrog halves: kick + drift before the force kernel, kick + world bounds after it
+const char* INTEGRATE_KERNEL = R"(
+layout(local_size_x = WORKGROUP_SIZE) in;
+layout(std430, binding = BODY_BINDING) buffer Bodies { Body bodies[]; };
+uniform uint bodyCount;
+uniform bool drift;
+uniform float deltaTime;
+uniform vec2 worldSize;
+
+void main() {
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= bodyCount) return;
+
+    Body body = bodies[i];
+    body.velocity += body.acceleration * (0.5 * deltaTime);
+    if (drift) {
+        body.position += body.velocity * deltaTime;
+    } else {
+        // Bounce off the world edges with some energy loss
+        for (int axis = 0; axis < 2; ++axis) {
+            if (body.position[axis] < 0.0 || body.position[axis] > worldSize[axis]) {
+                body.velocity[axis] = -body.velocity[axis] * 0.8;
+                body.position[axis] = clamp(body.position[axis], 0.0, worldSize[axis]);
+            }
+        }
+    }
+    bodies[i].position = body.position;
+    bodies[i].velocity = body.velocity;
+}
+)";
+
+// Field on a unit mass at every grid point, tiled over the bodies like the force kernel
+const char* FIELD_KERNEL = R"(
+layout(local_size_x = WORKGROUP_SIZE) in;
+layout(std430, binding = BODY_BINDING) readonly buffer Bodies { Body bodies[]; };
+layout(std430, binding = FIELD_BINDING) writeonly buffer Field { float magnitudes[]; };
+uniform uint bodyCount;
+uniform float gravitationalConstant;
+uniform ivec2 gridSize;
+uniform vec2 worldSize;
+
+shared vec3 tile[WORKGROUP_SIZE];
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    uint pointCount = uint(gridSize.x * gridSize.y);
+    bool inRange = index < pointCount;
+    vec2 cell = vec2(index % uint(gridSize.x), index / uint(gridSize.x));
+    vec2 point = cell / vec2(gridSize - 1) * worldSize;
+    vec2 total = vec2(0.0);
+
+    for (uint base = 0u; base < bodyCount; base += WORKGROUP_SIZE) {
+        uint j = base + gl_LocalInvocationID.x;
+        tile[gl_LocalInvocationID.x] = j < bodyCount ? vec3(bodies[j].position, bodies[j].mass) : vec3(0.0);
+        barrier();
+
+        uint tileSize = min(uint(WORKGROUP_SIZE), bodyCount - base);
+        for (uint k = 0u; k < tileSize; ++k) {
+            vec2 direction = tile[k].xy - point;
+            float distanceSquared = dot(direction, direction);
+            if (distanceSquared > 0.0) {
+                float force = min(gravitationalConstant * tile[k].z / max(distanceSquared, FIELD_MIN_DISTANCE_SQUARED),
+                                  FIELD_MAX_FORCE);
+                total += direction * (force * inversesqrt(distanceSquared));
+            }
+        }
+        barrier();
+    }
+
+    if (inRange) {
+        magnitudes[index] = length(total);
+    }
+}
+)";
+
+/** Storage buffer binding of the field buffer */
+constexpr GLuint FIELD_BINDING = 1;
+
+/**
+ * @brief Builds the #defines shared by all kernels (sizes, bindings and GravityBody's constants)
+ */
+std::string kernelDefines() {
+    std::ostringstream defines;
+    defines.precision(9);
+    defines << std::showpoint
+            << "#define WORKGROUP_SIZE " << GpuNBodySimulation::WORKGROUP_SIZE << "\n"
+            << "#define BODY_BINDING " << GpuNBodySimulation::BODY_BINDING << "\n"
+            << "#define FIELD_BINDING " << FIELD_BINDING << "\n"
+            << "#define PAIR_MIN_DISTANCE_SQUARED "
+            << GravityBody::PAIR_MIN_DISTANCE * GravityBody::PAIR_MIN_DISTANCE << "\n"
+            << "#define PAIR_MAX_FORCE " << GravityBody::PAIR_MAX_FORCE << "\n"
+            << "#define FIELD_MIN_DISTANCE_SQUARED "
+            << GravityBody::FIELD_MIN_DISTANCE * GravityBody::FIELD_MIN_DISTANCE << "\n"
+            << "#define FIELD_MAX_FORCE " << GravityBody::FIELD_MAX_FORCE << "\n";
+    return defines.str();
+}
+
+} // namespace
+
+GpuNBodySimulation::GpuNBodySimulation(float worldWidth, float worldHeight)
+    : worldWidth(worldWidth), worldHeight(worldHeight) {}
+
+GpuNBodySimulation::~GpuNBodySimulation() {
+    release();
+}
+
+bool GpuNBodySimulation::isSupported() {
+    return GLEW_VERSION_4_3;
+}
+
+bool GpuNBodySimulation::initialize() {
+    if (!isSupported()) {
+        std::cerr << "GpuNBodySimulation requires OpenGL 4.3 compute shaders" << std::endl;
+        return false;
+    }
+
+    const std::string defines = kernelDefines();
+    const char* header = ShaderProgram::versionHeader(ShaderProgram::Profile::Core, GL_COMPUTE_SHADER);
+    if (!forceProgram.buildCompute({header, defines.c_str(), GLSL_BODY_STRUCT, FORCE_KERNEL}) ||
+        !integrateProgram.buildCompute({header, defines.c_str(), GLSL_BODY_STRUCT, INTEGRATE_KERNEL}) ||
+        !fieldProgram.buildCompute({header, defines.c_str(), GLSL_BODY_STRUCT, FIELD_KERNEL})) {
+        std::cerr << "GpuNBodySimulation failed to build its kernels" << std::endl;
+        release();
+        return false;
+    }
+
+    forceBodyCountLocation = forceProgram.getUniformLocation("bodyCount");
+    forceGLocation = forceProgram.getUniformLocation("gravitationalConstant");
+    integrateBodyCountLocation = integrateProgram.getUniformLocation("bodyCount");
+    integrateDriftLocation = integrateProgram.getUniformLocation("drift");
+    integrateDeltaTimeLocation = integrateProgram.getUniformLocation("deltaTime");
+    integrateWorldSizeLocation = integrateProgram.getUniformLocation("worldSize");
+    fieldBodyCountLocation = fieldProgram.getUniformLocation("bodyCount");
+    fieldGLocation = fieldProgram.getUniformLocation("gravitationalConstant");
+    fieldGridSizeLocation = fieldProgram.getUniformLocation("gridSize");
+    fieldWorldSizeLocation = fieldProgram.getUniformLocation("worldSize");
+
+    glGenBuffers(1, &bodyBuffer);
+    glGenBuffers(1, &fieldBuffer);
+    return true;
+}
+
+void GpuNBodySimulation::upload(const BodyStore& bodies) {
+    std::vector<Body> records(bodies.size());
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        records[i] = {bodies.x[i], bodies.y[i], bodies.vx[i], bodies.vy[i],
+                      bodies.mass[i], bodies.radius[i], 0.0f, 0.0f};
+    }
+
+    bodyCount = static_cast<GLsizei>(records.size());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bodyBuffer);
+    // Never allocate zero bytes so the buffer can always be bound
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>((records.size() + 1) * sizeof(Body)),
+                 nullptr, GL_DYNAMIC_COPY);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(records.size() * sizeof(Body)),
+                    records.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    hasAccelerations = false;
+}
+
+void GpuNBodySimulation::setGridDimensions(int width, int height) {
+    gridWidth = width;
+    gridHeight = height;
+
+    // Zeroed, so the grid draws flat until the first updateField()
+    std::vector<float> zeros(static_cast<size_t>(width) * height, 0.0f);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, fieldBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(zeros.size() * sizeof(float)),
+                 zeros.data(), GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void GpuNBodySimulation::step(float deltaTime, float gravitationalConstant) {
+    if (!forceProgram.isValid() || bodyCount == 0) return;
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BODY_BINDING, bodyBuffer);
+    if (!hasAccelerations || accelerationG != gravitationalConstant) {
+        computeAccelerations(gravitationalConstant);
+    }
+
+    // Kick-drift-kick, as LeapfrogIntegrator; the final accelerations carry over to the next step
+    integrate(true, deltaTime);
+    computeAccelerations(gravitationalConstant);
+    integrate(false, deltaTime);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BODY_BINDING, 0);
+    glUseProgram(0);
+}
+
+void GpuNBodySimulation::updateField(float gravitationalConstant) {
+    const size_t pointCount = static_cast<size_t>(gridWidth) * gridHeight;
+    if (!fieldProgram.isValid() || pointCount == 0) return;
+
+    fieldProgram.use();
+    glUniform1ui(fieldBodyCountLocation, static_cast<GLuint>(bodyCount));
+    glUniform1f(fieldGLocation, gravitationalConstant);
+    glUniform2i(fieldGridSizeLocation, gridWidth, gridHeight);
+    glUniform2f(fieldWorldSizeLocation, worldWidth, worldHeight);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BODY_BINDING, bodyBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, FIELD_BINDING, fieldBuffer);
+    glDispatchCompute(groupsFor(pointCount), 1, 1);
+
+    // The grid mesh reads the magnitudes as a vertex attribute
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BODY_BINDING, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, FIELD_BINDING, 0);
+    glUseProgram(0);
+}
+
+void GpuNBodySimulation::download(BodyStore& bodies) const {
+    std::vector<Body> records(static_cast<size_t>(bodyCount));
+    if (!records.empty()) {
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, bodyBuffer);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(records.size() * sizeof(Body)),
+                           records.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    bodies.clear();
+    bodies.reserve(records.size());
+    for (const Body& body : records) {
+        bodies.add(Vec2(body.x, body.y), Vec2(body.vx, body.vy), body.mass, body.radius);
+    }
+}
+
+void GpuNBodySimulation::release() {
+    if (bodyBuffer) glDeleteBuffers(1, &bodyBuffer);
+    if (fieldBuffer) glDeleteBuffers(1, &fieldBuffer);
+    bodyBuffer = fieldBuffer = 0;
+    bodyCount = 0;
+    gridWidth = gridHeight = 0;
+    hasAccelerations = false;
+    forceProgram.release();
+    integrateProgram.release();
+    fieldProgram.release();
+}
+
+void GpuNBodySimulation::computeAccelerations(float gravitationalConstant) {
+    forceProgram.use();
+    glUniform1ui(forceBodyCountLocation, static_cast<GLuint>(bodyCount));
+    glUniform1f(forceGLocation, gravitationalConstant);
+    glDispatchCompute(groupsFor(static_cast<size_t>(bodyCount)), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    hasAccelerations = true;
+    accelerationG = gravitationalConstant;
+}
+
+void GpuNBodySimulation::integrate(bool drift, float deltaTime) {
+    integrateProgram.use();
+    glUniform1ui(integrateBodyCountLocation, static_cast<GLuint>(bodyCount));
+    glUniform1i(integrateDriftLocation, drift ? 1 : 0);
+    glUniform1f(integrateDeltaTimeLocation, deltaTime);
+    glUniform2f(integrateWorldSizeLocation, worldWidth, worldHeight);
+    glDispatchCompute(groupsFor(static_cast<size_t>(bodyCount)), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
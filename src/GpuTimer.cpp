@@ -0,0 +1,48 @@
+/**
+ * @file GpuTimer.cpp
+ * @brief Implementation of the OpenGL timestamp queries
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/GpuTimer.h"
+
+GpuTimer::~GpuTimer() {
+    if (!queries.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    }
+}
+
+bool GpuTimer::initialize(size_t queryCount) {
+    if (!GLEW_VERSION_3_3 && !GLEW_ARB_timer_query) {
+        return false;
+    }
+    if (!queries.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    }
+    queries.assign(queryCount, 0);
+    glGenQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    return true;
+}
+
+void GpuTimer::writeTimestamp(size_t query) {
+    glQueryCounter(queries[query], GL_TIMESTAMP);
+}
+
+bool GpuTimer::isAvailable(size_t query) const {
+    GLint available = 0;
+    glGetQueryObjectiv(queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+    return available != 0;
+}
+
+uint64_t GpuTimer::getTimestamp(size_t query) const {
+    GLuint64 time = 0;
+    glGetQueryObjectui64v(queries[query], GL_QUERY_RESULT, &time);
+    return time;
+}
+
+uint64_t GpuTimer::getCurrentTime() const {
+    GLint64 time = 0;
+    glGetInteger64v(GL_TIMESTAMP, &time);
+    return static_cast<uint64_t>(time);
+}
@@ -1,64 +1,87 @@
 #include "../include/GravityBody.h"
+#include "../include/ForceLaw.h"
 #include <algorithm>
 
 GravityBody::GravityBody(const Vec2& position, float mass, float radius)
-    : position(position), velocity(0.0f, 0.0f), mass(mass), radius(radius) {}
+    : position(position), velocity(0.0f, 0.0f), mass(mass), radius(radius), storeIndex(0) {}
 
-Vec2 GravityBody::calculateGravitationalForce(const Vec2& point, float gravitationalConstant) const {
-    Vec2 direction = position - point;
-    float distanceSquared = direction.magnitudeSquared();
-    
-    // Avoid division by zero and singularities
-    const float minDistance = 1.0f;
-    if (distanceSquared < minDistance * minDistance) {
-        distanceSquared = minDistance * minDistance;
+void GravityBody::setPosition(const Vec2& newPosition) {
+    if (store) {
+        store->x[storeIndex] = newPosition.x;
+        store->y[storeIndex] = newPosition.y;
+        store->touch();
+    } else {
+        position = newPosition;
     }
-    
-    // F = G * m1 * m2 / r^2, but we assume unit mass at the point
-    float forceMagnitude = (gravitationalConstant * mass) / distanceSquared;
-    
-    // Limit maximum force to prevent numerical instabilities
-    const float maxForce = 1000.0f;
-    forceMagnitude = std::min(forceMagnitude, maxForce);
-    
-    return direction.normalized() * forceMagnitude;
 }
 
-Vec2 GravityBody::calculateForceFrom(const GravityBody& other, float gravitationalConstant) const {
-    Vec2 direction = other.position - position;
-    float distanceSquared = direction.magnitudeSquared();
-    
-    // Avoid division by zero and prevent bodies from getting too close
-    const float minDistance = 10.0f; // Minimum separation distance
-    if (distanceSquared < minDistance * minDistance) {
-        distanceSquared = minDistance * minDistance;
+void GravityBody::setVelocity(const Vec2& newVelocity) {
+    if (store) {
+        store->vx[storeIndex] = newVelocity.x;
+        store->vy[storeIndex] = newVelocity.y;
+        store->touch();
+    } else {
+        velocity = newVelocity;
     }
+}
+
+void GravityBody::bindToStore(std::shared_ptr<BodyStore> bodyStore, size_t index) {
+    store = std::move(bodyStore);
+    storeIndex = index;
+}
+
+void GravityBody::unbindFromStore() {
+    if (!store) return;
     
-    // F = G * m1 * m2 / r^2
-    float forceMagnitude = (gravitationalConstant * mass * other.mass) / distanceSquared;
-    
-    // Limit maximum force to prevent numerical instabilities
-    const float maxForce = 5000.0f;
-    forceMagnitude = std::min(forceMagnitude, maxForce);
-    
-    return direction.normalized() * forceMagnitude;
+    // Keep the latest state so the body remains usable on its own
+    position = store->getPosition(storeIndex);
+    velocity = store->getVelocity(storeIndex);
+    mass = store->mass[storeIndex];
+    radius = store->radius[storeIndex];
+    store.reset();
+    storeIndex = 0;
+}
+
+Vec2 GravityBody::calculateGravitationalForce(const Vec2& point, float gravitationalConstant) const {
+    return calculateFieldForce(point, getPosition(), getMass(), gravitationalConstant);
+}
+
+Vec2 GravityBody::calculateFieldForce(const Vec2& point, const Vec2& sourcePosition, float sourceMass,
+                                      float gravitationalConstant) {
+    // F = G * m1 * m2 / r^2, but we assume unit mass at the point; softened
+    // and clamped to avoid singularities and numerical instabilities
+    return DefaultForceLaw::force(sourcePosition - point, gravitationalConstant * sourceMass,
+                                  FIELD_MIN_DISTANCE * FIELD_MIN_DISTANCE, FIELD_MAX_FORCE);
+}
+
+Vec2 GravityBody::calculateForceFrom(const GravityBody& other, float gravitationalConstant) const {
+    return calculatePairForce(getPosition(), getMass(), other.getPosition(), other.getMass(),
+                              gravitationalConstant);
+}
+
+Vec2 GravityBody::calculatePairForce(const Vec2& targetPosition, float targetMass,
+                                     const Vec2& sourcePosition, float sourceMass,
+                                     float gravitationalConstant) {
+    // F = G * m1 * m2 / r^2, softened so bodies cannot get too close and clamped
+    return DefaultForceLaw::force(sourcePosition - targetPosition, gravitationalConstant * targetMass * sourceMass,
+                                  PAIR_MIN_DISTANCE * PAIR_MIN_DISTANCE, PAIR_MAX_FORCE);
 }
 
 void GravityBody::applyForce(const Vec2& force, float deltaTime) {
     // F = ma, so a = F/m
-    Vec2 acceleration = force / mass;
+    Vec2 acceleration = force / getMass();
     
     // Update velocity: v = v0 + a*dt
-    velocity = velocity + acceleration * deltaTime;
+    Vec2 newVelocity = getVelocity() + acceleration * deltaTime;
     
     // Apply very light velocity damping to prevent numerical instabilities
     // (reduced from 0.999f to preserve orbital motion)
     const float dampingFactor = 0.9999f;
-    velocity = velocity * dampingFactor;
+    setVelocity(newVelocity * dampingFactor);
 }
 
 void GravityBody::updatePosition(float deltaTime) {
     // Update position: x = x0 + v*dt
     // This should apply the current velocity immediately, including initial velocity
-    position = position + velocity * deltaTime;
+    setPosition(getPosition() + getVelocity() * deltaTime);
 }
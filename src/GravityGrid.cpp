@@ -1,4 +1,6 @@
 #include "../include/GravityGrid.h"
+#include "../include/ForceKernels.h"
+#include "../include/ParticleMeshField.h"
 #include <algorithm>
 #include <cmath>
 
@@ -13,50 +15,173 @@ GravityGrid::GravityGrid(float width, float height, int gridResolution)
     gridHeight = std::max(gridHeight, 10);
     
     gridSpacing = width / static_cast<float>(gridWidth - 1);
+    moveThreshold = gridSpacing * DEFAULT_MOVE_THRESHOLD;
     
     // Initialize the forces grid
-    forces.resize(gridHeight);
-    for (auto& row : forces) {
-        row.resize(gridWidth, Vec2(0.0f, 0.0f));
+    forces.assign(static_cast<size_t>(gridWidth) * gridHeight, Vec2(0.0f, 0.0f));
+    magnitudes.assign(forces.size(), 0.0f);
+    
+    // Cache grid point positions in SoA form for the vectorized field kernel
+    pointX.resize(static_cast<size_t>(gridWidth) * gridHeight);
+    pointY.resize(pointX.size());
+    for (int y = 0; y < gridHeight; ++y) {
+        for (int x = 0; x < gridWidth; ++x) {
+            Vec2 worldPos = gridToWorld(x, y);
+            pointX[static_cast<size_t>(y) * gridWidth + x] = worldPos.x;
+            pointY[static_cast<size_t>(y) * gridWidth + x] = worldPos.y;
+        }
     }
 }
 
-void GravityGrid::updateGrid(const std::vector<std::shared_ptr<GravityBody>>& bodies, 
-                            float gravitationalConstant) {
-    // Reset all forces to zero
-    for (int y = 0; y < gridHeight; ++y) {
-        for (int x = 0; x < gridWidth; ++x) {
-            forces[y][x] = Vec2(0.0f, 0.0f);
+bool GravityGrid::updateGrid(const BodyStore& bodies, float gravitationalConstant,
+                             ThreadPool* threadPool) {
+    const size_t count = bodies.size();
+    FrameArena& arena = scratchArena(threadPool);
+    if (!contributionsValid || contributedMass.size() != count || contributedG != gravitationalConstant) {
+        computeFullGrid(bodies, gravitationalConstant, threadPool, arena);
+        return true;
+    }
+    
+    // Find bodies whose field on the grid is out of date; the field only reads x, y and mass
+    movedBefore.clear();
+    movedAfter.clear();
+    const float thresholdSquared = moveThreshold * moveThreshold;
+    for (size_t i = 0; i < count; ++i) {
+        float dx = bodies.x[i] - contributedX[i];
+        float dy = bodies.y[i] - contributedY[i];
+        if (dx * dx + dy * dy > thresholdSquared || bodies.mass[i] != contributedMass[i]) {
+            movedBefore.x.push_back(contributedX[i]);
+            movedBefore.y.push_back(contributedY[i]);
+            movedBefore.mass.push_back(contributedMass[i]);
+            movedAfter.x.push_back(bodies.x[i]);
+            movedAfter.y.push_back(bodies.y[i]);
+            movedAfter.mass.push_back(bodies.mass[i]);
+            contributedX[i] = bodies.x[i];
+            contributedY[i] = bodies.y[i];
+            contributedMass[i] = bodies.mass[i];
         }
     }
     
-    // Calculate forces at each grid point
-    for (int y = 0; y < gridHeight; ++y) {
-        for (int x = 0; x < gridWidth; ++x) {
-            Vec2 gridWorldPos = gridToWorld(x, y);
-            Vec2 totalForce(0.0f, 0.0f);
-            
-            // Sum forces from all bodies
-            for (const auto& body : bodies) {
-                Vec2 force = body->calculateGravitationalForce(gridWorldPos, gravitationalConstant);
-                totalForce += force;
+    lastUpdatedBodyCount = movedAfter.size();
+    if (movedAfter.empty()) {
+        return false;
+    }
+    
+    // Keep the scratch stores whole (zero velocity and radius) and stamp each once
+    const size_t moved = movedAfter.size();
+    for (BodyStore* store : {&movedBefore, &movedAfter}) {
+        store->vx.assign(moved, 0.0f);
+        store->vy.assign(moved, 0.0f);
+        store->radius.assign(moved, 0.0f);
+        store->touch();
+    }
+    
+    // The mesh always solves for the whole field; a direct delta costs two
+    // field evaluations per moved body, a full update one per body
+    if (fieldMethod == FieldMethod::ParticleMesh ||
+        2 * movedAfter.size() >= count || incrementalUpdates >= FULL_UPDATE_INTERVAL) {
+        computeFullGrid(bodies, gravitationalConstant, threadPool, arena);
+        return true;
+    }
+    
+    applyMovedBodies(gravitationalConstant, threadPool, arena);
+    ++incrementalUpdates;
+    return true;
+}
+
+void GravityGrid::setFieldMethod(FieldMethod method) {
+    if (method != fieldMethod) {
+        fieldMethod = method;
+        invalidate();
+    }
+}
+
+FrameArena& GravityGrid::scratchArena(ThreadPool* threadPool) {
+    size_t threads = threadPool ? threadPool->getThreadCount() : 1;
+    if (frameArena) {
+        frameArena->reserveLanes(threads);
+        return *frameArena;
+    }
+    if (!ownArena) {
+        ownArena = std::make_shared<FrameArena>(threads);
+    }
+    ownArena->reset();
+    ownArena->reserveLanes(threads);
+    return *ownArena;
+}
+
+void GravityGrid::computeFullGrid(const BodyStore& bodies, float gravitationalConstant,
+                                  ThreadPool* threadPool, FrameArena& arena) {
+    if (fieldMethod == FieldMethod::ParticleMesh) {
+        if (!particleMesh) {
+            float spacingY = worldHeight / static_cast<float>(gridHeight - 1);
+            particleMesh = std::make_shared<ParticleMeshField>(gridWidth, gridHeight, gridSpacing, spacingY);
+        }
+        particleMesh->compute(bodies, gravitationalConstant, forces.data(), threadPool, arena);
+        ThreadPool::run(threadPool, 0, static_cast<size_t>(gridHeight), 1, [&](size_t firstRow, size_t lastRow) {
+            updateMagnitudes(firstRow, lastRow);
+        });
+    } else {
+        // Calculate forces at each grid point, one row at a time, summing over all bodies
+        ThreadPool::run(threadPool, 0, static_cast<size_t>(gridHeight), 1, [&](size_t firstRow, size_t lastRow) {
+            for (size_t y = firstRow; y < lastRow; ++y) {
+                size_t rowStart = y * gridWidth;
+                ForceKernels::computeFieldForces(pointX.data() + rowStart, pointY.data() + rowStart, gridWidth,
+                                                 bodies, gravitationalConstant, forces.data() + rowStart);
+            }
+            updateMagnitudes(firstRow, lastRow);
+        });
+    }
+    
+    contributedX = bodies.x;
+    contributedY = bodies.y;
+    contributedMass = bodies.mass;
+    contributedG = gravitationalConstant;
+    version = BodyStore::nextVersion();
+    contributionsValid = true;
+    incrementalUpdates = 0;
+    lastUpdatedBodyCount = bodies.size();
+}
+
+void GravityGrid::applyMovedBodies(float gravitationalConstant, ThreadPool* threadPool, FrameArena& arena) {
+    // Subtract each moved body's old field and add its new one. Because of the
+    // per-source force clamp a negative-mass copy would not cancel the old field
+    // exactly, so both are evaluated.
+    ThreadPool::run(threadPool, 0, static_cast<size_t>(gridHeight), 1, [&](size_t firstRow, size_t lastRow) {
+        FrameArena::Scope scope(arena);
+        Vec2* before = arena.allocate<Vec2>(gridWidth);
+        Vec2* after = arena.allocate<Vec2>(gridWidth);
+        for (size_t y = firstRow; y < lastRow; ++y) {
+            size_t rowStart = y * gridWidth;
+            ForceKernels::computeFieldForces(pointX.data() + rowStart, pointY.data() + rowStart, gridWidth,
+                                             movedBefore, gravitationalConstant, before);
+            ForceKernels::computeFieldForces(pointX.data() + rowStart, pointY.data() + rowStart, gridWidth,
+                                             movedAfter, gravitationalConstant, after);
+            for (int x = 0; x < gridWidth; ++x) {
+                forces[rowStart + x] += after[x] - before[x];
             }
-            
-            forces[y][x] = totalForce;
         }
+        updateMagnitudes(firstRow, lastRow);
+    });
+    version = BodyStore::nextVersion();
+}
+
+void GravityGrid::updateMagnitudes(size_t firstRow, size_t lastRow) {
+    for (size_t i = firstRow * gridWidth; i < lastRow * gridWidth; ++i) {
+        magnitudes[i] = forces[i].magnitude();
     }
 }
 
 Vec2 GravityGrid::getForceAtGridPoint(int gridX, int gridY) const {
     if (isValidGridPoint(gridX, gridY)) {
-        return forces[gridY][gridX];
+        return forces[static_cast<size_t>(gridY) * gridWidth + gridX];
     }
     return Vec2(0.0f, 0.0f);
 }
 
 float GravityGrid::getForceMagnitudeAtGridPoint(int gridX, int gridY) const {
     if (isValidGridPoint(gridX, gridY)) {
-        return forces[gridY][gridX].magnitude();
+        return magnitudes[static_cast<size_t>(gridY) * gridWidth + gridX];
     }
     return 0.0f;
 }
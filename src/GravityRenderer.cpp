@@ -6,9 +6,13 @@
  */
 
 #include "../include/GravityRenderer.h"
+#include "../include/Frustum.h"
+#include "../include/SphereGeometry.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -29,6 +33,20 @@ void GravityRenderer::initialize() {
     // Set viewport
     glViewport(0, 0, static_cast<GLsizei>(viewportWidth), static_cast<GLsizei>(viewportHeight));
     
+    // Retained grid mesh needs GLSL; keep immediate mode as the fallback
+    gridMesh = std::make_unique<SpacetimeGridMesh>();
+    if (!gridMesh->initialize()) {
+        std::cout << "Shaders unavailable, drawing the spacetime grid in immediate mode" << std::endl;
+        gridMesh.reset();
+    }
+    
+    // Instanced bodies need ARB_draw_instanced/ARB_instanced_arrays on 2.1 contexts
+    bodyMesh = std::make_unique<BodyMesh>();
+    if (!bodyMesh->initialize(ShaderProgram::Profile::Legacy)) {
+        std::cout << "Instancing unavailable, drawing bodies one sphere at a time" << std::endl;
+        bodyMesh.reset();
+    }
+    
     isInitialized = true;
     std::cout << "GravityRenderer initialized with " << viewportWidth << "x" << viewportHeight << " viewport" << std::endl;
 }
@@ -51,10 +69,10 @@ void GravityRenderer::render(const CameraController& cameraController, UIRendere
     
     // Apply camera transformation (delegated to CameraController)
     cameraController.applyTransform();
+    viewMatrix = cameraController.getViewMatrix();
 
     // Render 3D gravity visualization
-    render3DSpacetimeGrid();
-    render3DGravityBodies();
+    renderScene();
     
     // Render UI overlay if provided
     if (uiRenderer) {
@@ -82,13 +100,15 @@ void GravityRenderer::render() {
     
     // Simple default camera position
     glTranslatef(0.0f, 0.0f, -800.0f);
+    viewMatrix = Mat4::translation(0.0f, 0.0f, -800.0f);
 
-    render3DSpacetimeGrid();
-    render3DGravityBodies();
+    renderScene();
 }
 
 void GravityRenderer::cleanup() {
     // Clean up any OpenGL resources if needed
+    gridMesh.reset();
+    bodyMesh.reset();
     isInitialized = false;
     std::cout << "GravityRenderer cleaned up" << std::endl;
 }
@@ -108,7 +128,7 @@ void GravityRenderer::setup3DProjection() {
     glLoadIdentity();
     
     // Set up perspective projection
-    float fovy = 60.0f; // Field of view in degrees
+    float fovy = FIELD_OF_VIEW; // Field of view in degrees
     float aspect = viewportWidth / viewportHeight;
     float zNear = 1.0f;
     float zFar = 2000.0f;
@@ -117,17 +137,36 @@ void GravityRenderer::setup3DProjection() {
     float fW = fH * aspect;
     
     glFrustum(-fW, fW, -fH, fH, zNear, zFar);
+    projectionMatrix = Mat4::frustum(-fW, fW, -fH, fH, zNear, zFar);
 }
 
-void GravityRenderer::render3DSpacetimeGrid() {
-    if (!gravityGrid) return;
+void GravityRenderer::renderScene() {
+    SceneSource::Frame frame = sceneSource.acquire();
+    
+    if (frame.grid) {
+        Profiler::Scope scope(profiler, Profiler::Phase::GridRender, true);
+        render3DSpacetimeGrid(*frame.grid);
+    }
+    if (frame.bodies) {
+        Profiler::Scope scope(profiler, Profiler::Phase::BodyRender, true);
+        render3DGravityBodies(*frame.bodies);
+    }
+}
 
+void GravityRenderer::render3DSpacetimeGrid(const GravityGrid& grid) {
+    if (gridMesh) {
+        gridMesh->update(grid);
+        gridMesh->draw(maxForceVisualization, viewMatrix, projectionMatrix,
+                       BodyMesh::pixelScaleFor(FIELD_OF_VIEW, viewportHeight));
+        return;
+    }
+    
     // Enable polygon offset to avoid z-fighting
     glEnable(GL_POLYGON_OFFSET_FILL);
     glPolygonOffset(1.0f, 1.0f);
     
     // Get grid properties
-    auto gridDimensions = gravityGrid->getGridDimensions();
+    auto gridDimensions = grid.getGridDimensions();
     float gridSizeX = static_cast<float>(gridDimensions.first);
     float gridSizeY = static_cast<float>(gridDimensions.second);
     float gridScale = 600.0f; // Scale factor for visualization
@@ -136,80 +175,96 @@ void GravityRenderer::render3DSpacetimeGrid() {
     float spacingX = gridScale / gridSizeX;
     float spacingY = gridScale / gridSizeY;
     
+    // Heights based on force magnitude (gravitational potential), read straight from the grid
+    const float* magnitudes = grid.getForceMagnitudeData();
+    const int rowLength = gridDimensions.first;
+    auto heightAt = [&](int x, int y) {
+        return std::min(magnitudes[y * rowLength + x] * 0.5f, 200.0f);
+    };
+    
+    // Only blocks of the grid that can be on screen are drawn
+    const int block = SpacetimeGridMesh::TILE_CELLS;
+    const Frustum frustum = Frustum::fromMatrix(projectionMatrix * viewMatrix);
+    std::vector<std::pair<int, int>> visibleBlocks;
+    for (int by = 0; by < gridDimensions.second - 1; by += block) {
+        for (int bx = 0; bx < gridDimensions.first - 1; bx += block) {
+            int ex = std::min(bx + block, gridDimensions.first - 1);
+            int ey = std::min(by + block, gridDimensions.second - 1);
+            if (frustum.intersectsBox((bx - gridSizeX/2) * spacingX, -200.0f, (by - gridSizeY/2) * spacingY,
+                                      (ex - gridSizeX/2) * spacingX, 0.0f, (ey - gridSizeY/2) * spacingY)) {
+                visibleBlocks.emplace_back(bx, by);
+            }
+        }
+    }
+    
     // Render grid as a mesh of quads with height representing gravitational potential
     glBegin(GL_QUADS);
     
-    for (int x = 0; x < gridDimensions.first - 1; ++x) {
-        for (int y = 0; y < gridDimensions.second - 1; ++y) {
-            // Calculate world positions
-            float worldX1 = (x - gridSizeX/2) * spacingX;
-            float worldY1 = (y - gridSizeY/2) * spacingY;
-            float worldX2 = ((x+1) - gridSizeX/2) * spacingX;
-            float worldY2 = ((y+1) - gridSizeY/2) * spacingY;
-            
-            // Get gravitational field strengths at grid points
-            Vec2 force1 = gravityGrid->getForceAtGridPoint(x, y);
-            Vec2 force2 = gravityGrid->getForceAtGridPoint(x+1, y);
-            Vec2 force3 = gravityGrid->getForceAtGridPoint(x+1, y+1);
-            Vec2 force4 = gravityGrid->getForceAtGridPoint(x, y+1);
-            
-            // Calculate heights based on force magnitude (gravitational potential)
-            float height1 = std::min(sqrtf(force1.x * force1.x + force1.y * force1.y) * 0.5f, 200.0f);
-            float height2 = std::min(sqrtf(force2.x * force2.x + force2.y * force2.y) * 0.5f, 200.0f);
-            float height3 = std::min(sqrtf(force3.x * force3.x + force3.y * force3.y) * 0.5f, 200.0f);
-            float height4 = std::min(sqrtf(force4.x * force4.x + force4.y * force4.y) * 0.5f, 200.0f);
-            
-            // Apply color based on gravitational field strength
-            Vec2 avgForce = forceToColor((height1 + height2 + height3 + height4) / 4.0f);
-            glColor3f(avgForce.x, 0.2f, avgForce.y); // Red-Blue gradient
-            
-            // Create warped grid quad
-            glVertex3f(worldX1, -height1, worldY1);  // Bottom-left
-            glVertex3f(worldX2, -height2, worldY1);  // Bottom-right
-            glVertex3f(worldX2, -height3, worldY2);  // Top-right
-            glVertex3f(worldX1, -height4, worldY2);  // Top-left
+    for (const auto& origin : visibleBlocks) {
+        int ex = std::min(origin.first + block, gridDimensions.first - 1);
+        int ey = std::min(origin.second + block, gridDimensions.second - 1);
+        for (int x = origin.first; x < ex; ++x) {
+            for (int y = origin.second; y < ey; ++y) {
+                // Calculate world positions
+                float worldX1 = (x - gridSizeX/2) * spacingX;
+                float worldY1 = (y - gridSizeY/2) * spacingY;
+                float worldX2 = ((x+1) - gridSizeX/2) * spacingX;
+                float worldY2 = ((y+1) - gridSizeY/2) * spacingY;
+                
+                // Heights from gravitational field strengths at the quad corners
+                float height1 = heightAt(x, y);
+                float height2 = heightAt(x+1, y);
+                float height3 = heightAt(x+1, y+1);
+                float height4 = heightAt(x, y+1);
+                
+                // Apply color based on gravitational field strength
+                Vec2 avgForce = forceToColor((height1 + height2 + height3 + height4) / 4.0f);
+                glColor3f(avgForce.x, 0.2f, avgForce.y); // Red-Blue gradient
+                
+                // Create warped grid quad
+                glVertex3f(worldX1, -height1, worldY1);  // Bottom-left
+                glVertex3f(worldX2, -height2, worldY1);  // Bottom-right
+                glVertex3f(worldX2, -height3, worldY2);  // Top-right
+                glVertex3f(worldX1, -height4, worldY2);  // Top-left
+            }
         }
     }
     
     glEnd();
     
-    // Render grid lines for better visualization
+    // Render grid lines for better visualization; each block draws its first row and
+    // column, plus the last ones along the far edges of the grid
     glColor3f(0.3f, 0.3f, 0.3f);
     glBegin(GL_LINES);
     
-    // Horizontal lines
-    for (int y = 0; y < gridDimensions.second; ++y) {
-        for (int x = 0; x < gridDimensions.first - 1; ++x) {
-            float worldX1 = (x - gridSizeX/2) * spacingX;
-            float worldY = (y - gridSizeY/2) * spacingY;
-            float worldX2 = ((x+1) - gridSizeX/2) * spacingX;
-            
-            Vec2 force1 = gravityGrid->getForceAtGridPoint(x, y);
-            Vec2 force2 = gravityGrid->getForceAtGridPoint(x+1, y);
-            
-            float height1 = std::min(sqrtf(force1.x * force1.x + force1.y * force1.y) * 0.5f, 200.0f);
-            float height2 = std::min(sqrtf(force2.x * force2.x + force2.y * force2.y) * 0.5f, 200.0f);
-            
-            glVertex3f(worldX1, -height1, worldY);
-            glVertex3f(worldX2, -height2, worldY);
+    for (const auto& origin : visibleBlocks) {
+        int ex = std::min(origin.first + block, gridDimensions.first - 1);
+        int ey = std::min(origin.second + block, gridDimensions.second - 1);
+        int lastRow = ey == gridDimensions.second - 1 ? ey : ey - 1;
+        int lastColumn = ex == gridDimensions.first - 1 ? ex : ex - 1;
+        
+        // Horizontal lines
+        for (int y = origin.second; y <= lastRow; ++y) {
+            for (int x = origin.first; x < ex; ++x) {
+                float worldX1 = (x - gridSizeX/2) * spacingX;
+                float worldY = (y - gridSizeY/2) * spacingY;
+                float worldX2 = ((x+1) - gridSizeX/2) * spacingX;
+                
+                glVertex3f(worldX1, -heightAt(x, y), worldY);
+                glVertex3f(worldX2, -heightAt(x+1, y), worldY);
+            }
         }
-    }
-    
-    // Vertical lines
-    for (int x = 0; x < gridDimensions.first; ++x) {
-        for (int y = 0; y < gridDimensions.second - 1; ++y) {
-            float worldX = (x - gridSizeX/2) * spacingX;
-            float worldY1 = (y - gridSizeY/2) * spacingY;
-            float worldY2 = ((y+1) - gridSizeY/2) * spacingY;
-            
-            Vec2 force1 = gravityGrid->getForceAtGridPoint(x, y);
-            Vec2 force2 = gravityGrid->getForceAtGridPoint(x, y+1);
-            
-            float height1 = std::min(sqrtf(force1.x * force1.x + force1.y * force1.y) * 0.5f, 200.0f);
-            float height2 = std::min(sqrtf(force2.x * force2.x + force2.y * force2.y) * 0.5f, 200.0f);
-            
-            glVertex3f(worldX, -height1, worldY1);
-            glVertex3f(worldX, -height2, worldY2);
+        
+        // Vertical lines
+        for (int x = origin.first; x <= lastColumn; ++x) {
+            for (int y = origin.second; y < ey; ++y) {
+                float worldX = (x - gridSizeX/2) * spacingX;
+                float worldY1 = (y - gridSizeY/2) * spacingY;
+                float worldY2 = ((y+1) - gridSizeY/2) * spacingY;
+                
+                glVertex3f(worldX, -heightAt(x, y), worldY1);
+                glVertex3f(worldX, -heightAt(x, y+1), worldY2);
+            }
         }
     }
     
@@ -217,71 +272,49 @@ void GravityRenderer::render3DSpacetimeGrid() {
     glDisable(GL_POLYGON_OFFSET_FILL);
 }
 
-void GravityRenderer::render3DGravityBodies() {
-    if (!gravityGrid) return;
-    
-    // Get grid properties for consistent coordinate mapping
-    auto gridDimensions = gravityGrid->getGridDimensions();
-    float gridSizeX = static_cast<float>(gridDimensions.first);
-    float gridSizeY = static_cast<float>(gridDimensions.second);
-    float gridScale = 600.0f; // Same scale as used in grid rendering
-    
-    // Calculate grid spacing (same as in render3DSpacetimeGrid)
-    float spacingX = gridScale / gridSizeX;
-    float spacingY = gridScale / gridSizeY;
+void GravityRenderer::render3DGravityBodies(const BodyStore& bodies) {
+    float pixelScale = BodyMesh::pixelScaleFor(FIELD_OF_VIEW, viewportHeight);
+    if (bodyMesh) {
+        bodyMesh->update(bodies, viewMatrix, projectionMatrix, pixelScale);
+        bodyMesh->draw();
+        return;
+    }
     
-    for (const auto& body : gravityBodies) {
-        if (!body) continue;
+    const Frustum frustum = Frustum::fromMatrix(projectionMatrix * viewMatrix);
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        // Same placement, size and color as the instanced path
+        BodyMesh::Instance body = BodyMesh::instanceFor(bodies, i);
+        if (!frustum.intersectsSphere(body.x, body.y, body.z, body.radius * BodyMesh::GLOW_SCALE)) continue;
+        Vec3 worldPos(body.x, body.y, body.z);
         
-        // Get body properties
-        Vec2 bodyPos = body->getPosition();
-        float mass = body->getMass();
-        
-        // Direct coordinate mapping to match grid system
-        // Body positions are in world coordinates (0-800 for X, 0-600 for Y typically)
-        // Convert directly to grid world coordinates
-        float worldX = (bodyPos.x / 800.0f - 0.5f) * gridScale; // Map 0-800 to -300 to +300
-        float worldZ = (bodyPos.y / 600.0f - 0.5f) * gridScale; // Map 0-600 to -300 to +300
-        
-        Vec3 worldPos(worldX, 50.0f, worldZ); // Elevate above the grid
-        float radius = std::max(5.0f, std::min(50.0f, mass / 1000.0f)); // Scale radius by mass
-        
-        // Set color based on mass
-        float massRatio = std::min(1.0f, mass / 50000.0f);
-        glColor3f(1.0f, 1.0f - massRatio, 0.0f); // Yellow to red gradient
+        // Without point sprites the smallest bodies use the coarsest sphere
+        int level = std::min(BodyMesh::levelFor(body, viewMatrix, pixelScale), BodyMesh::LOD_LEVEL_COUNT - 1);
+        const BodyMesh::LodLevel& detail = BodyMesh::LOD_LEVELS[level];
         
         // Render 3D sphere
-        render3DSphere(worldPos, radius);
+        glColor3f(body.r, body.g, body.b);
+        render3DSphere(worldPos, body.radius, detail.bodySegments);
         
         // Render glow effect
         glColor4f(1.0f, 0.8f, 0.0f, 0.3f);
-        render3DSphere(worldPos, radius * 1.5f, 8);
+        render3DSphere(worldPos, body.radius * BodyMesh::GLOW_SCALE, detail.glowSegments);
     }
 }
 
 void GravityRenderer::render3DSphere(const Vec3& center, float radius, int segments) {
-    // Render a simple 3D sphere using latitude/longitude approach
-    for (int i = 0; i < segments; ++i) {
-        float lat1 = (i / float(segments)) * M_PI - M_PI/2;
-        float lat2 = ((i + 1) / float(segments)) * M_PI - M_PI/2;
-        
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= segments; ++j) {
-            float lng = (j / float(segments)) * 2 * M_PI;
-            
-            float x1 = cos(lat1) * cos(lng);
-            float y1 = sin(lat1);
-            float z1 = cos(lat1) * sin(lng);
-            
-            float x2 = cos(lat2) * cos(lng);
-            float y2 = sin(lat2);
-            float z2 = cos(lat2) * sin(lng);
-            
-            glVertex3f(center.x + radius * x1, center.y + radius * y1, center.z + radius * z1);
-            glVertex3f(center.x + radius * x2, center.y + radius * y2, center.z + radius * z2);
-        }
-        glEnd();
-    }
+    // Unit sphere is built once per segment count; no trigonometry per frame
+    const SphereGeometry& sphere = SphereGeometry::cached(segments);
+    
+    glPushMatrix();
+    glTranslatef(center.x, center.y, center.z);
+    glScalef(radius, radius, radius);
+    
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, sphere.positions.data());
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(sphere.indices.size()), GL_UNSIGNED_INT, sphere.indices.data());
+    glDisableClientState(GL_VERTEX_ARRAY);
+    
+    glPopMatrix();
 }
 
 Vec2 GravityRenderer::worldToNDC(const Vec2& worldPos) const {
@@ -1,12 +1,29 @@
 #include "../include/GravitySimulation.h"
+#include "../include/DirectForceSolver.h"
+#include "../include/Integrators.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
-GravitySimulation::GravitySimulation(float worldWidth, float worldHeight, int gridResolution)
+GravitySimulation::GravitySimulation(float worldWidth, float worldHeight, int gridResolution,
+                                     std::unique_ptr<IForceSolver> forceSolver,
+                                     size_t threadCount)
     : worldWidth(worldWidth), worldHeight(worldHeight), 
-      gravitationalConstant(80.0f), needsGridUpdate(true) { // Reduced G for solar system scale
+      gravitationalConstant(80.0f), needsGridUpdate(true), // Reduced G for solar system scale
+      forceSolver(std::move(forceSolver)),
+      threadPool(std::make_unique<ThreadPool>(threadCount)),
+      frameArena(this->threadPool->getThreadCount()),
+      integrator(std::make_unique<LeapfrogIntegrator>()),
+      collisionResolver(std::make_unique<CollisionResolver>(worldWidth, worldHeight)) {
     
     gravityGrid = std::make_shared<GravityGrid>(worldWidth, worldHeight, gridResolution);
+    bodyStore = std::make_shared<BodyStore>();
+    gravityGrid->setFrameArena(&frameArena);
+    
+    if (!this->forceSolver) {
+        this->forceSolver = std::make_unique<DirectForceSolver>();
+    }
+    this->forceSolver->setFrameArena(&frameArena);
 }
 
 void GravitySimulation::initialize() {
@@ -14,35 +31,161 @@ void GravitySimulation::initialize() {
     createDefaultBodies();
     
     // Initial grid calculation
-    gravityGrid->updateGrid(bodies, gravitationalConstant);
+    gravityGrid->updateGrid(*bodyStore, gravitationalConstant, threadPool.get());
+    frameArena.reset();
     needsGridUpdate = false;
     
-    std::cout << "Solar System simulation initialized with " << bodies.size() << " celestial bodies\n";
+    std::cout << "Solar System simulation initialized with " << bodyStore->size() << " celestial bodies"
+              << " (" << forceSolver->getName() << " force solver, "
+              << integrator->getName() << " integrator, "
+              << threadPool->getThreadCount() << " threads)\n";
 }
 
 void GravitySimulation::update(float deltaTime) {
+    stepBodies(deltaTime);
+    updateGrid();
+}
+
+void GravitySimulation::stepBodies(float deltaTime) {
     // Update body physics (N-body gravitational attraction)
+    Profiler::Scope scope(profiler, Profiler::Phase::Bodies);
     updateBodies(deltaTime);
-    
-    // Recalculate gravity grid since bodies may have moved
-    gravityGrid->updateGrid(bodies, gravitationalConstant);
+    bodyStore->touch();
+    integratorVersion = bodyStore->version;
+    simulationTime += deltaTime;
+    ++stepCount;
+    if (recorder) {
+        recorder->record(*bodyStore, simulationTime, stepCount);
+    }
+    frameArena.reset();
+}
+
+void GravitySimulation::updateGrid() {
+    // Bring the grid up to date; it only recomputes the fields of bodies that moved
+    if (needsGridUpdate) {
+        gravityGrid->invalidate();
+        needsGridUpdate = false;
+    }
+    Profiler::Scope scope(profiler, Profiler::Phase::Grid);
+    gravityGrid->updateGrid(*bodyStore, gravitationalConstant, threadPool.get());
+    frameArena.reset();
 }
 
-void GravitySimulation::setupRenderer(std::shared_ptr<GravityRenderer> renderer) {
+void GravitySimulation::setupRenderer(std::shared_ptr<IGravityRenderer> renderer) {
     if (renderer) {
         renderer->setGravityGrid(gravityGrid);
-        renderer->setGravityBodies(bodies);
+        renderer->setBodyStore(bodyStore);
         renderer->setMaxForceForVisualization(500.0f);
     }
 }
 
 void GravitySimulation::addBody(std::shared_ptr<GravityBody> body) {
+    if (!body) return;
+    
+    // Detach from any previous simulation before copying state into our store
+    body->unbindFromStore();
+    size_t index = bodyStore->add(body->getPosition(), body->getVelocity(),
+                                  body->getMass(), body->getRadius());
+    body->bindToStore(bodyStore, index);
+    bodies.resize(index);
     bodies.push_back(body);
+    integrator->reset();
+    needsGridUpdate = true;
+}
+
+void GravitySimulation::reserveBodies(size_t count) {
+    bodyStore->reserve(count);
+}
+
+void GravitySimulation::addBodies(const BodyDescriptor* descriptors, size_t count) {
+    if (count == 0) return;
+    bodyStore->append(descriptors, count);
+    integrator->reset();
+    needsGridUpdate = true;
+}
+
+size_t GravitySimulation::addBodies(const IBodyGenerator& generator) {
+    size_t first = bodyStore->size();
+    size_t count = generator.getBodyCount();
+    if (count == 0) return first;
+    bodyStore->resize(first + count);
+    generator.generate(*bodyStore, first, gravitationalConstant, threadPool.get());
+    bodyStore->touch();
+    integrator->reset();
     needsGridUpdate = true;
+    return first;
+}
+
+const std::vector<std::shared_ptr<GravityBody>>& GravitySimulation::getBodies() const {
+    bodies.resize(bodyStore->size());
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (!bodies[i]) {
+            bodies[i] = std::make_shared<GravityBody>(bodyStore->getPosition(i), bodyStore->mass[i], bodyStore->radius[i]);
+            bodies[i]->bindToStore(bodyStore, i);
+        }
+    }
+    return bodies;
+}
+
+void GravitySimulation::setForceSolver(std::unique_ptr<IForceSolver> solver) {
+    if (solver) {
+        solver->setForceLaw(forceSolver->getForceLaw());
+        solver->setFrameArena(&frameArena);
+        forceSolver = std::move(solver);
+        integrator->reset();
+    }
+}
+
+bool GravitySimulation::setForceLaw(const ForceLaw& law) {
+    if (!(law.softeningLength > 0.0f) || !(law.maxForce > 0.0f)) {
+        std::cerr << "Force law needs a positive softening length and force limit" << std::endl;
+        return false;
+    }
+    forceSolver->setForceLaw(law);
+    integrator->reset();
+    return true;
+}
+
+void GravitySimulation::setIntegrator(std::unique_ptr<IIntegrator> newIntegrator) {
+    if (newIntegrator) {
+        integrator = std::move(newIntegrator);
+        if (!integrator->setPositionPrecision(positionPrecision)) {
+            std::cerr << "Integrator " << integrator->getName() << " only supports single precision positions"
+                      << std::endl;
+        }
+    }
+}
+
+bool GravitySimulation::setPositionPrecision(PositionPrecision precision) {
+    positionPrecision = precision;
+    return integrator->setPositionPrecision(precision);
+}
+
+void GravitySimulation::setThreadCount(size_t threadCount) {
+    threadPool = std::make_unique<ThreadPool>(threadCount);
+    frameArena.reserveLanes(threadPool->getThreadCount());
 }
 
 void GravitySimulation::clearBodies() {
+    for (auto& body : bodies) {
+        if (body) body->unbindFromStore();
+    }
     bodies.clear();
+    bodyStore->clear();
+    integrator->reset();
+    needsGridUpdate = true;
+}
+
+void GravitySimulation::replaceBodies(BodyStore store) {
+    for (auto& body : bodies) {
+        if (body) body->unbindFromStore();
+    }
+    *bodyStore = std::move(store);
+    bodyStore->touch();
+    
+    // Handles are created by getBodies() when someone needs them
+    bodies.clear();
+    integrator->reset();
     needsGridUpdate = true;
 }
 
@@ -150,45 +293,121 @@ void GravitySimulation::createDefaultBodies() {
 }
 
 void GravitySimulation::updateBodies(float deltaTime) {
-    // N-body gravitational simulation
-    // First, calculate all forces acting on each body
-    std::vector<Vec2> forces(bodies.size(), Vec2(0.0f, 0.0f));
+    // Anyone touching the store since the last step (e.g. GravityBody::setPosition) may have moved bodies
+    if (bodyStore->version != integratorVersion) {
+        integrator->invalidateForces();
+    }
     
-    for (size_t i = 0; i < bodies.size(); ++i) {
-        for (size_t j = 0; j < bodies.size(); ++j) {
-            if (i != j) {
-                // Calculate gravitational force from body j on body i
-                Vec2 force = bodies[i]->calculateForceFrom(*bodies[j], gravitationalConstant);
-                forces[i] = forces[i] + force;
+    // N-body gravitational simulation: the integrator asks for forces (from the
+    // force solver) as often as its scheme needs and advances the body store
+    integrator->step(*bodyStore, deltaTime, [this](const BodyStore& store,
+                                                   const std::vector<size_t>* targets,
+                                                   std::vector<Vec2>& forces) {
+        evaluateForces(store, targets, forces);
+    });
+    
+    // Forces cached at the end of the step describe positions these may still change
+    bool bounded = applyWorldBounds();
+    bool bounced = resolveCollisions();
+    lastStepMovedBodies = bounded || bounced;
+    if (lastStepMovedBodies) {
+        integrator->invalidateForces();
+    }
+}
+
+void GravitySimulation::evaluateForces(const BodyStore& store, const std::vector<size_t>* targets,
+                                       std::vector<Vec2>& forces) {
+    if (targets) {
+        forceSolver->computeForcesOn(store, gravitationalConstant, *targets, forces, threadPool.get());
+    } else {
+        forceSolver->computeForces(store, gravitationalConstant, forces, threadPool.get());
+    }
+}
+
+double GravitySimulation::computeTotalEnergy() const {
+    const BodyStore& store = *bodyStore;
+    const double g = gravitationalConstant;
+    const ForceLaw& law = forceSolver->getForceLaw();
+    const double softening = law.softeningLength;
+    
+    // Every pair is visited from both ends (balanced chunks), hence the half
+    double potential = visitForceLaw(law, [&](auto policy) {
+        using Law = decltype(policy);
+        return threadPool->parallelReduce(0, store.size(), 64, 0.0, [&](size_t begin, size_t end) {
+            double sum = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t j = 0; j < store.size(); ++j) {
+                    if (j == i) continue;
+                    double dx = static_cast<double>(store.x[j]) - store.x[i];
+                    double dy = static_cast<double>(store.y[j]) - store.y[i];
+                    double r = std::sqrt(dx * dx + dy * dy);
+                    sum += Law::potential(r, g * store.mass[i] * store.mass[j], softening);
+                }
             }
-        }
+            return sum;
+        });
+    });
+    
+    double kinetic = 0.0;
+    for (size_t i = 0; i < store.size(); ++i) {
+        kinetic += 0.5 * store.mass[i] * (static_cast<double>(store.vx[i]) * store.vx[i] +
+                                          static_cast<double>(store.vy[i]) * store.vy[i]);
     }
+    return kinetic + 0.5 * potential;
+}
+
+bool GravitySimulation::resolveCollisions() {
+    if (collisionResolver->getMode() == CollisionResolver::Mode::None) return false;
     
-    // Apply forces and update positions
-    for (size_t i = 0; i < bodies.size(); ++i) {
-        bodies[i]->applyForce(forces[i], deltaTime);
-        bodies[i]->updatePosition(deltaTime);
-        
-        // Keep bodies within world bounds (simple boundary handling)
-        Vec2 pos = bodies[i]->getPosition();
-        Vec2 vel = bodies[i]->getVelocity();
-        bool bounced = false;
-        
-        if (pos.x < 0 || pos.x > worldWidth) {
-            vel.x = -vel.x * 0.8f; // Bounce with some energy loss
-            pos.x = std::max(0.0f, std::min(worldWidth, pos.x));
-            bounced = true;
+    size_t collisions = collisionResolver->resolve(*bodyStore, mergedBodies);
+    if (!mergedBodies.empty()) {
+        removeBodies(mergedBodies);
+    }
+    // Every handled inelastic collision pushes its overlapping pair apart
+    return collisionResolver->getMode() == CollisionResolver::Mode::Inelastic && collisions > 0;
+}
+
+void GravitySimulation::removeBodies(const std::vector<size_t>& indices) {
+    if (indices.empty()) return;
+    
+    // Handles mirror the store, so compact them with the same stable scheme
+    size_t write = indices.front();
+    size_t next = 0;
+    for (size_t read = indices.front(); read < bodies.size(); ++read) {
+        if (next < indices.size() && indices[next] == read) {
+            if (bodies[read]) bodies[read]->unbindFromStore();
+            ++next;
+            continue;
         }
-        
-        if (pos.y < 0 || pos.y > worldHeight) {
-            vel.y = -vel.y * 0.8f; // Bounce with some energy loss
-            pos.y = std::max(0.0f, std::min(worldHeight, pos.y));
-            bounced = true;
+        bodies[write] = std::move(bodies[read]);
+        if (bodies[write]) bodies[write]->bindToStore(bodyStore, write);
+        ++write;
+    }
+    bodies.resize(std::min(write, bodies.size()));
+    bodyStore->erase(indices);
+    
+    // Per-body integrator state and grid contributions are indexed by body
+    integrator->reset();
+    needsGridUpdate = true;
+}
+
+bool GravitySimulation::applyWorldBounds() {
+    BodyStore& store = *bodyStore;
+    bool moved = false;
+    
+    // Keep bodies within world bounds (simple boundary handling)
+    for (size_t i = 0; i < store.size(); ++i) {
+        if (store.x[i] < 0 || store.x[i] > worldWidth) {
+            store.vx[i] = -store.vx[i] * 0.8f; // Bounce with some energy loss
+            store.x[i] = std::max(0.0f, std::min(worldWidth, store.x[i]));
+            moved = true;
         }
         
-        if (bounced) {
-            bodies[i]->setPosition(pos);
-            bodies[i]->setVelocity(vel);
+        if (store.y[i] < 0 || store.y[i] > worldHeight) {
+            store.vy[i] = -store.vy[i] * 0.8f; // Bounce with some energy loss
+            store.y[i] = std::max(0.0f, std::min(worldHeight, store.y[i]));
+            moved = true;
         }
     }
+    return moved;
 }
@@ -0,0 +1,297 @@
+/**
+ * @file Integrators.cpp
+ * @brief Implementation of the time integration schemes
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/Integrators.h"
+#include "../include/GravityBody.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+/** v += F/m * dt for every body */
+void kick(BodyStore& bodies, const std::vector<Vec2>& forces, float dt) {
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        float scale = dt / bodies.mass[i];
+        bodies.vx[i] += forces[i].x * scale;
+        bodies.vy[i] += forces[i].y * scale;
+    }
+}
+
+/** v += F/m * dt for a single body */
+void kickBody(BodyStore& bodies, size_t i, const Vec2& force, float dt) {
+    float scale = dt / bodies.mass[i];
+    bodies.vx[i] += force.x * scale;
+    bodies.vy[i] += force.y * scale;
+}
+
+/** Copies a checkpointed array into a per-body buffer; false if it is missing or mis-sized */
+bool restoreArray(const IntegratorState& state, const std::string& name, size_t count, std::vector<Vec2>& values) {
+    const void* data = state.find(name, IntegratorState::ElementType::Float32, 2 * count);
+    if (!data) return false;
+    const float* floats = static_cast<const float*>(data);
+    values.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = Vec2(floats[2 * i], floats[2 * i + 1]);
+    }
+    return true;
+}
+
+bool restoreArray(const IntegratorState& state, const std::string& name, size_t count, std::vector<float>& values) {
+    const void* data = state.find(name, IntegratorState::ElementType::Float32, count);
+    if (!data) return false;
+    const float* floats = static_cast<const float*>(data);
+    values.assign(floats, floats + count);
+    return true;
+}
+
+bool restoreArray(const IntegratorState& state, const std::string& name, size_t count, std::vector<int>& values) {
+    const void* data = state.find(name, IntegratorState::ElementType::Int32, count);
+    if (!data) return false;
+    const int* ints = static_cast<const int*>(data);
+    values.assign(ints, ints + count);
+    return true;
+}
+
+} // namespace
+
+void EulerIntegrator::step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) {
+    evaluateForces(bodies, nullptr, forces);
+    
+    // a = F/m, v = (v0 + a*dt) * damping, x = x0 + v*dt
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        float ax = forces[i].x / bodies.mass[i];
+        float ay = forces[i].y / bodies.mass[i];
+        bodies.vx[i] = (bodies.vx[i] + ax * deltaTime) * DAMPING_FACTOR;
+        bodies.vy[i] = (bodies.vy[i] + ay * deltaTime) * DAMPING_FACTOR;
+    }
+    positions.drift(bodies, deltaTime);
+}
+
+bool EulerIntegrator::restoreState(const IntegratorState& state, size_t bodyCount) {
+    positions.restoreState(state, bodyCount);
+    return true;
+}
+
+void LeapfrogIntegrator::step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) {
+    if (!hasForces || forces.size() != bodies.size()) {
+        evaluateForces(bodies, nullptr, forces);
+    }
+    
+    kick(bodies, forces, 0.5f * deltaTime);
+    positions.drift(bodies, deltaTime);
+    evaluateForces(bodies, nullptr, forces);
+    kick(bodies, forces, 0.5f * deltaTime);
+    hasForces = true;
+}
+
+void VelocityVerletIntegrator::step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) {
+    if (!hasForces || forces.size() != bodies.size()) {
+        evaluateForces(bodies, nullptr, forces);
+    }
+    
+    // x(t+dt) = x + v*dt + a*dt^2/2
+    float halfDtSquared = 0.5f * deltaTime * deltaTime;
+    positions.advance(bodies, [&](size_t i) {
+        float invMass = 1.0f / bodies.mass[i];
+        return Vec2(bodies.vx[i] * deltaTime + forces[i].x * invMass * halfDtSquared,
+                    bodies.vy[i] * deltaTime + forces[i].y * invMass * halfDtSquared);
+    });
+    
+    // v(t+dt) = v + (a(t) + a(t+dt)) * dt/2
+    evaluateForces(bodies, nullptr, newForces);
+    float halfDt = 0.5f * deltaTime;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        float scale = halfDt / bodies.mass[i];
+        bodies.vx[i] += (forces[i].x + newForces[i].x) * scale;
+        bodies.vy[i] += (forces[i].y + newForces[i].y) * scale;
+    }
+    
+    forces.swap(newForces);
+    hasForces = true;
+}
+
+void YoshidaIntegrator::step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) {
+    // Yoshida (1990) coefficients for a 4th order symmetric composition
+    static const double cubeRootTwo = std::cbrt(2.0);
+    static const float w1 = static_cast<float>(1.0 / (2.0 - cubeRootTwo));
+    static const float w0 = static_cast<float>(-cubeRootTwo / (2.0 - cubeRootTwo));
+    static const float c1 = 0.5f * w1;
+    static const float c2 = 0.5f * (w0 + w1);
+    
+    positions.drift(bodies, c1 * deltaTime);
+    evaluateForces(bodies, nullptr, forces);
+    kick(bodies, forces, w1 * deltaTime);
+    positions.drift(bodies, c2 * deltaTime);
+    evaluateForces(bodies, nullptr, forces);
+    kick(bodies, forces, w0 * deltaTime);
+    positions.drift(bodies, c2 * deltaTime);
+    evaluateForces(bodies, nullptr, forces);
+    kick(bodies, forces, w1 * deltaTime);
+    positions.drift(bodies, c1 * deltaTime);
+}
+
+bool YoshidaIntegrator::restoreState(const IntegratorState& state, size_t bodyCount) {
+    positions.restoreState(state, bodyCount);
+    return true;
+}
+
+BlockTimestepIntegrator::BlockTimestepIntegrator(int maxLevel, float accuracy)
+    : maxLevel(std::max(0, std::min(maxLevel, MAX_SUPPORTED_LEVEL))), accuracy(accuracy) {
+}
+
+void BlockTimestepIntegrator::step(BodyStore& bodies, float deltaTime, const ForceEvaluator& evaluateForces) {
+    const size_t count = bodies.size();
+    lastBodyEvaluations = 0;
+    lastSubsteps = 0;
+    if (count == 0) return;
+    
+    if (!hasForces || forces.size() != count) {
+        evaluateForces(bodies, nullptr, forces);
+        lastAcceleration.assign(count, Vec2(0.0f, 0.0f));
+        lastStepLength.assign(count, 0.0f);
+        levels.assign(count, 0);
+        lastBodyEvaluations += count;
+        ++lastSubsteps;
+        hasForces = true;
+    }
+    
+    // Time is counted in ticks of the finest level so step boundaries compare exactly
+    const int64_t totalTicks = int64_t(1) << maxLevel;
+    const float tickLength = deltaTime / static_cast<float>(totalTicks);
+    auto stepTicks = [&](int level) { return int64_t(1) << (maxLevel - level); };
+    
+    // Everyone is synchronised at the start of a frame, so levels may change freely here
+    for (size_t i = 0; i < count; ++i) {
+        levels[i] = chooseLevel(bodies, i, deltaTime);
+        kickBody(bodies, i, forces[i], 0.5f * stepTicks(levels[i]) * tickLength);
+    }
+    
+    int64_t tick = 0;
+    while (tick < totalTicks) {
+        // Drift everyone to the earliest step end
+        int64_t next = totalTicks;
+        for (size_t i = 0; i < count; ++i) {
+            int64_t length = stepTicks(levels[i]);
+            next = std::min(next, (tick / length + 1) * length);
+        }
+        positions.drift(bodies, static_cast<float>(next - tick) * tickLength);
+        tick = next;
+        
+        active.clear();
+        for (size_t i = 0; i < count; ++i) {
+            int64_t length = stepTicks(levels[i]);
+            if (tick % length == 0) {
+                rememberAcceleration(bodies, i, static_cast<float>(length) * tickLength);
+                active.push_back(i);
+            }
+        }
+        
+        evaluateForces(bodies, active.size() == count ? nullptr : &active, forces);
+        lastBodyEvaluations += active.size();
+        ++lastSubsteps;
+        
+        for (size_t i : active) {
+            // Closing half kick of the step that ended...
+            kickBody(bodies, i, forces[i], 0.5f * stepTicks(levels[i]) * tickLength);
+            if (tick == totalTicks) continue;
+            
+            // ...and opening half kick of the next one, possibly on a new level
+            int level = chooseLevel(bodies, i, deltaTime);
+            if (level < levels[i]) {
+                level = levels[i] - 1;
+                if (tick % stepTicks(level) != 0) {
+                    level = levels[i];
+                }
+            }
+            levels[i] = level;
+            kickBody(bodies, i, forces[i], 0.5f * stepTicks(level) * tickLength);
+        }
+    }
+}
+
+int BlockTimestepIntegrator::chooseLevel(const BodyStore& bodies, size_t body, float deltaTime) const {
+    Vec2 acceleration = forces[body] / bodies.mass[body];
+    float accelerationMagnitude = acceleration.magnitude();
+    if (accelerationMagnitude <= 0.0f) {
+        return 0;
+    }
+    
+    // Softening-length criterion, then the acceleration/jerk (Aarseth) criterion once a jerk estimate exists
+    float desired = std::sqrt(2.0f * accuracy * GravityBody::PAIR_MIN_DISTANCE / accelerationMagnitude);
+    if (lastStepLength[body] > 0.0f) {
+        float jerk = (acceleration - lastAcceleration[body]).magnitude() / lastStepLength[body];
+        if (jerk > 0.0f) {
+            desired = std::min(desired, accuracy * accelerationMagnitude / jerk);
+        }
+    }
+    
+    int level = 0;
+    float length = deltaTime;
+    while (level < maxLevel && length > desired) {
+        length *= 0.5f;
+        ++level;
+    }
+    return level;
+}
+
+void BlockTimestepIntegrator::rememberAcceleration(const BodyStore& bodies, size_t body, float stepLength) {
+    lastAcceleration[body] = forces[body] / bodies.mass[body];
+    lastStepLength[body] = stepLength;
+}
+
+void LeapfrogIntegrator::saveState(IntegratorState& state) const {
+    if (hasForces) state.add("forces", forces);
+    positions.saveState(state);
+}
+
+bool LeapfrogIntegrator::restoreState(const IntegratorState& state, size_t bodyCount) {
+    positions.restoreState(state, bodyCount);
+    hasForces = restoreArray(state, "forces", bodyCount, forces);
+    return hasForces;
+}
+
+void VelocityVerletIntegrator::saveState(IntegratorState& state) const {
+    if (hasForces) state.add("forces", forces);
+    positions.saveState(state);
+}
+
+bool VelocityVerletIntegrator::restoreState(const IntegratorState& state, size_t bodyCount) {
+    positions.restoreState(state, bodyCount);
+    hasForces = restoreArray(state, "forces", bodyCount, forces);
+    return hasForces;
+}
+
+void BlockTimestepIntegrator::saveState(IntegratorState& state) const {
+    positions.saveState(state);
+    if (!hasForces) return;
+    state.add("forces", forces);
+    state.add("lastAcceleration", lastAcceleration);
+    state.add("lastStepLength", lastStepLength);
+    state.add("levels", levels);
+}
+
+bool BlockTimestepIntegrator::restoreState(const IntegratorState& state, size_t bodyCount) {
+    positions.restoreState(state, bodyCount);
+    hasForces = restoreArray(state, "forces", bodyCount, forces) &&
+                restoreArray(state, "lastAcceleration", bodyCount, lastAcceleration) &&
+                restoreArray(state, "lastStepLength", bodyCount, lastStepLength) &&
+                restoreArray(state, "levels", bodyCount, levels) &&
+                std::all_of(levels.begin(), levels.end(), [this](int level) {
+                    return level >= 0 && level <= maxLevel;
+                });
+    return hasForces;
+}
+
+std::unique_ptr<IIntegrator> createIntegrator(const std::string& name) {
+    if (name == "euler") return std::make_unique<EulerIntegrator>();
+    if (name == "leapfrog") return std::make_unique<LeapfrogIntegrator>();
+    if (name == "verlet") return std::make_unique<VelocityVerletIntegrator>();
+    if (name == "yoshida4") return std::make_unique<YoshidaIntegrator>();
+    if (name == "block") return std::make_unique<BlockTimestepIntegrator>();
+    return nullptr;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file ParticleMeshField.cpp
+ * @brief Implementation of the particle-mesh gravity field
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/ParticleMeshField.h"
+#include "../include/GravityBody.h"
+#include <algorithm>
+#include <cmath>
+
+ParticleMeshField::ParticleMeshField(int gridWidth, int gridHeight, float spacingX, float spacingY)
+    : gridWidth(gridWidth), gridHeight(gridHeight), spacingX(spacingX), spacingY(spacingY),
+      rowTransform(FFT::nextPowerOfTwo(2 * static_cast<size_t>(gridWidth))),
+      columnTransform(FFT::nextPowerOfTwo(2 * static_cast<size_t>(gridHeight))) {
+
+    const size_t width = paddedWidth();
+    const size_t height = paddedHeight();
+    kernelSpectrum.resize(width * height);
+    workspace.resize(width * height);
+
+    // Force on a unit mass from a unit mass at offset (dx, dy), written as Kx + i*Ky.
+    // Offsets past half the padded size wrap to negative, which is what makes the
+    // circular convolution equal the linear one over the real grid.
+    const float minDistanceSquared = GravityBody::FIELD_MIN_DISTANCE * GravityBody::FIELD_MIN_DISTANCE;
+    for (size_t j = 0; j < height; ++j) {
+        long offsetY = j <= height / 2 ? static_cast<long>(j) : static_cast<long>(j) - static_cast<long>(height);
+        for (size_t i = 0; i < width; ++i) {
+            long offsetX = i <= width / 2 ? static_cast<long>(i) : static_cast<long>(i) - static_cast<long>(width);
+            // The kernel gives the pull toward the source, hence the negated offset
+            float dx = -static_cast<float>(offsetX) * spacingX;
+            float dy = -static_cast<float>(offsetY) * spacingY;
+            float distanceSquared = dx * dx + dy * dy;
+            Complex value(0.0f, 0.0f);
+            if (distanceSquared > 0.0f) {
+                float scale = 1.0f / (std::max(distanceSquared, minDistanceSquared) * std::sqrt(distanceSquared));
+                value = Complex(dx * scale, dy * scale);
+            }
+            kernelSpectrum[j * width + i] = value;
+        }
+    }
+    FrameArena setupArena;
+    transform2D(kernelSpectrum.data(), false, height, nullptr, setupArena);
+
+    // Fold the inverse transform's 1/N into the kernel
+    const float normalization = 1.0f / static_cast<float>(width * height);
+    for (auto& value : kernelSpectrum) {
+        value *= normalization;
+    }
+}
+
+void ParticleMeshField::compute(const BodyStore& bodies, float gravitationalConstant, Vec2* forces,
+                                ThreadPool* threadPool, FrameArena& arena) {
+    const size_t width = paddedWidth();
+    std::fill(workspace.begin(), workspace.end(), Complex(0.0f, 0.0f));
+
+    // Cloud-in-cell deposit: each mass is shared bilinearly between its 4 surrounding points
+    const float maxGridX = static_cast<float>(gridWidth - 1);
+    const float maxGridY = static_cast<float>(gridHeight - 1);
+    for (size_t b = 0; b < bodies.size(); ++b) {
+        float gx = std::max(0.0f, std::min(bodies.x[b] / spacingX, maxGridX));
+        float gy = std::max(0.0f, std::min(bodies.y[b] / spacingY, maxGridY));
+        int ix = std::min(static_cast<int>(gx), gridWidth - 2);
+        int iy = std::min(static_cast<int>(gy), gridHeight - 2);
+        float tx = gx - static_cast<float>(ix);
+        float ty = gy - static_cast<float>(iy);
+        float mass = bodies.mass[b];
+
+        Complex* cell = workspace.data() + static_cast<size_t>(iy) * width + ix;
+        cell[0] += mass * (1.0f - tx) * (1.0f - ty);
+        cell[1] += mass * tx * (1.0f - ty);
+        cell[width] += mass * (1.0f - tx) * ty;
+        cell[width + 1] += mass * tx * ty;
+    }
+
+    // Convolve density with the force kernel in frequency space
+    transform2D(workspace.data(), false, static_cast<size_t>(gridHeight), threadPool, arena);
+    ThreadPool::run(threadPool, 0, workspace.size(), width, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const Complex& a = workspace[k];
+            const Complex& b = kernelSpectrum[k];
+            workspace[k] = Complex(a.real() * b.real() - a.imag() * b.imag(),
+                                   a.real() * b.imag() + a.imag() * b.real());
+        }
+    });
+    transform2D(workspace.data(), true, static_cast<size_t>(gridHeight), threadPool, arena);
+
+    // Real part is Fx, imaginary part Fy; clamp like the per-body clamp of the direct sum
+    const float maxForce = GravityBody::FIELD_MAX_FORCE;
+    ThreadPool::run(threadPool, 0, static_cast<size_t>(gridHeight), 1, [&](size_t firstRow, size_t lastRow) {
+        for (size_t y = firstRow; y < lastRow; ++y) {
+            for (int x = 0; x < gridWidth; ++x) {
+                const Complex& value = workspace[y * width + x];
+                Vec2 force(value.real() * gravitationalConstant, value.imag() * gravitationalConstant);
+                float magnitude = force.magnitude();
+                if (magnitude > maxForce) {
+                    force *= maxForce / magnitude;
+                }
+                forces[y * gridWidth + x] = force;
+            }
+        }
+    });
+}
+
+void ParticleMeshField::transform2D(Complex* data, bool inverse, size_t activeRows,
+                                    ThreadPool* threadPool, FrameArena& arena) const {
+    const size_t width = paddedWidth();
+    const size_t height = paddedHeight();
+
+    auto transformRows = [&]() {
+        ThreadPool::run(threadPool, 0, activeRows, 1, [&](size_t firstRow, size_t lastRow) {
+            for (size_t y = firstRow; y < lastRow; ++y) {
+                rowTransform.transform(data + y * width, inverse);
+            }
+        });
+    };
+    auto transformColumns = [&]() {
+        ThreadPool::run(threadPool, 0, width, COLUMNS_PER_TASK, [&](size_t firstColumn, size_t lastColumn) {
+            // Gather the whole block of columns at once so every row access is contiguous
+            const size_t blockWidth = lastColumn - firstColumn;
+            FrameArena::Scope scope(arena);
+            Complex* columns = arena.allocate<Complex>(blockWidth * height);
+            for (size_t y = 0; y < height; ++y) {
+                const Complex* row = data + y * width + firstColumn;
+                for (size_t c = 0; c < blockWidth; ++c) {
+                    columns[c * height + y] = row[c];
+                }
+            }
+            for (size_t c = 0; c < blockWidth; ++c) {
+                columnTransform.transform(columns + c * height, inverse);
+            }
+            for (size_t y = 0; y < height; ++y) {
+                Complex* row = data + y * width + firstColumn;
+                for (size_t c = 0; c < blockWidth; ++c) {
+                    row[c] = columns[c * height + y];
+                }
+            }
+        });
+    };
+
+    // Rows outside activeRows are zero going forward and unused coming back
+    if (inverse) {
+        transformColumns();
+        transformRows();
+    } else {
+        transformRows();
+        transformColumns();
+    }
+}
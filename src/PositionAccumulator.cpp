@@ -0,0 +1,52 @@
+/**
+ * @file PositionAccumulator.cpp
+ * @brief Checkpointing and resynchronisation of accumulated positions
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/PositionAccumulator.h"
+
+namespace {
+
+const char RESIDUAL_NAME[] = "positionResidual";
+const char PRECISE_NAME[] = "positionPrecise";
+
+} // namespace
+
+void PositionAccumulator::saveState(IntegratorState& state) const {
+    // A float plus a float remainder holds only 48 of a double's 53 bits, so double mode keeps the doubles
+    if (precision == PositionPrecision::Compensated) state.add(RESIDUAL_NAME, residuals);
+    if (precision == PositionPrecision::Double) state.add(PRECISE_NAME, precise);
+}
+
+void PositionAccumulator::restoreState(const IntegratorState& state, size_t bodyCount) {
+    reset();
+    if (precision == PositionPrecision::Compensated) {
+        const void* data = state.find(RESIDUAL_NAME, IntegratorState::ElementType::Float32, 2 * bodyCount);
+        if (!data) return;
+        const float* floats = static_cast<const float*>(data);
+        residuals.resize(bodyCount);
+        for (size_t i = 0; i < bodyCount; ++i) {
+            residuals[i] = Vec2(floats[2 * i], floats[2 * i + 1]);
+        }
+    } else if (precision == PositionPrecision::Double) {
+        const void* data = state.find(PRECISE_NAME, IntegratorState::ElementType::Float64, 2 * bodyCount);
+        if (!data) return;
+        const double* doubles = static_cast<const double*>(data);
+        precise.resize(bodyCount);
+        for (size_t i = 0; i < bodyCount; ++i) {
+            precise[i] = Vec2d(doubles[2 * i], doubles[2 * i + 1]);
+        }
+    }
+}
+
+void PositionAccumulator::synchronizePrecise(const BodyStore& bodies) {
+    const size_t count = bodies.size();
+    if (precise.size() == count) return;
+
+    precise.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        precise[i] = Vec2d(bodies.x[i], bodies.y[i]);
+    }
+}
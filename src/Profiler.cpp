@@ -0,0 +1,238 @@
+/**
+ * @file Profiler.cpp
+ * @brief Implementation of the frame profiler
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+Profiler::Scope::Scope(Profiler* profiler, Phase phase, bool gpu)
+    : profiler(profiler && profiler->isEnabled() ? profiler : nullptr), phase(phase) {
+    if (!this->profiler) return;
+    if (gpu) gpuQuery = this->profiler->beginGpuScope(phase);
+    start = std::chrono::steady_clock::now();
+}
+
+Profiler::Scope::~Scope() {
+    if (!profiler) return;
+    auto end = std::chrono::steady_clock::now();
+    if (gpuQuery >= 0) profiler->endGpuScope(gpuQuery);
+    profiler->recordCpu(phase, start, end);
+}
+
+Profiler::Profiler()
+    : enabled(false), epoch(std::chrono::steady_clock::now()), history(HISTORY_FRAMES) {
+    previousFrameStart = epoch;
+}
+
+Profiler::~Profiler() = default;
+
+bool Profiler::initializeGpuTimers(std::unique_ptr<IGpuTimer> timer) {
+    if (gpuTimer) return true;
+    if (!timer || !timer->initialize(2 * GPU_SCOPES_PER_FRAME * GPU_LATENCY_FRAMES)) {
+        return false;
+    }
+
+    size_t query = 0;
+    for (GpuFrame& gpuFrame : gpuFrames) {
+        for (GpuScope& scope : gpuFrame.scopes) {
+            scope.queries[0] = query++;
+            scope.queries[1] = query++;
+        }
+    }
+
+    // GPU timestamps count from an arbitrary origin; line them up with the CPU trace time
+    uint64_t gpuNow = timer->getCurrentTime();
+    gpuClockOffsetUs = toTraceUs(std::chrono::steady_clock::now()) - gpuNow / 1000.0;
+    gpuTimer = std::move(timer);
+    return true;
+}
+
+void Profiler::beginFrame() {
+    if (!isEnabled()) return;
+    ownerThread = std::this_thread::get_id();
+
+    if (gpuTimer) {
+        // Reuse the slot written GPU_LATENCY_FRAMES frames ago, collecting it first
+        GpuFrame& gpuFrame = gpuFrames[frameNumber % GPU_LATENCY_FRAMES];
+        collectGpuFrame(gpuFrame);
+        gpuFrame.scopeCount = 0;
+        gpuFrame.frameNumber = frameNumber;
+    }
+
+    frameStart = std::chrono::steady_clock::now();
+    inFrame = true;
+}
+
+void Profiler::endFrame() {
+    if (!inFrame) return;
+    inFrame = false;
+    auto end = std::chrono::steady_clock::now();
+
+    newestFrame = (newestFrame + 1) % HISTORY_FRAMES;
+    frameCount = std::min(frameCount + 1, HISTORY_FRAMES);
+    FrameStats& stats = history[newestFrame];
+    stats = FrameStats();
+    stats.frameNumber = frameNumber++;
+    stats.frameMs = std::chrono::duration<float, std::milli>(end - frameStart).count();
+    stats.intervalMs = std::chrono::duration<float, std::milli>(frameStart - previousFrameStart).count();
+    previousFrameStart = frameStart;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.cpuMs = currentCpuMs;
+    currentCpuMs.fill(0.0f);
+    pushTraceEvent({"frame", traceThreadId(), toTraceUs(frameStart),
+                    std::chrono::duration<double, std::micro>(end - frameStart).count()});
+}
+
+const Profiler::FrameStats& Profiler::getFrame(size_t age) const {
+    return history[(newestFrame + HISTORY_FRAMES - age % HISTORY_FRAMES) % HISTORY_FRAMES];
+}
+
+Profiler::FrameStats Profiler::getAverage(size_t frames) const {
+    FrameStats average;
+    frames = std::min(frames, frameCount);
+    if (frames == 0) return average;
+
+    size_t gpuFrameCount = 0;
+    for (size_t age = 0; age < frames; ++age) {
+        const FrameStats& stats = getFrame(age);
+        average.frameMs += stats.frameMs;
+        average.intervalMs += stats.intervalMs;
+        for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+            average.cpuMs[phase] += stats.cpuMs[phase];
+            if (stats.hasGpuTimes) average.gpuMs[phase] += stats.gpuMs[phase];
+        }
+        if (stats.hasGpuTimes) ++gpuFrameCount;
+    }
+
+    average.frameNumber = getFrame(0).frameNumber;
+    average.frameMs /= frames;
+    average.intervalMs /= frames;
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        average.cpuMs[phase] /= frames;
+        if (gpuFrameCount) average.gpuMs[phase] /= gpuFrameCount;
+    }
+    average.hasGpuTimes = gpuFrameCount > 0;
+    return average;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Profiler: cannot write trace to " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    file << "{\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+    for (size_t i = 0; i < threadIds.size(); ++i) {
+        std::string name = threadIds[i] == ownerThread ? "main" : "thread " + std::to_string(i + 1);
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i + 1
+             << ",\"args\":{\"name\":\"" << name << "\"}}";
+    }
+
+    // Oldest first, so viewers get the events in time order per thread
+    size_t count = traceWrapped ? trace.size() : traceNext;
+    size_t first = traceWrapped ? traceNext : 0;
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for (size_t i = 0; i < count; ++i) {
+        const TraceEvent& event = trace[(first + i) % trace.size()];
+        file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << (event.thread ? "cpu" : "gpu")
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+             << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(file);
+}
+
+const char* Profiler::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Bodies: return "updateBodies";
+        case Phase::Grid: return "updateGrid";
+        case Phase::GridRender: return "render3DSpacetimeGrid";
+        case Phase::BodyRender: return "render3DGravityBodies";
+        case Phase::UI: return "UI";
+        case Phase::Swap: return "swap";
+        default: return "unknown";
+    }
+}
+
+int Profiler::beginGpuScope(Phase phase) {
+    if (!gpuTimer || !inFrame) return -1;
+    GpuFrame& gpuFrame = gpuFrames[frameNumber % GPU_LATENCY_FRAMES];
+    if (gpuFrame.scopeCount == GPU_SCOPES_PER_FRAME) return -1;
+
+    GpuScope& scope = gpuFrame.scopes[gpuFrame.scopeCount];
+    scope.phase = phase;
+    gpuTimer->writeTimestamp(scope.queries[0]);
+    return static_cast<int>(gpuFrame.scopeCount++);
+}
+
+void Profiler::endGpuScope(int slot) {
+    GpuFrame& gpuFrame = gpuFrames[frameNumber % GPU_LATENCY_FRAMES];
+    gpuTimer->writeTimestamp(gpuFrame.scopes[slot].queries[1]);
+}
+
+void Profiler::collectGpuFrame(GpuFrame& gpuFrame) {
+    if (gpuFrame.scopeCount == 0) return;
+
+    // Queries complete in order, so the last end query tells whether the whole frame is done
+    if (!gpuTimer->isAvailable(gpuFrame.scopes[gpuFrame.scopeCount - 1].queries[1])) return;
+
+    // The frame may already have dropped out of the history; its events still go to the trace
+    uint64_t newestNumber = frameCount ? getFrame(0).frameNumber : 0;
+    uint64_t age = newestNumber - gpuFrame.frameNumber;
+    FrameStats* stats = frameCount && gpuFrame.frameNumber <= newestNumber && age < frameCount
+                            ? &history[(newestFrame + HISTORY_FRAMES - age) % HISTORY_FRAMES]
+                            : nullptr;
+    if (stats) {
+        stats->gpuMs.fill(0.0f);
+        stats->hasGpuTimes = true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < gpuFrame.scopeCount; ++i) {
+        GpuScope& scope = gpuFrame.scopes[i];
+        uint64_t begin = gpuTimer->getTimestamp(scope.queries[0]);
+        uint64_t end = gpuTimer->getTimestamp(scope.queries[1]);
+        double durationUs = (end - begin) / 1000.0;
+        if (stats) stats->gpuMs[static_cast<size_t>(scope.phase)] += static_cast<float>(durationUs / 1000.0);
+        pushTraceEvent({getPhaseName(scope.phase), 0, begin / 1000.0 + gpuClockOffsetUs, durationUs});
+    }
+}
+
+void Profiler::recordCpu(Phase phase, std::chrono::steady_clock::time_point start,
+                         std::chrono::steady_clock::time_point end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    currentCpuMs[static_cast<size_t>(phase)] += std::chrono::duration<float, std::milli>(end - start).count();
+    pushTraceEvent({getPhaseName(phase), traceThreadId(), toTraceUs(start),
+                    std::chrono::duration<double, std::micro>(end - start).count()});
+}
+
+void Profiler::pushTraceEvent(const TraceEvent& event) {
+    if (trace.size() < TRACE_CAPACITY) {
+        trace.push_back(event);
+        traceNext = trace.size() % TRACE_CAPACITY;
+        traceWrapped = traceNext == 0;
+        return;
+    }
+    trace[traceNext] = event;
+    traceNext = (traceNext + 1) % TRACE_CAPACITY;
+}
+
+uint32_t Profiler::traceThreadId() {
+    std::thread::id id = std::this_thread::get_id();
+    auto it = std::find(threadIds.begin(), threadIds.end(), id);
+    if (it == threadIds.end()) {
+        threadIds.push_back(id);
+        return static_cast<uint32_t>(threadIds.size());
+    }
+    return static_cast<uint32_t>(it - threadIds.begin()) + 1;
+}
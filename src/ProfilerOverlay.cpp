@@ -0,0 +1,115 @@
+/**
+ * @file ProfilerOverlay.cpp
+ * @brief Implementation of the profiler frame graph
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/ProfilerOverlay.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Bar color of each phase, in Profiler::Phase order
+const float PHASE_COLORS[Profiler::PHASE_COUNT][3] = {
+    {0.95f, 0.45f, 0.25f},  // updateBodies
+    {0.95f, 0.80f, 0.25f},  // updateGrid
+    {0.30f, 0.60f, 1.00f},  // render3DSpacetimeGrid
+    {0.40f, 0.90f, 0.45f},  // render3DGravityBodies
+    {0.80f, 0.45f, 0.95f},  // UI
+    {0.60f, 0.60f, 0.60f},  // swap
+};
+
+// Legend labels, short enough for the panel width
+const char* PHASE_LABELS[Profiler::PHASE_COUNT] = {
+    "BODIES", "GRID", "GRID DRAW", "BODY DRAW", "UI", "SWAP",
+};
+
+} // namespace
+
+void ProfilerOverlay::render(UIRenderer& ui, const Profiler& profiler) {
+    if (profiler.getFrameCount() == 0) return;
+
+    const Profiler::FrameStats& newest = profiler.getFrame(0);
+    if (!hasLegend || newest.frameNumber - legendFrame >= TEXT_REFRESH_FRAMES) {
+        updateLegend(profiler);
+        legendFrame = newest.frameNumber;
+        hasLegend = true;
+    }
+
+    int windowWidth = 0, windowHeight = 0;
+    ui.getWindowSize(windowWidth, windowHeight);
+    const float panelWidth = GRAPH_FRAMES + 2.0f * PANEL_PADDING;
+    const float panelHeight = GRAPH_HEIGHT + legend.size() * LINE_HEIGHT + 3.0f * PANEL_PADDING;
+    const float panelX = windowWidth - panelWidth - PANEL_MARGIN;
+    const float panelY = PANEL_MARGIN;
+
+    ui.setColor(0.0f, 0.0f, 0.0f, 0.7f);
+    ui.renderRectangle(panelX, panelY, panelWidth, panelHeight);
+
+    // Stacked CPU phases per frame, newest on the right
+    const float graphX = panelX + PANEL_PADDING;
+    const float graphBottom = panelY + PANEL_PADDING + GRAPH_HEIGHT;
+    const float pixelsPerMs = GRAPH_HEIGHT / GRAPH_RANGE_MS;
+    size_t frames = std::min(GRAPH_FRAMES, profiler.getFrameCount());
+    for (size_t age = 0; age < frames; ++age) {
+        const Profiler::FrameStats& stats = profiler.getFrame(age);
+        float barX = graphX + GRAPH_FRAMES - 1 - age;
+        float top = graphBottom;
+        for (size_t phase = 0; phase < Profiler::PHASE_COUNT; ++phase) {
+            float height = std::min(stats.cpuMs[phase] * pixelsPerMs, top - (graphBottom - GRAPH_HEIGHT));
+            if (height <= 0.0f) continue;
+            top -= height;
+            ui.setColor(PHASE_COLORS[phase][0], PHASE_COLORS[phase][1], PHASE_COLORS[phase][2], 0.9f);
+            ui.renderRectangle(barX, top, 1.0f, height);
+        }
+        if (stats.hasGpuTimes) {
+            float gpuTotal = 0.0f;
+            for (float ms : stats.gpuMs) gpuTotal += ms;
+            float tickY = graphBottom - std::min(gpuTotal * pixelsPerMs, GRAPH_HEIGHT);
+            ui.setColor(1.0f, 1.0f, 1.0f, 0.9f);
+            ui.renderRectangle(barX, tickY - 1.0f, 1.0f, 1.0f);
+        }
+    }
+
+    // 60 and 30 FPS guides
+    ui.setColor(1.0f, 1.0f, 1.0f, 0.25f);
+    ui.renderRectangle(graphX, graphBottom - 1000.0f / 60.0f * pixelsPerMs, GRAPH_FRAMES, 1.0f);
+    ui.renderRectangle(graphX, graphBottom - 1000.0f / 30.0f * pixelsPerMs, GRAPH_FRAMES, 1.0f);
+
+    // Legend: header, then a swatch and the averages of each phase
+    float lineY = graphBottom + PANEL_PADDING;
+    for (size_t line = 0; line < legend.size(); ++line) {
+        float textX = graphX;
+        if (line > 0) {
+            const float* color = PHASE_COLORS[line - 1];
+            ui.setColor(color[0], color[1], color[2]);
+            ui.renderRectangle(graphX, lineY + 2.0f, SWATCH_SIZE, SWATCH_SIZE);
+            textX += SWATCH_SIZE + 4.0f;
+        }
+        ui.setColor(0.9f, 0.9f, 0.9f);
+        ui.renderText(legend[line], textX, lineY);
+        lineY += LINE_HEIGHT;
+    }
+}
+
+void ProfilerOverlay::updateLegend(const Profiler& profiler) {
+    Profiler::FrameStats average = profiler.getAverage(AVERAGE_FRAMES);
+    char text[64];
+    legend.clear();
+
+    float fps = average.intervalMs > 0.0f ? 1000.0f / average.intervalMs : 0.0f;
+    std::snprintf(text, sizeof(text), "%.1f FPS  FRAME %.2f MS", fps, average.frameMs);
+    legend.emplace_back(text);
+
+    for (size_t phase = 0; phase < Profiler::PHASE_COUNT; ++phase) {
+        const char* label = PHASE_LABELS[phase];
+        if (average.hasGpuTimes && average.gpuMs[phase] > 0.0f) {
+            std::snprintf(text, sizeof(text), "%-9s%6.2f  GPU%6.2f", label, average.cpuMs[phase], average.gpuMs[phase]);
+        } else {
+            std::snprintf(text, sizeof(text), "%-9s%6.2f", label, average.cpuMs[phase]);
+        }
+        legend.emplace_back(text);
+    }
+}
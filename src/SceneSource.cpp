@@ -0,0 +1,56 @@
+/**
+ * @file SceneSource.cpp
+ * @brief Implementation of the renderer data source
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/SceneSource.h"
+#include <algorithm>
+#include <chrono>
+
+SceneSource::Frame SceneSource::acquire() {
+    Frame frame;
+    if (!snapshotSource) {
+        frame.grid = gravityGrid.get();
+        frame.bodies = bodyStore.get();
+        return frame;
+    }
+
+    // The simulation thread owns the shared store, so draw nothing until its first snapshot arrives
+    if (snapshotSource->acquireLatest()) {
+        const SimulationSnapshot& snapshot = snapshotSource->getReadSlot();
+        interpolateBodies(snapshot);
+        frame.grid = &snapshot.grid;
+        frame.bodies = &interpolatedBodies;
+    }
+    return frame;
+}
+
+void SceneSource::interpolateBodies(const SimulationSnapshot& snapshot) {
+    const BodyStore& current = snapshot.bodies;
+    float alpha = snapshot.interpolationFactor(std::chrono::steady_clock::now());
+    if (current.version != 0 && current.version == interpolatedSource && alpha == interpolatedAlpha) {
+        return;
+    }
+
+    // Only positions depend on alpha; the other arrays change once per tick
+    if (current.version == 0 || current.version != interpolatedSource) {
+        interpolatedBodies.vx = current.vx;
+        interpolatedBodies.vy = current.vy;
+        interpolatedBodies.mass = current.mass;
+        interpolatedBodies.radius = current.radius;
+    }
+    interpolatedBodies.x.resize(current.size());
+    interpolatedBodies.y.resize(current.size());
+    size_t blended = std::min(current.size(), snapshot.previousX.size());
+    for (size_t i = 0; i < blended; ++i) {
+        interpolatedBodies.x[i] = snapshot.previousX[i] + (current.x[i] - snapshot.previousX[i]) * alpha;
+        interpolatedBodies.y[i] = snapshot.previousY[i] + (current.y[i] - snapshot.previousY[i]) * alpha;
+    }
+    std::copy(current.x.begin() + blended, current.x.end(), interpolatedBodies.x.begin() + blended);
+    std::copy(current.y.begin() + blended, current.y.end(), interpolatedBodies.y.begin() + blended);
+    interpolatedBodies.touch();
+    interpolatedSource = current.version;
+    interpolatedAlpha = alpha;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file ShaderProgram.cpp
+ * @brief Implementation of the GLSL program wrapper
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/ShaderProgram.h"
+#include <iostream>
+#include <string>
+
+ShaderProgram::~ShaderProgram() {
+    release();
+}
+
+namespace {
+
+const char* LEGACY_VERTEX_HEADER =
+    "#version 120\n"
+    "#define IN attribute\n"
+    "#define OUT varying\n";
+
+const char* LEGACY_FRAGMENT_HEADER =
+    "#version 120\n"
+    "#define IN varying\n"
+    "#define FRAG_COLOR gl_FragColor\n"
+    "#define TEXTURE_2D texture2D\n";
+
+const char* CORE_VERTEX_HEADER =
+    "#version 330 core\n"
+    "#define IN in\n"
+    "#define OUT out\n";
+
+const char* CORE_FRAGMENT_HEADER =
+    "#version 330 core\n"
+    "#define IN in\n"
+    "out vec4 fragColor;\n"
+    "#define FRAG_COLOR fragColor\n"
+    "#define TEXTURE_2D texture\n";
+
+const char* COMPUTE_HEADER =
+    "#version 430 core\n";
+
+} // namespace
+
+bool ShaderProgram::build(const char* vertexSource, const char* fragmentSource,
+                          const std::vector<AttributeBinding>& attributes) {
+    return build(std::vector<const char*>{vertexSource}, std::vector<const char*>{fragmentSource}, attributes);
+}
+
+bool ShaderProgram::build(const std::vector<const char*>& vertexSources,
+                          const std::vector<const char*>& fragmentSources,
+                          const std::vector<AttributeBinding>& attributes) {
+    release();
+
+    GLuint vertexShader = compile(GL_VERTEX_SHADER, vertexSources);
+    GLuint fragmentShader = compile(GL_FRAGMENT_SHADER, fragmentSources);
+    if (!vertexShader || !fragmentShader) {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        return false;
+    }
+    return link({vertexShader, fragmentShader}, attributes);
+}
+
+bool ShaderProgram::buildCompute(const std::vector<const char*>& computeSources) {
+    release();
+
+    GLuint computeShader = compile(GL_COMPUTE_SHADER, computeSources);
+    if (!computeShader) {
+        return false;
+    }
+    return link({computeShader}, {});
+}
+
+void ShaderProgram::release() {
+    if (program) {
+        glDeleteProgram(program);
+        program = 0;
+    }
+}
+
+const char* ShaderProgram::versionHeader(Profile profile, GLenum stage) {
+    if (stage == GL_COMPUTE_SHADER) {
+        return COMPUTE_HEADER;
+    }
+    bool vertex = stage == GL_VERTEX_SHADER;
+    if (profile == Profile::Core) {
+        return vertex ? CORE_VERTEX_HEADER : CORE_FRAGMENT_HEADER;
+    }
+    return vertex ? LEGACY_VERTEX_HEADER : LEGACY_FRAGMENT_HEADER;
+}
+
+void ShaderProgram::bindUniformBlock(const char* blockName, GLuint bindingPoint) const {
+    GLuint blockIndex = glGetUniformBlockIndex(program, blockName);
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, bindingPoint);
+    }
+}
+
+GLuint ShaderProgram::compile(GLenum type, const std::vector<const char*>& sources) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, static_cast<GLsizei>(sources.size()), sources.data(), nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint logLength = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+        std::string log(static_cast<size_t>(logLength > 1 ? logLength : 1), '\0');
+        glGetShaderInfoLog(shader, logLength, nullptr, &log[0]);
+        std::cerr << "Shader compilation failed: " << log << "\n";
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool ShaderProgram::link(const std::vector<GLuint>& shaders, const std::vector<AttributeBinding>& attributes) {
+    program = glCreateProgram();
+    for (GLuint shader : shaders) {
+        glAttachShader(program, shader);
+    }
+    for (const auto& attribute : attributes) {
+        glBindAttribLocation(program, attribute.first, attribute.second);
+    }
+    glLinkProgram(program);
+
+    // Shaders are owned by the program once linked
+    for (GLuint shader : shaders) {
+        glDetachShader(program, shader);
+        glDeleteShader(shader);
+    }
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint logLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+        std::string log(static_cast<size_t>(logLength > 1 ? logLength : 1), '\0');
+        glGetProgramInfoLog(program, logLength, nullptr, &log[0]);
+        std::cerr << "Shader program link failed: " << log << "\n";
+        release();
+        return false;
+    }
+    return true;
+}
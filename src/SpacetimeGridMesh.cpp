@@ -0,0 +1,415 @@
+/**
+ * @file SpacetimeGridMesh.cpp
+ * @brief Implementation of the retained-mode spacetime grid
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/SpacetimeGridMesh.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Written against ShaderProgram's dialect macros so it builds for GLSL 1.20 and 3.30 core
+const char* GRID_VERTEX_SHADER = R"(
+IN vec2 position;              // render-space x/z of the grid point
+IN float magnitude;            // |force| at the grid point
+uniform float maxForce;
+uniform float heightScale;
+uniform float maxHeight;
+uniform float lineColorWeight; // 0 for the surface, 1 for the grid lines
+OUT vec3 color;
+
+void main() {
+    float height = min(magnitude * heightScale, maxHeight);
+    float strength = min(1.0, height / maxForce);
+    vec3 surfaceColor = vec3(strength, 0.2, 1.0 - strength);
+    color = mix(surfaceColor, vec3(0.3), lineColorWeight);
+    gl_Position = viewProjection * vec4(position.x, -height, position.y, 1.0);
+}
+)";
+
+const char* GRID_FRAGMENT_SHADER = R"(
+IN vec3 color;
+
+void main() {
+    FRAG_COLOR = vec4(color, 1.0);
+}
+)";
+
+} // namespace
+
+SpacetimeGridMesh::~SpacetimeGridMesh() {
+    release();
+}
+
+bool SpacetimeGridMesh::initialize(ShaderProgram::Profile profile) {
+    bool core = profile == ShaderProgram::Profile::Core;
+    if (core ? !GLEW_VERSION_3_3 : !GLEW_VERSION_2_0) {
+        return false;
+    }
+    
+    if (!program.build({ShaderProgram::versionHeader(profile, GL_VERTEX_SHADER),
+                        CameraUniformBuffer::glslDeclaration(profile), GRID_VERTEX_SHADER},
+                       {ShaderProgram::versionHeader(profile, GL_FRAGMENT_SHADER), GRID_FRAGMENT_SHADER},
+                       {{POSITION_ATTRIBUTE, "position"}, {MAGNITUDE_ATTRIBUTE, "magnitude"}})) {
+        return false;
+    }
+    if (core) {
+        program.bindUniformBlock(CameraUniformBuffer::BLOCK_NAME, CameraUniformBuffer::BINDING_POINT);
+        // Core profiles cannot draw without a vertex array object
+        glGenVertexArrays(1, &vertexArray);
+    }
+
+    maxForceLocation = program.getUniformLocation("maxForce");
+    heightScaleLocation = program.getUniformLocation("heightScale");
+    maxHeightLocation = program.getUniformLocation("maxHeight");
+    lineColorWeightLocation = program.getUniformLocation("lineColorWeight");
+    return true;
+}
+
+void SpacetimeGridMesh::update(const GravityGrid& grid) {
+    auto dimensions = grid.getGridDimensions();
+    if (dimensions.first != gridWidth || dimensions.second != gridHeight) {
+        buildTopology(dimensions.first, dimensions.second);
+        uploadedVersion = 0;
+    }
+    if (!externalMagnitudes && grid.getVersion() != 0 && grid.getVersion() == uploadedVersion) {
+        return;
+    }
+
+    magnitudeOffset = magnitudeBuffer.upload(grid.getForceMagnitudeData(), grid.getPointCount() * sizeof(float));
+    externalMagnitudes = 0;
+    uploadedVersion = grid.getVersion();
+    updateTileHeights(grid.getForceMagnitudeData());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SpacetimeGridMesh::updateFromBuffer(GLuint magnitudes, int width, int height) {
+    if (width != gridWidth || height != gridHeight) {
+        buildTopology(width, height);
+    }
+    if (!externalMagnitudes) updateTileHeights(nullptr);
+
+    magnitudeOffset = 0;
+    externalMagnitudes = magnitudes;
+}
+
+void SpacetimeGridMesh::draw(float maxForceVisualization, const Mat4& view, const Mat4& projection,
+                             float pixelScale) {
+    drawnTiles = drawnTriangles = 0;
+    if (!program.isValid() || surfaceIndexCount == 0) return;
+
+    // Camera position is -R^T t for a rigid view transform
+    const float* v = view.data();
+    float cameraX = -(v[0] * v[12] + v[1] * v[13] + v[2] * v[14]);
+    float cameraY = -(v[4] * v[12] + v[5] * v[13] + v[6] * v[14]);
+    float cameraZ = -(v[8] * v[12] + v[9] * v[13] + v[10] * v[14]);
+    Frustum frustum = Frustum::fromMatrix(projection * view);
+
+    surfaceCounts.clear();
+    surfaceOffsets.clear();
+    lineCounts.clear();
+    lineOffsets.clear();
+    for (const Tile& tile : tiles) {
+        // Heights are displaced downwards, so the box spans y = -maxHeight .. -minHeight
+        if (!frustum.intersectsBox(tile.minX, -tile.maxHeight, tile.minZ, tile.maxX, -tile.minHeight, tile.maxZ)) {
+            continue;
+        }
+        const TileLevel& level = tile.levels[selectLevel(tile, cameraX, cameraY, cameraZ, pixelScale)];
+        surfaceCounts.push_back(level.surfaceCount);
+        surfaceOffsets.push_back(reinterpret_cast<const void*>(level.surfaceOffset));
+        lineCounts.push_back(level.lineCount);
+        lineOffsets.push_back(reinterpret_cast<const void*>(level.lineOffset));
+        drawnTriangles += level.surfaceCount / 3;
+    }
+    drawnTiles = surfaceCounts.size();
+    if (drawnTiles == 0) {
+        if (!externalMagnitudes) magnitudeBuffer.fence();
+        return;
+    }
+
+    program.use();
+    if (vertexArray) glBindVertexArray(vertexArray);
+    glUniform1f(maxForceLocation, maxForceVisualization);
+    glUniform1f(heightScaleLocation, HEIGHT_SCALE);
+    glUniform1f(maxHeightLocation, MAX_HEIGHT);
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionBuffer);
+    glEnableVertexAttribArray(POSITION_ATTRIBUTE);
+    glVertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    if (externalMagnitudes) {
+        glBindBuffer(GL_ARRAY_BUFFER, externalMagnitudes);
+    } else {
+        magnitudeBuffer.bind();
+    }
+    glEnableVertexAttribArray(MAGNITUDE_ATTRIBUTE);
+    glVertexAttribPointer(MAGNITUDE_ATTRIBUTE, 1, GL_FLOAT, GL_FALSE, 0,
+                          reinterpret_cast<const void*>(magnitudeOffset));
+
+    // Surface, pushed back slightly so the lines drawn on top do not z-fight
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(1.0f, 1.0f);
+    glUniform1f(lineColorWeightLocation, 0.0f);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surfaceIndexBuffer);
+    glMultiDrawElements(GL_TRIANGLES, surfaceCounts.data(), GL_UNSIGNED_INT, surfaceOffsets.data(),
+                        static_cast<GLsizei>(drawnTiles));
+    glDisable(GL_POLYGON_OFFSET_FILL);
+
+    glUniform1f(lineColorWeightLocation, 1.0f);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lineIndexBuffer);
+    glMultiDrawElements(GL_LINES, lineCounts.data(), GL_UNSIGNED_INT, lineOffsets.data(),
+                        static_cast<GLsizei>(drawnTiles));
+    if (!externalMagnitudes) magnitudeBuffer.fence();
+
+    // Leave state as the fixed-function code expects it
+    glDisableVertexAttribArray(POSITION_ATTRIBUTE);
+    glDisableVertexAttribArray(MAGNITUDE_ATTRIBUTE);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (vertexArray) glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+void SpacetimeGridMesh::release() {
+    if (positionBuffer) glDeleteBuffers(1, &positionBuffer);
+    if (surfaceIndexBuffer) glDeleteBuffers(1, &surfaceIndexBuffer);
+    if (lineIndexBuffer) glDeleteBuffers(1, &lineIndexBuffer);
+    if (vertexArray) glDeleteVertexArrays(1, &vertexArray);
+    positionBuffer = surfaceIndexBuffer = lineIndexBuffer = vertexArray = 0;
+    surfaceIndexCount = lineIndexCount = 0;
+    gridWidth = gridHeight = 0;
+    tiles.clear();
+    externalMagnitudes = 0;
+    magnitudeBuffer.release();
+    program.release();
+}
+
+void SpacetimeGridMesh::buildTopology(int width, int height) {
+    gridWidth = width;
+    gridHeight = height;
+
+    // Same placement as the immediate mode grid: centered, GRID_SCALE across
+    std::vector<float> positions;
+    positions.reserve(static_cast<size_t>(width) * height * 2);
+    float spacingX = GRID_SCALE / static_cast<float>(width);
+    float spacingY = GRID_SCALE / static_cast<float>(height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            positions.push_back((x - width * 0.5f) * spacingX);
+            positions.push_back((y - height * 0.5f) * spacingY);
+        }
+    }
+
+    // Every tile stores all of its levels back to back; draw() picks one range per tile
+    tiles.clear();
+    std::vector<uint32_t> surface;
+    std::vector<uint32_t> lines;
+    surface.reserve(static_cast<size_t>(width - 1) * (height - 1) * 8);
+    lines.reserve(static_cast<size_t>(width) * height * 6);
+    for (int y0 = 0; y0 < height - 1; y0 += TILE_CELLS) {
+        for (int x0 = 0; x0 < width - 1; x0 += TILE_CELLS) {
+            Tile tile;
+            tile.x0 = x0;
+            tile.y0 = y0;
+            tile.x1 = std::min(x0 + TILE_CELLS, width - 1);
+            tile.y1 = std::min(y0 + TILE_CELLS, height - 1);
+            tile.minX = (tile.x0 - width * 0.5f) * spacingX;
+            tile.maxX = (tile.x1 - width * 0.5f) * spacingX;
+            tile.minZ = (tile.y0 - height * 0.5f) * spacingY;
+            tile.maxZ = (tile.y1 - height * 0.5f) * spacingY;
+            for (int level = 0; level < LOD_LEVEL_COUNT; ++level) {
+                size_t surfaceFirst = surface.size(), lineFirst = lines.size();
+                tessellateTile(tile, 1 << level, surface, lines);
+                TileLevel& range = tile.levels[level];
+                range.surfaceOffset = static_cast<GLintptr>(surfaceFirst * sizeof(uint32_t));
+                range.surfaceCount = static_cast<GLsizei>(surface.size() - surfaceFirst);
+                range.lineOffset = static_cast<GLintptr>(lineFirst * sizeof(uint32_t));
+                range.lineCount = static_cast<GLsizei>(lines.size() - lineFirst);
+            }
+            tiles.push_back(tile);
+        }
+    }
+
+    if (!positionBuffer) glGenBuffers(1, &positionBuffer);
+    if (!surfaceIndexBuffer) glGenBuffers(1, &surfaceIndexBuffer);
+    if (!lineIndexBuffer) glGenBuffers(1, &lineIndexBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(positions.size() * sizeof(float)),
+                 positions.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surfaceIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(surface.size() * sizeof(uint32_t)),
+                 surface.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lineIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(lines.size() * sizeof(uint32_t)),
+                 lines.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    surfaceIndexCount = static_cast<GLsizei>(surface.size());
+    lineIndexCount = static_cast<GLsizei>(lines.size());
+}
+
+void SpacetimeGridMesh::tessellateTile(const Tile& tile, int step, std::vector<uint32_t>& surface,
+                                       std::vector<uint32_t>& lines) const {
+    const int width = gridWidth;
+    const int height = gridHeight;
+    auto index = [width](int x, int y) { return static_cast<uint32_t>(y * width + x); };
+
+    // Kept grid points; the last interval is shorter when the tile is not a multiple of step
+    std::vector<int> xs, ys;
+    for (int x = tile.x0; x < tile.x1; x += step) xs.push_back(x);
+    xs.push_back(tile.x1);
+    for (int y = tile.y0; y < tile.y1; y += step) ys.push_back(y);
+    ys.push_back(tile.y1);
+
+    // Surface: one quad per coarse cell; edges on the tile border keep every grid point
+    std::vector<uint32_t> perimeter;
+    for (size_t j = 0; j + 1 < ys.size(); ++j) {
+        for (size_t i = 0; i + 1 < xs.size(); ++i) {
+            int xa = xs[i], xb = xs[i + 1], ya = ys[j], yb = ys[j + 1];
+            bool split[4] = {ya == tile.y0 && xb - xa > 1,    // bottom, walked +x
+                             xb == tile.x1 && yb - ya > 1,    // right, walked +y
+                             yb == tile.y1 && xb - xa > 1,    // top, walked -x
+                             xa == tile.x0 && yb - ya > 1};   // left, walked -y
+            if (!split[0] && !split[1] && !split[2] && !split[3]) {
+                // Same winding as the full resolution quads
+                surface.insert(surface.end(), {index(xa, ya), index(xb, ya), index(xb, yb),
+                                               index(xa, ya), index(xb, yb), index(xa, yb)});
+                continue;
+            }
+            // Walk the border counterclockwise, remembering where the corners land
+            perimeter.clear();
+            size_t corner[4];
+            corner[0] = perimeter.size();
+            for (int x = xa; x < xb; x += split[0] ? 1 : xb - xa) perimeter.push_back(index(x, ya));
+            corner[1] = perimeter.size();
+            for (int y = ya; y < yb; y += split[1] ? 1 : yb - ya) perimeter.push_back(index(xb, y));
+            corner[2] = perimeter.size();
+            for (int x = xb; x > xa; x -= split[2] ? 1 : xb - xa) perimeter.push_back(index(x, yb));
+            corner[3] = perimeter.size();
+            for (int y = yb; y > ya; y -= split[3] ? 1 : yb - ya) perimeter.push_back(index(xa, y));
+            const size_t count = perimeter.size();
+
+            if (xb - xa >= 2 && yb - ya >= 2) {
+                // Fan around the grid point nearest the cell center, which sees every border point
+                const uint32_t center = index((xa + xb) / 2, (ya + yb) / 2);
+                for (size_t k = 0; k < count; ++k) {
+                    surface.insert(surface.end(), {center, perimeter[k], perimeter[(k + 1) % count]});
+                }
+                continue;
+            }
+
+            // One cell thick: only the long edges can be split. With one of them split,
+            // fan from a corner of the other; with both, the strip is already full resolution.
+            int pivot = -1;
+            for (int c = 0; c < 4 && pivot < 0; ++c) {
+                if (!split[c] && !split[(c + 3) % 4]) pivot = c;
+            }
+            if (pivot < 0) {
+                for (int y = ya; y < yb; ++y) {
+                    for (int x = xa; x < xb; ++x) {
+                        surface.insert(surface.end(), {index(x, y), index(x + 1, y), index(x + 1, y + 1),
+                                                       index(x, y), index(x + 1, y + 1), index(x, y + 1)});
+                    }
+                }
+                continue;
+            }
+            for (size_t k = 1; k + 1 < count; ++k) {
+                surface.insert(surface.end(), {perimeter[corner[pivot]], perimeter[(corner[pivot] + k) % count],
+                                               perimeter[(corner[pivot] + k + 1) % count]});
+            }
+        }
+    }
+
+    // Lines: each tile owns its first row and column (and the last ones at the grid edge),
+    // drawn at full resolution on the border and along the kept points inside
+    auto addRow = [&](int y) {
+        bool border = y == tile.y0 || y == tile.y1;
+        if (border) {
+            for (int x = tile.x0; x < tile.x1; ++x) lines.insert(lines.end(), {index(x, y), index(x + 1, y)});
+        } else {
+            for (size_t i = 0; i + 1 < xs.size(); ++i) lines.insert(lines.end(), {index(xs[i], y), index(xs[i + 1], y)});
+        }
+    };
+    auto addColumn = [&](int x) {
+        bool border = x == tile.x0 || x == tile.x1;
+        if (border) {
+            for (int y = tile.y0; y < tile.y1; ++y) lines.insert(lines.end(), {index(x, y), index(x, y + 1)});
+        } else {
+            for (size_t j = 0; j + 1 < ys.size(); ++j) lines.insert(lines.end(), {index(x, ys[j]), index(x, ys[j + 1])});
+        }
+    };
+    for (int y : ys) {
+        if (y < tile.y1 || tile.y1 == height - 1) addRow(y);
+    }
+    for (int x : xs) {
+        if (x < tile.x1 || tile.x1 == width - 1) addColumn(x);
+    }
+}
+
+void SpacetimeGridMesh::updateTileHeights(const float* magnitudes) {
+    if (!magnitudes) {
+        // The field stays on the GPU: assume any height and let distance alone pick the level
+        for (Tile& tile : tiles) {
+            tile.minHeight = 0.0f;
+            tile.maxHeight = MAX_HEIGHT;
+            tile.curvature = -1.0f;
+        }
+        return;
+    }
+
+    const int width = gridWidth;
+    const int height = gridHeight;
+    auto heightAt = [&](int x, int y) {
+        return std::min(magnitudes[static_cast<size_t>(y) * width + x] * HEIGHT_SCALE, MAX_HEIGHT);
+    };
+    for (Tile& tile : tiles) {
+        float minHeight = MAX_HEIGHT, maxHeight = 0.0f, curvature = 0.0f;
+        for (int y = tile.y0; y <= tile.y1; ++y) {
+            for (int x = tile.x0; x <= tile.x1; ++x) {
+                float h = heightAt(x, y);
+                minHeight = std::min(minHeight, h);
+                maxHeight = std::max(maxHeight, h);
+                if (x > 0 && x < width - 1) {
+                    curvature = std::max(curvature, std::fabs(heightAt(x - 1, y) - 2.0f * h + heightAt(x + 1, y)));
+                }
+                if (y > 0 && y < height - 1) {
+                    curvature = std::max(curvature, std::fabs(heightAt(x, y - 1) - 2.0f * h + heightAt(x, y + 1)));
+                }
+            }
+        }
+        tile.minHeight = minHeight;
+        tile.maxHeight = maxHeight;
+        tile.curvature = curvature;
+    }
+}
+
+int SpacetimeGridMesh::selectLevel(const Tile& tile, float cameraX, float cameraY, float cameraZ,
+                                   float pixelScale) const {
+    // Distance from the camera to the nearest point of the tile's box
+    float dx = std::max({tile.minX - cameraX, 0.0f, cameraX - tile.maxX});
+    float dy = std::max({-tile.maxHeight - cameraY, 0.0f, cameraY + tile.minHeight});
+    float dz = std::max({tile.minZ - cameraZ, 0.0f, cameraZ - tile.maxZ});
+    float distance = std::max(std::sqrt(dx * dx + dy * dy + dz * dz), 1.0f);
+    float pixelsPerUnit = pixelScale / distance;
+
+    // Coverage: coarsen while a coarse cell stays under TARGET_CELL_PIXELS
+    float cellSize = std::max(tile.maxX - tile.minX, tile.maxZ - tile.minZ) / TILE_CELLS;
+    float allowedSteps = TARGET_CELL_PIXELS / std::max(cellSize * pixelsPerUnit, 1e-6f);
+
+    // Curvature: skipping s points misses at most curvature * s^2 / 8 of height
+    if (tile.curvature > 0.0f) {
+        float curvatureSteps = std::sqrt(8.0f * MAX_ERROR_PIXELS / (tile.curvature * pixelsPerUnit));
+        allowedSteps = std::min(allowedSteps, curvatureSteps);
+    }
+
+    int level = 0;
+    while (level + 1 < LOD_LEVEL_COUNT && static_cast<float>(2 << level) <= allowedSteps) ++level;
+    return level;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file SpatialHash.cpp
+ * @brief Implementation of the uniform grid broad phase
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float worldWidth, float worldHeight)
+    : worldWidth(worldWidth), worldHeight(worldHeight) {}
+
+void SpatialHash::build(const BodyStore& bodies, float requestedCellSize) {
+    cellSize = std::max(requestedCellSize, 1e-3f);
+    columns = std::max(1, static_cast<int>(std::ceil(worldWidth / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(worldHeight / cellSize)));
+    while (static_cast<size_t>(columns) * rows > MAX_CELLS) {
+        cellSize *= 2.0f;
+        columns = std::max(1, static_cast<int>(std::ceil(worldWidth / cellSize)));
+        rows = std::max(1, static_cast<int>(std::ceil(worldHeight / cellSize)));
+    }
+
+    // Counting sort by cell: count, prefix sum, scatter in body order
+    const size_t cellCount = static_cast<size_t>(columns) * rows;
+    const size_t count = bodies.size();
+    cellStart.assign(cellCount + 1, 0);
+    bodyCell.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        bodyCell[i] = cellOf(bodies.x[i], bodies.y[i]);
+        ++cellStart[bodyCell[i] + 1];
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    sortedBodies.resize(count);
+    cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        sortedBodies[cellFill[bodyCell[i]]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void SpatialHash::findOverlappingPairs(const BodyStore& bodies, float margin,
+                                       std::vector<BodyPair>& pairs) const {
+    collectPairs([&](uint32_t i, uint32_t j) {
+        float dx = bodies.x[j] - bodies.x[i];
+        float dy = bodies.y[j] - bodies.y[i];
+        float reach = bodies.radius[i] + bodies.radius[j] + margin;
+        return dx * dx + dy * dy < reach * reach;
+    }, pairs);
+}
+
+void SpatialHash::findPairsWithin(const BodyStore& bodies, float distance,
+                                  std::vector<BodyPair>& pairs) const {
+    const float distanceSquared = distance * distance;
+    collectPairs([&](uint32_t i, uint32_t j) {
+        float dx = bodies.x[j] - bodies.x[i];
+        float dy = bodies.y[j] - bodies.y[i];
+        return dx * dx + dy * dy < distanceSquared;
+    }, pairs);
+}
+
+uint32_t SpatialHash::cellOf(float x, float y) const {
+    int column = static_cast<int>(x / cellSize);
+    int row = static_cast<int>(y / cellSize);
+    column = std::max(0, std::min(column, columns - 1));
+    row = std::max(0, std::min(row, rows - 1));
+    return static_cast<uint32_t>(row) * columns + column;
+}
+
+template <typename Accept>
+void SpatialHash::collectPairs(Accept accept, std::vector<BodyPair>& pairs) const {
+    pairs.clear();
+    for (size_t k = 0; k < sortedBodies.size(); ++k) {
+        const uint32_t i = sortedBodies[k];
+        const int column = static_cast<int>(bodyCell[i] % columns);
+        const int row = static_cast<int>(bodyCell[i] / columns);
+
+        // Each pair is seen from both bodies; only the lower index reports it
+        for (int y = std::max(0, row - 1); y <= std::min(rows - 1, row + 1); ++y) {
+            for (int x = std::max(0, column - 1); x <= std::min(columns - 1, column + 1); ++x) {
+                const size_t cell = static_cast<size_t>(y) * columns + x;
+                for (uint32_t s = cellStart[cell]; s < cellStart[cell + 1]; ++s) {
+                    const uint32_t j = sortedBodies[s];
+                    if (j > i && accept(i, j)) {
+                        pairs.emplace_back(i, j);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+}
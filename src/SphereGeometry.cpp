@@ -0,0 +1,52 @@
+/**
+ * @file SphereGeometry.cpp
+ * @brief Implementation of the unit sphere meshes
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/SphereGeometry.h"
+#include <cmath>
+#include <map>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+SphereGeometry SphereGeometry::build(int segments) {
+    SphereGeometry sphere;
+    sphere.segments = segments < 3 ? 3 : segments;
+    const int n = sphere.segments;
+
+    sphere.positions.reserve(static_cast<size_t>(n + 1) * (n + 1) * 3);
+    for (int i = 0; i <= n; ++i) {
+        float lat = (i / float(n)) * M_PI - M_PI / 2;
+        for (int j = 0; j <= n; ++j) {
+            float lng = (j / float(n)) * 2 * M_PI;
+            sphere.positions.push_back(std::cos(lat) * std::cos(lng));
+            sphere.positions.push_back(std::sin(lat));
+            sphere.positions.push_back(std::cos(lat) * std::sin(lng));
+        }
+    }
+
+    // Each quad of the original GL_QUAD_STRIP becomes two triangles
+    const uint32_t rowLength = static_cast<uint32_t>(n + 1);
+    sphere.indices.reserve(static_cast<size_t>(n) * n * 6);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            uint32_t a = i * rowLength + j;
+            uint32_t b = a + rowLength;
+            sphere.indices.insert(sphere.indices.end(), {a, b, a + 1, b, b + 1, a + 1});
+        }
+    }
+    return sphere;
+}
+
+const SphereGeometry& SphereGeometry::cached(int segments) {
+    static std::map<int, SphereGeometry> cache;
+    auto it = cache.find(segments);
+    if (it == cache.end()) {
+        it = cache.emplace(segments, build(segments)).first;
+    }
+    return it->second;
+}
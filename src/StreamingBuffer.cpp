@@ -0,0 +1,107 @@
+/**
+ * @file StreamingBuffer.cpp
+ * @brief Implementation of the per-frame upload buffer
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/StreamingBuffer.h"
+#include <cstring>
+
+StreamingBuffer::StreamingBuffer(GLenum target) : target(target) {}
+
+StreamingBuffer::~StreamingBuffer() {
+    release();
+}
+
+GLintptr StreamingBuffer::upload(const void* data, size_t bytes) {
+    if (!buffer || bytes > regionCapacity) {
+        allocate(bytes);
+    }
+    bind();
+
+    if (!persistent) {
+        // Orphan the old storage so the GPU can keep reading it while we write
+        glBufferData(target, static_cast<GLsizeiptr>(regionCapacity), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(target, 0, static_cast<GLsizeiptr>(bytes), data);
+        return 0;
+    }
+
+    currentRegion = (currentRegion + 1) % REGION_COUNT;
+    waitForRegion(currentRegion);
+    size_t offset = static_cast<size_t>(currentRegion) * regionCapacity;
+    std::memcpy(mapped + offset, data, bytes);
+    return static_cast<GLintptr>(offset);
+}
+
+void StreamingBuffer::fence() {
+    if (!persistent) return;
+    if (fences[currentRegion]) {
+        glDeleteSync(fences[currentRegion]);
+    }
+    fences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamingBuffer::release() {
+    for (GLsync& sync : fences) {
+        if (sync) {
+            glDeleteSync(sync);
+            sync = nullptr;
+        }
+    }
+    if (buffer) {
+        if (mapped) {
+            bind();
+            glUnmapBuffer(target);
+            mapped = nullptr;
+        }
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    regionCapacity = 0;
+    persistent = false;
+}
+
+void StreamingBuffer::allocate(size_t regionBytes) {
+    release();
+
+    // Grow geometrically so slowly increasing sizes do not reallocate every frame
+    regionCapacity = 256;
+    while (regionCapacity < regionBytes) {
+        regionCapacity *= 2;
+    }
+
+    glGenBuffers(1, &buffer);
+    bind();
+
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr totalBytes = static_cast<GLsizeiptr>(regionCapacity * REGION_COUNT);
+        glBufferStorage(target, totalBytes, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(target, 0, totalBytes, flags));
+        persistent = mapped != nullptr;
+        if (!persistent) {
+            // Storage from glBufferStorage is immutable, so start over with a plain buffer
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            bind();
+        }
+    }
+
+    if (!persistent) {
+        glBufferData(target, static_cast<GLsizeiptr>(regionCapacity), nullptr, GL_STREAM_DRAW);
+    }
+    currentRegion = 0;
+}
+
+void StreamingBuffer::waitForRegion(int region) {
+    GLsync sync = fences[region];
+    if (!sync) return;
+
+    // Normally signalled long ago; loop in case the GPU is more than two frames behind
+    const GLuint64 timeoutNanoseconds = 1000000000ull;
+    while (glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds) == GL_TIMEOUT_EXPIRED) {
+    }
+    glDeleteSync(sync);
+    fences[region] = nullptr;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/ThreadPool.h"
+#include <algorithm>
+
+namespace {
+// Set while a thread executes pool work, so nested loops run inline
+thread_local bool insidePoolTask = false;
+
+// Queue index of a worker thread; 0 for threads that are not pool workers
+thread_local size_t currentThreadIndex = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : jobGeneration(0), stopping(false), currentTask(nullptr),
+      jobBegin(0), jobEnd(0), jobGrain(1), remainingChunks(0) {
+    
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    
+    // Queue 0 belongs to the thread calling parallelFor
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, const RangeTask& task) {
+    if (end <= begin) return;
+    grain = std::max<size_t>(grain, 1);
+    
+    size_t chunkCount = (end - begin + grain - 1) / grain;
+    if (workers.empty() || chunkCount == 1 || insidePoolTask) {
+        run(nullptr, begin, end, grain, task);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> submitLock(submitMutex);
+    
+    currentTask = &task;
+    jobBegin = begin;
+    jobEnd = end;
+    jobGrain = grain;
+    remainingChunks.store(chunkCount);
+    
+    // Deal out contiguous blocks of chunks so each thread starts on neighbouring data
+    size_t queueCount = queues.size();
+    for (size_t q = 0; q < queueCount; ++q) {
+        size_t first = chunkCount * q / queueCount;
+        size_t last = chunkCount * (q + 1) / queueCount;
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        queues[q]->front = first;
+        queues[q]->back = last;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        ++jobGeneration;
+    }
+    jobAvailable.notify_all();
+    
+    processChunks(0);
+    
+    std::unique_lock<std::mutex> lock(jobMutex);
+    jobFinished.wait(lock, [this] { return remainingChunks.load() == 0; });
+    currentTask = nullptr;
+}
+
+void ThreadPool::run(ThreadPool* pool, size_t begin, size_t end, size_t grain, const RangeTask& task) {
+    if (pool) {
+        pool->parallelFor(begin, end, grain, task);
+        return;
+    }
+    
+    grain = std::max<size_t>(grain, 1);
+    for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grain) {
+        task(chunkBegin, std::min(end, chunkBegin + grain));
+    }
+}
+
+size_t ThreadPool::getCurrentThreadIndex() {
+    return currentThreadIndex;
+}
+
+void ThreadPool::workerLoop(size_t queueIndex) {
+    uint64_t seenGeneration = 0;
+    currentThreadIndex = queueIndex;
+    
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobAvailable.wait(lock, [&] { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = jobGeneration;
+        }
+        
+        processChunks(queueIndex);
+    }
+}
+
+void ThreadPool::processChunks(size_t queueIndex) {
+    insidePoolTask = true;
+    
+    size_t chunk;
+    while (acquireChunk(queueIndex, chunk)) {
+        size_t chunkBegin = jobBegin + chunk * jobGrain;
+        size_t chunkEnd = std::min(jobEnd, chunkBegin + jobGrain);
+        (*currentTask)(chunkBegin, chunkEnd);
+        
+        if (remainingChunks.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            jobFinished.notify_all();
+        }
+    }
+    
+    insidePoolTask = false;
+}
+
+bool ThreadPool::acquireChunk(size_t queueIndex, size_t& chunk) {
+    // Own queue first, taking from the front to keep working on contiguous data
+    {
+        WorkQueue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.front < own.back) {
+            chunk = own.front++;
+            return true;
+        }
+    }
+    
+    // Steal from the back of the other queues
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkQueue& victim = *queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.front < victim.back) {
+            chunk = --victim.back;
+            return true;
+        }
+    }
+    
+    return false;
+}
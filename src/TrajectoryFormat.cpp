@@ -0,0 +1,55 @@
+/**
+ * @file TrajectoryFormat.cpp
+ * @brief Implementation of the trajectory frame codec
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/TrajectoryFormat.h"
+
+namespace {
+
+/** Number of low-order bytes needed to hold a value */
+uint32_t significantBytes(uint32_t value) {
+    if (value == 0) return 0;
+    if (value <= 0xFFu) return 1;
+    if (value <= 0xFFFFu) return 2;
+    if (value <= 0xFFFFFFu) return 3;
+    return 4;
+}
+
+} // namespace
+
+void TrajectoryCodec::encodeXorDelta(const uint32_t* current, const uint32_t* previous, size_t count,
+                                     std::vector<uint8_t>& output) {
+    const size_t controlStart = output.size();
+    output.reserve(controlStart + (count + 1) / 2 + 4 * count);
+    output.resize(controlStart + (count + 1) / 2, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t delta = current[i] ^ previous[i];
+        uint32_t bytes = significantBytes(delta);
+        output[controlStart + i / 2] |= static_cast<uint8_t>(bytes << ((i & 1) * 4));
+        for (uint32_t b = 0; b < bytes; ++b) {
+            output.push_back(static_cast<uint8_t>(delta >> (8 * b)));
+        }
+    }
+}
+
+bool TrajectoryCodec::decodeXorDelta(const uint8_t* payload, size_t payloadSize, const uint32_t* previous,
+                                     size_t count, uint32_t* current) {
+    const size_t controlSize = (count + 1) / 2;
+    if (payloadSize < controlSize) return false;
+
+    size_t position = controlSize;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t bytes = (payload[i / 2] >> ((i & 1) * 4)) & 0xFu;
+        if (bytes > 4 || position + bytes > payloadSize) return false;
+        uint32_t delta = 0;
+        for (uint32_t b = 0; b < bytes; ++b) {
+            delta |= static_cast<uint32_t>(payload[position++]) << (8 * b);
+        }
+        current[i] = previous[i] ^ delta;
+    }
+    return position == payloadSize;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file TrajectoryPlayer.cpp
+ * @brief Implementation of trajectory playback
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/TrajectoryPlayer.h"
+#include <iostream>
+
+TrajectoryPlayer::TrajectoryPlayer(int gridResolution, size_t threadCount)
+    : bodyStore(std::make_shared<BodyStore>()),
+      threadPool(std::make_unique<ThreadPool>(threadCount)),
+      gridResolution(gridResolution) {
+}
+
+bool TrajectoryPlayer::open(const std::string& path) {
+    if (!reader.open(path)) return false;
+
+    const TrajectoryFileHeader& header = reader.getHeader();
+    gravityGrid = std::make_shared<GravityGrid>(header.worldWidth, header.worldHeight, gridResolution);
+    gravityGrid->setFieldMethod(fieldMethod);
+    bool gridWasEnabled = gridUpdates;
+    gridUpdates = true;  // The grid always shows at least the first frame's field
+    bool shown = show(0);
+    gridUpdates = gridWasEnabled;
+    return shown;
+}
+
+bool TrajectoryPlayer::seek(double time) {
+    if (!gravityGrid) return false;
+    size_t frame = reader.findFrame(time);
+    if (frame == currentFrame) return false;
+    return show(frame);
+}
+
+bool TrajectoryPlayer::show(size_t frame) {
+    if (!reader.readFrame(frame, *bodyStore)) return false;
+    bodyStore->touch();
+    currentFrame = frame;
+    if (gridUpdates) {
+        gravityGrid->updateGrid(*bodyStore, reader.getHeader().gravitationalConstant, threadPool.get());
+    }
+    return true;
+}
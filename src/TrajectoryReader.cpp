@@ -0,0 +1,155 @@
+/**
+ * @file TrajectoryReader.cpp
+ * @brief Implementation of trajectory indexing and frame decoding
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/TrajectoryReader.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char MAGIC[8] = {'B', 'H', 'S', 'T', 'R', 'A', 'J', '\0'};
+
+/** Copies count bit patterns into a float array, resizing it */
+void copyValues(const uint32_t* source, size_t count, std::vector<float>& destination) {
+    destination.resize(count);
+    std::memcpy(destination.data(), source, count * sizeof(float));
+}
+
+} // namespace
+
+bool TrajectoryReader::open(const std::string& path) {
+    header = nullptr;
+    frames.clear();
+    decodedFrame = NO_FRAME;
+    if (!file.open(path)) return false;
+
+    const unsigned char* base = file.data();
+    if (file.size() < sizeof(TrajectoryFileHeader) || std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << path << " is not a trajectory recording\n";
+        return false;
+    }
+    const TrajectoryFileHeader* candidate = reinterpret_cast<const TrajectoryFileHeader*>(base);
+    if (candidate->byteOrder != TrajectoryFileHeader::BYTE_ORDER_MARK) {
+        std::cerr << path << " was written on a machine with a different byte order\n";
+        return false;
+    }
+    if (candidate->version != TrajectoryFileHeader::CURRENT_VERSION ||
+        candidate->headerSize != sizeof(TrajectoryFileHeader)) {
+        std::cerr << path << " has unsupported trajectory version " << candidate->version << "\n";
+        return false;
+    }
+    header = candidate;
+
+    // A cleanly closed file ends in a footer locating the index
+    TrajectoryFooter footer{};
+    const uint64_t size = file.size();
+    if (size >= sizeof(TrajectoryFileHeader) + sizeof(TrajectoryFooter)) {
+        std::memcpy(&footer, base + size - sizeof(TrajectoryFooter), sizeof(TrajectoryFooter));
+    }
+    const uint64_t indexEnd = size - sizeof(TrajectoryFooter);
+    bool indexed = footer.magic == TrajectoryFooter::FOOTER_MAGIC && footer.indexOffset <= indexEnd &&
+                   footer.frameCount == (indexEnd - footer.indexOffset) / sizeof(TrajectoryIndexEntry) &&
+                   (indexEnd - footer.indexOffset) % sizeof(TrajectoryIndexEntry) == 0;
+    if (indexed) {
+        frames.resize(static_cast<size_t>(footer.frameCount));
+        std::memcpy(frames.data(), base + footer.indexOffset, frames.size() * sizeof(TrajectoryIndexEntry));
+        TrajectoryFrameHeader frame;
+        for (const TrajectoryIndexEntry& entry : frames) {
+            if (!frameAt(entry.offset, frame) || entry.offset + sizeof(frame) + frame.payloadSize > footer.indexOffset) {
+                indexed = false;
+                break;
+            }
+        }
+    }
+    if (!indexed) {
+        std::cerr << path << " has no valid frame index (recording interrupted?), scanning frames\n";
+        scanFrames();
+    }
+
+    if (frames.empty()) {
+        std::cerr << path << " contains no frames\n";
+        header = nullptr;
+        return false;
+    }
+    return true;
+}
+
+size_t TrajectoryReader::findFrame(double time) const {
+    auto after = std::upper_bound(frames.begin(), frames.end(), time,
+                                  [](double t, const TrajectoryIndexEntry& entry) { return t < entry.time; });
+    return after == frames.begin() ? 0 : static_cast<size_t>(after - frames.begin()) - 1;
+}
+
+bool TrajectoryReader::readFrame(size_t frame, BodyStore& bodies) {
+    if (frame >= frames.size()) return false;
+
+    if (frame != decodedFrame) {
+        size_t keyframe = frame;
+        while (keyframe > 0 && !frames[keyframe].keyframe) --keyframe;
+
+        // Continue from the frame already decoded when it lies between the keyframe and the target
+        bool continues = decodedFrame != NO_FRAME && decodedFrame >= keyframe && decodedFrame < frame;
+        for (size_t next = continues ? decodedFrame + 1 : keyframe; next <= frame; ++next) {
+            if (!decodeFrame(next)) {
+                std::cerr << "Trajectory frame " << next << " is corrupt\n";
+                return false;
+            }
+        }
+    }
+
+    const size_t count = decodedBits.size() / TrajectoryFrameHeader::RAW_ARRAYS;
+    copyValues(decodedBits.data(), count, bodies.x);
+    copyValues(decodedBits.data() + count, count, bodies.y);
+    copyValues(decodedBits.data() + 2 * count, count, bodies.vx);
+    copyValues(decodedBits.data() + 3 * count, count, bodies.vy);
+    copyValues(decodedBits.data() + 4 * count, count, bodies.mass);
+    copyValues(decodedBits.data() + 5 * count, count, bodies.radius);
+    return true;
+}
+
+bool TrajectoryReader::frameAt(uint64_t offset, TrajectoryFrameHeader& frame) const {
+    const uint64_t size = file.size();
+    if (offset > size || size - offset < sizeof(TrajectoryFrameHeader)) return false;
+    std::memcpy(&frame, file.data() + offset, sizeof(frame));
+    return frame.magic == TrajectoryFrameHeader::FRAME_MAGIC &&
+           frame.payloadSize <= size - offset - sizeof(TrajectoryFrameHeader);
+}
+
+void TrajectoryReader::scanFrames() {
+    uint64_t offset = sizeof(TrajectoryFileHeader);
+    TrajectoryFrameHeader frame;
+    while (frameAt(offset, frame)) {
+        frames.push_back({frame.time, frame.step, offset, frame.encoding == TrajectoryFrameHeader::Raw ? 1u : 0u});
+        offset += sizeof(TrajectoryFrameHeader) + frame.payloadSize;
+    }
+}
+
+bool TrajectoryReader::decodeFrame(size_t frame) {
+    TrajectoryFrameHeader info;
+    decodedFrame = NO_FRAME;
+    if (!frameAt(frames[frame].offset, info)) return false;
+
+    const size_t count = info.bodyCount;
+    const unsigned char* payload = file.data() + frames[frame].offset + sizeof(TrajectoryFrameHeader);
+    if (info.encoding == TrajectoryFrameHeader::Raw) {
+        if (info.payloadSize != TrajectoryFrameHeader::RAW_ARRAYS * count * sizeof(uint32_t)) return false;
+        decodedBits.resize(TrajectoryFrameHeader::RAW_ARRAYS * count);
+        std::memcpy(decodedBits.data(), payload, info.payloadSize);
+    } else if (info.encoding == TrajectoryFrameHeader::XorDelta) {
+        // Masses and radii carry over from the previous frame, which must hold the same bodies
+        if (decodedBits.size() != TrajectoryFrameHeader::RAW_ARRAYS * count ||
+            !TrajectoryCodec::decodeXorDelta(payload, info.payloadSize, decodedBits.data(),
+                                             TrajectoryFrameHeader::DELTA_ARRAYS * count, decodedBits.data())) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    decodedFrame = frame;
+    return true;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file TrajectoryRecorder.cpp
+ * @brief Implementation of the background trajectory writer
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/TrajectoryRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char MAGIC[8] = {'B', 'H', 'S', 'T', 'R', 'A', 'J', '\0'};
+
+/** Copies a float array's bit patterns into place */
+void copyBits(const std::vector<float>& values, uint32_t* destination) {
+    std::memcpy(destination, values.data(), values.size() * sizeof(float));
+}
+
+} // namespace
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+    stop();
+}
+
+bool TrajectoryRecorder::start(const std::string& path, const Settings& requested, float gravitationalConstant,
+                               float worldWidth, float worldHeight) {
+    stop();
+
+    settings = requested;
+    settings.decimation = std::max(settings.decimation, 1);
+    settings.keyframeInterval = settings.compress ? std::max(settings.keyframeInterval, 1) : 1;
+    settings.ringFrames = std::max<size_t>(settings.ringFrames, 2);
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Cannot create trajectory file " << path << "\n";
+        return false;
+    }
+
+    TrajectoryFileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = TrajectoryFileHeader::CURRENT_VERSION;
+    header.headerSize = sizeof(TrajectoryFileHeader);
+    header.byteOrder = TrajectoryFileHeader::BYTE_ORDER_MARK;
+    header.decimation = static_cast<uint32_t>(settings.decimation);
+    header.keyframeInterval = static_cast<uint32_t>(settings.keyframeInterval);
+    header.gravitationalConstant = gravitationalConstant;
+    header.worldWidth = worldWidth;
+    header.worldHeight = worldHeight;
+
+    fileOffset = 0;
+    bytesWritten.store(0, std::memory_order_relaxed);
+    writeBytes(&header, sizeof(header));
+
+    ring.assign(settings.ringFrames, Frame());
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    index.clear();
+    previousBits.clear();
+    stepsSinceFrame = 0;
+    recordedFrames = 0;
+    droppedFrames = 0;
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&TrajectoryRecorder::runWriter, this);
+    recording = true;
+    return true;
+}
+
+void TrajectoryRecorder::stop() {
+    if (!recording) return;
+    recording = false;
+
+    // The writer drains everything published before it sees running == false
+    running.store(false, std::memory_order_release);
+    writer.join();
+
+    TrajectoryFooter footer{};
+    footer.magic = TrajectoryFooter::FOOTER_MAGIC;
+    footer.indexOffset = fileOffset;
+    footer.frameCount = index.size();
+    writeBytes(index.data(), index.size() * sizeof(TrajectoryIndexEntry));
+    writeBytes(&footer, sizeof(footer));
+
+    file.close();
+    if (file.fail()) {
+        std::cerr << "Failed to finish trajectory file\n";
+    }
+    ring.clear();
+    ring.shrink_to_fit();
+}
+
+void TrajectoryRecorder::record(const BodyStore& bodies, double time, uint64_t step) {
+    if (!recording) return;
+    if (++stepsSinceFrame < static_cast<uint64_t>(settings.decimation)) return;
+    stepsSinceFrame = 0;
+
+    const uint64_t slot = head.load(std::memory_order_relaxed);
+    if (slot - tail.load(std::memory_order_acquire) >= ring.size()) {
+        ++droppedFrames;
+        return;
+    }
+
+    Frame& frame = ring[slot % ring.size()];
+    frame.x.assign(bodies.x.begin(), bodies.x.end());
+    frame.y.assign(bodies.y.begin(), bodies.y.end());
+    frame.vx.assign(bodies.vx.begin(), bodies.vx.end());
+    frame.vy.assign(bodies.vy.begin(), bodies.vy.end());
+    frame.mass.assign(bodies.mass.begin(), bodies.mass.end());
+    frame.radius.assign(bodies.radius.begin(), bodies.radius.end());
+    frame.time = time;
+    frame.step = step;
+    head.store(slot + 1, std::memory_order_release);
+    ++recordedFrames;
+}
+
+void TrajectoryRecorder::runWriter() {
+    for (;;) {
+        // Read the flag before the head so frames published before stop() are never missed
+        const bool keepRunning = running.load(std::memory_order_acquire);
+        const uint64_t available = head.load(std::memory_order_acquire);
+        uint64_t next = tail.load(std::memory_order_relaxed);
+
+        if (next == available) {
+            if (!keepRunning) break;
+            std::this_thread::sleep_for(WRITER_POLL_INTERVAL);
+            continue;
+        }
+        for (; next < available; ++next) {
+            writeFrame(ring[next % ring.size()]);
+            tail.store(next + 1, std::memory_order_release);
+        }
+    }
+    file.flush();
+}
+
+void TrajectoryRecorder::writeFrame(const Frame& frame) {
+    const size_t bodyCount = frame.x.size();
+    const size_t valueCount = TrajectoryFrameHeader::RAW_ARRAYS * bodyCount;
+    const size_t deltaCount = TrajectoryFrameHeader::DELTA_ARRAYS * bodyCount;
+    currentBits.resize(valueCount);
+    copyBits(frame.x, currentBits.data());
+    copyBits(frame.y, currentBits.data() + bodyCount);
+    copyBits(frame.vx, currentBits.data() + 2 * bodyCount);
+    copyBits(frame.vy, currentBits.data() + 3 * bodyCount);
+    copyBits(frame.mass, currentBits.data() + 4 * bodyCount);
+    copyBits(frame.radius, currentBits.data() + 5 * bodyCount);
+
+    // Deltas only make sense against the same bodies, and only cover positions and velocities
+    const bool keyframe = index.size() % static_cast<size_t>(settings.keyframeInterval) == 0 ||
+                          previousBits.size() != valueCount ||
+                          std::memcmp(previousBits.data() + deltaCount, currentBits.data() + deltaCount,
+                                      (valueCount - deltaCount) * sizeof(uint32_t)) != 0;
+
+    TrajectoryFrameHeader header{};
+    header.magic = TrajectoryFrameHeader::FRAME_MAGIC;
+    header.step = frame.step;
+    header.time = frame.time;
+    header.bodyCount = static_cast<uint32_t>(bodyCount);
+
+    const void* data;
+    if (keyframe) {
+        header.encoding = TrajectoryFrameHeader::Raw;
+        header.payloadSize = static_cast<uint32_t>(valueCount * sizeof(uint32_t));
+        data = currentBits.data();
+    } else {
+        payload.clear();
+        TrajectoryCodec::encodeXorDelta(currentBits.data(), previousBits.data(), deltaCount, payload);
+        header.encoding = TrajectoryFrameHeader::XorDelta;
+        header.payloadSize = static_cast<uint32_t>(payload.size());
+        data = payload.data();
+    }
+
+    index.push_back({frame.time, frame.step, fileOffset, keyframe ? 1u : 0u});
+    writeBytes(&header, sizeof(header));
+    writeBytes(data, header.payloadSize);
+    previousBits.swap(currentBits);
+}
+
+void TrajectoryRecorder::writeBytes(const void* data, size_t size) {
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    fileOffset += size;
+    bytesWritten.store(fileOffset, std::memory_order_relaxed);
+}
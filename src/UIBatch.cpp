@@ -0,0 +1,163 @@
+/**
+ * @file UIBatch.cpp
+ * @brief Implementation of the UI vertex batch
+ * @author BlackholeSimulator Team
+ * @date 2026-10-14
+ */
+
+#include "../include/UIBatch.h"
+#include <cstddef>
+
+namespace {
+
+// Written against ShaderProgram's dialect macros so it builds for GLSL 1.20 and 3.30 core
+const char* UI_VERTEX_SHADER = R"(
+IN vec2 position;              // window pixels
+IN vec2 texCoord;
+IN vec4 color;
+uniform mat4 projection;
+OUT vec2 atlasCoord;
+OUT vec4 tint;
+
+void main() {
+    atlasCoord = texCoord;
+    tint = color;
+    gl_Position = projection * vec4(position, 0.0, 1.0);
+}
+)";
+
+const char* UI_FRAGMENT_SHADER = R"(
+IN vec2 atlasCoord;
+IN vec4 tint;
+uniform sampler2D atlas;
+
+void main() {
+    FRAG_COLOR = tint * TEXTURE_2D(atlas, atlasCoord);
+}
+)";
+
+} // namespace
+
+UIBatch::~UIBatch() {
+    release();
+}
+
+bool UIBatch::initialize(ShaderProgram::Profile profile) {
+    bool core = profile == ShaderProgram::Profile::Core;
+    if (core ? !GLEW_VERSION_3_3 : !GLEW_VERSION_2_0) {
+        return false;
+    }
+
+    if (!program.build({ShaderProgram::versionHeader(profile, GL_VERTEX_SHADER), UI_VERTEX_SHADER},
+                       {ShaderProgram::versionHeader(profile, GL_FRAGMENT_SHADER), UI_FRAGMENT_SHADER},
+                       {{POSITION_ATTRIBUTE, "position"}, {TEXCOORD_ATTRIBUTE, "texCoord"},
+                        {COLOR_ATTRIBUTE, "color"}})) {
+        return false;
+    }
+    if (core) {
+        // Core profiles cannot draw without a vertex array object
+        glGenVertexArrays(1, &vertexArray);
+    }
+
+    projectionLocation = program.getUniformLocation("projection");
+    atlasLocation = program.getUniformLocation("atlas");
+    return true;
+}
+
+void UIBatch::appendQuad(std::vector<Vertex>& out, float x0, float y0, float x1, float y1,
+                         const GlyphAtlas::Glyph& glyph, const float color[4]) {
+    const float r = color[0], g = color[1], b = color[2], a = color[3];
+    out.push_back({x0, y0, glyph.u0, glyph.v0, r, g, b, a});
+    out.push_back({x1, y0, glyph.u1, glyph.v0, r, g, b, a});
+    out.push_back({x1, y1, glyph.u1, glyph.v1, r, g, b, a});
+    out.push_back({x0, y0, glyph.u0, glyph.v0, r, g, b, a});
+    out.push_back({x1, y1, glyph.u1, glyph.v1, r, g, b, a});
+    out.push_back({x0, y1, glyph.u0, glyph.v1, r, g, b, a});
+}
+
+void UIBatch::addQuad(float x0, float y0, float x1, float y1, const GlyphAtlas::Glyph& glyph, const float color[4]) {
+    appendQuad(vertices, x0, y0, x1, y1, glyph, color);
+}
+
+void UIBatch::addVertices(const std::vector<Vertex>& layout, float dx, float dy, const float color[4]) {
+    vertices.reserve(vertices.size() + layout.size());
+    for (const Vertex& vertex : layout) {
+        vertices.push_back({vertex.x + dx, vertex.y + dy, vertex.u, vertex.v, color[0], color[1], color[2], color[3]});
+    }
+}
+
+int UIBatch::flush(const Mat4& projection, GLuint texture) {
+    if (vertices.empty()) return 0;
+
+    if (!program.isValid()) {
+        drawImmediate(projection, texture);
+        return 1;
+    }
+
+    GLintptr offset = vertexBuffer.upload(vertices.data(), vertices.size() * sizeof(Vertex));
+
+    program.use();
+    if (vertexArray) glBindVertexArray(vertexArray);
+    glUniformMatrix4fv(projectionLocation, 1, GL_FALSE, projection.data());
+    glUniform1i(atlasLocation, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    const GLsizei stride = sizeof(Vertex);
+    glEnableVertexAttribArray(POSITION_ATTRIBUTE);
+    glVertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offset + offsetof(Vertex, x)));
+    glEnableVertexAttribArray(TEXCOORD_ATTRIBUTE);
+    glVertexAttribPointer(TEXCOORD_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offset + offsetof(Vertex, u)));
+    glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+    glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offset + offsetof(Vertex, r)));
+
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+    vertexBuffer.fence();
+
+    // Leave state as the fixed-function code expects it
+    glDisableVertexAttribArray(POSITION_ATTRIBUTE);
+    glDisableVertexAttribArray(TEXCOORD_ATTRIBUTE);
+    glDisableVertexAttribArray(COLOR_ATTRIBUTE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (vertexArray) glBindVertexArray(0);
+    glUseProgram(0);
+    return 1;
+}
+
+void UIBatch::drawImmediate(const Mat4& projection, GLuint texture) const {
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadMatrixf(projection.data());
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glBegin(GL_TRIANGLES);
+    for (const Vertex& vertex : vertices) {
+        glColor4f(vertex.r, vertex.g, vertex.b, vertex.a);
+        glTexCoord2f(vertex.u, vertex.v);
+        glVertex2f(vertex.x, vertex.y);
+    }
+    glEnd();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDisable(GL_TEXTURE_2D);
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+}
+
+void UIBatch::release() {
+    vertexBuffer.release();
+    if (vertexArray) glDeleteVertexArrays(1, &vertexArray);
+    vertexArray = 0;
+    program.release();
+}
@@ -9,54 +9,108 @@
 #include "../include/Camera.h"
 #include <GL/glew.h>
 #include <algorithm>
+#include <iostream>
 
 UIRenderer::UIRenderer(int windowWidth, int windowHeight)
     : windowWidth(windowWidth), windowHeight(windowHeight) {}
 
+bool UIRenderer::initialize(ShaderProgram::Profile profile) {
+    isInitialized = false;
+    if (!atlas.initialize()) {
+        std::cerr << "UIRenderer: failed to create the glyph atlas" << std::endl;
+        return false;
+    }
+    // Legacy contexts can still draw the batch in immediate mode
+    if (!batch.initialize(profile) && profile == ShaderProgram::Profile::Core) {
+        std::cerr << "UIRenderer: failed to build the UI shader" << std::endl;
+        return false;
+    }
+    isInitialized = true;
+    return true;
+}
+
 void UIRenderer::beginUIMode() {
-    // Switch to 2D orthographic projection for UI
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, windowHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Disable depth testing for UI overlay
+    batch.clear();
+    lastDrawCallCount = 0;
+    setColor(1.0f, 1.0f, 1.0f);
+    ++frameIndex;
+}
+
+void UIRenderer::endUIMode() {
+    if (!isInitialized || batch.getVertexCount() == 0) {
+        batch.clear();
+        return;
+    }
+
+    // Overlay on top of the scene with alpha blending, then put the caller's state back
+    GLboolean savedBlend = glIsEnabled(GL_BLEND);
+    GLboolean savedDepthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLint savedBlendSource = GL_ONE;
+    GLint savedBlendDestination = GL_ZERO;
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &savedBlendSource);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &savedBlendDestination);
     glDisable(GL_DEPTH_TEST);
-    
-    // Enable blending for transparent UI elements
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-}
 
-void UIRenderer::endUIMode() {
-    // Restore 3D perspective projection
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
-    
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    // Window pixels with y pointing down
+    Mat4 projection = Mat4::orthographic(0.0f, static_cast<float>(windowWidth),
+                                         static_cast<float>(windowHeight), 0.0f, -1.0f, 1.0f);
+    lastDrawCallCount = batch.flush(projection, atlas.getTexture());
+    batch.clear();
+
+    glBlendFunc(savedBlendSource, savedBlendDestination);
+    if (!savedBlend) glDisable(GL_BLEND);
+    if (savedDepthTest) glEnable(GL_DEPTH_TEST);
+
+    // Forget strings that have not been drawn for a while
+    for (auto it = layoutCache.begin(); it != layoutCache.end();) {
+        if (frameIndex - it->second.lastUsedFrame > LAYOUT_CACHE_FRAMES) {
+            it = layoutCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void UIRenderer::renderText(const std::string& text, float x, float y, float scale) {
-    float currentX = x;
-    
+    batch.addVertices(layoutText(text, scale).vertices, x, y, color);
+}
+
+void UIRenderer::renderRectangle(float x, float y, float width, float height) {
+    batch.addQuad(x, y, x + width, y + height, atlas.getSolidGlyph(), color);
+}
+
+void UIRenderer::setColor(float r, float g, float b, float a) {
+    color[0] = r;
+    color[1] = g;
+    color[2] = b;
+    color[3] = a;
+}
+
+const UIRenderer::CachedLayout& UIRenderer::layoutText(const std::string& text, float scale) {
+    CachedLayout& layout = layoutCache[{text, scale}];
+    layout.lastUsedFrame = frameIndex;
+    if (!layout.vertices.empty() || text.empty()) {
+        return layout;
+    }
+
+    const float white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float currentX = 0.0f;
+    float currentY = 0.0f;
     for (char c : text) {
         if (c == '\n') {
-            y += CHAR_HEIGHT * scale;
-            currentX = x;
+            currentY += CHAR_HEIGHT * scale;
+            currentX = 0.0f;
             continue;
         }
-        
-        drawCharacter(c, currentX, y, scale);
+        if (c != ' ') {
+            UIBatch::appendQuad(layout.vertices, currentX, currentY, currentX + CHAR_WIDTH * scale,
+                                currentY + CHAR_HEIGHT * scale, atlas.getGlyph(c), white);
+        }
         currentX += CHAR_WIDTH * scale;
     }
+    return layout;
 }
 
 void UIRenderer::renderPopupMenu(bool showMenu, int mouseX, int mouseY, CameraController::CameraMode currentMode) {
@@ -81,7 +135,7 @@ void UIRenderer::renderPopupMenu(bool showMenu, int mouseX, int mouseY, CameraCo
     renderMenuBackground(menuX, menuY, MENU_WIDTH, MENU_HEIGHT);
     
     // Menu title
-    glColor3f(1.0f, 1.0f, 1.0f);
+    setColor(1.0f, 1.0f, 1.0f);
     renderText("Camera Mode:", menuX + MENU_PADDING, menuY + MENU_PADDING);
     
     // Menu items
@@ -91,11 +145,11 @@ void UIRenderer::renderPopupMenu(bool showMenu, int mouseX, int mouseY, CameraCo
     bool freeFlightHighlighted = (mouseX >= menuX && mouseX <= menuX + MENU_WIDTH &&
                                  mouseY >= itemY && mouseY <= itemY + MENU_ITEM_HEIGHT);
     if (currentMode == CameraController::CameraMode::FreeFlight) {
-        glColor3f(0.0f, 1.0f, 0.0f); // Green for active
+        setColor(0.0f, 1.0f, 0.0f); // Green for active
     } else if (freeFlightHighlighted) {
-        glColor3f(1.0f, 1.0f, 0.0f); // Yellow for hover
+        setColor(1.0f, 1.0f, 0.0f); // Yellow for hover
     } else {
-        glColor3f(0.8f, 0.8f, 0.8f); // Gray for inactive
+        setColor(0.8f, 0.8f, 0.8f); // Gray for inactive
     }
     renderText("FreeFlight Camera", menuX + MENU_PADDING, itemY);
     
@@ -104,17 +158,17 @@ void UIRenderer::renderPopupMenu(bool showMenu, int mouseX, int mouseY, CameraCo
     bool gameStyleHighlighted = (mouseX >= menuX && mouseX <= menuX + MENU_WIDTH &&
                                 mouseY >= itemY && mouseY <= itemY + MENU_ITEM_HEIGHT);
     if (currentMode == CameraController::CameraMode::GameStyle) {
-        glColor3f(0.0f, 1.0f, 0.0f); // Green for active
+        setColor(0.0f, 1.0f, 0.0f); // Green for active
     } else if (gameStyleHighlighted) {
-        glColor3f(1.0f, 1.0f, 0.0f); // Yellow for hover
+        setColor(1.0f, 1.0f, 0.0f); // Yellow for hover
     } else {
-        glColor3f(0.8f, 0.8f, 0.8f); // Gray for inactive
+        setColor(0.8f, 0.8f, 0.8f); // Gray for inactive
     }
     renderText("GameStyle Camera", menuX + MENU_PADDING, itemY);
     
     // Instructions
     itemY += MENU_ITEM_HEIGHT + 10.0f;
-    glColor3f(0.7f, 0.7f, 0.7f);
+    setColor(0.7f, 0.7f, 0.7f);
     renderText("Click to select", menuX + MENU_PADDING, itemY);
 }
 
@@ -154,228 +208,26 @@ CameraController::CameraMode UIRenderer::getSelectedCameraMode(int mouseX, int m
     return CameraController::CameraMode::FreeFlight; // Default fallback
 }
 
-void UIRenderer::drawCharacter(char c, float x, float y, float scale) {
-    // Simple bitmap font rendering with actual character shapes
-    glColor3f(1.0f, 1.0f, 1.0f);
-    
-    // Define character rendering using line segments for readability
-    glBegin(GL_LINES);
-    
-    switch (c) {
-        case 'A': case 'a':
-            // Draw letter A
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 4*scale, y + 1*scale);  // Left line
-            glVertex2f(x + 4*scale, y + 1*scale); glVertex2f(x + 7*scale, y + 10*scale); // Right line
-            glVertex2f(x + 2*scale, y + 6*scale); glVertex2f(x + 6*scale, y + 6*scale);  // Cross bar
-            break;
-        case 'B': case 'b':
-            // Draw letter B
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 1*scale);  // Top horizontal
-            glVertex2f(x + 1*scale, y + 5.5f*scale); glVertex2f(x + 5*scale, y + 5.5f*scale); // Middle horizontal
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 5*scale, y + 10*scale); // Bottom horizontal
-            glVertex2f(x + 5*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 5.5f*scale); // Top right vertical
-            glVertex2f(x + 5*scale, y + 5.5f*scale); glVertex2f(x + 5*scale, y + 10*scale); // Bottom right vertical
-            break;
-        case 'C': case 'c':
-            // Draw letter C
-            glVertex2f(x + 6*scale, y + 2*scale); glVertex2f(x + 2*scale, y + 2*scale);  // Top
-            glVertex2f(x + 2*scale, y + 2*scale); glVertex2f(x + 2*scale, y + 9*scale); // Left
-            glVertex2f(x + 2*scale, y + 9*scale); glVertex2f(x + 6*scale, y + 9*scale); // Bottom
-            break;
-        case 'D': case 'd':
-            // Draw letter D
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 1*scale);  // Top
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 5*scale, y + 10*scale); // Bottom
-            glVertex2f(x + 5*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 3*scale);  // Top right curve
-            glVertex2f(x + 6*scale, y + 3*scale); glVertex2f(x + 6*scale, y + 8*scale);  // Right vertical
-            glVertex2f(x + 6*scale, y + 8*scale); glVertex2f(x + 5*scale, y + 10*scale); // Bottom right curve
-            break;
-        case 'E': case 'e':
-            // Draw letter E
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 1*scale);  // Top horizontal
-            glVertex2f(x + 1*scale, y + 5.5f*scale); glVertex2f(x + 5*scale, y + 5.5f*scale); // Middle horizontal
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 6*scale, y + 10*scale); // Bottom horizontal
-            break;
-        case 'F': case 'f':
-            // Draw letter F
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 1*scale);  // Top horizontal
-            glVertex2f(x + 1*scale, y + 5.5f*scale); glVertex2f(x + 5*scale, y + 5.5f*scale); // Middle horizontal
-            break;
-        case 'G': case 'g':
-            // Draw letter G
-            glVertex2f(x + 6*scale, y + 2*scale); glVertex2f(x + 2*scale, y + 2*scale);  // Top
-            glVertex2f(x + 2*scale, y + 2*scale); glVertex2f(x + 2*scale, y + 9*scale); // Left
-            glVertex2f(x + 2*scale, y + 9*scale); glVertex2f(x + 6*scale, y + 9*scale); // Bottom
-            glVertex2f(x + 6*scale, y + 9*scale); glVertex2f(x + 6*scale, y + 6*scale); // Right vertical
-            glVertex2f(x + 6*scale, y + 6*scale); glVertex2f(x + 4*scale, y + 6*scale); // Inner horizontal
-            break;
-        case 'H': case 'h':
-            // Draw letter H
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 6*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 10*scale); // Right vertical
-            glVertex2f(x + 1*scale, y + 5.5f*scale); glVertex2f(x + 6*scale, y + 5.5f*scale); // Cross bar
-            break;
-        case 'I': case 'i':
-            // Draw letter I
-            glVertex2f(x + 2*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 1*scale);  // Top horizontal
-            glVertex2f(x + 3.5f*scale, y + 1*scale); glVertex2f(x + 3.5f*scale, y + 10*scale); // Vertical
-            glVertex2f(x + 2*scale, y + 10*scale); glVertex2f(x + 5*scale, y + 10*scale); // Bottom horizontal
-            break;
-        case 'K': case 'k':
-            // Draw letter K
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 5.5f*scale); glVertex2f(x + 6*scale, y + 1*scale); // Upper diagonal
-            glVertex2f(x + 1*scale, y + 5.5f*scale); glVertex2f(x + 6*scale, y + 10*scale); // Lower diagonal
-            break;
-        case 'L': case 'l':
-            // Draw letter L
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Vertical
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 6*scale, y + 10*scale); // Bottom horizontal
-            break;
-        case 'M': case 'm':
-            // Draw letter M
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 1*scale, y + 1*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 3.5f*scale, y + 6*scale); // Left diagonal
-            glVertex2f(x + 3.5f*scale, y + 6*scale); glVertex2f(x + 6*scale, y + 1*scale); // Right diagonal
-            glVertex2f(x + 6*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 10*scale); // Right vertical
-            break;
-        case 'N': case 'n':
-            // Draw letter N
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 1*scale, y + 1*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 10*scale); // Diagonal
-            glVertex2f(x + 6*scale, y + 10*scale); glVertex2f(x + 6*scale, y + 1*scale); // Right vertical
-            break;
-        case 'O': case 'o':
-            // Draw letter O
-            glVertex2f(x + 2*scale, y + 2*scale); glVertex2f(x + 5*scale, y + 2*scale);  // Top
-            glVertex2f(x + 5*scale, y + 2*scale); glVertex2f(x + 5*scale, y + 9*scale); // Right
-            glVertex2f(x + 5*scale, y + 9*scale); glVertex2f(x + 2*scale, y + 9*scale); // Bottom
-            glVertex2f(x + 2*scale, y + 9*scale); glVertex2f(x + 2*scale, y + 2*scale); // Left
-            break;
-        case 'P': case 'p':
-            // Draw letter P
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 1*scale);  // Top horizontal
-            glVertex2f(x + 5*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 5.5f*scale); // Top right vertical
-            glVertex2f(x + 5*scale, y + 5.5f*scale); glVertex2f(x + 1*scale, y + 5.5f*scale); // Middle horizontal
-            break;
-        case 'R': case 'r':
-            // Draw letter R
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 1*scale);  // Top horizontal
-            glVertex2f(x + 5*scale, y + 1*scale); glVertex2f(x + 5*scale, y + 5.5f*scale); // Top right vertical
-            glVertex2f(x + 5*scale, y + 5.5f*scale); glVertex2f(x + 1*scale, y + 5.5f*scale); // Middle horizontal
-            glVertex2f(x + 3*scale, y + 5.5f*scale); glVertex2f(x + 6*scale, y + 10*scale); // Diagonal leg
-            break;
-        case 'S': case 's':
-            // Draw letter S
-            glVertex2f(x + 6*scale, y + 2*scale); glVertex2f(x + 2*scale, y + 2*scale);  // Top
-            glVertex2f(x + 2*scale, y + 2*scale); glVertex2f(x + 2*scale, y + 5.5f*scale); // Upper left
-            glVertex2f(x + 2*scale, y + 5.5f*scale); glVertex2f(x + 5*scale, y + 5.5f*scale); // Middle
-            glVertex2f(x + 5*scale, y + 5.5f*scale); glVertex2f(x + 5*scale, y + 9*scale); // Lower right
-            glVertex2f(x + 5*scale, y + 9*scale); glVertex2f(x + 1*scale, y + 9*scale); // Bottom
-            break;
-        case 'T': case 't':
-            // Draw letter T
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 1*scale);  // Top horizontal
-            glVertex2f(x + 3.5f*scale, y + 1*scale); glVertex2f(x + 3.5f*scale, y + 10*scale); // Vertical
-            break;
-        case 'U': case 'u':
-            // Draw letter U
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 9*scale); // Left vertical
-            glVertex2f(x + 1*scale, y + 9*scale); glVertex2f(x + 6*scale, y + 9*scale); // Bottom
-            glVertex2f(x + 6*scale, y + 9*scale); glVertex2f(x + 6*scale, y + 1*scale); // Right vertical
-            break;
-        case 'V': case 'v':
-            // Draw letter V
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 3.5f*scale, y + 10*scale); // Left diagonal
-            glVertex2f(x + 3.5f*scale, y + 10*scale); glVertex2f(x + 6*scale, y + 1*scale); // Right diagonal
-            break;
-        case 'W': case 'w':
-            // Draw letter W
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 2*scale, y + 10*scale); // Left diagonal
-            glVertex2f(x + 2*scale, y + 10*scale); glVertex2f(x + 3.5f*scale, y + 6*scale); // Left inner
-            glVertex2f(x + 3.5f*scale, y + 6*scale); glVertex2f(x + 5*scale, y + 10*scale); // Right inner
-            glVertex2f(x + 5*scale, y + 10*scale); glVertex2f(x + 6*scale, y + 1*scale); // Right diagonal
-            break;
-        case 'X': case 'x':
-            // Draw letter X
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 10*scale); // Diagonal 1
-            glVertex2f(x + 6*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Diagonal 2
-            break;
-        case 'Y': case 'y':
-            // Draw letter Y
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 3.5f*scale, y + 5.5f*scale); // Left diagonal
-            glVertex2f(x + 6*scale, y + 1*scale); glVertex2f(x + 3.5f*scale, y + 5.5f*scale); // Right diagonal
-            glVertex2f(x + 3.5f*scale, y + 5.5f*scale); glVertex2f(x + 3.5f*scale, y + 10*scale); // Vertical
-            break;
-        case 'Z': case 'z':
-            // Draw letter Z
-            glVertex2f(x + 1*scale, y + 1*scale); glVertex2f(x + 6*scale, y + 1*scale);  // Top
-            glVertex2f(x + 6*scale, y + 1*scale); glVertex2f(x + 1*scale, y + 10*scale); // Diagonal
-            glVertex2f(x + 1*scale, y + 10*scale); glVertex2f(x + 6*scale, y + 10*scale); // Bottom
-            break;
-        case ':':
-            // Draw colon
-            glVertex2f(x + 3*scale, y + 3*scale); glVertex2f(x + 4*scale, y + 3*scale);  // Top dot
-            glVertex2f(x + 3*scale, y + 8*scale); glVertex2f(x + 4*scale, y + 8*scale);  // Bottom dot
-            break;
-        case ' ':
-            // Space - draw nothing
-            break;
-        default:
-            // Draw a simple rectangle for unknown characters
-            glVertex2f(x + 1*scale, y + 2*scale); glVertex2f(x + 6*scale, y + 2*scale);  // Top
-            glVertex2f(x + 6*scale, y + 2*scale); glVertex2f(x + 6*scale, y + 9*scale); // Right
-            glVertex2f(x + 6*scale, y + 9*scale); glVertex2f(x + 1*scale, y + 9*scale); // Bottom
-            glVertex2f(x + 1*scale, y + 9*scale); glVertex2f(x + 1*scale, y + 2*scale); // Left
-            break;
-    }
-    
-    glEnd();
-}
-
-void UIRenderer::getBitmapFontData(char c, int& width, int& height, unsigned char*& data) {
-    // Simplified implementation - not used in the simplified version
-    width = CHAR_WIDTH;
-    height = CHAR_HEIGHT;
-    data = nullptr;
-}
-
 void UIRenderer::renderMenuBackground(float x, float y, float width, float height) {
     // Semi-transparent dark background
-    glColor4f(0.0f, 0.0f, 0.0f, 0.8f);
-    glBegin(GL_QUADS);
-    glVertex2f(x, y);
-    glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height);
-    glVertex2f(x, y + height);
-    glEnd();
+    setColor(0.0f, 0.0f, 0.0f, 0.8f);
+    renderRectangle(x, y, width, height);
     
     // Border
-    glColor3f(0.5f, 0.5f, 0.5f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(x, y);
-    glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height);
-    glVertex2f(x, y + height);
-    glEnd();
+    setColor(0.5f, 0.5f, 0.5f);
+    renderRectangle(x, y, width, MENU_BORDER_WIDTH);
+    renderRectangle(x, y + height - MENU_BORDER_WIDTH, width, MENU_BORDER_WIDTH);
+    renderRectangle(x, y, MENU_BORDER_WIDTH, height);
+    renderRectangle(x + width - MENU_BORDER_WIDTH, y, MENU_BORDER_WIDTH, height);
 }
 
 void UIRenderer::renderMenuItem(const std::string& text, float x, float y, bool isHighlighted) {
     if (isHighlighted) {
-        // Highlight background
-        glColor4f(0.3f, 0.3f, 0.3f, 0.5f);
-        glBegin(GL_QUADS);
-        glVertex2f(x - 5, y - 2);
-        glVertex2f(x + text.length() * CHAR_WIDTH + 5, y - 2);
-        glVertex2f(x + text.length() * CHAR_WIDTH + 5, y + CHAR_HEIGHT + 2);
-        glVertex2f(x - 5, y + CHAR_HEIGHT + 2);
-        glEnd();
+        // Highlight background, keeping the text color
+        float textColor[4] = {color[0], color[1], color[2], color[3]};
+        setColor(0.3f, 0.3f, 0.3f, 0.5f);
+        renderRectangle(x - 5, y - 2, text.length() * CHAR_WIDTH + 10, CHAR_HEIGHT + 4);
+        setColor(textColor[0], textColor[1], textColor[2], textColor[3]);
     }
     
     renderText(text, x, y);